@@ -0,0 +1,87 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "core/gemm/include/batched.hpp"
+#include "core/gemm/include/gemm.hpp"
+
+namespace {
+std::vector<double> TestValues(size_t size, int seed) {
+  std::vector<double> v(size);
+  for (size_t i = 0; i < size; i++) {
+    v[i] = static_cast<double>((i * seed + 3) % 11) - 5.0;
+  }
+  return v;
+}
+
+void CheckUniform(int m, int n, int k, int count, int threads) {
+  std::vector<double> a = TestValues(static_cast<size_t>(count) * m * k, 7);
+  std::vector<double> b = TestValues(static_cast<size_t>(count) * k * n, 5);
+  std::vector<double> c = TestValues(static_cast<size_t>(count) * m * n, 3);
+  std::vector<double> expected = c;
+  for (int i = 0; i < count; i++) {
+    ppc::core::Gemm(m, n, k, a.data() + i * m * k, k, b.data() + i * k * n, n, expected.data() + i * m * n, n);
+  }
+  ppc::core::GemmBatched(m, n, k, a.data(), b.data(), c.data(), count, threads);
+  // small integers: every kernel gives the exact result
+  EXPECT_EQ(expected, c) << m << " x " << n << " x " << k << " on " << threads << " threads";
+}
+}  // namespace
+
+TEST(batched_tests, check_uniform_sizes) {
+  // the compiled square kernels, their neighbours on the generic kernel and one size past it on Gemm
+  for (int n : {1, 3, 4, 5, 8, 16, 17, 32, 64, 65}) {
+    CheckUniform(n, n, n, 7, 1);
+  }
+  CheckUniform(3, 7, 5, 11, 1);
+  CheckUniform(64, 2, 70, 3, 1);
+}
+
+TEST(batched_tests, check_uniform_threads) {
+  CheckUniform(4, 4, 4, 1000, 4);
+  CheckUniform(9, 5, 6, 101, 3);
+  // more threads than products
+  CheckUniform(8, 8, 8, 2, 16);
+}
+
+TEST(batched_tests, check_variable_batch) {
+  // quadrants and other views of one matrix, from a 4 x 4 block to the whole matrix, into views of another
+  int ld = 100;
+  std::vector<double> a = TestValues(static_cast<size_t>(ld) * ld, 7);
+  std::vector<double> b = TestValues(static_cast<size_t>(ld) * ld, 5);
+  std::vector<std::vector<double>> c;
+  std::vector<ppc::core::GemmBatchEntry> batch;
+  int shapes[][3] = {{4, 4, 4}, {16, 16, 16}, {64, 64, 64}, {5, 9, 3}, {33, 17, 40}, {100, 100, 100}, {70, 1, 2}};
+  for (int round = 0; round < 3; round++) {
+    for (auto& shape : shapes) {
+      c.emplace_back(TestValues(static_cast<size_t>(shape[0]) * (shape[1] + round), 3));
+    }
+  }
+  size_t index = 0;
+  for (int round = 0; round < 3; round++) {
+    for (auto& shape : shapes) {
+      int m = shape[0];
+      int n = shape[1];
+      int k = shape[2];
+      // an offset view of A and B, and a C with a row stride wider than n
+      batch.push_back({m, n, k, a.data() + (ld - m) * ld, ld, b.data() + (ld - n), ld, c[index].data(), n + round});
+      index++;
+    }
+  }
+
+  std::vector<std::vector<double>> expected = c;
+  for (size_t i = 0; i < batch.size(); i++) {
+    const auto& e = batch[i];
+    ppc::core::Gemm(e.m, e.n, e.k, e.A, e.lda, e.B, e.ldb, expected[i].data(), e.ldc);
+  }
+  for (int threads : {1, 4}) {
+    std::vector<std::vector<double>> result = c;
+    for (size_t i = 0; i < batch.size(); i++) {
+      batch[i].C = result[i].data();
+    }
+    ppc::core::GemmBatched(batch, threads);
+    EXPECT_EQ(expected, result) << "on " << threads << " threads";
+  }
+  ppc::core::GemmBatched(std::vector<ppc::core::GemmBatchEntry>(), 4);
+}
@@ -0,0 +1,30 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include "core/gemm/include/blocking.hpp"
+
+TEST(blocking_tests, check_cache_sizes) {
+  ppc::core::CacheSizes caches = ppc::core::ReadCacheSizes();
+  EXPECT_GT(caches.l1, 0U);
+  EXPECT_LE(caches.l1, caches.l2);
+  EXPECT_LE(caches.l2, caches.l3);
+}
+
+TEST(blocking_tests, check_tuned_block_size) {
+  int block = ppc::core::TuneBlockSize("test", 320, 4);
+  EXPECT_GE(block, 16);
+  EXPECT_EQ(0, block % 8);
+  EXPECT_LE(block, 320);
+  // cached and recorded once
+  EXPECT_EQ(block, ppc::core::TuneBlockSize("test", 320, 4));
+  int recorded = 0;
+  for (const auto& tuning : ppc::core::BlockTunings()) {
+    if (tuning.algorithm == "test" && tuning.n == 320 && tuning.threads == 4) {
+      EXPECT_EQ(block, tuning.block);
+      recorded++;
+    }
+  }
+  EXPECT_EQ(1, recorded);
+  // small matrices are a single block
+  EXPECT_EQ(10, ppc::core::TuneBlockSize("test", 10, 4));
+}
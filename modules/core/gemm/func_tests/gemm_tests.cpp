@@ -0,0 +1,121 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "core/gemm/include/gemm.hpp"
+
+namespace {
+std::vector<double> NaiveMultiply(const std::vector<double> &a, const std::vector<double> &b, int m, int n, int k) {
+  std::vector<double> c(m * n, 0.0);
+  for (int i = 0; i < m; i++) {
+    for (int p = 0; p < k; p++) {
+      for (int j = 0; j < n; j++) {
+        c[i * n + j] += a[i * k + p] * b[p * n + j];
+      }
+    }
+  }
+  return c;
+}
+
+// integers this small are exact in float too, so every precision must match the naive product exactly
+template <typename T = double, typename Acc = T>
+void CheckShape(int m, int n, int k) {
+  std::vector<T> a(m * k);
+  std::vector<T> b(k * n);
+  for (int i = 0; i < m * k; i++) {
+    a[i] = i % 7 - 3;
+  }
+  for (int i = 0; i < k * n; i++) {
+    b[i] = i % 5 - 2;
+  }
+  std::vector<double> expected =
+      NaiveMultiply(std::vector<double>(a.begin(), a.end()), std::vector<double>(b.begin(), b.end()), m, n, k);
+  // the result is accumulated into what C already holds
+  std::vector<Acc> c(m * n, 1.0);
+  ppc::core::Gemm(m, n, k, a.data(), k, b.data(), n, c.data(), n);
+  for (int i = 0; i < m * n; i++) {
+    ASSERT_EQ(expected[i] + 1.0, c[i]) << m << " x " << n << " x " << k << ", element " << i;
+  }
+}
+}  // namespace
+
+TEST(gemm_tests, check_small_shapes) {
+  for (int m : {1, 3, 4, 5, 17}) {
+    for (int n : {1, 7, 8, 9, 33}) {
+      for (int k : {1, 2, 31}) {
+        CheckShape(m, n, k);
+        CheckShape<float>(m, n, k);
+        CheckShape<float, double>(m, n, k);
+      }
+    }
+  }
+}
+
+TEST(gemm_tests, check_shapes_across_blocks) {
+  // crosses the KC, MC and NC block boundaries
+  CheckShape(100, 2050, 3);
+  CheckShape(197, 45, 300);
+  CheckShape(64, 64, 64);
+  CheckShape<float>(197, 45, 300);
+  CheckShape<float, double>(100, 2050, 3);
+}
+
+TEST(gemm_tests, check_submatrix_strides) {
+  // top-left 3 x 3 block of a 5 x 5 matrix times the bottom-right block, added into the middle of a 4 x 6 matrix
+  int n = 5;
+  std::vector<double> a(n * n);
+  for (int i = 0; i < n * n; i++) {
+    a[i] = i + 1.0;
+  }
+  std::vector<double> c(4 * 6, 0.0);
+  ppc::core::Gemm(3, 3, 3, a.data(), n, a.data() + 2 * n + 2, n, c.data() + 6 + 1, 6);
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 6; j++) {
+      double expected = 0.0;
+      if (i >= 1 && j >= 1 && j <= 3) {
+        for (int p = 0; p < 3; p++) {
+          expected += a[(i - 1) * n + p] * a[(p + 2) * n + (j - 1) + 2];
+        }
+      }
+      EXPECT_EQ(expected, c[i * 6 + j]);
+    }
+  }
+}
+
+TEST(gemm_tests, check_square_vector_overload) {
+  int n = 13;
+  std::vector<double> a(n * n);
+  std::vector<double> b(n * n);
+  for (int i = 0; i < n * n; i++) {
+    a[i] = i % 4 - 1.5;
+    b[i] = i % 3 + 0.5;
+  }
+  EXPECT_EQ(NaiveMultiply(a, b, n, n, n), ppc::core::Gemm(a, b, n));
+  EXPECT_TRUE(ppc::core::Gemm(std::vector<double>(), std::vector<double>(), 0).empty());
+}
+
+TEST(gemm_tests, check_reduced_precision) {
+  int n = 300;
+  std::mt19937 gen(3);
+  std::uniform_real_distribution<float> dis(-1.0F, 1.0F);
+  std::vector<float> a(n * n);
+  std::vector<float> b(n * n);
+  for (int i = 0; i < n * n; i++) {
+    a[i] = dis(gen);
+    b[i] = dis(gen);
+  }
+  std::vector<double> reference =
+      ppc::core::Gemm(std::vector<double>(a.begin(), a.end()), std::vector<double>(b.begin(), b.end()), n);
+
+  // float products are exact in double and are summed in the same order as by the double Gemm
+  std::vector<double> mixed(n * n, 0.0);
+  ppc::core::Gemm(n, n, n, a.data(), n, b.data(), n, mixed.data(), n);
+  EXPECT_EQ(reference, mixed);
+
+  double error = ppc::core::RelativeError(ppc::core::Gemm(a, b, n), reference);
+  std::cout << "relative error of the float Gemm for n = " << n << ": " << error << std::endl;
+  EXPECT_LT(error, n * 6e-8);
+}
@@ -0,0 +1,113 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "core/gemm/include/gemm.hpp"
+#include "core/gemm/include/strassen.hpp"
+
+namespace {
+std::vector<double> TestMatrix(int n, int seed) {
+  std::vector<double> m(n * n);
+  for (int i = 0; i < n * n; i++) {
+    m[i] = (i * seed + 3) % 11 - 5;
+  }
+  return m;
+}
+}  // namespace
+
+TEST(strassen_tests, check_against_gemm) {
+  for (auto variant : {ppc::core::StrassenVariant::Strassen, ppc::core::StrassenVariant::Winograd}) {
+    // 17 and 200 reach an odd block above the cutoff and stop there
+    for (int n : {1, 16, 17, 64, 96, 128, 200}) {
+      std::vector<double> a = TestMatrix(n, 7);
+      std::vector<double> b = TestMatrix(n, 5);
+      std::vector<double> work(ppc::core::StrassenWorkspace(n, 8));
+      std::vector<double> c(n * n, 42.0);
+      ppc::core::Strassen(n, a.data(), n, b.data(), n, c.data(), n, work.data(), 8, variant);
+      // small integers stay exact through all the additions
+      EXPECT_EQ(ppc::core::Gemm(a, b, n), c) << "n = " << n;
+    }
+  }
+}
+
+TEST(strassen_tests, check_float) {
+  for (auto variant : {ppc::core::StrassenVariant::Strassen, ppc::core::StrassenVariant::Winograd}) {
+    for (int n : {17, 64, 200}) {
+      std::vector<double> a = TestMatrix(n, 7);
+      std::vector<double> b = TestMatrix(n, 5);
+      std::vector<float> af(a.begin(), a.end());
+      std::vector<float> bf(b.begin(), b.end());
+      std::vector<float> work(ppc::core::StrassenWorkspace(n, 8));
+      std::vector<float> c(n * n, 42.0F);
+      ppc::core::Strassen(n, af.data(), n, bf.data(), n, c.data(), n, work.data(), 8, variant);
+      // the sums stay far below 2^24, exact in float as well
+      EXPECT_EQ(ppc::core::Gemm(af, bf, n), c) << "n = " << n;
+    }
+  }
+}
+
+TEST(strassen_tests, check_submatrix_views) {
+  // bottom-right 32 x 32 block of a 40 x 40 matrix times its top-left block, into the middle of a 48 x 48 matrix
+  int n = 32;
+  int lda = 40;
+  int ldc = 48;
+  std::vector<double> a = TestMatrix(lda, 3);
+  std::vector<double> c(ldc * ldc, -1.0);
+  std::vector<double> work(ppc::core::StrassenWorkspace(n, 4));
+  ppc::core::Strassen(n, a.data() + 8 * lda + 8, lda, a.data(), lda, c.data() + 8 * ldc + 8, ldc, work.data(), 4);
+
+  std::vector<double> expected(ldc * ldc, -1.0);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      expected[(i + 8) * ldc + j + 8] = 0.0;
+    }
+  }
+  ppc::core::Gemm(n, n, n, a.data() + 8 * lda + 8, lda, a.data(), lda, expected.data() + 8 * ldc + 8, ldc);
+  EXPECT_EQ(expected, c);
+}
+
+TEST(strassen_tests, check_split_merge) {
+  int n = 24;
+  int h = n / 2;
+  std::vector<double> a = TestMatrix(n, 2);
+  std::vector<double> b = TestMatrix(n, 9);
+  for (auto variant : {ppc::core::StrassenVariant::Strassen, ppc::core::StrassenVariant::Winograd}) {
+    std::vector<double> sums(ppc::core::StrassenSplitWorkspace(n));
+    std::vector<double> m(7 * h * h);
+    ppc::core::StrassenProduct products[7];
+    ppc::core::StrassenSplit(n, a.data(), n, b.data(), n, sums.data(), products, variant);
+    for (int i = 0; i < 7; i++) {
+      ppc::core::Gemm(h, h, h, products[i].A, products[i].lda, products[i].B, products[i].ldb, m.data() + i * h * h,
+                      h);
+    }
+    std::vector<double> c(n * n);
+    ppc::core::StrassenMerge(n, m.data(), c.data(), n, variant);
+    EXPECT_EQ(ppc::core::Gemm(a, b, n), c);
+
+    // the same in float: the small integers are exact there as well
+    std::vector<float> af(a.begin(), a.end());
+    std::vector<float> bf(b.begin(), b.end());
+    std::vector<float> sumsF(ppc::core::StrassenSplitWorkspace(n));
+    std::vector<float> mF(7 * h * h);
+    ppc::core::StrassenProductF productsF[7];
+    ppc::core::StrassenSplit(n, af.data(), n, bf.data(), n, sumsF.data(), productsF, variant);
+    for (int i = 0; i < 7; i++) {
+      ppc::core::Gemm(h, h, h, productsF[i].A, productsF[i].lda, productsF[i].B, productsF[i].ldb,
+                      mF.data() + i * h * h, h);
+    }
+    std::vector<float> cF(n * n);
+    ppc::core::StrassenMerge(n, mF.data(), cF.data(), n, variant);
+    EXPECT_EQ(std::vector<float>(c.begin(), c.end()), cF);
+  }
+}
+
+TEST(strassen_tests, check_tuning) {
+  ppc::core::StrassenTuning tuning = ppc::core::TuneStrassen(1);
+  EXPECT_GE(tuning.cutoff, 32);
+  EXPECT_LE(tuning.cutoff, 512);
+  // cached: the second call does not measure again and cannot disagree
+  ppc::core::StrassenTuning again = ppc::core::TuneStrassen(1);
+  EXPECT_EQ(tuning.cutoff, again.cutoff);
+  EXPECT_EQ(tuning.variant, again.variant);
+}
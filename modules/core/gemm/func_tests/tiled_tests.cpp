@@ -0,0 +1,106 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "core/gemm/include/gemm.hpp"
+#include "core/gemm/include/tiled.hpp"
+
+TEST(tiled_tests, check_round_trip) {
+  // 4 does not divide 10 or 7: the edge blocks are padded
+  int rows = 10;
+  int cols = 7;
+  std::vector<double> a(rows * cols);
+  for (int i = 0; i < rows * cols; i++) {
+    a[i] = i + 1.0;
+  }
+  ppc::core::TiledMatrix tiled(rows, cols, 4);
+  EXPECT_EQ(3, tiled.BlockRows());
+  EXPECT_EQ(2, tiled.BlockCols());
+  tiled.FromRowMajor(a.data(), cols);
+
+  // element (9, 6) is row 1, column 2 of block (2, 1); the padding around it stays zero
+  EXPECT_EQ(a[9 * cols + 6], tiled.Block(2, 1)[1 * 4 + 2]);
+  EXPECT_EQ(0.0, tiled.Block(2, 1)[1 * 4 + 3]);
+  EXPECT_EQ(0.0, tiled.Block(2, 1)[2 * 4 + 0]);
+
+  std::vector<double> back(rows * cols, -1.0);
+  tiled.ToRowMajor(back.data(), cols);
+  EXPECT_EQ(a, back);
+}
+
+TEST(tiled_tests, check_z_order) {
+  ppc::core::TiledMatrix tiled(16, 16, 4);
+  const double* base = tiled.Block(0, 0);
+  int block = 4 * 4;
+  // each 2 x 2 group of blocks, and each quadrant of the grid, is contiguous
+  EXPECT_EQ(base + 1 * block, tiled.Block(0, 1));
+  EXPECT_EQ(base + 2 * block, tiled.Block(1, 0));
+  EXPECT_EQ(base + 3 * block, tiled.Block(1, 1));
+  EXPECT_EQ(base + 4 * block, tiled.Block(0, 2));
+  EXPECT_EQ(base + 8 * block, tiled.Block(2, 0));
+  EXPECT_EQ(base + 15 * block, tiled.Block(3, 3));
+
+  // a 3 x 3 grid keeps the Z order of its blocks and leaves no holes
+  ppc::core::TiledMatrix odd(9, 9, 3);
+  base = odd.Block(0, 0);
+  block = 3 * 3;
+  EXPECT_EQ(base + 3 * block, odd.Block(1, 1));
+  EXPECT_EQ(base + 4 * block, odd.Block(0, 2));
+  EXPECT_EQ(base + 8 * block, odd.Block(2, 2));
+}
+
+TEST(tiled_tests, check_block_product) {
+  int n = 50;
+  int tile = 16;
+  std::vector<double> a(n * n);
+  std::vector<double> b(n * n);
+  for (int i = 0; i < n * n; i++) {
+    a[i] = i % 7 - 3;
+    b[i] = i % 5 - 2;
+  }
+  ppc::core::TiledMatrix ta(n, n, tile);
+  ppc::core::TiledMatrix tb(n, n, tile);
+  ppc::core::TiledMatrix tc(n, n, tile);
+  ta.FromRowMajor(a.data(), n);
+  tb.FromRowMajor(b.data(), n);
+  int q = ta.BlockRows();
+  for (int i = 0; i < q; i++) {
+    for (int j = 0; j < q; j++) {
+      for (int k = 0; k < q; k++) {
+        ppc::core::Gemm(tile, tile, tile, ta.Block(i, k), tile, tb.Block(k, j), tile, tc.Block(i, j), tile);
+      }
+    }
+  }
+  std::vector<double> c(n * n);
+  tc.ToRowMajor(c.data(), n);
+  EXPECT_EQ(ppc::core::Gemm(a, b, n), c);
+}
+
+TEST(tiled_tests, check_float_block_product) {
+  int n = 40;
+  int tile = 16;
+  std::vector<float> a(n * n);
+  std::vector<float> b(n * n);
+  for (int i = 0; i < n * n; i++) {
+    a[i] = i % 7 - 3;
+    b[i] = i % 5 - 2;
+  }
+  ppc::core::TiledMatrixF ta(n, n, tile);
+  ppc::core::TiledMatrixF tb(n, n, tile);
+  // float blocks accumulated into double ones
+  ppc::core::TiledMatrix tc(n, n, tile);
+  ta.FromRowMajor(a.data(), n);
+  tb.FromRowMajor(b.data(), n);
+  int q = ta.BlockRows();
+  for (int i = 0; i < q; i++) {
+    for (int j = 0; j < q; j++) {
+      for (int k = 0; k < q; k++) {
+        ppc::core::Gemm(tile, tile, tile, ta.Block(i, k), tile, tb.Block(k, j), tile, tc.Block(i, j), tile);
+      }
+    }
+  }
+  std::vector<double> c(n * n);
+  tc.ToRowMajor(c.data(), n);
+  EXPECT_EQ(ppc::core::Gemm(std::vector<double>(a.begin(), a.end()), std::vector<double>(b.begin(), b.end()), n), c);
+}
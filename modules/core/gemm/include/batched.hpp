@@ -0,0 +1,37 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_BATCHED_HPP_
+#define MODULES_CORE_INCLUDE_BATCHED_HPP_
+
+#include <vector>
+
+namespace ppc::core {
+
+// Many small products at once, where calling Gemm for each would spend more on packing and setup than on arithmetic.
+// Every product is C += A * B on row-major matrices, as for Gemm. Square products of 4, 8, 16, 32 and 64 run on
+// kernels compiled for that size, with the loops fully unrolled; other sizes up to 64 on a kernel without packing,
+// and larger ones on Gemm. The batch is split over threads threads, in contiguous ranges of about equal flops;
+// products must not write to the same C.
+
+// count products of the same shape stored back to back: A[i] is the m x k matrix at A + i * m * k, B[i] the k x n
+// matrix at B + i * k * n and C[i] the m x n matrix at C + i * m * n.
+void GemmBatched(int m, int n, int k, const double* A, const double* B, double* C, int count, int threads = 1);
+
+// One product of a batch of any shapes, with row strides as for Gemm.
+struct GemmBatchEntry {
+  int m;
+  int n;
+  int k;
+  const double* A;
+  int lda;
+  const double* B;
+  int ldb;
+  double* C;
+  int ldc;
+};
+
+void GemmBatched(const std::vector<GemmBatchEntry>& batch, int threads = 1);
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_BATCHED_HPP_
@@ -0,0 +1,42 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_BLOCKING_HPP_
+#define MODULES_CORE_INCLUDE_BLOCKING_HPP_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace ppc::core {
+
+// Data cache sizes in bytes, per core for L1 and L2.
+struct CacheSizes {
+  size_t l1;
+  size_t l2;
+  size_t l3;
+};
+
+// Read from /sys/devices/system/cpu/cpu0/cache; common desktop sizes where that is not available.
+CacheSizes ReadCacheSizes();
+
+// Block size for the block algorithms (Cannon, Fox) multiplying n x n matrices on threads threads. Candidates run
+// from the largest block with three copies in L1 to the largest with three copies in L2, plus the sizes that make
+// the fewest blocks cover n with the least padding. Each candidate's block product is timed on this host, and the
+// pick minimises that time times the number of block products on the slowest thread, padding included. Never larger
+// than n. Cached per (algorithm, n, threads); the first call for a key takes up to a few hundred milliseconds.
+int TuneBlockSize(const std::string& algorithm, int n, int threads);
+
+struct BlockTuning {
+  std::string algorithm;
+  int n;
+  int threads;
+  int block;
+};
+
+// Every choice TuneBlockSize has made in this process, in order. Each is also recorded as a perf note, so a perf
+// statistic shows the ones made while its task was measured.
+std::vector<BlockTuning> BlockTunings();
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_BLOCKING_HPP_
@@ -0,0 +1,33 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_GEMM_HPP_
+#define MODULES_CORE_INCLUDE_GEMM_HPP_
+
+#include <vector>
+
+namespace ppc::core {
+
+// Dense multiply shared by the matrix multiplication tasks as the base case of their algorithms.
+// C += A * B for row-major matrices: A is m x k with row stride lda, B is k x n with row stride ldb and
+// C is m x n with row stride ldc. Blocked as in BLIS: a KC x NC panel of B and an MC x KC block of A are packed
+// into contiguous slivers sized for L3 and L2, and an MR x NR tile of C is accumulated in registers over a whole
+// KC-long slice. Sequential and reentrant, so it can be called from any thread; packing buffers are per thread.
+void Gemm(int m, int n, int k, const double* A, int lda, const double* B, int ldb, double* C, int ldc);
+// Single precision: the same blocking with half the vector instructions, since a vector register holds twice as many
+// floats, and half the bytes to move. The error grows like that of a float dot product, about k * 6e-8 relative.
+void Gemm(int m, int n, int k, const float* A, int lda, const float* B, int ldb, float* C, int ldc);
+// Mixed precision: float A and B, read from memory at half the bytes and widened to double as they are packed, and a
+// double C. A product of two floats is exact in double, so the result is that of the double Gemm on the float inputs.
+void Gemm(int m, int n, int k, const float* A, int lda, const float* B, int ldb, double* C, int ldc);
+
+// C = A * B for square n x n row-major matrices.
+std::vector<double> Gemm(const std::vector<double>& A, const std::vector<double>& B, int n);
+std::vector<float> Gemm(const std::vector<float>& A, const std::vector<float>& B, int n);
+
+// max |C - reference| / max |reference|: the error the reduced-precision paths report against a double reference.
+double RelativeError(const std::vector<float>& C, const std::vector<double>& reference);
+double RelativeError(const std::vector<double>& C, const std::vector<double>& reference);
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_GEMM_HPP_
@@ -0,0 +1,72 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_STRASSEN_HPP_
+#define MODULES_CORE_INCLUDE_STRASSEN_HPP_
+
+#include <cstddef>
+
+namespace ppc::core {
+
+// Blocks of this size or smaller are multiplied by Gemm: below it the extra additions cost more than they save.
+// Used when nothing better is known; TuneStrassen measures the actual crossover.
+const int STRASSEN_CUTOFF = 64;
+
+// Strassen's original scheme takes 18 block additions per level, Winograd's variant 15 by building operand sums on
+// top of each other; which one is faster depends on the host.
+enum class StrassenVariant { Strassen, Winograd };
+
+// Strassen's algorithm on row-major views, a pointer to the top-left element and a row stride, so that quadrants are
+// addressed in place instead of being copied out. All temporaries come from one workspace provided by the caller and
+// used as a stack, one frame of three (n/2) x (n/2) blocks per recursion level.
+
+// Elements of workspace Strassen() needs for an n x n product with either variant, in the element type of the product.
+size_t StrassenWorkspace(int n, int cutoff = STRASSEN_CUTOFF);
+
+// C = A * B for n x n views; C must not overlap A or B. Blocks of cutoff or less and blocks of odd size go to Gemm.
+// work must hold StrassenWorkspace(n, cutoff) elements; nothing is allocated.
+void Strassen(int n, const double* A, int lda, const double* B, int ldb, double* C, int ldc, double* work,
+              int cutoff = STRASSEN_CUTOFF, StrassenVariant variant = StrassenVariant::Strassen);
+// Single precision throughout, the leaves on the float Gemm. Every level adds a few roundings of its operand sums
+// on top of those of Gemm, so the error grows a little faster with n than that of the float Gemm alone.
+void Strassen(int n, const float* A, int lda, const float* B, int ldb, float* C, int ldc, float* work,
+              int cutoff = STRASSEN_CUTOFF, StrassenVariant variant = StrassenVariant::Strassen);
+
+// Parallel versions split a level into its seven products, which are independent of each other, and run those with
+// their own scheduler: StrassenSplit forms the operands, the caller computes the products into consecutive
+// (n/2) x (n/2) blocks and StrassenMerge assembles C from them. n must be even.
+template <typename T>
+struct BasicStrassenProduct {
+  const T* A;
+  int lda;
+  const T* B;
+  int ldb;
+};
+
+using StrassenProduct = BasicStrassenProduct<double>;
+using StrassenProductF = BasicStrassenProduct<float>;
+
+// Elements of workspace StrassenSplit() needs for the operand sums of an n x n product with either variant.
+size_t StrassenSplitWorkspace(int n);
+// Writes the operand sums into work and the two (n/2) x (n/2) factors of each product into products.
+void StrassenSplit(int n, const double* A, int lda, const double* B, int ldb, double* work,
+                   StrassenProduct products[7], StrassenVariant variant = StrassenVariant::Strassen);
+void StrassenSplit(int n, const float* A, int lda, const float* B, int ldb, float* work, StrassenProductF products[7],
+                   StrassenVariant variant = StrassenVariant::Strassen);
+// C from the seven products stored one after another in M.
+void StrassenMerge(int n, const double* M, double* C, int ldc, StrassenVariant variant = StrassenVariant::Strassen);
+void StrassenMerge(int n, const float* M, float* C, int ldc, StrassenVariant variant = StrassenVariant::Strassen);
+
+struct StrassenTuning {
+  int cutoff;
+  StrassenVariant variant;
+};
+
+// Cutoff and variant for this host: the smallest block size for which one level of either variant beats Gemm on a
+// block twice as large, and the faster variant at that size. The probe runs on min(threads, 16) threads at once, so
+// that it sees the memory bandwidth left to each thread when the task runs with that many. Measured on the first call
+// for a thread count and cached for the rest of the process; takes a few hundred milliseconds.
+StrassenTuning TuneStrassen(int threads);
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_STRASSEN_HPP_
@@ -0,0 +1,56 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_TILED_HPP_
+#define MODULES_CORE_INCLUDE_TILED_HPP_
+
+#include <cstddef>
+#include <vector>
+
+namespace ppc::core {
+
+// Matrix stored as tile x tile blocks for the block algorithms (Cannon, Fox), so that a block is one contiguous
+// row-major array with row stride Tile() instead of a strided gather out of the whole matrix. Blocks follow a
+// Z-order (Morton) curve over the block grid: the four quadrants of a power-of-two grid, and recursively theirs,
+// are contiguous as well, and blocks that are close in the grid are close in memory. Edge blocks are padded with
+// zeros, which leave products unchanged, so the tile does not have to divide the matrix size. Instantiated for
+// double and float.
+template <typename T>
+class BasicTiledMatrix {
+ public:
+  BasicTiledMatrix() = default;
+  // all zeros
+  BasicTiledMatrix(int rows, int cols, int tile);
+
+  // copies a row-major rows x cols matrix with row stride ld in or out
+  void FromRowMajor(const T* a, int ld);
+  void ToRowMajor(T* a, int ld) const;
+
+  void SetZero();
+
+  int Rows() const { return rows_; }
+  int Cols() const { return cols_; }
+  int Tile() const { return tile_; }
+  int BlockRows() const { return block_rows_; }
+  int BlockCols() const { return block_cols_; }
+
+  // block (bi, bj): Tile() x Tile() elements, row stride Tile()
+  T* Block(int bi, int bj) { return data_.data() + offsets_[bi * block_cols_ + bj]; }
+  const T* Block(int bi, int bj) const { return data_.data() + offsets_[bi * block_cols_ + bj]; }
+
+ private:
+  int rows_ = 0;
+  int cols_ = 0;
+  int tile_ = 1;
+  int block_rows_ = 0;
+  int block_cols_ = 0;
+  // start of each block in data_, indexed by bi * block_cols_ + bj
+  std::vector<size_t> offsets_;
+  std::vector<T> data_;
+};
+
+using TiledMatrix = BasicTiledMatrix<double>;
+using TiledMatrixF = BasicTiledMatrix<float>;
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_TILED_HPP_
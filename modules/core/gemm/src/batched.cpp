@@ -0,0 +1,158 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/gemm/include/batched.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+
+#include "core/gemm/include/gemm.hpp"
+
+namespace {
+// largest side handled without Gemm: up to here the operands fit in L1 and L2 as they are
+const int SMALL_MAX = 64;
+
+// rows of C the square kernel keeps in registers: as many as fill 32 doubles, the 16 vector registers of SSE2
+constexpr int KernelRows(int n) { return std::clamp(32 / n, 1, n); }
+
+// C += A * B for an N x N product. R rows of C stay in registers through the whole k loop, so that each row of B
+// loaded is used R times; with N known the compiler unrolls the loops into vector multiply-adds.
+template <int N, int R = KernelRows(N)>
+void SquareKernel(const double* A, int lda, const double* B, int ldb, double* C, int ldc) {
+  for (int i = 0; i < N; i += R) {
+    double c[R][N];
+    for (int r = 0; r < R; r++) {
+      for (int j = 0; j < N; j++) {
+        c[r][j] = C[static_cast<size_t>(i + r) * ldc + j];
+      }
+    }
+    for (int p = 0; p < N; p++) {
+      const double* b = B + static_cast<size_t>(p) * ldb;
+      for (int r = 0; r < R; r++) {
+        double a = A[static_cast<size_t>(i + r) * lda + p];
+        for (int j = 0; j < N; j++) {
+          c[r][j] += a * b[j];
+        }
+      }
+    }
+    for (int r = 0; r < R; r++) {
+      for (int j = 0; j < N; j++) {
+        C[static_cast<size_t>(i + r) * ldc + j] = c[r][j];
+      }
+    }
+  }
+}
+
+// the same loop order for any m, n, k up to SMALL_MAX
+void SmallKernel(const ppc::core::GemmBatchEntry& e) {
+  for (int i = 0; i < e.m; i++) {
+    double c[SMALL_MAX];
+    double* row = e.C + static_cast<size_t>(i) * e.ldc;
+    std::copy(row, row + e.n, c);
+    for (int p = 0; p < e.k; p++) {
+      double a = e.A[static_cast<size_t>(i) * e.lda + p];
+      const double* b = e.B + static_cast<size_t>(p) * e.ldb;
+      for (int j = 0; j < e.n; j++) {
+        c[j] += a * b[j];
+      }
+    }
+    std::copy(c, c + e.n, row);
+  }
+}
+
+using Kernel = void (*)(const double*, int, const double*, int, double*, int);
+
+// the kernel compiled for an n x n x n product, or nullptr
+Kernel SquareKernelFor(int m, int n, int k) {
+  if (m != n || n != k) {
+    return nullptr;
+  }
+  switch (n) {
+    case 4:
+      return SquareKernel<4>;
+    case 8:
+      return SquareKernel<8>;
+    case 16:
+      return SquareKernel<16>;
+    case 32:
+      return SquareKernel<32>;
+    case 64:
+      return SquareKernel<64>;
+    default:
+      return nullptr;
+  }
+}
+
+void Multiply(const ppc::core::GemmBatchEntry& e, Kernel kernel) {
+  if (kernel != nullptr) {
+    kernel(e.A, e.lda, e.B, e.ldb, e.C, e.ldc);
+  } else if (e.m <= SMALL_MAX && e.n <= SMALL_MAX && e.k <= SMALL_MAX) {
+    SmallKernel(e);
+  } else {
+    ppc::core::Gemm(e.m, e.n, e.k, e.A, e.lda, e.B, e.ldb, e.C, e.ldc);
+  }
+}
+
+// runs body(begin, end) on threads contiguous ranges of [0, count), cut where the prefix of weights crosses each
+// multiple of the total over threads; the calling thread takes the first range
+template <typename Weight, typename Body>
+void ForRanges(int count, int threads, Weight weight, Body body) {
+  threads = std::clamp(threads, 1, std::max(1, count));
+  if (threads == 1) {
+    body(0, count);
+    return;
+  }
+  double total = 0.0;
+  for (int i = 0; i < count; i++) {
+    total += weight(i);
+  }
+  std::vector<int> bounds{0};
+  double prefix = 0.0;
+  for (int i = 0; i < count && static_cast<int>(bounds.size()) < threads; i++) {
+    prefix += weight(i);
+    if (prefix >= total * static_cast<double>(bounds.size()) / threads) {
+      bounds.push_back(i + 1);
+    }
+  }
+  bounds.push_back(count);
+
+  std::vector<std::thread> pool;
+  for (size_t t = 1; t + 1 < bounds.size(); t++) {
+    pool.emplace_back(body, bounds[t], bounds[t + 1]);
+  }
+  body(bounds[0], bounds[1]);
+  for (auto& thread : pool) {
+    thread.join();
+  }
+}
+}  // namespace
+
+void ppc::core::GemmBatched(int m, int n, int k, const double* A, const double* B, double* C, int count, int threads) {
+  if (m <= 0 || n <= 0 || k <= 0 || count <= 0) {
+    return;
+  }
+  Kernel kernel = SquareKernelFor(m, n, k);
+  size_t a_size = static_cast<size_t>(m) * k;
+  size_t b_size = static_cast<size_t>(k) * n;
+  size_t c_size = static_cast<size_t>(m) * n;
+  ForRanges(
+      count, threads, [](int) { return 1.0; },
+      [&](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+          Multiply({m, n, k, A + i * a_size, k, B + i * b_size, n, C + i * c_size, n}, kernel);
+        }
+      });
+}
+
+void ppc::core::GemmBatched(const std::vector<GemmBatchEntry>& batch, int threads) {
+  ForRanges(
+      static_cast<int>(batch.size()), threads,
+      [&](int i) { return static_cast<double>(batch[i].m) * batch[i].n * batch[i].k; },
+      [&](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+          const GemmBatchEntry& e = batch[i];
+          if (e.m > 0 && e.n > 0 && e.k > 0) {
+            Multiply(e, SquareKernelFor(e.m, e.n, e.k));
+          }
+        }
+      });
+}
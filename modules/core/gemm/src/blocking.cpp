@@ -0,0 +1,156 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/gemm/include/blocking.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <set>
+#include <tuple>
+
+#include "core/gemm/include/gemm.hpp"
+#include "core/gemm/include/tiled.hpp"
+#include "core/perf/include/perf.hpp"
+
+namespace {
+// blocks are multiples of the micro-kernel width, so no edge tiles are computed inside a block
+const int BLOCK_ALIGN = 8;
+const int MIN_BLOCK = 16;
+
+size_t ReadSize(const std::string& path) {
+  std::ifstream in(path);
+  size_t value = 0;
+  char unit = 0;
+  if (!(in >> value)) {
+    return 0;
+  }
+  if (in >> unit) {
+    if (unit == 'K') {
+      value <<= 10;
+    } else if (unit == 'M') {
+      value <<= 20;
+    }
+  }
+  return value;
+}
+
+// largest aligned block size b with three b x b blocks of doubles in bytes
+int FittingBlock(size_t bytes) {
+  int b = static_cast<int>(std::sqrt(static_cast<double>(bytes) / (3 * sizeof(double))));
+  return std::max(MIN_BLOCK, b / BLOCK_ALIGN * BLOCK_ALIGN);
+}
+
+int AlignUp(int n) { return (n + BLOCK_ALIGN - 1) / BLOCK_ALIGN * BLOCK_ALIGN; }
+
+// seconds per block product: the eight products of a 2 x 2 block grid, best of two sweeps
+double ProbeBlock(int block) {
+  ppc::core::TiledMatrix a(2 * block, 2 * block, block);
+  ppc::core::TiledMatrix b(2 * block, 2 * block, block);
+  ppc::core::TiledMatrix c(2 * block, 2 * block, block);
+  std::vector<double> init(static_cast<size_t>(4) * block * block, 1.0);
+  a.FromRowMajor(init.data(), 2 * block);
+  b.FromRowMajor(init.data(), 2 * block);
+  double best = std::numeric_limits<double>::max();
+  for (int run = 0; run < 2; run++) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 2; i++) {
+      for (int j = 0; j < 2; j++) {
+        for (int k = 0; k < 2; k++) {
+          ppc::core::Gemm(block, block, block, a.Block(i, k), block, b.Block(k, j), block, c.Block(i, j), block);
+        }
+      }
+    }
+    best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+  }
+  return best / 8;
+}
+
+int Measure(int n, int threads) {
+  if (n <= MIN_BLOCK) {
+    return n;
+  }
+  ppc::core::CacheSizes caches = ppc::core::ReadCacheSizes();
+  int largest = std::min(FittingBlock(caches.l2), AlignUp(n));
+  std::set<int> candidates;
+  for (int b = FittingBlock(caches.l1); b <= largest; b = b * 3 / 2 / BLOCK_ALIGN * BLOCK_ALIGN) {
+    candidates.insert(b);
+  }
+  candidates.insert(largest);
+  // the fewest blocks that fit, each as small as covers n: the least padding for that count
+  int fewest = (n + largest - 1) / largest;
+  for (int count = fewest; count < fewest + 4; count++) {
+    candidates.insert(std::max(MIN_BLOCK, AlignUp((n + count - 1) / count)));
+  }
+
+  int best_block = std::min(n, largest);
+  double best_time = std::numeric_limits<double>::max();
+  for (int candidate : candidates) {
+    // callers reject blocks larger than the matrix
+    int block = std::min(n, candidate);
+    int grid = (n + block - 1) / block;
+    // grid steps, each spreading grid^2 block products over the threads
+    double rounds = static_cast<double>(grid) * ((grid * grid + threads - 1) / threads);
+    double time = rounds * ProbeBlock(block);
+    if (time < best_time) {
+      best_time = time;
+      best_block = block;
+    }
+  }
+  return best_block;
+}
+
+std::mutex tuning_mutex;
+std::map<std::tuple<std::string, int, int>, int> tuned;
+std::vector<ppc::core::BlockTuning> history;
+}  // namespace
+
+ppc::core::CacheSizes ppc::core::ReadCacheSizes() {
+  CacheSizes sizes{32 << 10, 256 << 10, 8 << 20};
+  const std::string root = "/sys/devices/system/cpu/cpu0/cache/index";
+  for (int index = 0; index < 8; index++) {
+    std::string dir = root + std::to_string(index) + "/";
+    std::ifstream level_file(dir + "level");
+    std::ifstream type_file(dir + "type");
+    int level = 0;
+    std::string type;
+    if (!(level_file >> level) || !(type_file >> type) || type == "Instruction") {
+      continue;
+    }
+    size_t size = ReadSize(dir + "size");
+    if (size == 0) {
+      continue;
+    }
+    if (level == 1) {
+      sizes.l1 = size;
+    } else if (level == 2) {
+      sizes.l2 = size;
+    } else if (level == 3) {
+      sizes.l3 = size;
+    }
+  }
+  return sizes;
+}
+
+int ppc::core::TuneBlockSize(const std::string& algorithm, int n, int threads) {
+  threads = std::max(1, threads);
+  std::lock_guard<std::mutex> lock(tuning_mutex);
+  auto key = std::make_tuple(algorithm, n, threads);
+  auto found = tuned.find(key);
+  if (found != tuned.end()) {
+    return found->second;
+  }
+  int block = Measure(n, threads);
+  tuned[key] = block;
+  history.push_back({algorithm, n, threads, block});
+  RecordPerfNote("tuned block size of " + algorithm + " for n = " + std::to_string(n) + " on " +
+                 std::to_string(threads) + " threads: " + std::to_string(block));
+  return block;
+}
+
+std::vector<ppc::core::BlockTuning> ppc::core::BlockTunings() {
+  std::lock_guard<std::mutex> lock(tuning_mutex);
+  return history;
+}
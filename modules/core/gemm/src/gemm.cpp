@@ -0,0 +1,150 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/gemm/include/gemm.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+// The micro-kernel keeps an MR x NR tile of C in registers: 8 vector registers with AVX, 16 with SSE2 for double, and
+// half as many for float, whose vectors hold twice as many elements. A float tile twice as wide would take the same
+// registers, but leaves none for the operands and spills on SSE2.
+const int MR = 4;
+const int NR = 8;
+// KC x NR sliver of B stays in L1, MC x KC block of A in L2, KC x NC panel of B in L3.
+const int KC = 256;
+const int MC = 96;
+const int NC = 2048;
+
+// rows [0, mc) x columns [0, kc) of A as MR-row slivers, each stored column by column and padded with zeros; the
+// packed copy has the accumulator type
+template <typename T, typename Acc>
+void PackA(int mc, int kc, const T* A, int lda, Acc* out) {
+  for (int i = 0; i < mc; i += MR) {
+    int rows = std::min(MR, mc - i);
+    for (int p = 0; p < kc; p++) {
+      for (int r = 0; r < MR; r++) {
+        *out++ = r < rows ? static_cast<Acc>(A[static_cast<size_t>(i + r) * lda + p]) : Acc(0);
+      }
+    }
+  }
+}
+
+// rows [0, kc) x columns [0, nc) of B as NR-column slivers, each stored row by row and padded with zeros
+template <typename T, typename Acc>
+void PackB(int kc, int nc, const T* B, int ldb, Acc* out) {
+  for (int j = 0; j < nc; j += NR) {
+    int cols = std::min(NR, nc - j);
+    for (int p = 0; p < kc; p++) {
+      const T* row = B + static_cast<size_t>(p) * ldb + j;
+      for (int q = 0; q < NR; q++) {
+        *out++ = q < cols ? static_cast<Acc>(row[q]) : Acc(0);
+      }
+    }
+  }
+}
+
+// C[0, rows) x [0, cols) += a * b for one packed sliver of each; the fixed-size loops unroll and vectorise at the
+// vector width of the build target. The project sets no -march, so the multiplies and adds are not fused. The tile
+// starts from C, so every element is summed in the same order as by the textbook triple loop.
+template <typename T>
+void MicroKernel(int kc, const T* a, const T* b, T* C, int ldc, int rows, int cols) {
+  T c[MR][NR] = {};
+  for (int r = 0; r < rows; r++) {
+    for (int q = 0; q < cols; q++) {
+      c[r][q] = C[static_cast<size_t>(r) * ldc + q];
+    }
+  }
+  for (int p = 0; p < kc; p++) {
+    for (int r = 0; r < MR; r++) {
+      for (int q = 0; q < NR; q++) {
+        c[r][q] += a[r] * b[q];
+      }
+    }
+    a += MR;
+    b += NR;
+  }
+  for (int r = 0; r < rows; r++) {
+    for (int q = 0; q < cols; q++) {
+      C[static_cast<size_t>(r) * ldc + q] = c[r][q];
+    }
+  }
+}
+
+// Operands of type T are widened to the accumulator type Acc as they are packed, so float operands accumulated in
+// double run on the double micro-kernel: a product of two floats is exact in double and only the sums round, while A
+// and B are read from memory at half the bytes.
+template <typename T, typename Acc>
+void GemmBlocked(int m, int n, int k, const T* A, int lda, const T* B, int ldb, Acc* C, int ldc) {
+  if (m <= 0 || n <= 0 || k <= 0) {
+    return;
+  }
+  thread_local std::vector<Acc> a_pack;
+  thread_local std::vector<Acc> b_pack;
+  int kc_max = std::min(KC, k);
+  a_pack.resize(static_cast<size_t>((std::min(MC, m) + MR - 1) / MR * MR) * kc_max);
+  b_pack.resize(static_cast<size_t>((std::min(NC, n) + NR - 1) / NR * NR) * kc_max);
+
+  for (int jc = 0; jc < n; jc += NC) {
+    int nc = std::min(NC, n - jc);
+    for (int pc = 0; pc < k; pc += KC) {
+      int kc = std::min(KC, k - pc);
+      PackB(kc, nc, B + static_cast<size_t>(pc) * ldb + jc, ldb, b_pack.data());
+      for (int ic = 0; ic < m; ic += MC) {
+        int mc = std::min(MC, m - ic);
+        PackA(mc, kc, A + static_cast<size_t>(ic) * lda + pc, lda, a_pack.data());
+        for (int jr = 0; jr < nc; jr += NR) {
+          for (int ir = 0; ir < mc; ir += MR) {
+            MicroKernel(kc, a_pack.data() + static_cast<size_t>(ir) * kc, b_pack.data() + static_cast<size_t>(jr) * kc,
+                        C + static_cast<size_t>(ic + ir) * ldc + jc + jr, ldc, std::min(MR, mc - ir),
+                        std::min(NR, nc - jr));
+          }
+        }
+      }
+    }
+  }
+}
+
+template <typename T>
+double MaxRelativeError(const std::vector<T>& C, const std::vector<double>& reference) {
+  double error = 0.0;
+  double scale = 0.0;
+  for (size_t i = 0; i < reference.size(); i++) {
+    error = std::max(error, std::fabs(static_cast<double>(C[i]) - reference[i]));
+    scale = std::max(scale, std::fabs(reference[i]));
+  }
+  return scale > 0.0 ? error / scale : error;
+}
+}  // namespace
+
+void ppc::core::Gemm(int m, int n, int k, const double* A, int lda, const double* B, int ldb, double* C, int ldc) {
+  GemmBlocked(m, n, k, A, lda, B, ldb, C, ldc);
+}
+
+void ppc::core::Gemm(int m, int n, int k, const float* A, int lda, const float* B, int ldb, float* C, int ldc) {
+  GemmBlocked(m, n, k, A, lda, B, ldb, C, ldc);
+}
+
+void ppc::core::Gemm(int m, int n, int k, const float* A, int lda, const float* B, int ldb, double* C, int ldc) {
+  GemmBlocked(m, n, k, A, lda, B, ldb, C, ldc);
+}
+
+std::vector<double> ppc::core::Gemm(const std::vector<double>& A, const std::vector<double>& B, int n) {
+  std::vector<double> C(static_cast<size_t>(n) * n, 0.0);
+  Gemm(n, n, n, A.data(), n, B.data(), n, C.data(), n);
+  return C;
+}
+
+std::vector<float> ppc::core::Gemm(const std::vector<float>& A, const std::vector<float>& B, int n) {
+  std::vector<float> C(static_cast<size_t>(n) * n, 0.0F);
+  Gemm(n, n, n, A.data(), n, B.data(), n, C.data(), n);
+  return C;
+}
+
+double ppc::core::RelativeError(const std::vector<float>& C, const std::vector<double>& reference) {
+  return MaxRelativeError(C, reference);
+}
+
+double ppc::core::RelativeError(const std::vector<double>& C, const std::vector<double>& reference) {
+  return MaxRelativeError(C, reference);
+}
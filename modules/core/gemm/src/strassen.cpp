@@ -0,0 +1,401 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/gemm/include/strassen.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "core/gemm/include/gemm.hpp"
+
+namespace {
+size_t Offset(int row, int ld) { return static_cast<size_t>(row) * ld; }
+
+// C = A + B
+template <typename T>
+void Add(int n, const T* A, int lda, const T* B, int ldb, T* C, int ldc) {
+  for (int i = 0; i < n; i++) {
+    const T* a = A + Offset(i, lda);
+    const T* b = B + Offset(i, ldb);
+    T* c = C + Offset(i, ldc);
+    for (int j = 0; j < n; j++) {
+      c[j] = a[j] + b[j];
+    }
+  }
+}
+
+// C = A - B
+template <typename T>
+void Sub(int n, const T* A, int lda, const T* B, int ldb, T* C, int ldc) {
+  for (int i = 0; i < n; i++) {
+    const T* a = A + Offset(i, lda);
+    const T* b = B + Offset(i, ldb);
+    T* c = C + Offset(i, ldc);
+    for (int j = 0; j < n; j++) {
+      c[j] = a[j] - b[j];
+    }
+  }
+}
+
+// C = A
+template <typename T>
+void Copy(int n, const T* A, int lda, T* C, int ldc) {
+  for (int i = 0; i < n; i++) {
+    std::copy(A + Offset(i, lda), A + Offset(i, lda) + n, C + Offset(i, ldc));
+  }
+}
+
+// C += sign * A
+template <typename T>
+void Accumulate(int n, const T* A, int lda, T* C, int ldc, int sign) {
+  for (int i = 0; i < n; i++) {
+    const T* a = A + Offset(i, lda);
+    T* c = C + Offset(i, ldc);
+    for (int j = 0; j < n; j++) {
+      c[j] += sign * a[j];
+    }
+  }
+}
+
+template <typename T>
+void Leaf(int n, const T* A, int lda, const T* B, int ldb, T* C, int ldc) {
+  for (int i = 0; i < n; i++) {
+    std::fill(C + Offset(i, ldc), C + Offset(i, ldc) + n, T(0));
+  }
+  ppc::core::Gemm(n, n, n, A, lda, B, ldb, C, ldc);
+}
+
+template <typename T>
+void StrassenRecursive(int n, const T* A, int lda, const T* B, int ldb, T* C, int ldc, T* work, int cutoff,
+                       ppc::core::StrassenVariant variant);
+
+template <typename T>
+void StrassenLevel(int h, const T* A, int lda, const T* B, int ldb, T* C, int ldc, T* work, int cutoff,
+                   ppc::core::StrassenVariant variant) {
+  const T* A11 = A;
+  const T* A12 = A + h;
+  const T* A21 = A + Offset(h, lda);
+  const T* A22 = A21 + h;
+  const T* B11 = B;
+  const T* B12 = B + h;
+  const T* B21 = B + Offset(h, ldb);
+  const T* B22 = B21 + h;
+  T* C11 = C;
+  T* C12 = C + h;
+  T* C21 = C + Offset(h, ldc);
+  T* C22 = C21 + h;
+  // X and Y hold the operand sums and Z the products that do not go straight into a quadrant of C
+  T* X = work;
+  T* Y = X + Offset(h, h);
+  T* Z = Y + Offset(h, h);
+  T* next = Z + Offset(h, h);
+
+  // C11 = M1 + M4 - M5 + M7, C12 = M3 + M5, C21 = M2 + M4, C22 = M1 - M2 + M3 + M6
+  Add(h, A11, lda, A22, lda, X, h);
+  Add(h, B11, ldb, B22, ldb, Y, h);
+  StrassenRecursive(h, X, h, Y, h, C11, ldc, next, cutoff, variant);
+  Copy(h, C11, ldc, C22, ldc);
+
+  Add(h, A21, lda, A22, lda, X, h);
+  StrassenRecursive(h, X, h, B11, ldb, C21, ldc, next, cutoff, variant);
+  Accumulate(h, C21, ldc, C22, ldc, -1);
+
+  Sub(h, B12, ldb, B22, ldb, Y, h);
+  StrassenRecursive(h, A11, lda, Y, h, C12, ldc, next, cutoff, variant);
+  Accumulate(h, C12, ldc, C22, ldc, 1);
+
+  Sub(h, B21, ldb, B11, ldb, Y, h);
+  StrassenRecursive(h, A22, lda, Y, h, Z, h, next, cutoff, variant);
+  Accumulate(h, Z, h, C11, ldc, 1);
+  Accumulate(h, Z, h, C21, ldc, 1);
+
+  Add(h, A11, lda, A12, lda, X, h);
+  StrassenRecursive(h, X, h, B22, ldb, Z, h, next, cutoff, variant);
+  Accumulate(h, Z, h, C11, ldc, -1);
+  Accumulate(h, Z, h, C12, ldc, 1);
+
+  Sub(h, A21, lda, A11, lda, X, h);
+  Add(h, B11, ldb, B12, ldb, Y, h);
+  StrassenRecursive(h, X, h, Y, h, Z, h, next, cutoff, variant);
+  Accumulate(h, Z, h, C22, ldc, 1);
+
+  Sub(h, A12, lda, A22, lda, X, h);
+  Add(h, B21, ldb, B22, ldb, Y, h);
+  StrassenRecursive(h, X, h, Y, h, Z, h, next, cutoff, variant);
+  Accumulate(h, Z, h, C11, ldc, 1);
+}
+
+// the schedule of Douglas et al. (1994), which needs only two temporaries besides C
+template <typename T>
+void WinogradLevel(int h, const T* A, int lda, const T* B, int ldb, T* C, int ldc, T* work, int cutoff,
+                   ppc::core::StrassenVariant variant) {
+  const T* A11 = A;
+  const T* A12 = A + h;
+  const T* A21 = A + Offset(h, lda);
+  const T* A22 = A21 + h;
+  const T* B11 = B;
+  const T* B12 = B + h;
+  const T* B21 = B + Offset(h, ldb);
+  const T* B22 = B21 + h;
+  T* C11 = C;
+  T* C12 = C + h;
+  T* C21 = C + Offset(h, ldc);
+  T* C22 = C21 + h;
+  // the third block of the frame is left unused, the workspace is sized for the other schedule
+  T* X = work;
+  T* Y = X + Offset(h, h);
+  T* next = Y + 2 * Offset(h, h);
+
+  // S3 = A11 - A21, T3 = B22 - B12, P7 = S3 T3
+  Sub(h, A11, lda, A21, lda, X, h);
+  Sub(h, B22, ldb, B12, ldb, Y, h);
+  StrassenRecursive(h, X, h, Y, h, C21, ldc, next, cutoff, variant);
+  // S1 = A21 + A22, T1 = B12 - B11, P5 = S1 T1
+  Add(h, A21, lda, A22, lda, X, h);
+  Sub(h, B12, ldb, B11, ldb, Y, h);
+  StrassenRecursive(h, X, h, Y, h, C22, ldc, next, cutoff, variant);
+  // S2 = S1 - A11, T2 = B22 - T1, P6 = S2 T2
+  Sub(h, X, h, A11, lda, X, h);
+  Sub(h, B22, ldb, Y, h, Y, h);
+  StrassenRecursive(h, X, h, Y, h, C12, ldc, next, cutoff, variant);
+  // S4 = A12 - S2, P3 = S4 B22
+  Sub(h, A12, lda, X, h, X, h);
+  StrassenRecursive(h, X, h, B22, ldb, C11, ldc, next, cutoff, variant);
+  // P1 = A11 B11
+  StrassenRecursive(h, A11, lda, B11, ldb, X, h, next, cutoff, variant);
+  // U2 = P1 + P6, U3 = U2 + P7, U4 = U2 + P5, C22 = U3 + P5, C12 = U4 + P3
+  Accumulate(h, X, h, C12, ldc, 1);
+  Accumulate(h, C12, ldc, C21, ldc, 1);
+  Accumulate(h, C22, ldc, C12, ldc, 1);
+  Accumulate(h, C21, ldc, C22, ldc, 1);
+  Accumulate(h, C11, ldc, C12, ldc, 1);
+  // T4 = T2 - B21, P4 = A22 T4, C21 = U3 - P4
+  Sub(h, Y, h, B21, ldb, Y, h);
+  StrassenRecursive(h, A22, lda, Y, h, C11, ldc, next, cutoff, variant);
+  Accumulate(h, C11, ldc, C21, ldc, -1);
+  // P2 = A12 B21, C11 = P1 + P2
+  StrassenRecursive(h, A12, lda, B21, ldb, C11, ldc, next, cutoff, variant);
+  Accumulate(h, X, h, C11, ldc, 1);
+}
+
+template <typename T>
+void StrassenRecursive(int n, const T* A, int lda, const T* B, int ldb, T* C, int ldc, T* work, int cutoff,
+                       ppc::core::StrassenVariant variant) {
+  if (n <= cutoff || n % 2 != 0) {
+    Leaf(n, A, lda, B, ldb, C, ldc);
+    return;
+  }
+  if (variant == ppc::core::StrassenVariant::Winograd) {
+    WinogradLevel(n / 2, A, lda, B, ldb, C, ldc, work, cutoff, variant);
+  } else {
+    StrassenLevel(n / 2, A, lda, B, ldb, C, ldc, work, cutoff, variant);
+  }
+}
+
+// more threads than this do not change what the probe sees: by then the memory bandwidth is shared out
+const int PROBE_MAX_THREADS = 16;
+// cutoffs tried by the probe; every one is measured on a product twice as large
+const int PROBE_MIN_CUTOFF = 32;
+const int PROBE_MAX_CUTOFF = 256;
+
+// Wall time of an n x n product computed on threads threads at once, each on its own matrices; best of three runs.
+double ProbeTime(int threads, int n, int cutoff, ppc::core::StrassenVariant variant) {
+  size_t size = Offset(n, n);
+  std::vector<std::vector<double>> a(threads, std::vector<double>(size));
+  std::vector<std::vector<double>> b(threads, std::vector<double>(size));
+  std::vector<std::vector<double>> c(threads, std::vector<double>(size));
+  std::vector<std::vector<double>> work(threads, std::vector<double>(ppc::core::StrassenWorkspace(n, cutoff)));
+  for (int t = 0; t < threads; t++) {
+    for (size_t i = 0; i < size; i++) {
+      a[t][i] = static_cast<double>((i * 7 + t) % 13) - 6.0;
+      b[t][i] = static_cast<double>((i * 5 + t) % 11) - 5.0;
+    }
+  }
+  auto multiply = [&](int t) {
+    ppc::core::Strassen(n, a[t].data(), n, b[t].data(), n, c[t].data(), n, work[t].data(), cutoff, variant);
+  };
+
+  double best = std::numeric_limits<double>::max();
+  for (int run = 0; run < 3; run++) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; t++) {
+      pool.emplace_back(multiply, t);
+    }
+    multiply(0);
+    for (auto& thread : pool) {
+      thread.join();
+    }
+    best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+  }
+  return best;
+}
+
+ppc::core::StrassenTuning Measure(int threads) {
+  ppc::core::StrassenTuning tuning{2 * PROBE_MAX_CUTOFF, ppc::core::StrassenVariant::Strassen};
+  for (int cutoff = PROBE_MIN_CUTOFF; cutoff <= PROBE_MAX_CUTOFF; cutoff *= 2) {
+    int n = 2 * cutoff;
+    double gemm = ProbeTime(threads, n, n, ppc::core::StrassenVariant::Strassen);
+    double strassen = ProbeTime(threads, n, cutoff, ppc::core::StrassenVariant::Strassen);
+    double winograd = ProbeTime(threads, n, cutoff, ppc::core::StrassenVariant::Winograd);
+    tuning.variant = winograd < strassen ? ppc::core::StrassenVariant::Winograd : ppc::core::StrassenVariant::Strassen;
+    // a win within the timing noise does not count
+    if (std::min(strassen, winograd) < 0.98 * gemm) {
+      tuning.cutoff = cutoff;
+      break;
+    }
+  }
+  return tuning;
+}
+}  // namespace
+
+size_t ppc::core::StrassenWorkspace(int n, int cutoff) {
+  if (n <= cutoff || n % 2 != 0) {
+    return 0;
+  }
+  size_t half = n / 2;
+  return 3 * half * half + StrassenWorkspace(n / 2, cutoff);
+}
+
+void ppc::core::Strassen(int n, const double* A, int lda, const double* B, int ldb, double* C, int ldc, double* work,
+                         int cutoff, StrassenVariant variant) {
+  StrassenRecursive(n, A, lda, B, ldb, C, ldc, work, cutoff, variant);
+}
+
+void ppc::core::Strassen(int n, const float* A, int lda, const float* B, int ldb, float* C, int ldc, float* work,
+                         int cutoff, StrassenVariant variant) {
+  StrassenRecursive(n, A, lda, B, ldb, C, ldc, work, cutoff, variant);
+}
+
+size_t ppc::core::StrassenSplitWorkspace(int n) {
+  size_t half = n / 2;
+  return 10 * half * half;
+}
+
+namespace {
+template <typename T>
+void Split(int n, const T* A, int lda, const T* B, int ldb, T* work, ppc::core::BasicStrassenProduct<T> products[7],
+           ppc::core::StrassenVariant variant) {
+  int h = n / 2;
+  const T* A11 = A;
+  const T* A12 = A + h;
+  const T* A21 = A + Offset(h, lda);
+  const T* A22 = A21 + h;
+  const T* B11 = B;
+  const T* B12 = B + h;
+  const T* B21 = B + Offset(h, ldb);
+  const T* B22 = B21 + h;
+  T* sums[10];
+  for (int i = 0; i < 10; i++) {
+    sums[i] = work + i * Offset(h, h);
+  }
+
+  if (variant == ppc::core::StrassenVariant::Winograd) {
+    // S1..S4 in sums[0..3], T1..T4 in sums[4..7]
+    Add(h, A21, lda, A22, lda, sums[0], h);
+    Sub(h, sums[0], h, A11, lda, sums[1], h);
+    Sub(h, A11, lda, A21, lda, sums[2], h);
+    Sub(h, A12, lda, sums[1], h, sums[3], h);
+    Sub(h, B12, ldb, B11, ldb, sums[4], h);
+    Sub(h, B22, ldb, sums[4], h, sums[5], h);
+    Sub(h, B22, ldb, B12, ldb, sums[6], h);
+    Sub(h, sums[5], h, B21, ldb, sums[7], h);
+
+    products[0] = {A11, lda, B11, ldb};
+    products[1] = {A12, lda, B21, ldb};
+    products[2] = {sums[3], h, B22, ldb};
+    products[3] = {A22, lda, sums[7], h};
+    products[4] = {sums[0], h, sums[4], h};
+    products[5] = {sums[1], h, sums[5], h};
+    products[6] = {sums[2], h, sums[6], h};
+    return;
+  }
+
+  Add(h, A11, lda, A22, lda, sums[0], h);
+  Add(h, B11, ldb, B22, ldb, sums[1], h);
+  Add(h, A21, lda, A22, lda, sums[2], h);
+  Sub(h, B12, ldb, B22, ldb, sums[3], h);
+  Sub(h, B21, ldb, B11, ldb, sums[4], h);
+  Add(h, A11, lda, A12, lda, sums[5], h);
+  Sub(h, A21, lda, A11, lda, sums[6], h);
+  Add(h, B11, ldb, B12, ldb, sums[7], h);
+  Sub(h, A12, lda, A22, lda, sums[8], h);
+  Add(h, B21, ldb, B22, ldb, sums[9], h);
+
+  products[0] = {sums[0], h, sums[1], h};
+  products[1] = {sums[2], h, B11, ldb};
+  products[2] = {A11, lda, sums[3], h};
+  products[3] = {A22, lda, sums[4], h};
+  products[4] = {sums[5], h, B22, ldb};
+  products[5] = {sums[6], h, sums[7], h};
+  products[6] = {sums[8], h, sums[9], h};
+}
+
+template <typename T>
+void Merge(int n, const T* M, T* C, int ldc, ppc::core::StrassenVariant variant) {
+  int h = n / 2;
+  size_t block = Offset(h, h);
+  const T* M1 = M;
+  const T* M2 = M1 + block;
+  const T* M3 = M2 + block;
+  const T* M4 = M3 + block;
+  const T* M5 = M4 + block;
+  const T* M6 = M5 + block;
+  const T* M7 = M6 + block;
+  for (int i = 0; i < h; i++) {
+    T* c1 = C + Offset(i, ldc);
+    T* c2 = C + Offset(i + h, ldc);
+    size_t row = Offset(i, h);
+    for (int j = 0; j < h; j++) {
+      size_t k = row + j;
+      if (variant == ppc::core::StrassenVariant::Winograd) {
+        T u2 = M1[k] + M6[k];
+        T u3 = u2 + M7[k];
+        c1[j] = M1[k] + M2[k];
+        c1[j + h] = u2 + M5[k] + M3[k];
+        c2[j] = u3 - M4[k];
+        c2[j + h] = u3 + M5[k];
+      } else {
+        c1[j] = M1[k] + M4[k] - M5[k] + M7[k];
+        c1[j + h] = M3[k] + M5[k];
+        c2[j] = M2[k] + M4[k];
+        c2[j + h] = M1[k] - M2[k] + M3[k] + M6[k];
+      }
+    }
+  }
+}
+}  // namespace
+
+void ppc::core::StrassenSplit(int n, const double* A, int lda, const double* B, int ldb, double* work,
+                              StrassenProduct products[7], StrassenVariant variant) {
+  Split(n, A, lda, B, ldb, work, products, variant);
+}
+
+void ppc::core::StrassenSplit(int n, const float* A, int lda, const float* B, int ldb, float* work,
+                              StrassenProductF products[7], StrassenVariant variant) {
+  Split(n, A, lda, B, ldb, work, products, variant);
+}
+
+void ppc::core::StrassenMerge(int n, const double* M, double* C, int ldc, StrassenVariant variant) {
+  Merge(n, M, C, ldc, variant);
+}
+
+void ppc::core::StrassenMerge(int n, const float* M, float* C, int ldc, StrassenVariant variant) {
+  Merge(n, M, C, ldc, variant);
+}
+
+ppc::core::StrassenTuning ppc::core::TuneStrassen(int threads) {
+  static std::mutex mutex;
+  static std::map<int, StrassenTuning> tuned;
+  int hardware = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  threads = std::clamp(threads, 1, std::min(hardware, PROBE_MAX_THREADS));
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = tuned.find(threads);
+  if (it == tuned.end()) {
+    it = tuned.emplace(threads, Measure(threads)).first;
+  }
+  return it->second;
+}
@@ -0,0 +1,78 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/gemm/include/tiled.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+namespace {
+// bits of row and col interleaved, row bits in the odd positions: the position of (row, col) along the Z curve
+uint64_t MortonKey(uint32_t row, uint32_t col) {
+  uint64_t key = 0;
+  for (int bit = 0; bit < 32; bit++) {
+    key |= static_cast<uint64_t>((col >> bit) & 1U) << (2 * bit);
+    key |= static_cast<uint64_t>((row >> bit) & 1U) << (2 * bit + 1);
+  }
+  return key;
+}
+}  // namespace
+
+template <typename T>
+ppc::core::BasicTiledMatrix<T>::BasicTiledMatrix(int rows, int cols, int tile)
+    : rows_(rows),
+      cols_(cols),
+      tile_(tile),
+      block_rows_((rows + tile - 1) / tile),
+      block_cols_((cols + tile - 1) / tile),
+      offsets_(static_cast<size_t>(block_rows_) * block_cols_),
+      data_(offsets_.size() * tile * tile, T(0)) {
+  // blocks ranked by their Z-order key: grids that are not a power of two stay dense, without holes
+  std::vector<std::pair<uint64_t, size_t>> order(offsets_.size());
+  for (int bi = 0; bi < block_rows_; bi++) {
+    for (int bj = 0; bj < block_cols_; bj++) {
+      size_t index = static_cast<size_t>(bi) * block_cols_ + bj;
+      order[index] = {MortonKey(bi, bj), index};
+    }
+  }
+  std::sort(order.begin(), order.end());
+  size_t block_size = static_cast<size_t>(tile) * tile;
+  for (size_t rank = 0; rank < order.size(); rank++) {
+    offsets_[order[rank].second] = rank * block_size;
+  }
+}
+
+template <typename T>
+void ppc::core::BasicTiledMatrix<T>::FromRowMajor(const T* a, int ld) {
+  for (int bi = 0; bi < block_rows_; bi++) {
+    int rows = std::min(tile_, rows_ - bi * tile_);
+    for (int bj = 0; bj < block_cols_; bj++) {
+      int cols = std::min(tile_, cols_ - bj * tile_);
+      T* block = Block(bi, bj);
+      for (int r = 0; r < rows; r++) {
+        const T* src = a + static_cast<size_t>(bi * tile_ + r) * ld + bj * tile_;
+        std::copy(src, src + cols, block + static_cast<size_t>(r) * tile_);
+      }
+    }
+  }
+}
+
+template <typename T>
+void ppc::core::BasicTiledMatrix<T>::ToRowMajor(T* a, int ld) const {
+  for (int bi = 0; bi < block_rows_; bi++) {
+    int rows = std::min(tile_, rows_ - bi * tile_);
+    for (int bj = 0; bj < block_cols_; bj++) {
+      int cols = std::min(tile_, cols_ - bj * tile_);
+      const T* block = Block(bi, bj);
+      for (int r = 0; r < rows; r++) {
+        const T* src = block + static_cast<size_t>(r) * tile_;
+        std::copy(src, src + cols, a + static_cast<size_t>(bi * tile_ + r) * ld + bj * tile_);
+      }
+    }
+  }
+}
+
+template <typename T>
+void ppc::core::BasicTiledMatrix<T>::SetZero() { std::fill(data_.begin(), data_.end(), T(0)); }
+
+template class ppc::core::BasicTiledMatrix<double>;
+template class ppc::core::BasicTiledMatrix<float>;
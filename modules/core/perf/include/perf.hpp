@@ -6,6 +6,7 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "core/task/include/task.hpp"
@@ -23,10 +24,15 @@ struct PerfResults {
   // measurement of task's time (in seconds)
   double time_sec = 0.0;
   enum TypeOfRunning { PIPELINE, TASK_RUN, NONE } type_of_running = NONE;
+  // notes recorded while the task was measured
+  std::vector<std::string> notes;
   constexpr const static double MAX_TIME = 10.0;
   constexpr const static double MIN_TIME = 0.05;
 };
 
+// Record a line to print next to the statistic of the task measured now, e.g. a block size tuned for this host.
+void RecordPerfNote(const std::string& note);
+
 class Perf {
  public:
   // Init performance analysis with initialized task and initialized data
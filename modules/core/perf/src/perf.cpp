@@ -5,9 +5,30 @@
 
 #include <iomanip>
 #include <iostream>
+#include <mutex>
 #include <sstream>
 #include <utility>
 
+namespace {
+std::mutex notes_mutex;
+std::vector<std::string> notes;
+
+size_t NotesCount() {
+  std::lock_guard<std::mutex> lock(notes_mutex);
+  return notes.size();
+}
+
+std::vector<std::string> NotesSince(size_t first) {
+  std::lock_guard<std::mutex> lock(notes_mutex);
+  return {notes.begin() + first, notes.end()};
+}
+}  // namespace
+
+void ppc::core::RecordPerfNote(const std::string& note) {
+  std::lock_guard<std::mutex> lock(notes_mutex);
+  notes.push_back(note);
+}
+
 ppc::core::Perf::Perf(std::shared_ptr<Task> task_) { set_task(std::move(task_)); }
 
 void ppc::core::Perf::set_task(std::shared_ptr<Task> task_) {
@@ -18,6 +39,7 @@ void ppc::core::Perf::set_task(std::shared_ptr<Task> task_) {
 void ppc::core::Perf::pipeline_run(const std::shared_ptr<PerfAttr>& perfAttr,
                                    const std::shared_ptr<ppc::core::PerfResults>& perfResults) {
   perfResults->type_of_running = PerfResults::TypeOfRunning::PIPELINE;
+  size_t first_note = NotesCount();
 
   common_run(
       std::move(perfAttr),
@@ -27,18 +49,21 @@ void ppc::core::Perf::pipeline_run(const std::shared_ptr<PerfAttr>& perfAttr,
         task->run();
         task->post_processing();
       },
-      std::move(perfResults));
+      perfResults);
+  perfResults->notes = NotesSince(first_note);
 }
 
 void ppc::core::Perf::task_run(const std::shared_ptr<PerfAttr>& perfAttr,
                                const std::shared_ptr<ppc::core::PerfResults>& perfResults) {
   perfResults->type_of_running = PerfResults::TypeOfRunning::TASK_RUN;
+  size_t first_note = NotesCount();
 
   task->validation();
   task->pre_processing();
   common_run(
-      std::move(perfAttr), [&]() { task->run(); }, std::move(perfResults));
+      std::move(perfAttr), [&]() { task->run(); }, perfResults);
   task->post_processing();
+  perfResults->notes = NotesSince(first_note);
 
   task->validation();
   task->pre_processing();
@@ -90,4 +115,8 @@ void ppc::core::Perf::print_perf_statistic(const std::shared_ptr<PerfResults>& p
   }
 
   std::cout << relative_path << ":" << type_test_name << ":" << perf_res_str.str() << std::endl;
+  // what the kernels picked for this host while the task was measured, next to the time it produced
+  for (const auto& note : perfResults->notes) {
+    std::cout << note << std::endl;
+  }
 }
@@ -0,0 +1,98 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+#include "core/sparse/include/compress.hpp"
+
+namespace {
+// nonzeros on a different stride in every row; row 3 is empty, and so are some columns
+std::vector<double> makeMatrix(int rows, int cols) {
+  std::vector<double> a(rows * cols, 0.0);
+  for (int i = 0; i < rows; i++) {
+    if (i == 3) {
+      continue;
+    }
+    for (int j = (i * 3) % 5; j < cols; j += 4 + i) {
+      a[i * cols + j] = i * 1000 + j + 1;
+    }
+  }
+  return a;
+}
+}  // namespace
+
+TEST(compress_tests, check_rows) {
+  int rows = 7;
+  int cols = 150;
+  std::vector<double> a = makeMatrix(rows, cols);
+  for (int threads : {1, 3, 16}) {
+    std::vector<double> values;
+    std::vector<int> indices;
+    std::vector<int> offsets;
+    ppc::core::DenseToCompressed(a.data(), rows, cols, false, [](double v) { return v != 0.0; }, values, indices,
+                                 offsets, threads);
+    ASSERT_EQ(static_cast<size_t>(rows) + 1, offsets.size());
+    EXPECT_EQ(offsets[3], offsets[4]);
+
+    std::vector<double> back(rows * cols, 0.0);
+    for (int i = 0; i < rows; i++) {
+      for (int k = offsets[i]; k < offsets[i + 1]; k++) {
+        if (k > offsets[i]) {
+          EXPECT_LT(indices[k - 1], indices[k]);
+        }
+        back[i * cols + indices[k]] = values[k];
+      }
+    }
+    EXPECT_EQ(a, back);
+  }
+}
+
+TEST(compress_tests, check_columns) {
+  int rows = 7;
+  int cols = 150;
+  std::vector<double> a = makeMatrix(rows, cols);
+  std::vector<double> values;
+  std::vector<size_t> indices;
+  std::vector<size_t> offsets;
+  ppc::core::DenseToCompressed(a.data(), rows, cols, true, [](double v) { return v != 0.0; }, values, indices, offsets,
+                               4);
+  ASSERT_EQ(static_cast<size_t>(cols) + 1, offsets.size());
+
+  std::vector<double> back(rows * cols, 0.0);
+  for (int j = 0; j < cols; j++) {
+    for (size_t k = offsets[j]; k < offsets[j + 1]; k++) {
+      if (k > offsets[j]) {
+        EXPECT_LT(indices[k - 1], indices[k]);
+      }
+      back[indices[k] * cols + j] = values[k];
+    }
+  }
+  EXPECT_EQ(a, back);
+}
+
+TEST(compress_tests, check_keep) {
+  // entries below the threshold are dropped along with the zeros
+  std::vector<std::complex<double>> a{{1e-9, 0.0}, {0.0, 2.0}, {0.0, 0.0}, {3.0, -1.0}};
+  std::vector<std::complex<double>> values;
+  std::vector<int> indices;
+  std::vector<int> offsets;
+  ppc::core::DenseToCompressed(a.data(), 2, 2, true, [](std::complex<double> v) { return std::abs(v) >= 1e-6; }, values,
+                               indices, offsets);
+  EXPECT_EQ(std::vector<int>({0, 0, 2}), offsets);
+  EXPECT_EQ(std::vector<int>({0, 1}), indices);
+  EXPECT_EQ(a[1], values[0]);
+  EXPECT_EQ(a[3], values[1]);
+}
+
+TEST(compress_tests, check_empty) {
+  std::vector<double> values{1.0};
+  std::vector<int> indices{1};
+  std::vector<int> offsets;
+  ppc::core::DenseToCompressed(static_cast<const double*>(nullptr), 0, 5, true, [](double v) { return v != 0.0; },
+                               values, indices, offsets, 8);
+  EXPECT_EQ(std::vector<int>(6, 0), offsets);
+  EXPECT_TRUE(values.empty());
+  EXPECT_TRUE(indices.empty());
+}
@@ -0,0 +1,117 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_COMPRESS_HPP_
+#define MODULES_CORE_INCLUDE_COMPRESS_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace ppc::core {
+
+// Columns of a dense matrix compressed together by columns: a slab is read row by row, so reads stay contiguous
+// instead of striding over whole rows, and 64 doubles are 8 cache lines per row.
+constexpr int COMPRESS_SLAB = 64;
+
+// Runs body(begin, end) on about equal contiguous parts of [0, n), on up to threads threads; inline for one thread.
+template <typename Body>
+void ForRanges(int n, int threads, const Body& body) {
+  int parts = std::max(1, std::min(threads, n));
+  if (parts == 1) {
+    body(0, n);
+    return;
+  }
+  std::vector<std::thread> workers;
+  workers.reserve(parts - 1);
+  for (int p = 1; p < parts; p++) {
+    workers.emplace_back(body, static_cast<int>(static_cast<long long>(n) * p / parts),
+                         static_cast<int>(static_cast<long long>(n) * (p + 1) / parts));
+  }
+  body(0, n / parts);
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
+// Compresses a row-major rows x cols matrix a into values, indices and offsets, keeping the entries for which
+// keep(value) is true: by rows (CRS) with indices holding columns, or with by_columns by columns (CCS) with indices
+// holding rows. offsets gets one entry more than there are rows (columns); indices increase within each row (column).
+// The matrix is read twice: the entries kept are counted per row (column), an exclusive scan turns the counts into
+// offsets, and every value is then written at its final place, so nothing is appended or moved. Rows, or slabs of
+// COMPRESS_SLAB columns, are split over threads threads.
+template <typename T, typename Index, typename Keep>
+void DenseToCompressed(const T* a, int rows, int cols, bool by_columns, const Keep& keep, std::vector<T>& values,
+                       std::vector<Index>& indices, std::vector<Index>& offsets, int threads = 1) {
+  int lines = by_columns ? cols : rows;
+  int slabs = (cols + COMPRESS_SLAB - 1) / COMPRESS_SLAB;
+  std::vector<size_t> counts(static_cast<size_t>(lines) + 1, 0);
+  if (!by_columns) {
+    ForRanges(rows, threads, [&](int begin, int end) {
+      for (int i = begin; i < end; i++) {
+        const T* row = a + static_cast<size_t>(i) * cols;
+        size_t count = 0;
+        for (int j = 0; j < cols; j++) {
+          count += keep(row[j]) ? 1 : 0;
+        }
+        counts[i + 1] = count;
+      }
+    });
+  } else {
+    ForRanges(slabs, threads, [&](int begin, int end) {
+      for (int s = begin; s < end; s++) {
+        int c_begin = s * COMPRESS_SLAB;
+        int c_end = std::min(cols, c_begin + COMPRESS_SLAB);
+        for (int i = 0; i < rows; i++) {
+          const T* row = a + static_cast<size_t>(i) * cols;
+          for (int j = c_begin; j < c_end; j++) {
+            counts[j + 1] += keep(row[j]) ? 1 : 0;
+          }
+        }
+      }
+    });
+  }
+  for (int i = 0; i < lines; i++) {
+    counts[i + 1] += counts[i];
+  }
+
+  offsets.assign(counts.begin(), counts.end());
+  values.resize(counts[lines]);
+  indices.resize(counts[lines]);
+  if (!by_columns) {
+    ForRanges(rows, threads, [&](int begin, int end) {
+      for (int i = begin; i < end; i++) {
+        const T* row = a + static_cast<size_t>(i) * cols;
+        size_t pos = counts[i];
+        for (int j = 0; j < cols; j++) {
+          if (keep(row[j])) {
+            values[pos] = row[j];
+            indices[pos++] = static_cast<Index>(j);
+          }
+        }
+      }
+    });
+  } else {
+    ForRanges(slabs, threads, [&](int begin, int end) {
+      for (int s = begin; s < end; s++) {
+        int c_begin = s * COMPRESS_SLAB;
+        int c_end = std::min(cols, c_begin + COMPRESS_SLAB);
+        std::vector<size_t> pos(counts.begin() + c_begin, counts.begin() + c_end);
+        for (int i = 0; i < rows; i++) {
+          const T* row = a + static_cast<size_t>(i) * cols;
+          for (int j = c_begin; j < c_end; j++) {
+            if (keep(row[j])) {
+              size_t& p = pos[j - c_begin];
+              values[p] = row[j];
+              indices[p++] = static_cast<Index>(i);
+            }
+          }
+        }
+      }
+    });
+  }
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_COMPRESS_HPP_
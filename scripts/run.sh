@@ -31,3 +31,8 @@ fi
 ./build/bin/seq_func_tests --gtest_also_run_disabled_tests --gtest_repeat=10 --gtest_recreate_environments_when_repeating
 ./build/bin/stl_func_tests --gtest_also_run_disabled_tests --gtest_repeat=10 --gtest_recreate_environments_when_repeating
 ./build/bin/tbb_func_tests --gtest_also_run_disabled_tests --gtest_repeat=10 --gtest_recreate_environments_when_repeating
+
+# MPI tests run on a 2 x 2 process grid; MPIRUN_ARGS passes e.g. --oversubscribe on hosts with fewer cores
+if [[ -x ./build/bin/mpi_func_tests ]]; then
+  mpirun $MPIRUN_ARGS -np 4 ./build/bin/mpi_func_tests --gtest_also_run_disabled_tests --gtest_repeat=10 --gtest_recreate_environments_when_repeating
+fi
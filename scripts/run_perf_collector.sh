@@ -4,3 +4,6 @@
 ./build/bin/seq_perf_tests
 ./build/bin/stl_perf_tests
 ./build/bin/tbb_perf_tests
+if [[ -x ./build/bin/mpi_perf_tests ]]; then
+  mpirun $MPIRUN_ARGS -np 4 ./build/bin/mpi_perf_tests
+fi
@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+
+#include <boost/mpi/communicator.hpp>
+#include <random>
+#include <vector>
+
+#include "core/gemm/include/gemm.hpp"
+#include "mpi/ermolaev_d_fox_algorithm/include/ops_mpi.hpp"
+
+TEST(ermolaev_d_fox_algorithm_mpi, Test_Matrix_Multiplication_Simple_32) {
+  boost::mpi::communicator world;
+  constexpr size_t matrix_size = 32;
+  std::vector<double> A(matrix_size * matrix_size, 1.0);
+  std::vector<double> B(matrix_size * matrix_size, 2.0);
+  std::vector<double> C(matrix_size * matrix_size, 0.0);
+
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(A.data()));
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(B.data()));
+    taskDataPar->inputs_count.emplace_back(matrix_size * matrix_size);
+    taskDataPar->inputs_count.emplace_back(matrix_size * matrix_size);
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t *>(C.data()));
+    taskDataPar->outputs_count.emplace_back(matrix_size * matrix_size);
+  }
+
+  FoxAlgorithmMPI test(taskDataPar);
+  ASSERT_TRUE(test.validation());
+  test.pre_processing();
+  test.run();
+  test.post_processing();
+
+  if (world.rank() == 0) {
+    for (size_t i = 0; i < matrix_size * matrix_size; i++) {
+      ASSERT_DOUBLE_EQ(C[i], matrix_size * 2.0);
+    }
+  }
+}
+
+TEST(ermolaev_d_fox_algorithm_mpi, Test_Matrix_Multiplication_Simple_64) {
+  boost::mpi::communicator world;
+  constexpr size_t matrix_size = 64;
+  std::vector<double> A(matrix_size * matrix_size, 1.0);
+  std::vector<double> B(matrix_size * matrix_size, 2.0);
+  std::vector<double> C(matrix_size * matrix_size, 0.0);
+
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(A.data()));
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(B.data()));
+    taskDataPar->inputs_count.emplace_back(matrix_size * matrix_size);
+    taskDataPar->inputs_count.emplace_back(matrix_size * matrix_size);
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t *>(C.data()));
+    taskDataPar->outputs_count.emplace_back(matrix_size * matrix_size);
+  }
+
+  FoxAlgorithmMPI test(taskDataPar);
+  ASSERT_TRUE(test.validation());
+  test.pre_processing();
+  test.run();
+  test.post_processing();
+
+  if (world.rank() == 0) {
+    for (size_t i = 0; i < matrix_size * matrix_size; i++) {
+      ASSERT_DOUBLE_EQ(C[i], matrix_size * 2.0);
+    }
+  }
+}
+
+TEST(ermolaev_d_fox_algorithm_mpi, Test_Matrix_Multiplication_Random_7) {
+  boost::mpi::communicator world;
+  // the grid side does not divide 7 for 4 or 9 processes: the edge blocks are padded
+  constexpr size_t matrix_size = 7;
+  const double tolerance = 1e-5;
+  std::mt19937 gen(1);
+  std::uniform_real_distribution<> dis(1.0, 6.0);
+  std::vector<double> A(matrix_size * matrix_size);
+  std::vector<double> B(matrix_size * matrix_size);
+  std::vector<double> C(matrix_size * matrix_size, 0.0);
+  for (size_t i = 0; i < matrix_size * matrix_size; ++i) {
+    A[i] = dis(gen);
+    B[i] = dis(gen);
+  }
+
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(A.data()));
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(B.data()));
+    taskDataPar->inputs_count.emplace_back(matrix_size * matrix_size);
+    taskDataPar->inputs_count.emplace_back(matrix_size * matrix_size);
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t *>(C.data()));
+    taskDataPar->outputs_count.emplace_back(matrix_size * matrix_size);
+  }
+
+  FoxAlgorithmMPI test(taskDataPar);
+  ASSERT_TRUE(test.validation());
+  test.pre_processing();
+  test.run();
+  test.post_processing();
+
+  if (world.rank() == 0) {
+    auto expected = ppc::core::Gemm(A, B, static_cast<int>(matrix_size));
+    for (size_t i = 0; i < matrix_size * matrix_size; i++) {
+      ASSERT_NEAR(C[i], expected[i], tolerance);
+    }
+  }
+}
+
+TEST(ermolaev_d_fox_algorithm_mpi, Test_Matrix_Multiplication_Random_37) {
+  boost::mpi::communicator world;
+  constexpr size_t matrix_size = 37;
+  const double tolerance = 1e-5;
+  std::mt19937 gen(1);
+  std::uniform_real_distribution<> dis(1.0, 6.0);
+  std::vector<double> A(matrix_size * matrix_size);
+  std::vector<double> B(matrix_size * matrix_size);
+  std::vector<double> C(matrix_size * matrix_size, 0.0);
+  for (size_t i = 0; i < matrix_size * matrix_size; ++i) {
+    A[i] = dis(gen);
+    B[i] = dis(gen);
+  }
+
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(A.data()));
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(B.data()));
+    taskDataPar->inputs_count.emplace_back(matrix_size * matrix_size);
+    taskDataPar->inputs_count.emplace_back(matrix_size * matrix_size);
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t *>(C.data()));
+    taskDataPar->outputs_count.emplace_back(matrix_size * matrix_size);
+  }
+
+  FoxAlgorithmMPI test(taskDataPar);
+  ASSERT_TRUE(test.validation());
+  test.pre_processing();
+  test.run();
+  test.post_processing();
+
+  if (world.rank() == 0) {
+    auto expected = ppc::core::Gemm(A, B, static_cast<int>(matrix_size));
+    for (size_t i = 0; i < matrix_size * matrix_size; i++) {
+      ASSERT_NEAR(C[i], expected[i], tolerance);
+    }
+  }
+}
+
+TEST(ermolaev_d_fox_algorithm_mpi, Test_Matrix_Multiplication_Random_128) {
+  boost::mpi::communicator world;
+  constexpr size_t matrix_size = 128;
+  const double tolerance = 1e-5;
+  std::mt19937 gen(1);
+  std::uniform_real_distribution<> dis(1.0, 6.0);
+  std::vector<double> A(matrix_size * matrix_size);
+  std::vector<double> B(matrix_size * matrix_size);
+  std::vector<double> C(matrix_size * matrix_size, 0.0);
+  for (size_t i = 0; i < matrix_size * matrix_size; ++i) {
+    A[i] = dis(gen);
+    B[i] = dis(gen);
+  }
+
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(A.data()));
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(B.data()));
+    taskDataPar->inputs_count.emplace_back(matrix_size * matrix_size);
+    taskDataPar->inputs_count.emplace_back(matrix_size * matrix_size);
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t *>(C.data()));
+    taskDataPar->outputs_count.emplace_back(matrix_size * matrix_size);
+  }
+
+  FoxAlgorithmMPI test(taskDataPar);
+  ASSERT_TRUE(test.validation());
+  test.pre_processing();
+  test.run();
+  test.post_processing();
+
+  if (world.rank() == 0) {
+    auto expected = ppc::core::Gemm(A, B, static_cast<int>(matrix_size));
+    for (size_t i = 0; i < matrix_size * matrix_size; i++) {
+      ASSERT_NEAR(C[i], expected[i], tolerance);
+    }
+  }
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <boost/mpi/communicator.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/task/include/task.hpp"
+
+// Fox's algorithm on a q x q grid of processes, q = floor(sqrt(world size)) but at most the matrix size; the processes
+// beyond q * q stay idle. Rank 0 holds the task data, laid out as for the shared-memory FoxAlgorithm. Each process
+// keeps its block of A and receives the block of its row's current stage, while its block of B moves up the column;
+// both transfers for the next stage run during the block product of the current one.
+class FoxAlgorithmMPI : public ppc::core::Task {
+ public:
+  explicit FoxAlgorithmMPI(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+  bool pre_processing() override;
+  bool validation() override;
+  bool run() override;
+  bool post_processing() override;
+
+ private:
+  boost::mpi::communicator world;
+  // the q * q processes of the grid, row-major
+  boost::mpi::communicator grid;
+  int data_size = 0;
+  int grid_size = 0;
+  int block = 0;
+  std::vector<double> block_A;
+  std::vector<double> block_B;
+  std::vector<double> block_C;
+  // the block of A broadcast along the row for this stage and the next one
+  std::vector<double> row_A;
+  std::vector<double> next_A;
+  std::vector<double> next_B;
+  // every block of C in grid rank order, on rank 0
+  std::vector<double> gathered_C;
+};
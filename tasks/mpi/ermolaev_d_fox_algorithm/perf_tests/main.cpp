@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <boost/mpi/communicator.hpp>
+#include <boost/mpi/timer.hpp>
+#include <random>
+#include <vector>
+
+#include "core/gemm/include/gemm.hpp"
+#include "core/perf/include/perf.hpp"
+#include "mpi/ermolaev_d_fox_algorithm/include/ops_mpi.hpp"
+
+TEST(ermolaev_d_fox_algorithm_mpi, test_pipline_run) {
+  boost::mpi::communicator world;
+  // the size of the shared-memory perf tests, so the perf table puts the four versions side by side
+  constexpr size_t matrix_size = 512;
+  const double tolerance = 1e-5;
+  std::mt19937 gen(1);
+  std::uniform_real_distribution<> dis(1.0, 6.0);
+  std::vector<double> A(matrix_size * matrix_size);
+  std::vector<double> B(matrix_size * matrix_size);
+  std::vector<double> C(matrix_size * matrix_size, 0.0);
+  for (size_t i = 0; i < matrix_size * matrix_size; ++i) {
+    A[i] = B[i] = dis(gen);
+  }
+
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(A.data()));
+    taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(B.data()));
+    taskData->inputs_count.emplace_back(matrix_size * matrix_size);
+    taskData->inputs_count.emplace_back(matrix_size * matrix_size);
+    taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(C.data()));
+    taskData->outputs_count.emplace_back(matrix_size * matrix_size);
+  }
+
+  auto testTask = std::make_shared<FoxAlgorithmMPI>(taskData);
+
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  const boost::mpi::timer current_timer;
+  perfAttr->current_timer = [&] { return current_timer.elapsed(); };
+
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  auto perfAnalyzer = std::make_shared<ppc::core::Perf>(testTask);
+  perfAnalyzer->pipeline_run(perfAttr, perfResults);
+  if (world.rank() == 0) {
+    ppc::core::Perf::print_perf_statistic(perfResults);
+    auto expected = ppc::core::Gemm(A, B, static_cast<int>(matrix_size));
+    for (size_t i = 0; i < matrix_size * matrix_size; i++) {
+      ASSERT_NEAR(C[i], expected[i], tolerance);
+    }
+  }
+}
+
+TEST(ermolaev_d_fox_algorithm_mpi, test_task_run) {
+  boost::mpi::communicator world;
+  constexpr size_t matrix_size = 512;
+  const double tolerance = 1e-5;
+  std::mt19937 gen(1);
+  std::uniform_real_distribution<> dis(1.0, 6.0);
+  std::vector<double> A(matrix_size * matrix_size);
+  std::vector<double> B(matrix_size * matrix_size);
+  std::vector<double> C(matrix_size * matrix_size, 0.0);
+  for (size_t i = 0; i < matrix_size * matrix_size; ++i) {
+    A[i] = B[i] = dis(gen);
+  }
+
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(A.data()));
+    taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(B.data()));
+    taskData->inputs_count.emplace_back(matrix_size * matrix_size);
+    taskData->inputs_count.emplace_back(matrix_size * matrix_size);
+    taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(C.data()));
+    taskData->outputs_count.emplace_back(matrix_size * matrix_size);
+  }
+
+  auto testTask = std::make_shared<FoxAlgorithmMPI>(taskData);
+
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  const boost::mpi::timer current_timer;
+  perfAttr->current_timer = [&] { return current_timer.elapsed(); };
+
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  auto perfAnalyzer = std::make_shared<ppc::core::Perf>(testTask);
+  perfAnalyzer->task_run(perfAttr, perfResults);
+  if (world.rank() == 0) {
+    ppc::core::Perf::print_perf_statistic(perfResults);
+    auto expected = ppc::core::Gemm(A, B, static_cast<int>(matrix_size));
+    for (size_t i = 0; i < matrix_size * matrix_size; i++) {
+      ASSERT_NEAR(C[i], expected[i], tolerance);
+    }
+  }
+}
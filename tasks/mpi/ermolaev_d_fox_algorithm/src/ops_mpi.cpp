@@ -0,0 +1,180 @@
+#include "mpi/ermolaev_d_fox_algorithm/include/ops_mpi.hpp"
+
+#include <algorithm>
+#include <boost/mpi/collectives.hpp>
+#include <boost/mpi/nonblocking.hpp>
+#include <cmath>
+
+#include "core/gemm/include/gemm.hpp"
+
+namespace {
+enum Tag : int { TAG_A = 1, TAG_B = 2, TAG_C = 3 };
+
+// block (bi, bj) of the n x n row-major matrix as a contiguous block x block array, zeros outside the matrix
+void packBlock(const double* matrix, int n, int block, int bi, int bj, double* out) {
+  std::fill(out, out + block * block, 0.0);
+  int rows = std::max(0, std::min(block, n - bi * block));
+  int cols = std::max(0, std::min(block, n - bj * block));
+  for (int r = 0; r < rows; ++r) {
+    const double* src = matrix + static_cast<size_t>(bi * block + r) * n + bj * block;
+    std::copy(src, src + cols, out + static_cast<size_t>(r) * block);
+  }
+}
+
+void unpackBlock(const double* in, int n, int block, int bi, int bj, double* matrix) {
+  int rows = std::max(0, std::min(block, n - bi * block));
+  int cols = std::max(0, std::min(block, n - bj * block));
+  for (int r = 0; r < rows; ++r) {
+    const double* src = in + static_cast<size_t>(r) * block;
+    std::copy(src, src + cols, matrix + static_cast<size_t>(bi * block + r) * n + bj * block);
+  }
+}
+
+int gridSide(int processes, int size) {
+  int q = static_cast<int>(std::sqrt(static_cast<double>(processes)));
+  while ((q + 1) * (q + 1) <= processes) ++q;
+  while (q * q > processes) --q;
+  return std::max(1, std::min(q, size));
+}
+}  // namespace
+
+bool FoxAlgorithmMPI::validation() {
+  internal_order_test();
+  if (world.rank() == 0) {
+    return taskData->inputs_count.size() == 2 && taskData->inputs_count[0] == taskData->inputs_count[1] &&
+           taskData->inputs_count[0] != 0 && taskData->outputs_count.size() == 1 &&
+           taskData->outputs_count[0] == taskData->inputs_count[0] && taskData->inputs[0] != nullptr &&
+           taskData->inputs[1] != nullptr && taskData->outputs[0] != nullptr;
+  }
+  return true;
+}
+
+bool FoxAlgorithmMPI::pre_processing() {
+  internal_order_test();
+  if (world.rank() == 0) {
+    data_size = static_cast<int>(std::sqrt(taskData->inputs_count[0]));
+    if (static_cast<size_t>(data_size) * data_size != taskData->inputs_count[0]) {
+      data_size = 0;
+    }
+  }
+  broadcast(world, data_size, 0);
+  if (data_size == 0) {
+    return false;
+  }
+
+  grid_size = gridSide(world.size(), data_size);
+  bool active = world.rank() < grid_size * grid_size;
+  grid = world.split(active ? 0 : 1);
+  if (!active) {
+    return true;
+  }
+
+  block = (data_size + grid_size - 1) / grid_size;
+  int block_size = block * block;
+  block_A.resize(block_size);
+  block_B.resize(block_size);
+  block_C.resize(block_size);
+  row_A.resize(block_size);
+  next_A.resize(block_size);
+  next_B.resize(block_size);
+
+  if (grid.rank() != 0) {
+    grid.recv(0, TAG_A, block_A.data(), block_size);
+    grid.recv(0, TAG_B, block_B.data(), block_size);
+    return true;
+  }
+
+  const auto* matrix_A = reinterpret_cast<double*>(taskData->inputs[0]);
+  const auto* matrix_B = reinterpret_cast<double*>(taskData->inputs[1]);
+  int processes = grid_size * grid_size;
+  std::vector<double> send_A(static_cast<size_t>(processes) * block_size);
+  std::vector<double> send_B(static_cast<size_t>(processes) * block_size);
+  std::vector<boost::mpi::request> requests;
+  for (int proc = 0; proc < processes; ++proc) {
+    double* a = send_A.data() + static_cast<size_t>(proc) * block_size;
+    double* b = send_B.data() + static_cast<size_t>(proc) * block_size;
+    packBlock(matrix_A, data_size, block, proc / grid_size, proc % grid_size, a);
+    packBlock(matrix_B, data_size, block, proc / grid_size, proc % grid_size, b);
+    if (proc != 0) {
+      requests.push_back(grid.isend(proc, TAG_A, a, block_size));
+      requests.push_back(grid.isend(proc, TAG_B, b, block_size));
+    }
+  }
+  std::copy(send_A.begin(), send_A.begin() + block_size, block_A.begin());
+  std::copy(send_B.begin(), send_B.begin() + block_size, block_B.begin());
+  boost::mpi::wait_all(requests.begin(), requests.end());
+  gathered_C.resize(static_cast<size_t>(processes) * block_size);
+  return true;
+}
+
+bool FoxAlgorithmMPI::run() {
+  internal_order_test();
+  if (world.rank() >= grid_size * grid_size) {
+    return true;
+  }
+  int q = grid_size;
+  int block_size = block * block;
+  int i = grid.rank() / q;
+  int j = grid.rank() % q;
+  int up = (i + q - 1) % q * q + j;
+  int down = (i + 1) % q * q + j;
+
+  // at stage s, process (i, i + s) of row i sends its block of A to the rest of the row
+  std::vector<boost::mpi::request> requests;
+  auto broadcastRow = [&](int stage, double* into) {
+    int k = (i + stage) % q;
+    if (j != k) {
+      requests.push_back(grid.irecv(i * q + k, TAG_A, into, block_size));
+      return;
+    }
+    for (int col = 0; col < q; ++col) {
+      if (col != k) {
+        requests.push_back(grid.isend(i * q + col, TAG_A, block_A.data(), block_size));
+      }
+    }
+    std::copy(block_A.begin(), block_A.end(), into);
+  };
+
+  std::fill(block_C.begin(), block_C.end(), 0.0);
+  broadcastRow(0, row_A.data());
+  boost::mpi::wait_all(requests.begin(), requests.end());
+  // the next stage's block of A and block of B are in flight while this stage multiplies; B shifts once more after
+  // the last stage, which brings it back to where the scatter put it, and run() can be repeated
+  for (int stage = 0; stage < q; ++stage) {
+    requests.clear();
+    if (stage + 1 < q) {
+      broadcastRow(stage + 1, next_A.data());
+    }
+    requests.push_back(grid.isend(up, TAG_B, block_B.data(), block_size));
+    requests.push_back(grid.irecv(down, TAG_B, next_B.data(), block_size));
+    ppc::core::Gemm(block, block, block, row_A.data(), block, block_B.data(), block, block_C.data(), block);
+    boost::mpi::wait_all(requests.begin(), requests.end());
+    row_A.swap(next_A);
+    block_B.swap(next_B);
+  }
+
+  if (grid.rank() != 0) {
+    grid.send(0, TAG_C, block_C.data(), block_size);
+    return true;
+  }
+  requests.clear();
+  for (int proc = 1; proc < q * q; ++proc) {
+    requests.push_back(grid.irecv(proc, TAG_C, gathered_C.data() + static_cast<size_t>(proc) * block_size, block_size));
+  }
+  std::copy(block_C.begin(), block_C.end(), gathered_C.begin());
+  boost::mpi::wait_all(requests.begin(), requests.end());
+  return true;
+}
+
+bool FoxAlgorithmMPI::post_processing() {
+  internal_order_test();
+  if (world.rank() == 0) {
+    auto* matrix_C = reinterpret_cast<double*>(taskData->outputs[0]);
+    int block_size = block * block;
+    for (int proc = 0; proc < grid_size * grid_size; ++proc) {
+      unpackBlock(gathered_C.data() + static_cast<size_t>(proc) * block_size, data_size, block, proc / grid_size,
+                  proc % grid_size, matrix_C);
+    }
+  }
+  return true;
+}
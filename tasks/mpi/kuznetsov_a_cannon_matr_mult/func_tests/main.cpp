@@ -0,0 +1,245 @@
+// Copyright 2024 Kuznetsov Artem
+#include <gtest/gtest.h>
+
+#include <boost/mpi/communicator.hpp>
+#include <vector>
+
+#include "core/gemm/include/gemm.hpp"
+#include "mpi/kuznetsov_a_cannon_matr_mult/include/ops_mpi.hpp"
+
+TEST(Kuznetsov_a_cannon_matr_mult_mpi_func_tests, mult_1x1) {
+  boost::mpi::communicator world;
+  // a single element: one process computes, whatever the number of processes
+  size_t size = 1;
+  std::vector<double> inputMatrOne;
+  std::vector<double> inputMatrTwo;
+  std::vector<double> outputMatr;
+
+  // Create TaskData
+  auto taskDataPar = std::make_shared<ppc::core::TaskData>();
+
+  if (world.rank() == 0) {
+    inputMatrOne = {3};
+    inputMatrTwo = {-2};
+    outputMatr.resize(size * size, 0.0);
+
+    // Add matrOne
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(inputMatrOne.data()));
+    taskDataPar->inputs_count.emplace_back(inputMatrOne.size());
+
+    // Add matrTwo
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(inputMatrTwo.data()));
+    taskDataPar->inputs_count.emplace_back(inputMatrTwo.size());
+
+    // Add size
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(&size));
+
+    // Add out matr
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t *>(outputMatr.data()));
+    taskDataPar->outputs_count.emplace_back(outputMatr.size());
+  }
+
+  // Create Task
+  KuznetsovArtyomMpi::KuznetsovCannonMatrMultMpi testTaskParallel(taskDataPar);
+
+  ASSERT_TRUE(testTaskParallel.validation());
+  testTaskParallel.pre_processing();
+  testTaskParallel.run();
+  testTaskParallel.post_processing();
+
+  if (world.rank() == 0) {
+    auto resSeq = ppc::core::Gemm(inputMatrOne, inputMatrTwo, static_cast<int>(size));
+    for (size_t i = 0; i < resSeq.size(); ++i) {
+      ASSERT_TRUE(KuznetsovArtyomMpi::isEqual(resSeq[i], outputMatr[i]));
+    }
+  }
+}
+
+TEST(Kuznetsov_a_cannon_matr_mult_mpi_func_tests, mult_4x4) {
+  boost::mpi::communicator world;
+  size_t size = 4;
+  std::vector<double> inputMatrOne;
+  std::vector<double> inputMatrTwo;
+  std::vector<double> outputMatr;
+
+  // Create TaskData
+  auto taskDataPar = std::make_shared<ppc::core::TaskData>();
+
+  if (world.rank() == 0) {
+    inputMatrOne = {2, 3, 4, 5, 9, 8, 7, 6, 5, 4, 2, 3, 8, 7, 3, 4};
+    inputMatrTwo = {3, 5, 7, 6, 2, 7, 6, 3, 7, 5, 3, 2, 4, 3, 2, 5};
+    outputMatr.resize(size * size, 0.0);
+
+    // Add matrOne
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(inputMatrOne.data()));
+    taskDataPar->inputs_count.emplace_back(inputMatrOne.size());
+
+    // Add matrTwo
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(inputMatrTwo.data()));
+    taskDataPar->inputs_count.emplace_back(inputMatrTwo.size());
+
+    // Add size
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(&size));
+
+    // Add out matr
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t *>(outputMatr.data()));
+    taskDataPar->outputs_count.emplace_back(outputMatr.size());
+  }
+
+  // Create Task
+  KuznetsovArtyomMpi::KuznetsovCannonMatrMultMpi testTaskParallel(taskDataPar);
+
+  ASSERT_TRUE(testTaskParallel.validation());
+  testTaskParallel.pre_processing();
+  testTaskParallel.run();
+  testTaskParallel.post_processing();
+
+  if (world.rank() == 0) {
+    auto resSeq = ppc::core::Gemm(inputMatrOne, inputMatrTwo, static_cast<int>(size));
+    for (size_t i = 0; i < resSeq.size(); ++i) {
+      ASSERT_TRUE(KuznetsovArtyomMpi::isEqual(resSeq[i], outputMatr[i]));
+    }
+  }
+}
+
+TEST(Kuznetsov_a_cannon_matr_mult_mpi_func_tests, mult_7x7) {
+  boost::mpi::communicator world;
+  // the grid side does not divide 7 for 4 or 9 processes: the edge blocks are padded
+  size_t size = 7;
+  std::vector<double> inputMatrOne;
+  std::vector<double> inputMatrTwo;
+  std::vector<double> outputMatr;
+
+  // Create TaskData
+  auto taskDataPar = std::make_shared<ppc::core::TaskData>();
+
+  if (world.rank() == 0) {
+    inputMatrOne = KuznetsovArtyomMpi::getRandomSquareMatrix(size, -100.0, 100.0);
+    inputMatrTwo = KuznetsovArtyomMpi::getRandomSquareMatrix(size, -100.0, 100.0);
+    outputMatr.resize(size * size, 0.0);
+
+    // Add matrOne
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(inputMatrOne.data()));
+    taskDataPar->inputs_count.emplace_back(inputMatrOne.size());
+
+    // Add matrTwo
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(inputMatrTwo.data()));
+    taskDataPar->inputs_count.emplace_back(inputMatrTwo.size());
+
+    // Add size
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(&size));
+
+    // Add out matr
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t *>(outputMatr.data()));
+    taskDataPar->outputs_count.emplace_back(outputMatr.size());
+  }
+
+  // Create Task
+  KuznetsovArtyomMpi::KuznetsovCannonMatrMultMpi testTaskParallel(taskDataPar);
+
+  ASSERT_TRUE(testTaskParallel.validation());
+  testTaskParallel.pre_processing();
+  testTaskParallel.run();
+  testTaskParallel.post_processing();
+
+  if (world.rank() == 0) {
+    auto resSeq = ppc::core::Gemm(inputMatrOne, inputMatrTwo, static_cast<int>(size));
+    for (size_t i = 0; i < resSeq.size(); ++i) {
+      ASSERT_TRUE(KuznetsovArtyomMpi::isEqual(resSeq[i], outputMatr[i]));
+    }
+  }
+}
+
+TEST(Kuznetsov_a_cannon_matr_mult_mpi_func_tests, mult_37x37) {
+  boost::mpi::communicator world;
+  size_t size = 37;
+  std::vector<double> inputMatrOne;
+  std::vector<double> inputMatrTwo;
+  std::vector<double> outputMatr;
+
+  // Create TaskData
+  auto taskDataPar = std::make_shared<ppc::core::TaskData>();
+
+  if (world.rank() == 0) {
+    inputMatrOne = KuznetsovArtyomMpi::getRandomSquareMatrix(size, -100.0, 100.0);
+    inputMatrTwo = KuznetsovArtyomMpi::getRandomSquareMatrix(size, -100.0, 100.0);
+    outputMatr.resize(size * size, 0.0);
+
+    // Add matrOne
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(inputMatrOne.data()));
+    taskDataPar->inputs_count.emplace_back(inputMatrOne.size());
+
+    // Add matrTwo
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(inputMatrTwo.data()));
+    taskDataPar->inputs_count.emplace_back(inputMatrTwo.size());
+
+    // Add size
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(&size));
+
+    // Add out matr
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t *>(outputMatr.data()));
+    taskDataPar->outputs_count.emplace_back(outputMatr.size());
+  }
+
+  // Create Task
+  KuznetsovArtyomMpi::KuznetsovCannonMatrMultMpi testTaskParallel(taskDataPar);
+
+  ASSERT_TRUE(testTaskParallel.validation());
+  testTaskParallel.pre_processing();
+  testTaskParallel.run();
+  testTaskParallel.post_processing();
+
+  if (world.rank() == 0) {
+    auto resSeq = ppc::core::Gemm(inputMatrOne, inputMatrTwo, static_cast<int>(size));
+    for (size_t i = 0; i < resSeq.size(); ++i) {
+      ASSERT_TRUE(KuznetsovArtyomMpi::isEqual(resSeq[i], outputMatr[i]));
+    }
+  }
+}
+
+TEST(Kuznetsov_a_cannon_matr_mult_mpi_func_tests, mult_128x128) {
+  boost::mpi::communicator world;
+  size_t size = 128;
+  std::vector<double> inputMatrOne;
+  std::vector<double> inputMatrTwo;
+  std::vector<double> outputMatr;
+
+  // Create TaskData
+  auto taskDataPar = std::make_shared<ppc::core::TaskData>();
+
+  if (world.rank() == 0) {
+    inputMatrOne = KuznetsovArtyomMpi::getRandomSquareMatrix(size, -100.0, 100.0);
+    inputMatrTwo = KuznetsovArtyomMpi::getRandomSquareMatrix(size, -100.0, 100.0);
+    outputMatr.resize(size * size, 0.0);
+
+    // Add matrOne
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(inputMatrOne.data()));
+    taskDataPar->inputs_count.emplace_back(inputMatrOne.size());
+
+    // Add matrTwo
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(inputMatrTwo.data()));
+    taskDataPar->inputs_count.emplace_back(inputMatrTwo.size());
+
+    // Add size
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(&size));
+
+    // Add out matr
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t *>(outputMatr.data()));
+    taskDataPar->outputs_count.emplace_back(outputMatr.size());
+  }
+
+  // Create Task
+  KuznetsovArtyomMpi::KuznetsovCannonMatrMultMpi testTaskParallel(taskDataPar);
+
+  ASSERT_TRUE(testTaskParallel.validation());
+  testTaskParallel.pre_processing();
+  testTaskParallel.run();
+  testTaskParallel.post_processing();
+
+  if (world.rank() == 0) {
+    auto resSeq = ppc::core::Gemm(inputMatrOne, inputMatrTwo, static_cast<int>(size));
+    for (size_t i = 0; i < resSeq.size(); ++i) {
+      ASSERT_TRUE(KuznetsovArtyomMpi::isEqual(resSeq[i], outputMatr[i]));
+    }
+  }
+}
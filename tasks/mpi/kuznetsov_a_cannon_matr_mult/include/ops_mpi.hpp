@@ -0,0 +1,44 @@
+// Copyright 2024 Kuznetsov Artem
+#pragma once
+
+#include <boost/mpi/communicator.hpp>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "core/task/include/task.hpp"
+
+namespace KuznetsovArtyomMpi {
+bool isEqual(double valueOne, double valueTwo, double eps = 0.01);
+
+std::vector<double> getRandomSquareMatrix(size_t size, double minVal, double maxVal);
+
+// Cannon's algorithm on a q x q grid of processes, q = floor(sqrt(world size)) but at most the matrix size; the
+// processes beyond q * q stay idle. Rank 0 holds the task data, laid out as for the shared-memory versions without
+// the block size: the blocks are n / q, rounded up and padded with zeros. While a process multiplies its current
+// blocks, the next ones are already on their way from its neighbours.
+class KuznetsovCannonMatrMultMpi : public ppc::core::Task {
+ public:
+  explicit KuznetsovCannonMatrMultMpi(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+  bool pre_processing() override;
+  bool validation() override;
+  bool run() override;
+  bool post_processing() override;
+
+ private:
+  boost::mpi::communicator world;
+  // the q * q processes of the grid, row-major
+  boost::mpi::communicator grid;
+  int mSize = 0;
+  int mGrid = 0;
+  int mBlock = 0;
+  std::vector<double> mBlockOne;
+  std::vector<double> mBlockTwo;
+  std::vector<double> mNextOne;
+  std::vector<double> mNextTwo;
+  std::vector<double> mBlockRes;
+  // every block of the result in grid rank order, on rank 0
+  std::vector<double> mGathered;
+};
+}  // namespace KuznetsovArtyomMpi
@@ -0,0 +1,121 @@
+// Copyright 2024 Kuznetsov Artem
+#include <gtest/gtest.h>
+
+#include <boost/mpi/communicator.hpp>
+#include <boost/mpi/timer.hpp>
+#include <vector>
+
+#include "core/gemm/include/gemm.hpp"
+#include "core/perf/include/perf.hpp"
+#include "mpi/kuznetsov_a_cannon_matr_mult/include/ops_mpi.hpp"
+
+TEST(Kuznetsov_a_cannon_matr_mult_mpi_perf_tests, test_pipeline_run) {
+  boost::mpi::communicator world;
+  // the size of the shared-memory perf tests, so the perf table puts the four versions side by side
+  size_t size = 900;
+  std::vector<double> inputMatrOne;
+  std::vector<double> inputMatrTwo;
+  std::vector<double> outputMatr;
+
+  // Create TaskData
+  auto taskDataPar = std::make_shared<ppc::core::TaskData>();
+
+  if (world.rank() == 0) {
+    inputMatrOne = KuznetsovArtyomMpi::getRandomSquareMatrix(size, -100.0, 100.0);
+    inputMatrTwo = KuznetsovArtyomMpi::getRandomSquareMatrix(size, -100.0, 100.0);
+    outputMatr.resize(size * size, 0.0);
+
+    // Add matrOne
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(inputMatrOne.data()));
+    taskDataPar->inputs_count.emplace_back(inputMatrOne.size());
+
+    // Add matrTwo
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(inputMatrTwo.data()));
+    taskDataPar->inputs_count.emplace_back(inputMatrTwo.size());
+
+    // Add size
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(&size));
+
+    // Add out matr
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t *>(outputMatr.data()));
+    taskDataPar->outputs_count.emplace_back(outputMatr.size());
+  }
+
+  // Create Task
+  auto testTaskParallel = std::make_shared<KuznetsovArtyomMpi::KuznetsovCannonMatrMultMpi>(taskDataPar);
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  const boost::mpi::timer current_timer;
+  perfAttr->current_timer = [&] { return current_timer.elapsed(); };
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  auto perfAnalyzer = std::make_shared<ppc::core::Perf>(testTaskParallel);
+  perfAnalyzer->pipeline_run(perfAttr, perfResults);
+  if (world.rank() == 0) {
+    ppc::core::Perf::print_perf_statistic(perfResults);
+    auto resSeq = ppc::core::Gemm(inputMatrOne, inputMatrTwo, static_cast<int>(size));
+    for (size_t i = 0; i < resSeq.size(); ++i) {
+      ASSERT_TRUE(KuznetsovArtyomMpi::isEqual(resSeq[i], outputMatr[i]));
+    }
+  }
+}
+
+TEST(Kuznetsov_a_cannon_matr_mult_mpi_perf_tests, test_task_run) {
+  boost::mpi::communicator world;
+  size_t size = 900;
+  std::vector<double> inputMatrOne;
+  std::vector<double> inputMatrTwo;
+  std::vector<double> outputMatr;
+
+  // Create TaskData
+  auto taskDataPar = std::make_shared<ppc::core::TaskData>();
+
+  if (world.rank() == 0) {
+    inputMatrOne = KuznetsovArtyomMpi::getRandomSquareMatrix(size, -100.0, 100.0);
+    inputMatrTwo = KuznetsovArtyomMpi::getRandomSquareMatrix(size, -100.0, 100.0);
+    outputMatr.resize(size * size, 0.0);
+
+    // Add matrOne
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(inputMatrOne.data()));
+    taskDataPar->inputs_count.emplace_back(inputMatrOne.size());
+
+    // Add matrTwo
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(inputMatrTwo.data()));
+    taskDataPar->inputs_count.emplace_back(inputMatrTwo.size());
+
+    // Add size
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(&size));
+
+    // Add out matr
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t *>(outputMatr.data()));
+    taskDataPar->outputs_count.emplace_back(outputMatr.size());
+  }
+
+  // Create Task
+  auto testTaskParallel = std::make_shared<KuznetsovArtyomMpi::KuznetsovCannonMatrMultMpi>(taskDataPar);
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  const boost::mpi::timer current_timer;
+  perfAttr->current_timer = [&] { return current_timer.elapsed(); };
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  auto perfAnalyzer = std::make_shared<ppc::core::Perf>(testTaskParallel);
+  perfAnalyzer->task_run(perfAttr, perfResults);
+  if (world.rank() == 0) {
+    ppc::core::Perf::print_perf_statistic(perfResults);
+    auto resSeq = ppc::core::Gemm(inputMatrOne, inputMatrTwo, static_cast<int>(size));
+    for (size_t i = 0; i < resSeq.size(); ++i) {
+      ASSERT_TRUE(KuznetsovArtyomMpi::isEqual(resSeq[i], outputMatr[i]));
+    }
+  }
+}
@@ -0,0 +1,180 @@
+// Copyright 2024 Kuznetsov Artem
+#include "mpi/kuznetsov_a_cannon_matr_mult/include/ops_mpi.hpp"
+
+#include <algorithm>
+#include <boost/mpi/collectives.hpp>
+#include <boost/mpi/nonblocking.hpp>
+#include <cmath>
+
+#include "core/gemm/include/gemm.hpp"
+
+namespace KuznetsovArtyomMpi {
+enum Order : size_t { MATR_ONE = 0, MATR_TWO = 1, SIZE = 2, MATR_RES = 0 };
+enum Tag : int { TAG_ONE = 1, TAG_TWO = 2, TAG_RES = 3 };
+
+namespace {
+// block (bi, bj) of the n x n row-major matrix as a contiguous block x block array, zeros outside the matrix
+void packBlock(const double* matr, int n, int block, int bi, int bj, double* out) {
+  std::fill(out, out + block * block, 0.0);
+  int rows = std::max(0, std::min(block, n - bi * block));
+  int cols = std::max(0, std::min(block, n - bj * block));
+  for (int r = 0; r < rows; ++r) {
+    const double* src = matr + static_cast<size_t>(bi * block + r) * n + bj * block;
+    std::copy(src, src + cols, out + static_cast<size_t>(r) * block);
+  }
+}
+
+void unpackBlock(const double* in, int n, int block, int bi, int bj, double* matr) {
+  int rows = std::max(0, std::min(block, n - bi * block));
+  int cols = std::max(0, std::min(block, n - bj * block));
+  for (int r = 0; r < rows; ++r) {
+    const double* src = in + static_cast<size_t>(r) * block;
+    std::copy(src, src + cols, matr + static_cast<size_t>(bi * block + r) * n + bj * block);
+  }
+}
+
+int gridSide(int processes, int size) {
+  int q = static_cast<int>(std::sqrt(static_cast<double>(processes)));
+  while ((q + 1) * (q + 1) <= processes) ++q;
+  while (q * q > processes) --q;
+  return std::max(1, std::min(q, size));
+}
+}  // namespace
+
+bool isEqual(double valueOne, double valueTwo, double eps) { return std::fabs(valueOne - valueTwo) <= eps; }
+
+std::vector<double> getRandomSquareMatrix(size_t size, double minVal, double maxVal) {
+  std::mt19937 gen(std::random_device{}());
+  std::uniform_real_distribution<double> dist(minVal, maxVal);
+
+  std::vector<double> matrix(size * size);
+  for (auto& elem : matrix) elem = dist(gen);
+
+  return matrix;
+}
+
+bool KuznetsovCannonMatrMultMpi::validation() {
+  internal_order_test();
+  if (world.rank() == 0) {
+    if (taskData->inputs.size() != 3 || taskData->inputs_count.size() != 2 || taskData->outputs_count.size() != 1) {
+      return false;
+    }
+    size_t size = *reinterpret_cast<size_t*>(taskData->inputs[SIZE]);
+    return size != 0 && taskData->inputs_count[MATR_ONE] == size * size &&
+           taskData->inputs_count[MATR_TWO] == size * size && taskData->outputs_count[MATR_RES] == size * size;
+  }
+  return true;
+}
+
+bool KuznetsovCannonMatrMultMpi::pre_processing() {
+  internal_order_test();
+  if (world.rank() == 0) {
+    mSize = static_cast<int>(*reinterpret_cast<size_t*>(taskData->inputs[SIZE]));
+  }
+  broadcast(world, mSize, 0);
+
+  mGrid = gridSide(world.size(), mSize);
+  bool active = world.rank() < mGrid * mGrid;
+  grid = world.split(active ? 0 : 1);
+  if (!active) {
+    return true;
+  }
+
+  mBlock = (mSize + mGrid - 1) / mGrid;
+  int blockSize = mBlock * mBlock;
+  mBlockOne.resize(blockSize);
+  mBlockTwo.resize(blockSize);
+  mNextOne.resize(blockSize);
+  mNextTwo.resize(blockSize);
+  mBlockRes.resize(blockSize);
+
+  if (grid.rank() != 0) {
+    grid.recv(0, TAG_ONE, mBlockOne.data(), blockSize);
+    grid.recv(0, TAG_TWO, mBlockTwo.data(), blockSize);
+    return true;
+  }
+
+  // the initial skew is applied while scattering: process (i, j) starts with A(i, i + j) and B(i + j, j)
+  const auto* matrOne = reinterpret_cast<double*>(taskData->inputs[MATR_ONE]);
+  const auto* matrTwo = reinterpret_cast<double*>(taskData->inputs[MATR_TWO]);
+  int processes = mGrid * mGrid;
+  std::vector<double> sendOne(static_cast<size_t>(processes) * blockSize);
+  std::vector<double> sendTwo(static_cast<size_t>(processes) * blockSize);
+  std::vector<boost::mpi::request> requests;
+  for (int proc = 0; proc < processes; ++proc) {
+    int i = proc / mGrid;
+    int j = proc % mGrid;
+    int k = (i + j) % mGrid;
+    double* one = sendOne.data() + static_cast<size_t>(proc) * blockSize;
+    double* two = sendTwo.data() + static_cast<size_t>(proc) * blockSize;
+    packBlock(matrOne, mSize, mBlock, i, k, one);
+    packBlock(matrTwo, mSize, mBlock, k, j, two);
+    if (proc != 0) {
+      requests.push_back(grid.isend(proc, TAG_ONE, one, blockSize));
+      requests.push_back(grid.isend(proc, TAG_TWO, two, blockSize));
+    }
+  }
+  std::copy(sendOne.begin(), sendOne.begin() + blockSize, mBlockOne.begin());
+  std::copy(sendTwo.begin(), sendTwo.begin() + blockSize, mBlockTwo.begin());
+  boost::mpi::wait_all(requests.begin(), requests.end());
+  mGathered.resize(static_cast<size_t>(processes) * blockSize);
+  return true;
+}
+
+bool KuznetsovCannonMatrMultMpi::run() {
+  internal_order_test();
+  if (world.rank() >= mGrid * mGrid) {
+    return true;
+  }
+  int blockSize = mBlock * mBlock;
+  int i = grid.rank() / mGrid;
+  int j = grid.rank() % mGrid;
+  int left = i * mGrid + (j + mGrid - 1) % mGrid;
+  int right = i * mGrid + (j + 1) % mGrid;
+  int up = (i + mGrid - 1) % mGrid * mGrid + j;
+  int down = (i + 1) % mGrid * mGrid + j;
+
+  std::fill(mBlockRes.begin(), mBlockRes.end(), 0.0);
+  // A moves left and B moves up by one block per step; the shift for the next step is posted before the product of
+  // this one, so the transfer runs while the block product computes. The shift after the last step brings every
+  // block back to where the scatter put it, and run() can be repeated.
+  std::vector<boost::mpi::request> requests;
+  for (int step = 0; step < mGrid; ++step) {
+    requests.clear();
+    requests.push_back(grid.isend(left, TAG_ONE, mBlockOne.data(), blockSize));
+    requests.push_back(grid.irecv(right, TAG_ONE, mNextOne.data(), blockSize));
+    requests.push_back(grid.isend(up, TAG_TWO, mBlockTwo.data(), blockSize));
+    requests.push_back(grid.irecv(down, TAG_TWO, mNextTwo.data(), blockSize));
+    ppc::core::Gemm(mBlock, mBlock, mBlock, mBlockOne.data(), mBlock, mBlockTwo.data(), mBlock, mBlockRes.data(),
+                    mBlock);
+    boost::mpi::wait_all(requests.begin(), requests.end());
+    mBlockOne.swap(mNextOne);
+    mBlockTwo.swap(mNextTwo);
+  }
+
+  if (grid.rank() != 0) {
+    grid.send(0, TAG_RES, mBlockRes.data(), blockSize);
+    return true;
+  }
+  requests.clear();
+  for (int proc = 1; proc < mGrid * mGrid; ++proc) {
+    requests.push_back(grid.irecv(proc, TAG_RES, mGathered.data() + static_cast<size_t>(proc) * blockSize, blockSize));
+  }
+  std::copy(mBlockRes.begin(), mBlockRes.end(), mGathered.begin());
+  boost::mpi::wait_all(requests.begin(), requests.end());
+  return true;
+}
+
+bool KuznetsovCannonMatrMultMpi::post_processing() {
+  internal_order_test();
+  if (world.rank() == 0) {
+    auto* matrRes = reinterpret_cast<double*>(taskData->outputs[MATR_RES]);
+    int blockSize = mBlock * mBlock;
+    for (int proc = 0; proc < mGrid * mGrid; ++proc) {
+      unpackBlock(mGathered.data() + static_cast<size_t>(proc) * blockSize, mSize, mBlock, proc / mGrid, proc % mGrid,
+                  matrRes);
+    }
+  }
+  return true;
+}
+}  // namespace KuznetsovArtyomMpi
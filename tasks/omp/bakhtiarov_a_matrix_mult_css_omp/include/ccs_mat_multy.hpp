@@ -50,3 +50,38 @@ class SparseOmpMatrixMultiParallel : public ppc::core::Task {
   int numCols2{};
   double* result{};
 };
+
+namespace BakhtiarovOmp {
+
+// Matrix in compressed columns: colPtr has numCols + 1 entries and the rows of column j are
+// rows[colPtr[j]], ..., rows[colPtr[j + 1] - 1] in increasing order.
+struct MatrixCCS {
+  std::vector<double> values;
+  std::vector<int> rows;
+  std::vector<int> colPtr;
+  int numRows{};
+  int numCols{};
+};
+
+// C = A * B without dense buffers: the columns of C are counted first and then written at their final
+// offsets, so C keeps every structural nonzero, including products that cancel.
+MatrixCCS MultiplyCCS(const MatrixCCS& a, const MatrixCCS& b);
+
+// Same multiplication on compressed input: inputs[0] and inputs[1] point to the MatrixCCS of A (n1 x m1) and
+// B (m1 x m2), inputs_count is {n1, m1, m1, m2}, outputs[0] points to the MatrixCCS receiving C.
+class SparseMatrixMultiCCS : public ppc::core::Task {
+ public:
+  explicit SparseMatrixMultiCCS(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+  bool pre_processing() override;
+  bool validation() override;
+  bool run() override;
+  bool post_processing() override;
+
+ private:
+  const MatrixCCS* a{};
+  const MatrixCCS* b{};
+  MatrixCCS c;
+  MatrixCCS* out{};
+};
+
+}  // namespace BakhtiarovOmp
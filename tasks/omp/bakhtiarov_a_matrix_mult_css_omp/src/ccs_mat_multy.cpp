@@ -2,8 +2,13 @@
 
 #include "omp/bakhtiarov_a_matrix_mult_css_omp/include/ccs_mat_multy.hpp"
 
+#include <omp.h>
+
+#include <algorithm>
 #include <thread>
 
+#include "core/sparse/include/compress.hpp"
+
 using namespace std::chrono_literals;
 using namespace std;
 
@@ -18,33 +23,9 @@ bool SparseOmpMatrixMultiSequential::pre_processing() {
 
   result = new double[numRows1 * numCols2]{0};
 
-  int notNullNumbers = 0;
-  for (int j = 0; j < numCols1; ++j) {
-    colPtr1.push_back(notNullNumbers);
-    for (int i = 0; i < numRows1; ++i) {
-      int index = i * numRows1 + j;
-      if (matrix1[index] != 0) {
-        values1.push_back(matrix1[index]);
-        rows1.push_back(i);
-        notNullNumbers++;
-      }
-    }
-  }
-  colPtr1.push_back(notNullNumbers);
-
-  notNullNumbers = 0;
-  for (int j = 0; j < numCols2; ++j) {
-    colPtr2.push_back(notNullNumbers);
-    for (int i = 0; i < numRows2; ++i) {
-      int index = i * numRows2 + j;
-      if (matrix2[index] != 0) {
-        values2.push_back(matrix2[index]);
-        rows2.push_back(i);
-        notNullNumbers++;
-      }
-    }
-  }
-  colPtr2.push_back(notNullNumbers);
+  auto nonzero = [](double v) { return v != 0; };
+  ppc::core::DenseToCompressed(matrix1, numRows1, numCols1, true, nonzero, values1, rows1, colPtr1);
+  ppc::core::DenseToCompressed(matrix2, numRows2, numCols2, true, nonzero, values2, rows2, colPtr2);
 
   return true;
 }
@@ -100,33 +81,11 @@ bool SparseOmpMatrixMultiParallel::pre_processing() {
 
   result = new double[numRows1 * numCols2]{0};
 
-  int notNullNumbers = 0;
-  for (int j = 0; j < numCols1; ++j) {
-    colPtr1.push_back(notNullNumbers);
-    for (int i = 0; i < numRows1; ++i) {
-      int index = i * numRows1 + j;
-      if (matrix1[index] != 0) {
-        values1.push_back(matrix1[index]);
-        rows1.push_back(i);
-        notNullNumbers++;
-      }
-    }
-  }
-  colPtr1.push_back(notNullNumbers);
-
-  notNullNumbers = 0;
-  for (int j = 0; j < numCols2; ++j) {
-    colPtr2.push_back(notNullNumbers);
-    for (int i = 0; i < numRows2; ++i) {
-      int index = i * numRows2 + j;
-      if (matrix2[index] != 0) {
-        values2.push_back(matrix2[index]);
-        rows2.push_back(i);
-        notNullNumbers++;
-      }
-    }
-  }
-  colPtr2.push_back(notNullNumbers);
+  auto nonzero = [](double v) { return v != 0; };
+  ppc::core::DenseToCompressed(matrix1, numRows1, numCols1, true, nonzero, values1, rows1, colPtr1,
+                               omp_get_max_threads());
+  ppc::core::DenseToCompressed(matrix2, numRows2, numCols2, true, nonzero, values2, rows2, colPtr2,
+                               omp_get_max_threads());
 
   return true;
 }
@@ -170,3 +129,118 @@ bool SparseOmpMatrixMultiParallel::post_processing() {
 
   return true;
 }
+
+namespace BakhtiarovOmp {
+
+MatrixCCS MultiplyCCS(const MatrixCCS& a, const MatrixCCS& b) {
+  MatrixCCS c;
+  c.numRows = a.numRows;
+  c.numCols = b.numCols;
+  c.colPtr.assign(b.numCols + 1, 0);
+
+  // first pass: the number of structural nonzeros of every column of C
+#pragma omp parallel
+  {
+    std::vector<int> mark(a.numRows, -1);
+#pragma omp for schedule(dynamic, 64)
+    for (int j = 0; j < b.numCols; j++) {
+      int count = 0;
+      for (int k = b.colPtr[j]; k < b.colPtr[j + 1]; k++) {
+        int rowB = b.rows[k];
+        for (int i = a.colPtr[rowB]; i < a.colPtr[rowB + 1]; i++) {
+          if (mark[a.rows[i]] != j) {
+            mark[a.rows[i]] = j;
+            count++;
+          }
+        }
+      }
+      c.colPtr[j + 1] = count;
+    }
+  }
+
+  // prefix sum: colPtr[j] becomes the offset of column j in the final arrays
+  for (int j = 0; j < b.numCols; j++) {
+    c.colPtr[j + 1] += c.colPtr[j];
+  }
+  c.rows.resize(c.colPtr[b.numCols]);
+  c.values.resize(c.colPtr[b.numCols]);
+
+  // second pass: every column is written straight into its place in the final arrays
+#pragma omp parallel
+  {
+    std::vector<double> column(a.numRows);
+    std::vector<int> mark(a.numRows, -1);
+#pragma omp for schedule(dynamic, 64)
+    for (int j = 0; j < b.numCols; j++) {
+      int pos = c.colPtr[j];
+      for (int k = b.colPtr[j]; k < b.colPtr[j + 1]; k++) {
+        int rowB = b.rows[k];
+        double y = b.values[k];
+        for (int i = a.colPtr[rowB]; i < a.colPtr[rowB + 1]; i++) {
+          int rowA = a.rows[i];
+          double x = a.values[i];
+          if (mark[rowA] != j) {
+            mark[rowA] = j;
+            c.rows[pos++] = rowA;
+          }
+          column[rowA] += x * y;
+        }
+      }
+      std::sort(c.rows.begin() + c.colPtr[j], c.rows.begin() + pos);
+      for (int p = c.colPtr[j]; p < pos; p++) {
+        c.values[p] = column[c.rows[p]];
+        column[c.rows[p]] = 0.0;
+      }
+    }
+  }
+
+  return c;
+}
+
+bool SparseMatrixMultiCCS::validation() {
+  internal_order_test();
+
+  if (taskData->inputs.size() != 2 || taskData->inputs_count.size() != 4 || taskData->outputs.size() != 1) {
+    return false;
+  }
+  if (taskData->inputs[0] == nullptr || taskData->inputs[1] == nullptr || taskData->outputs[0] == nullptr) {
+    return false;
+  }
+  const auto* matrix1 = reinterpret_cast<MatrixCCS*>(taskData->inputs[0]);
+  const auto* matrix2 = reinterpret_cast<MatrixCCS*>(taskData->inputs[1]);
+  return taskData->inputs_count[1] == taskData->inputs_count[2] &&
+         matrix1->numRows == static_cast<int>(taskData->inputs_count[0]) &&
+         matrix1->numCols == static_cast<int>(taskData->inputs_count[1]) &&
+         matrix2->numRows == static_cast<int>(taskData->inputs_count[2]) &&
+         matrix2->numCols == static_cast<int>(taskData->inputs_count[3]) &&
+         matrix1->colPtr.size() == static_cast<size_t>(matrix1->numCols) + 1 &&
+         matrix2->colPtr.size() == static_cast<size_t>(matrix2->numCols) + 1;
+}
+
+bool SparseMatrixMultiCCS::pre_processing() {
+  internal_order_test();
+
+  a = reinterpret_cast<MatrixCCS*>(taskData->inputs[0]);
+  b = reinterpret_cast<MatrixCCS*>(taskData->inputs[1]);
+  out = reinterpret_cast<MatrixCCS*>(taskData->outputs[0]);
+
+  return true;
+}
+
+bool SparseMatrixMultiCCS::run() {
+  internal_order_test();
+
+  c = MultiplyCCS(*a, *b);
+
+  return true;
+}
+
+bool SparseMatrixMultiCCS::post_processing() {
+  internal_order_test();
+
+  *out = std::move(c);
+
+  return true;
+}
+
+}  // namespace BakhtiarovOmp
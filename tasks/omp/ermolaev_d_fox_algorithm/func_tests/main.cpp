@@ -1,8 +1,10 @@
 #include <gtest/gtest.h>
 
+#include <iostream>
 #include <random>
 #include <vector>
 
+#include "core/gemm/include/gemm.hpp"
 #include "omp/ermolaev_d_fox_algorithm/include/ops_omp.hpp"
 
 TEST(ermolaev_d_fox_algorithm_omp, Test_Matrix_Multiplication_Simple_56) {
@@ -207,4 +209,42 @@ TEST(ermolaev_d_fox_algorithm_omp, Test_Matrix_Multiplication_Random_64) {
   for (size_t i = 0; i < matrix_size * matrix_size; ++i) {
     ASSERT_NEAR(C[i], expected[i], tolerance);
   }
-}
\ No newline at end of file
+}
+
+TEST(ermolaev_d_fox_algorithm_omp, Test_Matrix_Multiplication_Reduced_Precision_200) {
+  constexpr size_t matrix_size = 200;
+  std::mt19937 gen(1);
+  std::uniform_real_distribution<float> dis(1.0F, 6.0F);
+  std::vector<float> A(matrix_size * matrix_size);
+  std::vector<float> B(matrix_size * matrix_size);
+  for (size_t i = 0; i < matrix_size * matrix_size; ++i) {
+    A[i] = dis(gen);
+    B[i] = dis(gen);
+  }
+
+  // the double algorithm on the same inputs
+  std::vector<double> Ad(A.begin(), A.end());
+  std::vector<double> Bd(B.begin(), B.end());
+  std::vector<double> expected(matrix_size * matrix_size, 0.0);
+  std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(Ad.data()));
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(Bd.data()));
+  taskDataSeq->inputs_count.emplace_back(matrix_size * matrix_size);
+  taskDataSeq->inputs_count.emplace_back(matrix_size * matrix_size);
+  taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(expected.data()));
+  taskDataSeq->outputs_count.emplace_back(matrix_size * matrix_size);
+
+  FoxAlgorithmOMP test(taskDataSeq);
+  ASSERT_TRUE(test.validation());
+  test.pre_processing();
+  test.run();
+  test.post_processing();
+
+  int n = static_cast<int>(matrix_size);
+  double errorFloat = ppc::core::RelativeError(FoxMultiply(A, B, n), expected);
+  double errorMixed = ppc::core::RelativeError(FoxMultiplyMixed(A, B, n), expected);
+  std::cout << "relative error for n = " << n << ": float " << errorFloat << ", mixed " << errorMixed << std::endl;
+  EXPECT_LT(errorFloat, n * 6e-8);
+  // float products are exact in double, and each block of C is summed stage by stage as in the double version
+  EXPECT_EQ(0.0, errorMixed);
+}
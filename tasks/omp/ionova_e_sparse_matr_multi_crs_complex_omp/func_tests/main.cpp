@@ -5,6 +5,43 @@
 
 #include "omp/ionova_e_sparse_matr_multi_crs_complex_omp/include/ops_seq.hpp"
 
+namespace {
+ComplexMatrixCRS toCRS(const std::vector<Complex> &matrix, int numRows, int numCols) {
+  ComplexMatrixCRS crs;
+  crs.numRows = numRows;
+  crs.numCols = numCols;
+  crs.rowPtr.push_back(0);
+  for (int i = 0; i < numRows; ++i) {
+    for (int j = 0; j < numCols; ++j) {
+      const Complex &value = matrix[i * numCols + j];
+      if (value.real != 0 || value.imag != 0) {
+        crs.values.push_back(value);
+        crs.colPtr.push_back(j);
+      }
+    }
+    crs.rowPtr.push_back(crs.values.size());
+  }
+  return crs;
+}
+
+void expectDense(const ComplexMatrixCRS &crs, const std::vector<Complex> &expected) {
+  std::vector<Complex> matrix(crs.numRows * crs.numCols, Complex{0, 0});
+  for (int i = 0; i < crs.numRows; ++i) {
+    for (int k = crs.rowPtr[i]; k < crs.rowPtr[i + 1]; ++k) {
+      if (k > crs.rowPtr[i]) {
+        EXPECT_LT(crs.colPtr[k - 1], crs.colPtr[k]);
+      }
+      matrix[i * crs.numCols + crs.colPtr[k]] = crs.values[k];
+    }
+  }
+  ASSERT_EQ(matrix.size(), expected.size());
+  for (size_t i = 0; i < matrix.size(); ++i) {
+    EXPECT_DOUBLE_EQ(matrix[i].real, expected[i].real);
+    EXPECT_DOUBLE_EQ(matrix[i].imag, expected[i].imag);
+  }
+}
+}  // namespace
+
 TEST(ionova_e_sparse_matr_multi_crs_complex_omp, sizes_correct) {
   size_t n1 = 4;
   size_t m1 = 4;
@@ -326,3 +363,78 @@ TEST(ionova_e_sparse_matr_multi_crs_complex_omp, inverse_matrix) {
 
   ASSERT_EQ(ch, n1 * m2);
 }
+
+TEST(ionova_e_sparse_matr_multi_crs_complex_omp, crs_input_sizes_incorrect) {
+  // Create data
+  ComplexMatrixCRS in1 = toCRS(std::vector<Complex>(4 * 5, Complex{0, 0}), 4, 5);
+  ComplexMatrixCRS in2 = toCRS(std::vector<Complex>(3 * 4, Complex{0, 0}), 3, 4);
+  ComplexMatrixCRS out;
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataParallel = std::make_shared<ppc::core::TaskData>();
+  taskDataParallel->inputs.emplace_back(reinterpret_cast<uint8_t *>(&in1));
+  taskDataParallel->inputs_count.emplace_back(4);
+  taskDataParallel->inputs_count.emplace_back(5);
+  taskDataParallel->inputs.emplace_back(reinterpret_cast<uint8_t *>(&in2));
+  taskDataParallel->inputs_count.emplace_back(3);
+  taskDataParallel->inputs_count.emplace_back(4);
+  taskDataParallel->outputs.emplace_back(reinterpret_cast<uint8_t *>(&out));
+
+  // Create Task
+  SparseMatrixComplexMultiCRSOmp sparseMatrixComplexMultiCRSOmp(taskDataParallel);
+  ASSERT_FALSE(sparseMatrixComplexMultiCRSOmp.validation());
+}
+
+TEST(ionova_e_sparse_matr_multi_crs_complex_omp, crs_input_multy) {
+  // Create data
+  ComplexMatrixCRS in1 = toCRS({{3, 2}, {0, 0}, {0, 0}, {0, 0}, {1, -3}, {0, 0}, {0, 0}, {0, 0}, {-4, 1}}, 3, 3);
+  ComplexMatrixCRS in2 = toCRS({{0, 0}, {2, -1}, {0, 0}, {0, 0}, {0, 0}, {-5, 2}, {0, 0}, {2, 1}, {0, 0}}, 3, 3);
+  ComplexMatrixCRS out;
+  std::vector<Complex> test{{0, 0}, {8, 1}, {0, 0}, {0, 0}, {0, 0}, {1, 17}, {0, 0}, {-9, -2}, {0, 0}};
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataParallel = std::make_shared<ppc::core::TaskData>();
+  taskDataParallel->inputs.emplace_back(reinterpret_cast<uint8_t *>(&in1));
+  taskDataParallel->inputs_count.emplace_back(3);
+  taskDataParallel->inputs_count.emplace_back(3);
+  taskDataParallel->inputs.emplace_back(reinterpret_cast<uint8_t *>(&in2));
+  taskDataParallel->inputs_count.emplace_back(3);
+  taskDataParallel->inputs_count.emplace_back(3);
+  taskDataParallel->outputs.emplace_back(reinterpret_cast<uint8_t *>(&out));
+
+  // Create Task
+  SparseMatrixComplexMultiCRSOmp sparseMatrixComplexMultiCRSOmp(taskDataParallel);
+  ASSERT_TRUE(sparseMatrixComplexMultiCRSOmp.validation());
+  ASSERT_TRUE(sparseMatrixComplexMultiCRSOmp.pre_processing());
+  ASSERT_TRUE(sparseMatrixComplexMultiCRSOmp.run());
+  ASSERT_TRUE(sparseMatrixComplexMultiCRSOmp.post_processing());
+  ASSERT_EQ(out.values.size(), 3u);
+  expectDense(out, test);
+}
+
+TEST(ionova_e_sparse_matr_multi_crs_complex_omp, crs_input_keeps_cancelled_products) {
+  // Create data
+  ComplexMatrixCRS in1 = toCRS({{1, 0}, {0, 1}, {0, 0}, {2, 0}}, 2, 2);
+  ComplexMatrixCRS in2 = toCRS({{0, 1}, {3, 0}, {-1, 0}, {0, 0}}, 2, 2);
+  ComplexMatrixCRS out;
+  std::vector<Complex> test{{0, 0}, {3, 0}, {-2, 0}, {0, 0}};
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataParallel = std::make_shared<ppc::core::TaskData>();
+  taskDataParallel->inputs.emplace_back(reinterpret_cast<uint8_t *>(&in1));
+  taskDataParallel->inputs_count.emplace_back(2);
+  taskDataParallel->inputs_count.emplace_back(2);
+  taskDataParallel->inputs.emplace_back(reinterpret_cast<uint8_t *>(&in2));
+  taskDataParallel->inputs_count.emplace_back(2);
+  taskDataParallel->inputs_count.emplace_back(2);
+  taskDataParallel->outputs.emplace_back(reinterpret_cast<uint8_t *>(&out));
+
+  // Create Task
+  SparseMatrixComplexMultiCRSOmp sparseMatrixComplexMultiCRSOmp(taskDataParallel);
+  ASSERT_TRUE(sparseMatrixComplexMultiCRSOmp.validation());
+  ASSERT_TRUE(sparseMatrixComplexMultiCRSOmp.pre_processing());
+  ASSERT_TRUE(sparseMatrixComplexMultiCRSOmp.run());
+  ASSERT_TRUE(sparseMatrixComplexMultiCRSOmp.post_processing());
+  ASSERT_EQ(out.rowPtr, std::vector<int>({0, 2, 3}));
+  expectDense(out, test);
+}
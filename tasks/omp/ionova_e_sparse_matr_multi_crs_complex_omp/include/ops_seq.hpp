@@ -10,6 +10,20 @@ struct Complex {
   double imag;
 };
 
+// Matrix in compressed rows: rowPtr has numRows + 1 entries and the columns of row i are
+// colPtr[rowPtr[i]], ..., colPtr[rowPtr[i + 1] - 1] in increasing order.
+struct ComplexMatrixCRS {
+  std::vector<Complex> values;
+  std::vector<int> rowPtr;
+  std::vector<int> colPtr;
+  int numRows{};
+  int numCols{};
+};
+
+// C = A * B without dense buffers: the rows of C are counted first and then written at their final offsets, so C keeps
+// every structural nonzero, including products that cancel.
+ComplexMatrixCRS MultiplyComplexCRS(const ComplexMatrixCRS& a, const ComplexMatrixCRS& b);
+
 class SparseMatrixComplexMultiSequentialOmp : public ppc::core::Task {
  public:
   explicit SparseMatrixComplexMultiSequentialOmp(std::shared_ptr<ppc::core::TaskData> taskData_)
@@ -61,3 +75,21 @@ class SparseMatrixComplexMultiParallelOmp : public ppc::core::Task {
   std::vector<int> colPtr3{};
   Complex* result{};
 };
+
+// Same multiplication on compressed input: inputs[0] and inputs[1] point to the ComplexMatrixCRS of A (n1 x m1) and
+// B (m1 x m2), inputs_count is {n1, m1, m1, m2}, outputs[0] points to the ComplexMatrixCRS receiving C.
+class SparseMatrixComplexMultiCRSOmp : public ppc::core::Task {
+ public:
+  explicit SparseMatrixComplexMultiCRSOmp(std::shared_ptr<ppc::core::TaskData> taskData_)
+      : Task(std::move(taskData_)) {}
+  bool pre_processing() override;
+  bool validation() override;
+  bool run() override;
+  bool post_processing() override;
+
+ private:
+  const ComplexMatrixCRS* a{};
+  const ComplexMatrixCRS* b{};
+  ComplexMatrixCRS c;
+  ComplexMatrixCRS* out{};
+};
@@ -190,6 +190,45 @@ TEST(kazantsev_e_matmul_strassen_omp, multSecShtrassenOmp_64x64) {
   }
 }
 
+TEST(kazantsev_e_matmul_strassen_omp, multSecShtrassenOmp_129x129) {
+  const int n = 129;
+
+  // Create data
+  std::vector<double> A = getRandomMatrix(n);
+  std::vector<double> B = getRandomMatrix(n);
+  std::vector<double> out(n * n);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(A.data()));
+  taskDataSeq->inputs_count.emplace_back(A.size());
+
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(B.data()));
+  taskDataSeq->inputs_count.emplace_back(B.size());
+
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(const_cast<int *>(&n)));
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(const_cast<int *>(&n)));
+  // three levels of Strassen under the peeled 128 x 128 block instead of the tuned leaf
+  int leaf = 16;
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(&leaf));
+
+  taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskDataSeq->outputs_count.emplace_back(out.size());
+
+  std::vector<double> res = multMatrixNoShtrassen(A, B, n);
+
+  // Create Task
+  MatMulStrassenSec MatMulStrassenSec(taskDataSeq);
+  ASSERT_EQ(MatMulStrassenSec.validation(), true);
+  MatMulStrassenSec.pre_processing();
+  MatMulStrassenSec.run();
+  MatMulStrassenSec.post_processing();
+
+  for (size_t i = 0; i < res.size(); ++i) {
+    ASSERT_NEAR(res[i], out[i], 1e-6);
+  }
+}
+
 TEST(kazantsev_e_matmul_strassen_omp, multSecShtrassenOmp_size) {
   const int n = 64;
 
@@ -222,4 +261,56 @@ TEST(kazantsev_e_matmul_strassen_omp, multSecShtrassenOmp_size) {
   MatMulStrassenSec.post_processing();
 
   ASSERT_EQ(res.size(), out.size());
-}
\ No newline at end of file
+}
+
+TEST(kazantsev_e_matmul_strassen_omp, multSecShtrassenOmp_rectangular) {
+  // every dimension odd at some level of the recursion
+  const int m = 301;
+  const int k = 150;
+  const int n = 203;
+
+  std::vector<double> A(m * k);
+  std::vector<double> B(k * n);
+  for (int i = 0; i < m * k; i++) {
+    A[i] = i % 7 - 3;
+  }
+  for (int i = 0; i < k * n; i++) {
+    B[i] = i % 5 - 2;
+  }
+
+  std::vector<double> res(m * n, 0.0);
+  for (int i = 0; i < m; i++) {
+    for (int p = 0; p < k; p++) {
+      for (int j = 0; j < n; j++) {
+        res[i * n + j] += A[i * k + p] * B[p * n + j];
+      }
+    }
+  }
+
+  // small integers stay exact through all the additions
+  ASSERT_EQ(res, StrassenMatMul(A, B, m, k, n));
+  ASSERT_EQ(res, StrassenMatMul(A, B, m, k, n, 16));
+}
+
+TEST(kazantsev_e_matmul_strassen_omp, multSecShtrassenOmp_wrong_leaf) {
+  const int n = 4;
+  int leaf = 0;
+
+  std::vector<double> A = getRandomMatrix(n);
+  std::vector<double> B = getRandomMatrix(n);
+  std::vector<double> out(n * n);
+
+  std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(A.data()));
+  taskDataSeq->inputs_count.emplace_back(A.size());
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(B.data()));
+  taskDataSeq->inputs_count.emplace_back(B.size());
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(const_cast<int *>(&n)));
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(const_cast<int *>(&n)));
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(&leaf));
+  taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskDataSeq->outputs_count.emplace_back(out.size());
+
+  MatMulStrassenSec MatMulStrassenSec(taskDataSeq);
+  ASSERT_FALSE(MatMulStrassenSec.validation());
+}
@@ -5,6 +5,7 @@
 #include <string>
 #include <vector>
 
+#include "core/gemm/include/strassen.hpp"
 #include "core/task/include/task.hpp"
 
 class MatMulStrassenSec : public ppc::core::Task {
@@ -20,6 +21,10 @@ class MatMulStrassenSec : public ppc::core::Task {
   std::vector<double> B;
   std::vector<double> result;
   int n = 0, m = 0;
+  // operand sums and products of the levels run as tasks, then one leaf workspace per thread
+  std::vector<double> work;
+  ppc::core::StrassenTuning tuning{};
+  int levels = 0;
 };
 
 inline std::vector<double> getRandomMatrix(int n) {
@@ -38,4 +43,8 @@ inline std::vector<double> getRandomMatrix(int n) {
   return matrix;
 }
 
-std::vector<double> multMatrixNoShtrassen(const std::vector<double>& A, const std::vector<double>& B, int n);
\ No newline at end of file
+std::vector<double> multMatrixNoShtrassen(const std::vector<double>& A, const std::vector<double>& B, int n);
+// C = A * B for an m x k matrix A and a k x n matrix B of any sizes, both row-major, on the calling thread; blocks
+// with a side of at most leaf go to the packed kernel.
+std::vector<double> StrassenMatMul(const std::vector<double>& a, const std::vector<double>& b, int m, int k, int n,
+                                   int leaf = ppc::core::STRASSEN_CUTOFF);
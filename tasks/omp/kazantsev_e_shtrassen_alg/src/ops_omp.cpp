@@ -5,10 +5,10 @@
 
 #include <algorithm>
 #include <cmath>
-#include <thread>
 #include <vector>
 
-using namespace std::chrono_literals;
+#include "core/gemm/include/gemm.hpp"
+#include "core/gemm/include/strassen.hpp"
 
 std::vector<double> multMatrixNoShtrassen(const std::vector<double>& A, const std::vector<double>& B, int n) {
   std::vector<double> C(n * n, 0.0);
@@ -27,60 +27,38 @@ std::vector<double> multMatrixNoShtrassen(const std::vector<double>& A, const st
   return C;
 }
 
-// For pre_processing
-int log2(int n) {
-  int res = 1;
-  while ((n >>= 1) != 0) res++;
-  return res;
-}
-
-int getNewDimention(std::vector<double>& a) {
-  int n = std::sqrt(a.size());
-  if (n > 0 && (n & (n - 1)) == 0) {
-    return n;
-  }
-  return 1 << log2(n);
-}
-
-// add column and rows if not enough
-std::vector<double> additionSquareMatrix(std::vector<double>& a, int n) {
-  std::vector<double> res(n * n, 0.0);
-  int size = std::sqrt(a.size());
-
-  for (int i = 0; i < size; i++) {
-    for (int j = 0; j < size; j++) {
-      res[i * size + j] = a[i * size + j];
-    }
+// rows x cols block of a matrix with rows of length ld, starting at (row, col)
+std::vector<double> subMatrix(const std::vector<double>& a, int ld, int row, int col, int rows, int cols) {
+  std::vector<double> res(rows * cols);
+  for (int i = 0; i < rows; i++) {
+    std::copy(a.begin() + (row + i) * ld + col, a.begin() + (row + i) * ld + col + cols, res.begin() + i * cols);
   }
   return res;
 }
 
-// divide into four parts
-void splitMatrix(const std::vector<double>& mSplit, std::vector<double>& a11, std::vector<double>& a12,
-                 std::vector<double>& a21, std::vector<double>& a22) {
-  int n = std::sqrt(mSplit.size()) / 2;
-
-  for (int i = 0; i < n; i++) {
-    std::copy(mSplit.begin() + (2 * i) * n, mSplit.begin() + (2 * i + 1) * n, a11.begin() + i * n);
-    std::copy(mSplit.begin() + (2 * i + 1) * n, mSplit.begin() + (2 * i + 2) * n, a12.begin() + i * n);
-    std::copy(mSplit.begin() + ((n * n * 2) + (2 * i * n)), mSplit.begin() + ((n * n * 2) + ((2 * i + 1) * n)),
-              a21.begin() + i * n);
-    std::copy(mSplit.begin() + ((n * n * 2) + ((2 * i + 1) * n)), mSplit.begin() + ((n * n * 2) + ((2 * i + 2) * n)),
-              a22.begin() + i * n);
-  }
+// divide a rows x cols matrix into four parts
+void splitMatrix(const std::vector<double>& mSplit, int rows, int cols, std::vector<double>& a11,
+                 std::vector<double>& a12, std::vector<double>& a21, std::vector<double>& a22) {
+  int r = rows / 2;
+  int c = cols / 2;
+  a11 = subMatrix(mSplit, cols, 0, 0, r, c);
+  a12 = subMatrix(mSplit, cols, 0, c, r, c);
+  a21 = subMatrix(mSplit, cols, r, 0, r, c);
+  a22 = subMatrix(mSplit, cols, r, c, r, c);
 }
 
-std::vector<double> mergeMatrix(std::vector<double> a11, std::vector<double> a12, std::vector<double> a21,
-                                std::vector<double> a22) {
-  int n = a11.size();
-  std::vector<double> res(4 * n, 0.0);
-  n = std::sqrt(n);
-
-  for (int i = 0; i < n; i++) {
-    std::copy(a11.begin() + i * n, a11.begin() + (i + 1) * n, res.begin() + (2 * i * n));
-    std::copy(a12.begin() + i * n, a12.begin() + (i + 1) * n, res.begin() + (2 * i + 1) * n);
-    std::copy(a21.begin() + i * n, a21.begin() + (i + 1) * n, res.begin() + ((n * n * 2) + (2 * i * n)));
-    std::copy(a22.begin() + i * n, a22.begin() + (i + 1) * n, res.begin() + ((n * n * 2) + ((2 * i + 1) * n)));
+// assemble a rows x cols matrix from four parts
+std::vector<double> mergeMatrix(const std::vector<double>& a11, const std::vector<double>& a12,
+                                const std::vector<double>& a21, const std::vector<double>& a22, int rows, int cols) {
+  int r = rows / 2;
+  int c = cols / 2;
+  std::vector<double> res(rows * cols);
+
+  for (int i = 0; i < r; i++) {
+    std::copy(a11.begin() + i * c, a11.begin() + (i + 1) * c, res.begin() + i * cols);
+    std::copy(a12.begin() + i * c, a12.begin() + (i + 1) * c, res.begin() + i * cols + c);
+    std::copy(a21.begin() + i * c, a21.begin() + (i + 1) * c, res.begin() + (r + i) * cols);
+    std::copy(a22.begin() + i * c, a22.begin() + (i + 1) * c, res.begin() + (r + i) * cols + c);
   }
   return res;
 }
@@ -107,28 +85,60 @@ std::vector<double> subtraction(const std::vector<double>& a, const std::vector<
   return res;
 }
 
-// Algorithm Strassen's
-std::vector<double> StrassenMatMul(const std::vector<double>& a, const std::vector<double>& b, int n) {
-  int size = n;
+// Odd dimensions are peeled instead of padding the matrices: Strassen runs on the even top-left part and the last
+// row, the last column and the rank-1 term of the last inner index are added by the packed kernel, all O(n^2) work.
+std::vector<double> peelOdd(const std::vector<double>& a, const std::vector<double>& b, int m, int k, int n,
+                            int leaf) {
+  int mEven = m - m % 2;
+  int kEven = k - k % 2;
+  int nEven = n - n % 2;
+  std::vector<double> c(m * n, 0.0);
+
+  std::vector<double> even = StrassenMatMul(subMatrix(a, k, 0, 0, mEven, kEven), subMatrix(b, n, 0, 0, kEven, nEven),
+                                            mEven, kEven, nEven, leaf);
+  for (int i = 0; i < mEven; i++) {
+    std::copy(even.begin() + i * nEven, even.begin() + (i + 1) * nEven, c.begin() + i * n);
+  }
+  if (kEven != k) {
+    ppc::core::Gemm(mEven, nEven, 1, a.data() + kEven, k, b.data() + kEven * n, n, c.data(), n);
+  }
+  if (nEven != n) {
+    ppc::core::Gemm(mEven, 1, k, a.data(), k, b.data() + nEven, n, c.data() + nEven, n);
+  }
+  if (mEven != m) {
+    ppc::core::Gemm(1, n, k, a.data() + mEven * k, k, b.data(), n, c.data() + mEven * n, n);
+  }
+  return c;
+}
 
-  if (size <= 2) {
-    return multMatrixNoShtrassen(a, b, size);
+// Algorithm Strassen's, sequential
+std::vector<double> StrassenMatMul(const std::vector<double>& a, const std::vector<double>& b, int m, int k, int n,
+                                   int leaf) {
+  if (m <= leaf || k <= leaf || n <= leaf) {
+    std::vector<double> c(m * n, 0.0);
+    ppc::core::Gemm(m, n, k, a.data(), k, b.data(), n, c.data(), n);
+    return c;
+  }
+  if (m % 2 != 0 || k % 2 != 0 || n % 2 != 0) {
+    return peelOdd(a, b, m, k, n, leaf);
   }
 
-  size = size / 2;
+  std::vector<double> a11;
+  std::vector<double> a12;
+  std::vector<double> a21;
+  std::vector<double> a22;
 
-  std::vector<double> a11(size * size);
-  std::vector<double> a12(size * size);
-  std::vector<double> a21(size * size);
-  std::vector<double> a22(size * size);
+  std::vector<double> b11;
+  std::vector<double> b12;
+  std::vector<double> b21;
+  std::vector<double> b22;
 
-  std::vector<double> b11(size * size);
-  std::vector<double> b12(size * size);
-  std::vector<double> b21(size * size);
-  std::vector<double> b22(size * size);
+  splitMatrix(a, m, k, a11, a12, a21, a22);
+  splitMatrix(b, k, n, b11, b12, b21, b22);
 
-  splitMatrix(a, a11, a12, a21, a22);
-  splitMatrix(b, b11, b12, b21, b22);
+  int mh = m / 2;
+  int kh = k / 2;
+  int nh = n / 2;
 
   std::vector<double> p1;
   std::vector<double> p2;
@@ -138,39 +148,96 @@ std::vector<double> StrassenMatMul(const std::vector<double>& a, const std::vect
   std::vector<double> p6;
   std::vector<double> p7;
 
-#pragma omp parallel sections shared(p1, p2, p3, p4, p5, p6, p7)
-  {
-#pragma omp section
-    p1 = StrassenMatMul(summation(a11, a22), summation(b11, b22), size);
-#pragma omp section
-    p2 = StrassenMatMul(summation(a21, a22), b11, size);
-#pragma omp section
-    p3 = StrassenMatMul(a11, subtraction(b12, b22), size);
-#pragma omp section
-    p4 = StrassenMatMul(a22, subtraction(b21, b11), size);
-#pragma omp section
-    p5 = StrassenMatMul(summation(a11, a12), b22, size);
-#pragma omp section
-    p6 = StrassenMatMul(subtraction(a21, a11), summation(b11, b12), size);
-#pragma omp section
-    p7 = StrassenMatMul(subtraction(a12, a22), summation(b21, b22), size);
-  }
+  p1 = StrassenMatMul(summation(a11, a22), summation(b11, b22), mh, kh, nh, leaf);
+  p2 = StrassenMatMul(summation(a21, a22), b11, mh, kh, nh, leaf);
+  p3 = StrassenMatMul(a11, subtraction(b12, b22), mh, kh, nh, leaf);
+  p4 = StrassenMatMul(a22, subtraction(b21, b11), mh, kh, nh, leaf);
+  p5 = StrassenMatMul(summation(a11, a12), b22, mh, kh, nh, leaf);
+  p6 = StrassenMatMul(subtraction(a21, a11), summation(b11, b12), mh, kh, nh, leaf);
+  p7 = StrassenMatMul(subtraction(a12, a22), summation(b21, b22), mh, kh, nh, leaf);
 
   std::vector<double> c11 = summation(summation(p1, p4), subtraction(p7, p5));
   std::vector<double> c12 = summation(p3, p5);
   std::vector<double> c21 = summation(p2, p4);
   std::vector<double> c22 = summation(subtraction(p1, p2), summation(p3, p6));
-  return mergeMatrix(c11, c12, c21, c22);
+  return mergeMatrix(c11, c12, c21, c22, m, n);
 }
 
+namespace {
+// Square products of the task: the seven products of a level are tasks on the first levels only, until there are
+// two of them per thread; deeper blocks are multiplied by the thread that took them, in its own slot of the workspace.
+int parallelLevels(int threads) {
+  int levels = 0;
+  for (int tasks = 1; tasks < 2 * threads; tasks *= 7) {
+    levels++;
+  }
+  return levels;
+}
+
+bool isSequential(int n, int levels, ppc::core::StrassenTuning tuning) {
+  return levels == 0 || n <= tuning.cutoff || n % 2 != 0;
+}
+
+size_t levelsWorkspace(int n, int levels, ppc::core::StrassenTuning tuning) {
+  if (isSequential(n, levels, tuning)) {
+    return 0;
+  }
+  size_t nh = n / 2;
+  return ppc::core::StrassenSplitWorkspace(n) + 7 * nh * nh + 7 * levelsWorkspace(n / 2, levels - 1, tuning);
+}
+
+size_t leafWorkspace(int n, int levels, ppc::core::StrassenTuning tuning) {
+  if (isSequential(n, levels, tuning)) {
+    return ppc::core::StrassenWorkspace(n, tuning.cutoff);
+  }
+  return leafWorkspace(n / 2, levels - 1, tuning);
+}
+
+void strassenLevels(int n, const double* a, int lda, const double* b, int ldb, double* c, int ldc, double* work,
+                    double* leaves, size_t leafSize, int levels, ppc::core::StrassenTuning tuning) {
+  if (isSequential(n, levels, tuning)) {
+    ppc::core::Strassen(n, a, lda, b, ldb, c, ldc, leaves + omp_get_thread_num() * leafSize, tuning.cutoff,
+                        tuning.variant);
+    return;
+  }
+  int nh = n / 2;
+  size_t block = static_cast<size_t>(nh) * nh;
+  size_t child = levelsWorkspace(nh, levels - 1, tuning);
+  ppc::core::StrassenProduct p[7];
+  ppc::core::StrassenSplit(n, a, lda, b, ldb, work, p, tuning.variant);
+  double* products = work + ppc::core::StrassenSplitWorkspace(n);
+  double* rest = products + 7 * block;
+  for (int i = 0; i < 7; i++) {
+#pragma omp task
+    strassenLevels(nh, p[i].A, p[i].lda, p[i].B, p[i].ldb, products + i * block, nh, rest + i * child, leaves,
+                   leafSize, levels - 1, tuning);
+  }
+#pragma omp taskwait
+  ppc::core::StrassenMerge(n, products, c, ldc, tuning.variant);
+}
+}  // namespace
+
 bool MatMulStrassenSec::pre_processing() {
   internal_order_test();
+  // smaller blocks go to the packed kernel: the extra additions and copies do not pay off there; where that happens
+  // depends on the host, so it is measured here rather than inside the timed run. An optional fifth input fixes the
+  // leaf instead, so that a small matrix still goes through several levels of the recursion.
+  int threads = omp_get_max_threads();
+  if (taskData->inputs.size() > 4) {
+    tuning = {*reinterpret_cast<int*>(taskData->inputs[4]), ppc::core::StrassenVariant::Strassen};
+  } else {
+    tuning = ppc::core::TuneStrassen(threads);
+  }
+  levels = parallelLevels(threads);
   // Init value for input and output
   A = std::vector<double>(taskData->inputs_count[0]);
   B = std::vector<double>(taskData->inputs_count[1]);
 
   n = *reinterpret_cast<int*>(taskData->inputs[2]);
   m = *reinterpret_cast<int*>(taskData->inputs[3]);
+  int even = n - n % 2;
+  result = std::vector<double>(n * n);
+  work = std::vector<double>(levelsWorkspace(even, levels, tuning) + threads * leafWorkspace(even, levels, tuning));
 
   auto* tmp_ptr_A = reinterpret_cast<double*>(taskData->inputs[0]);
   for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
@@ -188,15 +255,31 @@ bool MatMulStrassenSec::validation() {
   internal_order_test();
   // Check count elements of output
   if (taskData->inputs_count[0] != taskData->inputs_count[1]) return false;
-  if (taskData->inputs_count[0] % 2 != 0) return false;
-  if (taskData->inputs_count[1] % 2 != 0) return false;
-  return true;
+  // any square size works, odd ones included
+  auto size = static_cast<unsigned>(std::lround(std::sqrt(taskData->inputs_count[0])));
+  if (size * size != taskData->inputs_count[0]) return false;
+  if (taskData->inputs.size() > 4 && *reinterpret_cast<int*>(taskData->inputs[4]) < 1) return false;
+  return taskData->outputs_count[0] == taskData->inputs_count[0];
 }
 
 bool MatMulStrassenSec::run() {
   internal_order_test();
-  n = getNewDimention(A);
-  result = StrassenMatMul(A, B, n);
+  // odd n is peeled as in StrassenMatMul, but in place: the even top-left block is multiplied on views of A, B and
+  // result, and the packed kernel adds the rank-1 term, the last column and the last row
+  int even = n - n % 2;
+  double* leaves = work.data() + levelsWorkspace(even, levels, tuning);
+  size_t leafSize = leafWorkspace(even, levels, tuning);
+  std::fill(result.begin(), result.end(), 0.0);
+  if (even > 0) {
+#pragma omp parallel
+#pragma omp single
+    strassenLevels(even, A.data(), n, B.data(), n, result.data(), n, work.data(), leaves, leafSize, levels, tuning);
+  }
+  if (even != n) {
+    ppc::core::Gemm(even, even, 1, A.data() + even, n, B.data() + even * n, n, result.data(), n);
+    ppc::core::Gemm(even, 1, n, A.data(), n, B.data() + even, n, result.data() + even, n);
+    ppc::core::Gemm(1, n, n, A.data() + even * n, n, B.data(), n, result.data() + even * n, n);
+  }
   return true;
 }
 
@@ -17,16 +17,19 @@ class StrassenMatrixMultParallelOMP : public ppc::core::Task {
 
  private:
   std::vector<double> A, B, C;
+  // scratch space of the whole recursion, sized once in pre_processing
+  std::vector<double> work;
   int n = 0;
 };
 
+// Elements of workspace the view version of strassen needs for an n x n product, in the element type of the product.
+size_t strassenWorkspace(int n);
+// C = A * B for n x n row-major views with row strides lda, ldb and ldc, all temporaries taken from work. The cutoff
+// and the variant are the ones measured for this host and the current number of threads.
+void strassen(int n, const double* A, int lda, const double* B, int ldb, double* C, int ldc, double* work);
 std::vector<double> strassen(const std::vector<double>& A, const std::vector<double>& B, int n);
-std::vector<double> add(const std::vector<double>& A, const std::vector<double>& B);
-std::vector<double> sub(const std::vector<double>& A, const std::vector<double>& B);
+// Single precision with the cutoff and variant measured for double.
+std::vector<float> strassen(const std::vector<float>& A, const std::vector<float>& B, int n);
 std::vector<double> mul(const std::vector<double>& A, const std::vector<double>& B, int n);
-void splitMatrix(const std::vector<double>& A, std::vector<double>& A11, std::vector<double>& A12,
-                 std::vector<double>& A21, std::vector<double>& A22);
-std::vector<double> joinMatrices(const std::vector<double>& A11, const std::vector<double>& A12,
-                                 const std::vector<double>& A21, const std::vector<double>& A22, int n);
 std::vector<double> generateRandomMatrix(int n);
 }  // namespace kirillov_omp
@@ -9,7 +9,7 @@
 using namespace kirillov_omp;
 
 TEST(kirillov_m_strassen_omp_perf_tests, test_pipeline_run) {
-  const int n = 128;
+  const int n = 512;
 
   // Create data
   std::vector<double> A = generateRandomMatrix(n);
@@ -51,7 +51,7 @@ TEST(kirillov_m_strassen_omp_perf_tests, test_pipeline_run) {
 }
 
 TEST(kirillov_m_strassen_omp_perf_tests, test_task_run) {
-  const int n = 128;
+  const int n = 512;
 
   // Create data
   std::vector<double> A = generateRandomMatrix(n);
@@ -5,11 +5,15 @@
 #include <vector>
 
 #include "core/task/include/task.hpp"
+#include "omp/kostin_a_sle_conjugate_gradient/include/precond.hpp"
 
 namespace KostinArtemOMP {
 class ConjugateGradientMethodOMP : public ppc::core::Task {
  public:
-  explicit ConjugateGradientMethodOMP(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+  // with a preconditioner other than None, A is converted to CSR and solved by preconditioned CG
+  explicit ConjugateGradientMethodOMP(std::shared_ptr<ppc::core::TaskData> taskData_,
+                                      PreconditionerKind preconditioner_ = PreconditionerKind::None)
+      : Task(std::move(taskData_)), preconditioner(preconditioner_) {}
   bool pre_processing() override;
   bool validation() override;
   bool run() override;
@@ -20,6 +24,31 @@ class ConjugateGradientMethodOMP : public ppc::core::Task {
   int size = 0;
   std::vector<double> b;
   std::vector<double> x;
+  PreconditionerKind preconditioner;
+  CsrMatrix csr;
+};
+
+// The same solve for a matrix given in CSR: inputs are row_ptr (n + 1 ints), col and val (nnz ints and doubles) and
+// b (n doubles), the output is x. Nothing of size n^2 is stored, so systems of millions of unknowns fit in memory.
+class SparseConjugateGradientMethodOMP : public ppc::core::Task {
+ public:
+  explicit SparseConjugateGradientMethodOMP(std::shared_ptr<ppc::core::TaskData> taskData_,
+                                            PreconditionerKind preconditioner_ = PreconditionerKind::None,
+                                            double tolerance_ = 1e-6)
+      : Task(std::move(taskData_)), preconditioner(preconditioner_), tolerance(tolerance_) {}
+  bool pre_processing() override;
+  bool validation() override;
+  bool run() override;
+  bool post_processing() override;
+  int iterations() const { return result.iterations; }
+
+ private:
+  // views of the input buffers, which outlive the task
+  CsrView A;
+  std::vector<double> b;
+  PreconditionerKind preconditioner;
+  double tolerance;
+  CgResult result;
 };
 
 std::vector<double> generateSPDMatrix(int size, int max_value);
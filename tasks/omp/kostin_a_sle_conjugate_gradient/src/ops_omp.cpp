@@ -2,6 +2,7 @@
 #include "omp/kostin_a_sle_conjugate_gradient/include/ops_omp.hpp"
 
 #include <random>
+#include <stdexcept>
 #include <thread>
 
 using namespace std::chrono_literals;
@@ -121,6 +122,9 @@ bool ConjugateGradientMethodOMP::pre_processing() {
 
   size = *reinterpret_cast<int*>(taskData->inputs[2]);
   x = std::vector<double>(size, 0);
+  if (preconditioner != PreconditionerKind::None) {
+    csr = dense_to_csr(A, size);
+  }
   return true;
 }
 
@@ -133,7 +137,18 @@ bool ConjugateGradientMethodOMP::validation() {
 
 bool ConjugateGradientMethodOMP::run() {
   internal_order_test();
-  x = conjugate_gradient(A, size, b, 1e-6);
+  if (preconditioner == PreconditionerKind::None) {
+    x = conjugate_gradient(A, size, b, 1e-6);
+  } else {
+    // setup of the preconditioner is part of the solve, as it is part of the time to reach the tolerance
+    // a non-positive diagonal entry makes the preconditioner setup throw: the matrix is not positive definite
+    try {
+      auto M = make_preconditioner(preconditioner, csr);
+      x = preconditioned_conjugate_gradient(csr, b, *M, 1e-6).x;
+    } catch (const std::invalid_argument&) {
+      return false;
+    }
+  }
   return true;
 }
 
@@ -144,4 +159,42 @@ bool ConjugateGradientMethodOMP::post_processing() {
   }
   return true;
 }
+
+bool SparseConjugateGradientMethodOMP::pre_processing() {
+  internal_order_test();
+  int n = static_cast<int>(taskData->inputs_count[3]);
+  A = CsrView(n, reinterpret_cast<int*>(taskData->inputs[0]), reinterpret_cast<int*>(taskData->inputs[1]),
+              reinterpret_cast<double*>(taskData->inputs[2]));
+  b.assign(reinterpret_cast<double*>(taskData->inputs[3]), reinterpret_cast<double*>(taskData->inputs[3]) + n);
+  return true;
+}
+
+bool SparseConjugateGradientMethodOMP::validation() {
+  internal_order_test();
+  if (taskData->inputs.size() != 4 || taskData->inputs_count.size() != 4 || taskData->outputs.size() != 1 ||
+      taskData->outputs_count.size() != 1 || taskData->inputs_count[0] != taskData->inputs_count[3] + 1 ||
+      taskData->inputs_count[1] != taskData->inputs_count[2] ||
+      taskData->outputs_count[0] != taskData->inputs_count[3]) {
+    return false;
+  }
+  const int* row_ptr = reinterpret_cast<int*>(taskData->inputs[0]);
+  return row_ptr[0] == 0 && row_ptr[taskData->inputs_count[3]] == static_cast<int>(taskData->inputs_count[1]);
+}
+
+bool SparseConjugateGradientMethodOMP::run() {
+  internal_order_test();
+  try {
+    auto M = make_preconditioner(preconditioner, A);
+    result = preconditioned_conjugate_gradient(A, b, *M, tolerance);
+  } catch (const std::invalid_argument&) {
+    return false;
+  }
+  return result.residual < tolerance;
+}
+
+bool SparseConjugateGradientMethodOMP::post_processing() {
+  internal_order_test();
+  std::copy(result.x.begin(), result.x.end(), reinterpret_cast<double*>(taskData->outputs[0]));
+  return true;
+}
 }  // namespace KostinArtemOMP
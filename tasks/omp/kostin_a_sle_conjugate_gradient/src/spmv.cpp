@@ -0,0 +1,217 @@
+// Copyright 2024 Kostin Artem
+#include "omp/kostin_a_sle_conjugate_gradient/include/spmv.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace KostinArtemOMP {
+CsrMatrix dense_to_csr(const std::vector<double>& A, int n) {
+  CsrMatrix csr;
+  csr.n = n;
+  csr.row_ptr.assign(n + 1, 0);
+#pragma omp parallel for
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      if (A[i * n + j] != 0.0) {
+        csr.row_ptr[i + 1]++;
+      }
+    }
+  }
+  for (int i = 0; i < n; i++) {
+    csr.row_ptr[i + 1] += csr.row_ptr[i];
+  }
+  csr.col.resize(csr.row_ptr[n]);
+  csr.val.resize(csr.row_ptr[n]);
+#pragma omp parallel for
+  for (int i = 0; i < n; i++) {
+    int pos = csr.row_ptr[i];
+    for (int j = 0; j < n; j++) {
+      if (A[i * n + j] != 0.0) {
+        csr.col[pos] = j;
+        csr.val[pos++] = A[i * n + j];
+      }
+    }
+  }
+  return csr;
+}
+
+SellMatrix csr_to_sell(CsrView A, int sigma) {
+  const int C = SellMatrix::C;
+  SellMatrix sell;
+  sell.n = A.n;
+  sell.sigma = sigma;
+  int slices = (A.n + C - 1) / C;
+  sell.perm.resize(A.n);
+  for (int i = 0; i < A.n; i++) {
+    sell.perm[i] = i;
+  }
+  auto length = [&](int row) { return A.row_ptr[row + 1] - A.row_ptr[row]; };
+  // longest rows first inside every window keeps the padding of the slices small
+  int windows = (A.n + sigma - 1) / sigma;
+#pragma omp parallel for
+  for (int w = 0; w < windows; w++) {
+    auto first = sell.perm.begin() + w * sigma;
+    auto last = sell.perm.begin() + std::min(A.n, (w + 1) * sigma);
+    std::stable_sort(first, last, [&](int a, int b) { return length(a) > length(b); });
+  }
+
+  sell.slice_ptr.assign(slices + 1, 0);
+  for (int s = 0; s < slices; s++) {
+    int width = 0;
+    for (int r = s * C; r < std::min(A.n, (s + 1) * C); r++) {
+      width = std::max(width, length(sell.perm[r]));
+    }
+    sell.slice_ptr[s + 1] = sell.slice_ptr[s] + width * C;
+  }
+  sell.row_len.assign(slices * C, 0);
+  sell.col.assign(sell.slice_ptr[slices], 0);
+  sell.val.assign(sell.slice_ptr[slices], 0.0);
+#pragma omp parallel for
+  for (int s = 0; s < slices; s++) {
+    for (int r = 0; r < C && s * C + r < A.n; r++) {
+      int row = sell.perm[s * C + r];
+      sell.row_len[s * C + r] = length(row);
+      for (int j = 0; j < length(row); j++) {
+        sell.col[sell.slice_ptr[s] + j * C + r] = A.col[A.row_ptr[row] + j];
+        sell.val[sell.slice_ptr[s] + j * C + r] = A.val[A.row_ptr[row] + j];
+      }
+      // the zeros of the padding sit at the last column of the row, which it reads anyway
+      int last = length(row) > 0 ? A.col[A.row_ptr[row + 1] - 1] : 0;
+      for (int j = length(row); j < (sell.slice_ptr[s + 1] - sell.slice_ptr[s]) / C; j++) {
+        sell.col[sell.slice_ptr[s] + j * C + r] = last;
+      }
+    }
+  }
+  return sell;
+}
+
+Csr5Matrix csr_to_csr5(CsrView A) {
+  const int OMEGA = Csr5Matrix::OMEGA;
+  const int SIGMA = Csr5Matrix::SIGMA;
+  const int TILE = OMEGA * SIGMA;
+  Csr5Matrix csr5;
+  csr5.n = A.n;
+  int nnz = A.row_ptr[A.n];
+  int full_tiles = nnz / TILE;
+  int tail = nnz - full_tiles * TILE;
+  csr5.tiles = full_tiles + (tail > 0 ? 1 : 0);
+  std::vector<int> row_begin;
+  for (int i = 0; i < A.n; i++) {
+    if (A.row_ptr[i] < A.row_ptr[i + 1]) {
+      csr5.nonempty_rows.push_back(i);
+      row_begin.push_back(A.row_ptr[i]);
+    }
+  }
+
+  csr5.col.resize(nnz);
+  csr5.val.resize(nnz);
+  csr5.row_start.assign(nnz, 0);
+  csr5.lane_row.resize(full_tiles * OMEGA + (tail > 0 ? 1 : 0));
+  auto row_of = [&](int e) {
+    return static_cast<int>(std::upper_bound(row_begin.begin(), row_begin.end(), e) - row_begin.begin()) - 1;
+  };
+#pragma omp parallel for
+  for (int t = 0; t < csr5.tiles; t++) {
+    int lanes = t < full_tiles ? OMEGA : 1;
+    int steps = t < full_tiles ? SIGMA : tail;
+    int base = t * TILE;
+    for (int l = 0; l < lanes; l++) {
+      int row = row_of(base + l * steps);
+      csr5.lane_row[t * OMEGA + l] = row;
+      for (int s = 0; s < steps; s++) {
+        int e = base + l * steps + s;
+        int pos = base + s * lanes + l;
+        while (row + 1 < static_cast<int>(row_begin.size()) && row_begin[row + 1] <= e) {
+          row++;
+        }
+        csr5.col[pos] = A.col[e];
+        csr5.val[pos] = A.val[e];
+        csr5.row_start[pos] = row_begin[row] == e ? 1 : 0;
+      }
+    }
+  }
+  return csr5;
+}
+
+void spmv(CsrView A, const double* x, double* y) {
+#pragma omp parallel for
+  for (int i = 0; i < A.n; i++) {
+    double sum = 0.0;
+    for (int j = A.row_ptr[i]; j < A.row_ptr[i + 1]; j++) {
+      sum += A.val[j] * x[A.col[j]];
+    }
+    y[i] = sum;
+  }
+}
+
+void spmv(const SellMatrix& A, const double* x, double* y) {
+  const int C = SellMatrix::C;
+  int slices = static_cast<int>(A.slice_ptr.size()) - 1;
+#pragma omp parallel for
+  for (int s = 0; s < slices; s++) {
+    double sum[C] = {};
+    const int* len = A.row_len.data() + s * C;
+    for (int p = A.slice_ptr[s]; p < A.slice_ptr[s + 1]; p += C) {
+      for (int r = 0; r < C; r++) {
+        sum[r] += A.val[p + r] * x[A.col[p + r]];
+      }
+    }
+    for (int r = 0; r < C && s * C + r < A.n; r++) {
+      y[A.perm[s * C + r]] = len[r] > 0 ? sum[r] : 0.0;
+    }
+  }
+}
+
+void spmv(const Csr5Matrix& A, const double* x, double* y) {
+  const int OMEGA = Csr5Matrix::OMEGA;
+  const int SIGMA = Csr5Matrix::SIGMA;
+  const int TILE = OMEGA * SIGMA;
+  int nnz = static_cast<int>(A.val.size());
+  int full_tiles = nnz / TILE;
+#pragma omp parallel for
+  for (int i = 0; i < A.n; i++) {
+    y[i] = 0.0;
+  }
+  // a tile owns every row that opens inside it; the part of the row it starts in is handed over as a carry
+  std::vector<double> carry(A.tiles, 0.0);
+#pragma omp parallel for
+  for (int t = 0; t < A.tiles; t++) {
+    int lanes = t < full_tiles ? OMEGA : 1;
+    int steps = t < full_tiles ? SIGMA : nnz - full_tiles * TILE;
+    int base = t * TILE;
+    int first_row = A.lane_row[t * OMEGA];
+    bool owns_first = A.row_start[base] != 0;
+    double sum[OMEGA] = {};
+    int row[OMEGA];
+    for (int l = 0; l < lanes; l++) {
+      row[l] = A.lane_row[t * OMEGA + l];
+    }
+    auto flush = [&](int l) {
+      if (row[l] == first_row && !owns_first) {
+        carry[t] += sum[l];
+      } else {
+        y[A.nonempty_rows[row[l]]] += sum[l];
+      }
+      sum[l] = 0.0;
+    };
+    for (int s = 0; s < steps; s++) {
+      for (int l = 0; l < lanes; l++) {
+        int pos = base + s * lanes + l;
+        if (s > 0 && A.row_start[pos] != 0) {
+          flush(l);
+          row[l]++;
+        }
+        sum[l] += A.val[pos] * x[A.col[pos]];
+      }
+    }
+    for (int l = 0; l < lanes; l++) {
+      flush(l);
+    }
+  }
+  for (int t = 0; t < A.tiles; t++) {
+    if (A.row_start[t * TILE] == 0) {
+      y[A.nonempty_rows[A.lane_row[t * OMEGA]]] += carry[t];
+    }
+  }
+}
+}  // namespace KostinArtemOMP
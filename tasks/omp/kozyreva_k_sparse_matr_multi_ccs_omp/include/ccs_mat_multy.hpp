@@ -6,6 +6,20 @@
 
 #include "core/task/include/task.hpp"
 
+// Matrix in compressed columns: colPtr has numCols + 1 entries and the rows of column j are
+// rows[colPtr[j]], ..., rows[colPtr[j + 1] - 1] in increasing order.
+struct SparseMatrixCCS {
+  std::vector<double> values;
+  std::vector<int> rows;
+  std::vector<int> colPtr;
+  int numRows{};
+  int numCols{};
+};
+
+// C = A * B without dense buffers: the columns of C are counted first and then written at their final offsets, so C
+// keeps every structural nonzero, including products that cancel.
+SparseMatrixCCS MultiplyCCS(const SparseMatrixCCS& a, const SparseMatrixCCS& b);
+
 class SparseOmpMatrixMultiSequential : public ppc::core::Task {
  public:
   explicit SparseOmpMatrixMultiSequential(std::shared_ptr<ppc::core::TaskData> taskData_)
@@ -60,3 +74,20 @@ class SparseOmpMatrixMultiParallel : public ppc::core::Task {
   int numCols3{};
   double* result{};
 };
+
+// Same multiplication without dense buffers: inputs[0] and inputs[1] point to the SparseMatrixCCS of A (n1 x m1) and
+// B (m1 x m2), inputs_count is {n1, m1, m1, m2}, outputs[0] points to the SparseMatrixCCS receiving C.
+class SparseOmpMatrixMultiCCS : public ppc::core::Task {
+ public:
+  explicit SparseOmpMatrixMultiCCS(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+  bool pre_processing() override;
+  bool validation() override;
+  bool run() override;
+  bool post_processing() override;
+
+ private:
+  const SparseMatrixCCS* a{};
+  const SparseMatrixCCS* b{};
+  SparseMatrixCCS c;
+  SparseMatrixCCS* out{};
+};
@@ -1,6 +1,7 @@
 // Copyright 2024 Kulaev Zhenya
 #include <gtest/gtest.h>
 
+#include <cmath>
 #include <vector>
 
 #include "omp/kulaev_e_block_cannons_omp/include/ops_omp.hpp"
@@ -59,7 +60,7 @@ TEST(Kulaev_e_block_cannons_omp, Multiplication_3x3) {
   testOmpTaskParallel.post_processing();
 
   for (size_t i = 0; i < seq_res.size(); ++i) {
-    ASSERT_EQ(par_res[i], seq_res[i]);
+    ASSERT_NEAR(par_res[i], seq_res[i], 1e-12 * std::abs(seq_res[i]));
   }
 }
 
@@ -116,7 +117,7 @@ TEST(Kulaev_e_block_cannons_omp, Multiplication_2x2) {
   testOmpTaskParallel.run();
   testOmpTaskParallel.post_processing();
   for (size_t i = 0; i < seq_res.size(); ++i) {
-    ASSERT_EQ(par_res[i], seq_res[i]);
+    ASSERT_NEAR(par_res[i], seq_res[i], 1e-12 * std::abs(seq_res[i]));
   }
 }
 
@@ -173,7 +174,7 @@ TEST(Kulaev_e_block_cannons_omp, Multiplication_5x5) {
   testOmpTaskParallel.run();
   testOmpTaskParallel.post_processing();
   for (size_t i = 0; i < seq_res.size(); ++i) {
-    ASSERT_EQ(par_res[i], seq_res[i]);
+    ASSERT_NEAR(par_res[i], seq_res[i], 1e-12 * std::abs(seq_res[i]));
   }
 }
 
@@ -230,7 +231,7 @@ TEST(Kulaev_e_block_cannons_omp, Multiplication_0x0) {
   testOmpTaskParallel.run();
   testOmpTaskParallel.post_processing();
   for (size_t i = 0; i < seq_res.size(); ++i) {
-    ASSERT_EQ(par_res[i], seq_res[i]);
+    ASSERT_NEAR(par_res[i], seq_res[i], 1e-12 * std::abs(seq_res[i]));
   }
 }
 
@@ -287,6 +288,6 @@ TEST(Kulaev_e_block_cannons_omp, Multiplication_100x100) {
   testOmpTaskParallel.run();
   testOmpTaskParallel.post_processing();
   for (size_t i = 0; i < seq_res.size(); ++i) {
-    ASSERT_EQ(par_res[i], seq_res[i]);
+    ASSERT_NEAR(par_res[i], seq_res[i], 1e-12 * std::abs(seq_res[i]));
   }
 }
\ No newline at end of file
@@ -1,8 +1,10 @@
 // Copyright 2023 Kuznetsov Artem
 #include <gtest/gtest.h>
 
+#include <iostream>
 #include <vector>
 
+#include "core/gemm/include/gemm.hpp"
 #include "omp/kuznetsov_a_cannon_matr_mult/include/ops_omp.hpp"
 
 TEST(Kuznetsov_a_cannon_matr_mult_omp_func_tests, mult_3x3) {
@@ -247,3 +249,75 @@ TEST(Kuznetsov_a_cannon_matr_mult_omp_func_tests, mult_7x7) {
     ASSERT_TRUE(KuznetsovArtyomOmp::isEqual(resSeq[i], outputMatr[i]));
   }
 }
+
+TEST(Kuznetsov_a_cannon_matr_mult_omp_func_tests, mult_tuned_block) {
+  // Create data
+  size_t size = 100;
+  // 0: the task picks the block size itself
+  size_t block = 0;
+
+  auto inputMatrOne = KuznetsovArtyomOmp::getRandomSquareMatrix(size, -100.0, 100.0);
+  auto inputMatrTwo = KuznetsovArtyomOmp::getRandomSquareMatrix(size, -100.0, 100.0);
+  std::vector<double> outputMatr(size * size, 0.0);
+
+  // Create TaskData
+  auto taskDataOmp = std::make_shared<ppc::core::TaskData>();
+
+  // Add matrOne
+  taskDataOmp->inputs.emplace_back(reinterpret_cast<uint8_t *>(inputMatrOne.data()));
+  taskDataOmp->inputs_count.emplace_back(inputMatrOne.size());
+
+  // Add matrTwo
+  taskDataOmp->inputs.emplace_back(reinterpret_cast<uint8_t *>(inputMatrTwo.data()));
+  taskDataOmp->inputs_count.emplace_back(inputMatrTwo.size());
+
+  // Add size
+  taskDataOmp->inputs.emplace_back(reinterpret_cast<uint8_t *>(&size));
+
+  // Add block
+  taskDataOmp->inputs.emplace_back(reinterpret_cast<uint8_t *>(&block));
+
+  // Add out matr
+  taskDataOmp->outputs.emplace_back(reinterpret_cast<uint8_t *>(outputMatr.data()));
+  taskDataOmp->outputs_count.emplace_back(outputMatr.size());
+
+  auto resSeq = KuznetsovArtyomOmp::CannonMatrixMultSeq(inputMatrOne, inputMatrTwo, size, 10);
+
+  // Create Task
+  KuznetsovArtyomOmp::KuznetsovCannonMatrMultOmp testTaskOmp(taskDataOmp);
+
+  ASSERT_TRUE(testTaskOmp.validation());
+  testTaskOmp.pre_processing();
+  testTaskOmp.run();
+  testTaskOmp.post_processing();
+
+  auto resSize = resSeq.size();
+
+  for (size_t i = 0; i < resSize; ++i) {
+    ASSERT_TRUE(KuznetsovArtyomOmp::isEqual(resSeq[i], outputMatr[i]));
+  }
+}
+
+TEST(Kuznetsov_a_cannon_matr_mult_omp_func_tests, mult_reduced_precision) {
+  int size = 300;
+  int block = 64;
+
+  auto matrOne = KuznetsovArtyomOmp::getRandomSquareMatrix(size, -100.0, 100.0);
+  auto matrTwo = KuznetsovArtyomOmp::getRandomSquareMatrix(size, -100.0, 100.0);
+  std::vector<float> floatOne(matrOne.begin(), matrOne.end());
+  std::vector<float> floatTwo(matrTwo.begin(), matrTwo.end());
+
+  // the double product of the inputs as rounded to float: what is left is the error of the computation
+  auto resDouble = KuznetsovArtyomOmp::CannonMatrixMultOmp(std::vector<double>(floatOne.begin(), floatOne.end()),
+                                                           std::vector<double>(floatTwo.begin(), floatTwo.end()),
+                                                           size, block);
+  auto resFloat = KuznetsovArtyomOmp::CannonMatrixMultOmp(floatOne, floatTwo, size, block);
+  auto resMixed = KuznetsovArtyomOmp::CannonMatrixMultOmpMixed(floatOne, floatTwo, size, block);
+
+  double errorFloat = ppc::core::RelativeError(resFloat, resDouble);
+  double errorMixed = ppc::core::RelativeError(resMixed, resDouble);
+  std::cout << "relative error for n = " << size << ": float " << errorFloat << ", mixed " << errorMixed << std::endl;
+  EXPECT_LT(errorFloat, size * 6e-8);
+  // each block of the result is summed by one thread in the order of the steps, as in the double version
+  EXPECT_EQ(0.0, errorMixed);
+}
@@ -20,6 +20,12 @@ std::vector<double> CannonMatrixMultSeq(const std::vector<double> &matrOne, cons
 
 std::vector<double> CannonMatrixMultOmp(const std::vector<double> &matrOne, const std::vector<double> &matrTwo,
                                         int size, int block);
+// single precision: half the memory and twice the elements per vector instruction
+std::vector<float> CannonMatrixMultOmp(const std::vector<float> &matrOne, const std::vector<float> &matrTwo, int size,
+                                       int block);
+// float operands with every block product accumulated in double
+std::vector<double> CannonMatrixMultOmpMixed(const std::vector<float> &matrOne, const std::vector<float> &matrTwo,
+                                             int size, int block);
 
 std::vector<double> getRandomSquareMatrix(size_t size, double minVal, double maxVal);
 
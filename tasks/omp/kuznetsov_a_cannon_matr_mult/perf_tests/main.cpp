@@ -32,8 +32,9 @@ TEST(Kuznetsov_a_cannon_matr_mult_omp_perf_tests, test_900x900) {
   // Add size
   taskDataOmp->inputs.emplace_back(reinterpret_cast<uint8_t *>(&size));
 
-  // Add block
-  taskDataOmp->inputs.emplace_back(reinterpret_cast<uint8_t *>(&block));
+  // Add block: 0, the task picks the block size itself and the perf statistics report it
+  size_t tunedBlock = 0;
+  taskDataOmp->inputs.emplace_back(reinterpret_cast<uint8_t *>(&tunedBlock));
 
   // Add out matr
   taskDataOmp->outputs.emplace_back(reinterpret_cast<uint8_t *>(outputMatr.data()));
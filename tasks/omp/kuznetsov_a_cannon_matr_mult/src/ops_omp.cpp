@@ -1,6 +1,10 @@
 // Copyright 2024 Kuznetsov Artem
 #include "omp/kuznetsov_a_cannon_matr_mult/include/ops_omp.hpp"
 
+#include "core/gemm/include/blocking.hpp"
+#include "core/gemm/include/gemm.hpp"
+#include "core/gemm/include/tiled.hpp"
+
 using namespace std::chrono_literals;
 
 namespace KuznetsovArtyomOmp {
@@ -34,30 +38,57 @@ std::vector<double> CannonMatrixMultSeq(const std::vector<double>& matrOne, cons
   return matrRes;
 }
 
-std::vector<double> CannonMatrixMultOmp(const std::vector<double>& matrOne, const std::vector<double>& matrTwo,
-                                        int size, int block) {
+namespace {
+// T is the element type of the operands, Acc that of the result: float and float for single precision, float and
+// double for float operands accumulated in double
+template <typename T, typename Acc>
+std::vector<Acc> cannonTiledOmp(const std::vector<T>& matrOne, const std::vector<T>& matrTwo, int size, int block) {
   if (!validateMatrix(matrOne.size(), matrTwo.size())) throw std::invalid_argument{"invalid matrixs"};
 
   if (block > size) throw std::invalid_argument{"Wrong size block"};
 
-  int jbMin = 0;
-  int kbMin = 0;
-  std::vector<double> matrRes(size * size, 0.0);
-
-  for (int jb = 0; jb < size; jb += block) {
-    for (int kb = 0; kb < size; kb += block) {
-      jbMin = std::min(jb + block, size);
-      kbMin = std::min(kb + block, size);
-
-#pragma omp parallel for
-      for (int i = 0; i < size; ++i)
-        for (int k = kb; k < kbMin; ++k)
-          for (int j = jb; j < jbMin; ++j) matrRes[i * size + j] += matrOne[i * size + k] * matrTwo[k * size + j];
+  // every block is a contiguous tile, so the block products run on the packed kernel without gathering
+  ppc::core::BasicTiledMatrix<T> tileOne(size, size, block);
+  ppc::core::BasicTiledMatrix<T> tileTwo(size, size, block);
+  ppc::core::BasicTiledMatrix<Acc> tileRes(size, size, block);
+  tileOne.FromRowMajor(matrOne.data(), size);
+  tileTwo.FromRowMajor(matrTwo.data(), size);
+  int grid = tileOne.BlockRows();
+
+  // at each step block (i, j) of the result takes the product of the blocks Cannon's shifts have brought to it; the
+  // blocks of a step are independent
+#pragma omp parallel
+  for (int step = 0; step < grid; ++step) {
+#pragma omp for
+    for (int t = 0; t < grid * grid; ++t) {
+      int i = t / grid;
+      int j = t % grid;
+      int k = (i + j + step) % grid;
+      ppc::core::Gemm(block, block, block, tileOne.Block(i, k), block, tileTwo.Block(k, j), block, tileRes.Block(i, j),
+                      block);
     }
   }
 
+  std::vector<Acc> matrRes(size * size);
+  tileRes.ToRowMajor(matrRes.data(), size);
   return matrRes;
 }
+}  // namespace
+
+std::vector<double> CannonMatrixMultOmp(const std::vector<double>& matrOne, const std::vector<double>& matrTwo,
+                                        int size, int block) {
+  return cannonTiledOmp<double, double>(matrOne, matrTwo, size, block);
+}
+
+std::vector<float> CannonMatrixMultOmp(const std::vector<float>& matrOne, const std::vector<float>& matrTwo, int size,
+                                       int block) {
+  return cannonTiledOmp<float, float>(matrOne, matrTwo, size, block);
+}
+
+std::vector<double> CannonMatrixMultOmpMixed(const std::vector<float>& matrOne, const std::vector<float>& matrTwo,
+                                             int size, int block) {
+  return cannonTiledOmp<float, double>(matrOne, matrTwo, size, block);
+}
 
 std::vector<double> getRandomSquareMatrix(size_t size, double minVal, double maxVal) {
   std::mt19937 gen(std::random_device{}());
@@ -78,6 +109,10 @@ bool KuznetsovCannonMatrMultOmp::pre_processing() {
 
   mSize = *reinterpret_cast<size_t*>(taskData->inputs[SIZE]);
   mBlock = *reinterpret_cast<size_t*>(taskData->inputs[BLOCK]);
+  // 0: no block size from the caller, use the one measured for this host
+  if (mBlock == 0) {
+    mBlock = ppc::core::TuneBlockSize("cannon", static_cast<int>(mSize), omp_get_max_threads());
+  }
 
   size_t countElem = mSize * mSize;
 
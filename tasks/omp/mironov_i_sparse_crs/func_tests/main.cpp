@@ -2,9 +2,67 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include "omp/mironov_i_sparse_crs/include/bcsr.hpp"
+#include "omp/mironov_i_sparse_crs/include/mtx_io.hpp"
 #include "omp/mironov_i_sparse_crs/include/ops_omp.hpp"
+#include "omp/mironov_i_sparse_crs/include/packed.hpp"
+#include "omp/mironov_i_sparse_crs/include/reorder.hpp"
+#include "omp/mironov_i_sparse_crs/include/semiring.hpp"
+#include "omp/mironov_i_sparse_crs/include/stream.hpp"
+
+namespace {
+std::string WriteTempMtx(const std::string &name, const std::string &content) {
+  std::string path = (std::filesystem::temp_directory_path() / name).string();
+  std::ofstream(path, std::ios::binary) << content;
+  return path;
+}
+
+// dense n x n matrix, n = 3 * side * side: a grid of nodes with 3 unknowns each, coupled to the 8 neighbouring nodes
+std::vector<double> FemMatrix(int side) {
+  int n = 3 * side * side;
+  std::vector<double> a(n * n, 0.0);
+  for (int u = 0; u < side * side; u++) {
+    for (int v = 0; v < side * side; v++) {
+      if (std::abs(u / side - v / side) > 1 || std::abs(u % side - v % side) > 1) {
+        continue;
+      }
+      for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+          a[(3 * u + i) * n + 3 * v + j] = u == v && i == j ? 8.0 : (u + 2 * v + i + j) % 5 - 2.5;
+        }
+      }
+    }
+  }
+  return a;
+}
+
+std::vector<int> RandomPermutation(int n) {
+  std::vector<int> perm(n);
+  std::iota(perm.begin(), perm.end(), 0);
+  std::shuffle(perm.begin(), perm.end(), std::mt19937(7));
+  return perm;
+}
+
+bool IsPermutation(std::vector<int> perm, int n) {
+  std::sort(perm.begin(), perm.end());
+  for (int i = 0; i < n; i++) {
+    if (i >= static_cast<int>(perm.size()) || perm[i] != i) {
+      return false;
+    }
+  }
+  return static_cast<int>(perm.size()) == n;
+}
+}  // namespace
 
 TEST(mironov_i_sparse_crs_omp, Test1Static) {
   std::vector<double> C(3 * 3, 0.0);
@@ -155,3 +213,815 @@ TEST(mironov_i_sparse_crs_omp, TestRandom) {
   testTask.run();
   testTask.post_processing();
 }
+
+TEST(mironov_i_sparse_crs_omp, TestSymbolicReuse) {
+  std::vector<double> A = {2, 0, 2, 0, 0, 1, 0, 2, -2, 0, 3, 0};
+  std::vector<double> B = {2, 0, 0, 0, -3, 0, 0, 1, 4, 1, 2, 3};
+  std::vector<double> res = {4, 2, 8, 2, 1, 6, -4, 3, 12};
+  int n = 3;
+  int m = 4;
+  int k = 3;
+
+  mironov_omp::MatrixCRS a(A.data(), n, m);
+  mironov_omp::MatrixCRS b(B.data(), m, k);
+  mironov_omp::MatrixCRS c = mironov_omp::MultiplicateSymbolic(a, b, k);
+  ASSERT_EQ(c.NZ, c.RowIndex[n]);
+
+  for (int scale = 1; scale <= 3; scale++) {
+    for (auto &value : a.Value) {
+      value *= scale;
+    }
+    mironov_omp::MultiplicateNumeric(a, b, k, c);
+    std::vector<double> C(n * k, 0.0);
+    for (int i = 0; i < n; i++) {
+      for (int c_j = c.RowIndex[i]; c_j < c.RowIndex[i + 1]; c_j++) {
+        C[i * k + c.Col[c_j]] = c.Value[c_j];
+      }
+    }
+    for (size_t i = 0; i < C.size(); i++) {
+      EXPECT_DOUBLE_EQ(res[i] * scale, C[i]);
+      res[i] *= scale;
+    }
+  }
+}
+
+TEST(mironov_i_sparse_crs_omp, TestSparseInputOutput) {
+  // A = {{2, 0, 2, 0}, {0, 1, 0, 2}, {-2, 0, 3, 0}}, B = {{2, 0, 0}, {0, -3, 0}, {0, 1, 4}, {1, 2, 3}}
+  mironov_omp::MatrixCRS A(3, 6);
+  A.Value = {2, 2, 1, 2, -2, 3};
+  A.Col = {0, 2, 1, 3, 0, 2};
+  A.RowIndex = {0, 2, 4, 6};
+  mironov_omp::MatrixCRS B(4, 7);
+  B.Value = {2, -3, 1, 4, 1, 2, 3};
+  B.Col = {0, 1, 1, 2, 0, 1, 2};
+  B.RowIndex = {0, 1, 2, 4, 7};
+  mironov_omp::MatrixCRS C;
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(&A));
+  taskData->inputs_count.emplace_back(3);
+  taskData->inputs_count.emplace_back(4);
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(&B));
+  taskData->inputs_count.emplace_back(4);
+  taskData->inputs_count.emplace_back(3);
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(&C));
+  taskData->outputs_count.emplace_back(1);
+
+  // Create Task
+  MironovIOMPSparse testTask(taskData);
+  ASSERT_EQ(testTask.validation(), true);
+  testTask.pre_processing();
+  testTask.run();
+  testTask.post_processing();
+
+  ASSERT_EQ(C.N, 3);
+  EXPECT_EQ(C.RowIndex, std::vector<int>({0, 3, 6, 9}));
+  EXPECT_EQ(C.Col, std::vector<int>({0, 1, 2, 0, 1, 2, 0, 1, 2}));
+  std::vector<double> res = {4, 2, 8, 2, 1, 6, -4, 3, 12};
+  for (size_t i = 0; i < res.size(); i++) {
+    EXPECT_DOUBLE_EQ(res[i], C.Value[i]);
+  }
+}
+
+TEST(mironov_i_sparse_crs_omp, TestSparseDimensionMismatch) {
+  mironov_omp::MatrixCRS A(3, 0);
+  mironov_omp::MatrixCRS B(5, 0);
+  mironov_omp::MatrixCRS C;
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(&A));
+  taskData->inputs_count.emplace_back(3);
+  taskData->inputs_count.emplace_back(4);
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(&B));
+  taskData->inputs_count.emplace_back(5);
+  taskData->inputs_count.emplace_back(3);
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(&C));
+  taskData->outputs_count.emplace_back(1);
+
+  // Create Task
+  MironovIOMPSparse testTask(taskData);
+  ASSERT_EQ(testTask.validation(), false);
+}
+
+TEST(mironov_i_sparse_crs_omp, TestDenseToCCS) {
+  // wider than one conversion block, so several column slabs are filled independently
+  int n = 7;
+  int m = 150;
+  std::vector<double> A(n * m, 0.0);
+  for (int i = 0; i < n; i++) {
+    for (int j = (i * 3) % 5; j < m; j += 4 + i) {
+      A[i * m + j] = i * 1000 + j + 1;
+    }
+  }
+
+  mironov_omp::MatrixCRS a(A.data(), n, m);
+  mironov_omp::MatrixCRS at(A.data(), n, m, true);
+  ASSERT_EQ(a.N, n);
+  ASSERT_EQ(at.N, m);
+  ASSERT_EQ(a.NZ, at.NZ);
+  ASSERT_EQ(at.RowIndex[m], at.NZ);
+
+  std::vector<double> A_from_rows(n * m, 0.0);
+  std::vector<double> A_from_cols(n * m, 0.0);
+  for (int i = 0; i < n; i++) {
+    for (int j = a.RowIndex[i]; j < a.RowIndex[i + 1]; j++) {
+      A_from_rows[i * m + a.Col[j]] = a.Value[j];
+    }
+  }
+  for (int j = 0; j < m; j++) {
+    for (int k = at.RowIndex[j]; k < at.RowIndex[j + 1]; k++) {
+      if (k > at.RowIndex[j]) {
+        EXPECT_LT(at.Col[k - 1], at.Col[k]);
+      }
+      A_from_cols[at.Col[k] * m + j] = at.Value[k];
+    }
+  }
+  EXPECT_EQ(A, A_from_rows);
+  EXPECT_EQ(A, A_from_cols);
+}
+
+TEST(mironov_i_sparse_crs_omp, TestSkewedRows) {
+  // power-law row lengths: row 0 is full, row i holds about n / (i + 1) entries
+  int n = 257;
+  std::vector<double> A(n * n, 0.0);
+  for (int i = 0; i < n; i++) {
+    for (int j = i % 3; j < n; j += i + 1) {
+      A[i * n + j] = (i + 2 * j) % 7 - 3;
+    }
+  }
+  std::vector<double> x(n);
+  for (int j = 0; j < n; j++) {
+    x[j] = j % 5 - 2;
+  }
+
+  mironov_omp::MatrixCRS a(A.data(), n, n);
+  mironov_omp::MatrixCRS c = mironov_omp::MultiplicateSymbolic(a, a, n);
+  mironov_omp::MultiplicateNumeric(a, a, n, c);
+  std::vector<double> y(n, -1.0);
+  mironov_omp::MultiplicateVector(a, x.data(), y.data());
+
+  std::vector<double> C(n * n, 0.0);
+  for (int i = 0; i < n; i++) {
+    for (int c_j = c.RowIndex[i]; c_j < c.RowIndex[i + 1]; c_j++) {
+      C[i * n + c.Col[c_j]] = c.Value[c_j];
+    }
+  }
+  for (int i = 0; i < n; i++) {
+    double y_ref = 0.0;
+    for (int j = 0; j < n; j++) {
+      y_ref += A[i * n + j] * x[j];
+      double c_ref = 0.0;
+      for (int l = 0; l < n; l++) {
+        c_ref += A[i * n + l] * A[l * n + j];
+      }
+      ASSERT_DOUBLE_EQ(c_ref, C[i * n + j]);
+    }
+    EXPECT_DOUBLE_EQ(y_ref, y[i]);
+  }
+}
+
+TEST(mironov_i_sparse_crs_omp, TestMtxReadGeneral) {
+  // unsorted entries, a duplicate (summed) and no newline after the last entry
+  std::string path = WriteTempMtx("mironov_omp_general.mtx",
+                                  "%%MatrixMarket matrix coordinate real general\n"
+                                  "% comment\n"
+                                  "3 4 5\n"
+                                  "2 4 2.5\n"
+                                  "1 3 -1\n"
+                                  "1 1 2\n"
+                                  "2 4 0.5\n"
+                                  "3 2 1e1");
+  mironov_omp::MatrixCRS a;
+  int rows;
+  int cols;
+  ASSERT_TRUE(mironov_omp::ReadMatrixMarket(path, a, rows, cols));
+  std::filesystem::remove(path);
+
+  EXPECT_EQ(rows, 3);
+  EXPECT_EQ(cols, 4);
+  EXPECT_EQ(a.RowIndex, std::vector<int>({0, 2, 3, 4}));
+  EXPECT_EQ(a.Col, std::vector<int>({0, 2, 3, 1}));
+  std::vector<double> values = {2, -1, 3, 10};
+  for (size_t i = 0; i < values.size(); i++) {
+    EXPECT_DOUBLE_EQ(values[i], a.Value[i]);
+  }
+}
+
+TEST(mironov_i_sparse_crs_omp, TestMtxReadSymmetricPattern) {
+  std::string path = WriteTempMtx("mironov_omp_symmetric.mtx",
+                                  "%%MatrixMarket matrix coordinate pattern symmetric\n"
+                                  "3 3 3\n"
+                                  "1 1\n"
+                                  "3 1\n"
+                                  "3 2\n");
+  mironov_omp::MatrixCRS a;
+  int rows;
+  int cols;
+  ASSERT_TRUE(mironov_omp::ReadMatrixMarket(path, a, rows, cols));
+  std::filesystem::remove(path);
+
+  EXPECT_EQ(a.RowIndex, std::vector<int>({0, 2, 3, 5}));
+  EXPECT_EQ(a.Col, std::vector<int>({0, 2, 2, 0, 1}));
+  EXPECT_EQ(a.Value, std::vector<double>(5, 1.0));
+}
+
+TEST(mironov_i_sparse_crs_omp, TestMtxReadHermitianAsCCS) {
+  std::string path = WriteTempMtx("mironov_omp_hermitian.mtx",
+                                  "%%MatrixMarket matrix coordinate complex hermitian\n"
+                                  "2 2 2\n"
+                                  "1 1 4 0\n"
+                                  "2 1 1 2\n");
+  mironov_omp::MatrixCRS a;
+  std::vector<double> imag;
+  int rows;
+  int cols;
+  ASSERT_FALSE(mironov_omp::ReadMatrixMarket(path, a, rows, cols, true));
+  ASSERT_TRUE(mironov_omp::ReadMatrixMarket(path, a, rows, cols, true, &imag));
+  std::filesystem::remove(path);
+
+  // columns of {{4, 1 - 2i}, {1 + 2i, 0}}
+  EXPECT_EQ(a.RowIndex, std::vector<int>({0, 2, 3}));
+  EXPECT_EQ(a.Col, std::vector<int>({0, 1, 0}));
+  EXPECT_EQ(a.Value, std::vector<double>({4, 1, 1}));
+  EXPECT_EQ(imag, std::vector<double>({0, 2, -2}));
+}
+
+TEST(mironov_i_sparse_crs_omp, TestMtxInvalid) {
+  mironov_omp::MatrixCRS a;
+  int rows;
+  int cols;
+  std::string path = WriteTempMtx("mironov_omp_invalid.mtx",
+                                  "%%MatrixMarket matrix coordinate real general\n"
+                                  "2 2 2\n"
+                                  "1 1 1\n"
+                                  "3 1 1\n");
+  EXPECT_FALSE(mironov_omp::ReadMatrixMarket(path, a, rows, cols));
+  std::filesystem::remove(path);
+  path = WriteTempMtx("mironov_omp_array.mtx", "%%MatrixMarket matrix array real general\n1 1\n1\n");
+  EXPECT_FALSE(mironov_omp::ReadMatrixMarket(path, a, rows, cols));
+  std::filesystem::remove(path);
+  EXPECT_FALSE(mironov_omp::ReadMatrixMarket("mironov_omp_missing.mtx", a, rows, cols));
+}
+
+TEST(mironov_i_sparse_crs_omp, TestMtxRoundTrip) {
+  int n = 60;
+  int m = 45;
+  std::vector<double> A(n * m, 0.0);
+  MironovIOMP::genrateSparseMatrix(A.data(), A.size(), 0.1);
+  mironov_omp::MatrixCRS a(A.data(), n, m);
+
+  std::string path = (std::filesystem::temp_directory_path() / "mironov_omp_round_trip.mtx").string();
+  // one round, rounds of a few rows and a round per row
+  for (int round_nonzeros : {1 << 20, 7, 1}) {
+    ASSERT_TRUE(mironov_omp::WriteMatrixMarket(path, a, m, round_nonzeros));
+    mironov_omp::MatrixCRS b;
+    int rows;
+    int cols;
+    ASSERT_TRUE(mironov_omp::ReadMatrixMarket(path, b, rows, cols));
+    std::filesystem::remove(path);
+
+    EXPECT_EQ(rows, n);
+    EXPECT_EQ(cols, m);
+    EXPECT_EQ(a.RowIndex, b.RowIndex);
+    EXPECT_EQ(a.Col, b.Col);
+    EXPECT_EQ(a.Value, b.Value);
+  }
+}
+
+TEST(mironov_i_sparse_crs_omp, TestBCSRBlockSizeChoice) {
+  int side = 4;
+  int n = 3 * side * side;
+  std::vector<double> A = FemMatrix(side);
+  mironov_omp::MatrixCRS a(A.data(), n, n);
+
+  EXPECT_DOUBLE_EQ(1.0, mironov_omp::FillRatio(a, n, 3, 3));
+  EXPECT_GT(mironov_omp::FillRatio(a, n, 2, 2), 1.0);
+  EXPECT_EQ(std::make_pair(3, 3), mironov_omp::ChooseBlockSize(a, n));
+
+  mironov_omp::MatrixBCSR b = mironov_omp::ToBCSR(a, n, 3, 3);
+  EXPECT_EQ(b.Blocks() * 9, a.NZ);
+  mironov_omp::MatrixCRS back = mironov_omp::FromBCSR(b);
+  EXPECT_EQ(a.RowIndex, back.RowIndex);
+  EXPECT_EQ(a.Col, back.Col);
+  EXPECT_EQ(a.Value, back.Value);
+}
+
+TEST(mironov_i_sparse_crs_omp, TestBCSRMultiplicate) {
+  // sizes that are not multiples of the blocks, and blocks that are not square
+  int n = 10;
+  int m = 8;
+  int k = 7;
+  std::vector<double> A(n * m, 0.0);
+  std::vector<double> B(m * k, 0.0);
+  for (int i = 0; i < n * m; i += 3) {
+    A[i] = i % 7 - 3.0;
+  }
+  for (int i = 0; i < m * k; i += 4) {
+    B[i] = i % 5 - 2.0;
+  }
+  std::vector<double> x(m);
+  for (int j = 0; j < m; j++) {
+    x[j] = j + 1.0;
+  }
+
+  mironov_omp::MatrixBCSR a = mironov_omp::ToBCSR(mironov_omp::MatrixCRS(A.data(), n, m), m, 3, 2);
+  mironov_omp::MatrixBCSR b = mironov_omp::ToBCSR(mironov_omp::MatrixCRS(B.data(), m, k), k, 2, 3);
+  std::vector<double> y(n, -1.0);
+  mironov_omp::MultiplicateVector(a, x.data(), y.data());
+  mironov_omp::MatrixBCSR c = mironov_omp::Multiplicate(a, b);
+  ASSERT_EQ(c.R, 3);
+  ASSERT_EQ(c.C, 3);
+  mironov_omp::MatrixCRS c_crs = mironov_omp::FromBCSR(c);
+
+  std::vector<double> C(n * k, 0.0);
+  for (int i = 0; i < n; i++) {
+    for (int j = c_crs.RowIndex[i]; j < c_crs.RowIndex[i + 1]; j++) {
+      C[i * k + c_crs.Col[j]] = c_crs.Value[j];
+    }
+  }
+  for (int i = 0; i < n; i++) {
+    double y_ref = 0.0;
+    for (int l = 0; l < m; l++) {
+      y_ref += A[i * m + l] * x[l];
+    }
+    EXPECT_DOUBLE_EQ(y_ref, y[i]);
+    for (int j = 0; j < k; j++) {
+      double c_ref = 0.0;
+      for (int l = 0; l < m; l++) {
+        c_ref += A[i * m + l] * B[l * k + j];
+      }
+      EXPECT_DOUBLE_EQ(c_ref, C[i * k + j]);
+    }
+  }
+}
+
+TEST(mironov_i_sparse_crs_omp, TestBCSRSquareBlocks) {
+  int side = 5;
+  int n = 3 * side * side;
+  std::vector<double> A = FemMatrix(side);
+  mironov_omp::MatrixCRS a(A.data(), n, n);
+  mironov_omp::MatrixBCSR b = mironov_omp::ToBCSR(a, n, 3, 3);
+
+  mironov_omp::MatrixCRS c = mironov_omp::MultiplicateSymbolic(a, a, n);
+  mironov_omp::MultiplicateNumeric(a, a, n, c);
+  mironov_omp::MatrixCRS c_blocks = mironov_omp::FromBCSR(mironov_omp::Multiplicate(b, b));
+  std::vector<double> C(n * n, 0.0);
+  std::vector<double> C_blocks(n * n, 0.0);
+  for (int i = 0; i < n; i++) {
+    for (int j = c.RowIndex[i]; j < c.RowIndex[i + 1]; j++) {
+      C[i * n + c.Col[j]] = c.Value[j];
+    }
+    for (int j = c_blocks.RowIndex[i]; j < c_blocks.RowIndex[i + 1]; j++) {
+      C_blocks[i * n + c_blocks.Col[j]] = c_blocks.Value[j];
+    }
+  }
+  for (int i = 0; i < n * n; i++) {
+    ASSERT_NEAR(C[i], C_blocks[i], 1e-9);
+  }
+
+  std::vector<double> x(n, 1.0);
+  std::vector<double> y(n);
+  std::vector<double> y_blocks(n);
+  mironov_omp::MultiplicateVector(a, x.data(), y.data());
+  mironov_omp::MultiplicateVector(b, x.data(), y_blocks.data());
+  for (int i = 0; i < n; i++) {
+    EXPECT_NEAR(y[i], y_blocks[i], 1e-12);
+  }
+}
+
+TEST(mironov_i_sparse_crs_omp, TestReorderRCMBandwidth) {
+  int side = 8;
+  int n = 3 * side * side;
+  std::vector<double> A = FemMatrix(side);
+  mironov_omp::MatrixCRS grid(A.data(), n, n);
+  mironov_omp::MatrixCRS a = mironov_omp::PermuteSymmetric(grid, RandomPermutation(n));
+  ASSERT_GT(mironov_omp::Bandwidth(a), n / 2);
+
+  std::vector<int> perm = mironov_omp::ReverseCuthillMcKee(a);
+  ASSERT_TRUE(IsPermutation(perm, n));
+  mironov_omp::MatrixCRS b = mironov_omp::PermuteSymmetric(a, perm);
+  EXPECT_EQ(b.NZ, a.NZ);
+  // a breadth-first level of the grid holds at most side + 1 nodes, each coupled only to the neighbouring levels
+  EXPECT_LE(mironov_omp::Bandwidth(b), 3 * 2 * (side + 1));
+
+  // permuting back restores the input exactly
+  mironov_omp::MatrixCRS back = mironov_omp::PermuteSymmetric(b, mironov_omp::InversePermutation(perm));
+  EXPECT_EQ(a.RowIndex, back.RowIndex);
+  EXPECT_EQ(a.Col, back.Col);
+  EXPECT_EQ(a.Value, back.Value);
+}
+
+TEST(mironov_i_sparse_crs_omp, TestReorderMultiplicate) {
+  int side = 6;
+  int n = 3 * side * side;
+  std::vector<double> A = FemMatrix(side);
+  mironov_omp::MatrixCRS grid(A.data(), n, n);
+  mironov_omp::MatrixCRS a = mironov_omp::PermuteSymmetric(grid, RandomPermutation(n));
+  std::vector<double> x(n);
+  for (int i = 0; i < n; i++) {
+    x[i] = (i % 11) - 5.0;
+  }
+  mironov_omp::MatrixCRS c = mironov_omp::MultiplicateSymbolic(a, a, n);
+  mironov_omp::MultiplicateNumeric(a, a, n, c);
+  std::vector<double> y(n);
+  mironov_omp::MultiplicateVector(a, x.data(), y.data());
+
+  for (const std::vector<int> &perm : {mironov_omp::ReverseCuthillMcKee(a), mironov_omp::NestedDissection(a, 3)}) {
+    ASSERT_TRUE(IsPermutation(perm, n));
+    // C = A * A computed as (P A P^T) (P A P^T) = P C P^T and permuted back
+    mironov_omp::MatrixCRS b = mironov_omp::PermuteSymmetric(a, perm);
+    mironov_omp::MatrixCRS c_perm = mironov_omp::MultiplicateSymbolic(b, b, n);
+    mironov_omp::MultiplicateNumeric(b, b, n, c_perm);
+    mironov_omp::MatrixCRS c_back = mironov_omp::PermuteSymmetric(c_perm, mironov_omp::InversePermutation(perm));
+    ASSERT_EQ(c.RowIndex, c_back.RowIndex);
+    ASSERT_EQ(c.Col, c_back.Col);
+    for (int j = 0; j < c.NZ; j++) {
+      EXPECT_NEAR(c.Value[j], c_back.Value[j], 1e-9);
+    }
+
+    std::vector<double> x_perm(n);
+    std::vector<double> y_perm(n);
+    std::vector<double> y_back(n);
+    mironov_omp::PermuteVector(x.data(), perm, x_perm.data());
+    mironov_omp::MultiplicateVector(b, x_perm.data(), y_perm.data());
+    mironov_omp::UnpermuteVector(y_perm.data(), perm, y_back.data());
+    for (int i = 0; i < n; i++) {
+      EXPECT_NEAR(y[i], y_back[i], 1e-9);
+    }
+  }
+}
+
+TEST(mironov_i_sparse_crs_omp, TestNestedDissectionSeparator) {
+  // a path 0 - 1 - ... - n-1: the first bisection splits it at the middle vertex, which is ordered last
+  int n = 101;
+  std::vector<double> A(n * n, 0.0);
+  for (int i = 0; i < n; i++) {
+    A[i * n + i] = 2.0;
+    if (i + 1 < n) {
+      A[i * n + i + 1] = A[(i + 1) * n + i] = -1.0;
+    }
+  }
+  mironov_omp::MatrixCRS a(A.data(), n, n);
+  std::vector<int> perm = mironov_omp::NestedDissection(a, 1);
+  ASSERT_TRUE(IsPermutation(perm, n));
+  EXPECT_EQ(perm.back(), n / 2);
+  // no coupling between the two halves except through the separator
+  mironov_omp::MatrixCRS b = mironov_omp::PermuteSymmetric(a, perm);
+  for (int i = 0; i < n / 2; i++) {
+    for (int j = b.RowIndex[i]; j < b.RowIndex[i + 1]; j++) {
+      EXPECT_TRUE(b.Col[j] < n / 2 || b.Col[j] == n - 1);
+    }
+  }
+  EXPECT_TRUE(IsPermutation(mironov_omp::NestedDissection(a), n));
+}
+
+TEST(mironov_i_sparse_crs_omp, TestPackedRoundTrip) {
+  // 4 panels of 65536 columns, gaps from 1 to well over 128
+  int n = 40;
+  int cols = 200000;
+  mironov_omp::MatrixCRS a(n, 0);
+  for (int i = 0; i < n; i++) {
+    for (int c = i; c < cols; c += 1 + (c * 7919 + i) % 30011) {
+      a.Col.push_back(c);
+      a.Value.push_back(0.5 * (c % 9) - 2.0);
+    }
+    a.RowIndex[i + 1] = static_cast<int>(a.Col.size());
+  }
+  a.NZ = a.RowIndex[n];
+  std::vector<double> x(cols);
+  for (int j = 0; j < cols; j++) {
+    x[j] = (j % 13) - 6.0;
+  }
+  std::vector<double> y(n);
+  mironov_omp::MultiplicateVector(a, x.data(), y.data());
+
+  for (auto encoding : {mironov_omp::IndexEncoding::Int32, mironov_omp::IndexEncoding::Block16,
+                        mironov_omp::IndexEncoding::DeltaVarint}) {
+    mironov_omp::MatrixPackedCRS packed = mironov_omp::Pack(a, cols, encoding);
+    mironov_omp::MatrixCRS back = mironov_omp::Unpack(packed);
+    EXPECT_EQ(a.RowIndex, back.RowIndex);
+    EXPECT_EQ(a.Col, back.Col);
+    EXPECT_EQ(a.Value, back.Value);
+    std::vector<double> y_packed(n);
+    mironov_omp::MultiplicateVector(packed, x.data(), y_packed.data());
+    for (int i = 0; i < n; i++) {
+      EXPECT_DOUBLE_EQ(y[i], y_packed[i]);
+    }
+  }
+  EXPECT_EQ(4, mironov_omp::Pack(a, cols, mironov_omp::IndexEncoding::Block16).Panels());
+
+  // neighbouring columns encode in a byte each; a few columns 200 apart favour 2 byte indices
+  int side = 4;
+  std::vector<double> A = FemMatrix(side);
+  EXPECT_EQ(mironov_omp::IndexEncoding::DeltaVarint,
+            mironov_omp::ChooseEncoding(mironov_omp::MatrixCRS(A.data(), 3 * side * side, 3 * side * side),
+                                        3 * side * side));
+  mironov_omp::MatrixCRS spread(n, 0);
+  for (int i = 0; i < n; i++) {
+    for (int k = 0; k < 5; k++) {
+      spread.Col.push_back(i + 200 * k);
+      spread.Value.push_back(1.0);
+    }
+    spread.RowIndex[i + 1] = static_cast<int>(spread.Col.size());
+  }
+  spread.NZ = spread.RowIndex[n];
+  EXPECT_EQ(mironov_omp::IndexEncoding::Block16, mironov_omp::ChooseEncoding(spread, 1000));
+}
+
+TEST(mironov_i_sparse_crs_omp, TestPackedMultiplicate) {
+  int side = 5;
+  int n = 3 * side * side;
+  std::vector<double> A = FemMatrix(side);
+  mironov_omp::MatrixCRS a(A.data(), n, n);
+  mironov_omp::MatrixCRS c = mironov_omp::MultiplicateSymbolic(a, a, n);
+  mironov_omp::MultiplicateNumeric(a, a, n, c);
+  std::vector<double> x(n);
+  for (int i = 0; i < n; i++) {
+    x[i] = 0.25 * (i % 7) - 1.0;
+  }
+  std::vector<double> y(n);
+  mironov_omp::MultiplicateVector(a, x.data(), y.data());
+
+  for (auto encoding : {mironov_omp::IndexEncoding::Int32, mironov_omp::IndexEncoding::Block16,
+                        mironov_omp::IndexEncoding::DeltaVarint}) {
+    for (bool single_precision : {false, true}) {
+      // the FEM values are multiples of 0.5, exact in float
+      mironov_omp::MatrixPackedCRS packed = mironov_omp::Pack(a, n, encoding, single_precision);
+      if (encoding != mironov_omp::IndexEncoding::Int32 || single_precision) {
+        EXPECT_LT(packed.Bytes(), mironov_omp::Pack(a, n, mironov_omp::IndexEncoding::Int32).Bytes());
+      }
+      std::vector<double> y_packed(n);
+      mironov_omp::MultiplicateVector(packed, x.data(), y_packed.data());
+      for (int i = 0; i < n; i++) {
+        EXPECT_DOUBLE_EQ(y[i], y_packed[i]);
+      }
+      mironov_omp::MatrixCRS c_packed = mironov_omp::Multiplicate(packed, packed);
+      ASSERT_EQ(c.RowIndex, c_packed.RowIndex);
+      ASSERT_EQ(c.Col, c_packed.Col);
+      for (int j = 0; j < c.NZ; j++) {
+        EXPECT_DOUBLE_EQ(c.Value[j], c_packed.Value[j]);
+      }
+    }
+  }
+}
+
+TEST(mironov_i_sparse_crs_omp, TestSemiringTriangles) {
+  // random undirected graph; with L its strictly lower triangle, sum(L * L .* L) counts every triangle once
+  int n = 60;
+  std::mt19937 gen(3);
+  std::vector<double> adj(n * n, 0.0);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < i; j++) {
+      if (gen() % 5 == 0) {
+        adj[i * n + j] = adj[j * n + i] = 1.0;
+      }
+    }
+  }
+  std::vector<double> lower(n * n, 0.0);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < i; j++) {
+      lower[i * n + j] = adj[i * n + j];
+    }
+  }
+  mironov_omp::MatrixCRS l(lower.data(), n, n);
+  mironov_omp::MatrixCRS c = mironov_omp::Multiplicate<mironov_omp::PlusTimes>(l, l, n, &l);
+  double triangles = 0.0;
+  for (double v : c.Value) {
+    triangles += v;
+  }
+  int expected = 0;
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < i; j++) {
+      for (int t = 0; t < j; t++) {
+        expected += adj[i * n + j] != 0.0 && adj[j * n + t] != 0.0 && adj[i * n + t] != 0.0 ? 1 : 0;
+      }
+    }
+  }
+  EXPECT_DOUBLE_EQ(expected, triangles);
+  EXPECT_GT(expected, 0);
+
+  // without a mask plus-times is the ordinary product
+  mironov_omp::MatrixCRS a(adj.data(), n, n);
+  mironov_omp::MatrixCRS c_full = mironov_omp::Multiplicate<mironov_omp::PlusTimes>(a, a, n);
+  mironov_omp::MatrixCRS c_ref = mironov_omp::MultiplicateSymbolic(a, a, n);
+  mironov_omp::MultiplicateNumeric(a, a, n, c_ref);
+  EXPECT_EQ(c_ref.RowIndex, c_full.RowIndex);
+  EXPECT_EQ(c_ref.Col, c_full.Col);
+  EXPECT_EQ(c_ref.Value, c_full.Value);
+}
+
+TEST(mironov_i_sparse_crs_omp, TestSemiringShortestPaths) {
+  // weighted digraph with a zero diagonal: squaring over min-plus doubles the number of hops covered
+  int n = 40;
+  double inf = mironov_omp::MinPlus::Zero();
+  std::mt19937 gen(5);
+  std::vector<double> dist(n * n, inf);
+  std::vector<double> w(n * n, 0.0);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      if (i != j && gen() % 8 == 0) {
+        dist[i * n + j] = w[i * n + j] = 1.0 + gen() % 9;
+      }
+    }
+  }
+  mironov_omp::MatrixCRS d(w.data(), n, n);
+  // the diagonal entries are zero lengths and have to be stored explicitly
+  mironov_omp::MatrixCRS d0(n, 0);
+  for (int i = 0; i < n; i++) {
+    std::vector<std::pair<int, double>> row = {{i, 0.0}};
+    for (int j = d.RowIndex[i]; j < d.RowIndex[i + 1]; j++) {
+      row.emplace_back(d.Col[j], d.Value[j]);
+    }
+    std::sort(row.begin(), row.end());
+    for (const auto &[col, value] : row) {
+      d0.Col.push_back(col);
+      d0.Value.push_back(value);
+    }
+    d0.RowIndex[i + 1] = static_cast<int>(d0.Col.size());
+  }
+  d0.NZ = d0.RowIndex[n];
+  for (int hops = 1; hops < n; hops *= 2) {
+    d0 = mironov_omp::Multiplicate<mironov_omp::MinPlus>(d0, d0, n);
+  }
+
+  for (int i = 0; i < n; i++) {
+    dist[i * n + i] = 0.0;
+  }
+  for (int t = 0; t < n; t++) {
+    for (int i = 0; i < n; i++) {
+      for (int j = 0; j < n; j++) {
+        dist[i * n + j] = std::min(dist[i * n + j], dist[i * n + t] + dist[t * n + j]);
+      }
+    }
+  }
+  std::vector<double> result(n * n, inf);
+  for (int i = 0; i < n; i++) {
+    for (int j = d0.RowIndex[i]; j < d0.RowIndex[i + 1]; j++) {
+      result[i * n + d0.Col[j]] = d0.Value[j];
+    }
+  }
+  EXPECT_EQ(dist, result);
+}
+
+TEST(mironov_i_sparse_crs_omp, TestSemiringMaskedBFS) {
+  // breadth-first search from several sources at once on a side x side grid: the next frontier is
+  // frontier * A over or-and, masked by the complement of the visited vertices
+  int side = 9;
+  int n = side * side;
+  std::vector<double> adj(n * n, 0.0);
+  for (int v = 0; v < n; v++) {
+    if (v % side + 1 < side) {
+      adj[v * n + v + 1] = adj[(v + 1) * n + v] = 1.0;
+    }
+    if (v + side < n) {
+      adj[v * n + v + side] = adj[(v + side) * n + v] = 1.0;
+    }
+  }
+  mironov_omp::MatrixCRS a(adj.data(), n, n);
+  std::vector<int> sources = {0, 40, 80};
+  int s = static_cast<int>(sources.size());
+  std::vector<double> start(s * n, 0.0);
+  for (int q = 0; q < s; q++) {
+    start[q * n + sources[q]] = 1.0;
+  }
+  mironov_omp::MatrixCRS frontier(start.data(), s, n);
+  mironov_omp::MatrixCRS visited = frontier;
+  std::vector<int> level(s * n, -1);
+  for (int q = 0; q < s; q++) {
+    level[q * n + sources[q]] = 0;
+  }
+  for (int depth = 1; frontier.NZ > 0; depth++) {
+    frontier = mironov_omp::Multiplicate<mironov_omp::OrAnd>(frontier, a, n, &visited, true);
+    std::vector<double> seen(s * n, 0.0);
+    for (int q = 0; q < s; q++) {
+      for (int j = visited.RowIndex[q]; j < visited.RowIndex[q + 1]; j++) {
+        seen[q * n + visited.Col[j]] = 1.0;
+      }
+      for (int j = frontier.RowIndex[q]; j < frontier.RowIndex[q + 1]; j++) {
+        ASSERT_EQ(level[q * n + frontier.Col[j]], -1);
+        level[q * n + frontier.Col[j]] = depth;
+        seen[q * n + frontier.Col[j]] = 1.0;
+      }
+    }
+    visited = mironov_omp::MatrixCRS(seen.data(), s, n);
+  }
+  for (int q = 0; q < s; q++) {
+    for (int v = 0; v < n; v++) {
+      int y = v / side;
+      int x = v % side;
+      EXPECT_EQ(std::abs(y - sources[q] / side) + std::abs(x - sources[q] % side), level[q * n + v]);
+    }
+  }
+}
+
+TEST(mironov_i_sparse_crs_omp, TestOutOfCoreMultiplicate) {
+  // panel sizes that do not divide the matrix sizes, with empty rows and columns in between
+  int n = 53;
+  int m = 41;
+  int k = 67;
+  std::vector<double> A(n * m, 0.0);
+  std::vector<double> B(m * k, 0.0);
+  for (int i = 0; i < n * m; i += 5) {
+    A[i] = (i % 7 != 0) ? i % 9 - 4.0 : 0.0;
+  }
+  for (int i = 0; i < m * k; i += 3) {
+    B[i] = (i / k) % 4 != 0 ? i % 5 - 2.5 : 0.0;
+  }
+  mironov_omp::MatrixCRS a(A.data(), n, m);
+  mironov_omp::MatrixCRS b(B.data(), m, k);
+  mironov_omp::MatrixCRS c = mironov_omp::MultiplicateSymbolic(a, b, k);
+  mironov_omp::MultiplicateNumeric(a, b, k, c);
+
+  std::string a_path = (std::filesystem::temp_directory_path() / "mironov_omp_a.panels").string();
+  std::string b_path = (std::filesystem::temp_directory_path() / "mironov_omp_b.panels").string();
+  std::string c_path = (std::filesystem::temp_directory_path() / "mironov_omp_c.panels").string();
+  ASSERT_TRUE(mironov_omp::WritePanels(a_path, a, m, 10, false));
+  ASSERT_TRUE(mironov_omp::WritePanels(b_path, b, k, 16, true));
+
+  // both kinds of panel file read back to the same matrix
+  mironov_omp::MatrixCRS b_back;
+  int rows = 0;
+  int cols = 0;
+  ASSERT_TRUE(mironov_omp::ReadPanels(b_path, b_back, rows, cols));
+  EXPECT_EQ(m, rows);
+  EXPECT_EQ(k, cols);
+  EXPECT_EQ(b.RowIndex, b_back.RowIndex);
+  EXPECT_EQ(b.Col, b_back.Col);
+  EXPECT_EQ(b.Value, b_back.Value);
+
+  ASSERT_TRUE(mironov_omp::MultiplicateOutOfCore(a_path, b_path, c_path));
+  mironov_omp::MatrixCRS c_stream;
+  ASSERT_TRUE(mironov_omp::ReadPanels(c_path, c_stream, rows, cols));
+  EXPECT_EQ(n, rows);
+  EXPECT_EQ(k, cols);
+  EXPECT_EQ(c.RowIndex, c_stream.RowIndex);
+  EXPECT_EQ(c.Col, c_stream.Col);
+  EXPECT_EQ(c.Value, c_stream.Value);
+
+  // A must come in row panels and B in column panels of matching size
+  EXPECT_FALSE(mironov_omp::MultiplicateOutOfCore(b_path, a_path, c_path));
+  EXPECT_FALSE(mironov_omp::MultiplicateOutOfCore(a_path, a_path, c_path));
+  EXPECT_FALSE(mironov_omp::MultiplicateOutOfCore(a_path, a_path + ".missing", c_path));
+  EXPECT_FALSE(mironov_omp::ReadPanels(WriteTempMtx("mironov_omp_bad.panels", "CRSP not a panel file"), c_stream, rows,
+                                       cols));
+  std::filesystem::remove(a_path);
+  std::filesystem::remove(b_path);
+  std::filesystem::remove(c_path);
+}
+
+TEST(mironov_i_sparse_crs_omp, TestOutOfCoreTask) {
+  int n = 45;
+  int m = 30;
+  int k = 38;
+  std::vector<double> A(n * m, 0.0);
+  std::vector<double> B(m * k, 0.0);
+  for (int i = 0; i < n * m; i += 4) {
+    A[i] = i % 9 - 4.0;
+  }
+  for (int i = 0; i < m * k; i += 3) {
+    B[i] = i % 5 - 2.5;
+  }
+  mironov_omp::MatrixCRS a(A.data(), n, m);
+  mironov_omp::MatrixCRS b(B.data(), m, k);
+  mironov_omp::MatrixCRS c = mironov_omp::MultiplicateSymbolic(a, b, k);
+  mironov_omp::MultiplicateNumeric(a, b, k, c);
+
+  std::string a_path = (std::filesystem::temp_directory_path() / "mironov_omp_task_a.panels").string();
+  std::string b_path = (std::filesystem::temp_directory_path() / "mironov_omp_task_b.panels").string();
+  std::string c_path = (std::filesystem::temp_directory_path() / "mironov_omp_task_c.panels").string();
+  ASSERT_TRUE(mironov_omp::WritePanels(a_path, a, m, 8, false));
+  ASSERT_TRUE(mironov_omp::WritePanels(b_path, b, k, 12, true));
+
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(&a_path));
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(&b_path));
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(&c_path));
+  MironovIOMPStream task(taskData);
+  ASSERT_TRUE(task.validation());
+  ASSERT_TRUE(task.pre_processing());
+  ASSERT_TRUE(task.run());
+  ASSERT_TRUE(task.post_processing());
+
+  mironov_omp::MatrixCRS c_stream;
+  int rows = 0;
+  int cols = 0;
+  ASSERT_TRUE(mironov_omp::ReadPanels(c_path, c_stream, rows, cols));
+  EXPECT_EQ(n, rows);
+  EXPECT_EQ(k, cols);
+  EXPECT_EQ(c.RowIndex, c_stream.RowIndex);
+  EXPECT_EQ(c.Col, c_stream.Col);
+  EXPECT_EQ(c.Value, c_stream.Value);
+
+  // B given in row panels
+  std::shared_ptr<ppc::core::TaskData> swapped = std::make_shared<ppc::core::TaskData>();
+  swapped->inputs.emplace_back(reinterpret_cast<uint8_t *>(&b_path));
+  swapped->inputs.emplace_back(reinterpret_cast<uint8_t *>(&a_path));
+  swapped->outputs.emplace_back(reinterpret_cast<uint8_t *>(&c_path));
+  MironovIOMPStream wrong(swapped);
+  EXPECT_FALSE(wrong.validation());
+  std::filesystem::remove(a_path);
+  std::filesystem::remove(b_path);
+  std::filesystem::remove(c_path);
+}
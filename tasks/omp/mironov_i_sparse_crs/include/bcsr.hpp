@@ -0,0 +1,41 @@
+// Copyright 2024 Mironov Ilya
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "omp/mironov_i_sparse_crs/include/ops_omp.hpp"
+
+namespace mironov_omp {
+// Block compressed rows: the matrix is cut into R x C dense blocks and only blocks holding a nonzero are stored,
+// row-major, with one column index per block. Rows and columns past the end of the matrix are zero padding.
+class MatrixBCSR {
+ public:
+  int R;
+  int C;
+  int Rows;  // scalar size of the matrix
+  int Cols;
+  int BlockRows;
+  int BlockCols;
+  std::vector<int> RowIndex;  // per block row
+  std::vector<int> Col;       // block column of every block
+  std::vector<double> Value;  // R * C values of every block
+
+  explicit MatrixBCSR(int r = 1, int c = 1, int rows = 0, int cols = 0);
+  int Blocks() const { return static_cast<int>(Col.size()); }
+};
+
+// Converts a rows x cols CRS matrix into r x c blocks.
+MatrixBCSR ToBCSR(const MatrixCRS& A, int cols, int r, int c);
+MatrixCRS FromBCSR(const MatrixBCSR& A);
+// Stored values per nonzero when A is cut into r x c blocks; 1 means every block is full.
+double FillRatio(const MatrixCRS& A, int cols, int r, int c);
+// Picks the block size up to 4 x 4 that moves the fewest bytes in SpMV: 8 * r * c per block value plus a 4 byte
+// column index per block, so blocks pay off as long as they are filled well enough to save on indices.
+std::pair<int, int> ChooseBlockSize(const MatrixCRS& A, int cols);
+
+// y = A * x with the R x C block kept in registers; x has A.Cols entries, y receives A.Rows.
+void MultiplicateVector(const MatrixBCSR& A, const double* x, double* y);
+// C = A * B on blocks, requires A.C == B.R and A.Cols == B.Rows; the result has A.R x B.C blocks.
+MatrixBCSR Multiplicate(const MatrixBCSR& A, const MatrixBCSR& B);
+}  // namespace mironov_omp
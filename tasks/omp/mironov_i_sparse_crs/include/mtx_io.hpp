@@ -0,0 +1,21 @@
+// Copyright 2024 Mironov Ilya
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "omp/mironov_i_sparse_crs/include/ops_omp.hpp"
+
+namespace mironov_omp {
+// Reads a Matrix Market coordinate file (real, integer, complex or pattern; general, symmetric, skew-symmetric or
+// hermitian). The file is mapped into memory and its entries are parsed by all OpenMP threads in line-aligned chunks.
+// Symmetric storage is expanded, duplicate entries are summed and columns are sorted inside every row.
+// With transpose = true the CRS of the transposed matrix, i.e. the CCS of the matrix itself, is returned.
+// Complex files need imag, which receives the imaginary parts aligned with matrix.Value.
+// Returns false if the file cannot be opened or is not a valid coordinate file.
+bool ReadMatrixMarket(const std::string& path, MatrixCRS& matrix, int& rows, int& cols, bool transpose = false,
+                      std::vector<double>* imag = nullptr);
+// Writes matrix (rows x cols) as a real general coordinate file. Blocks of rows with about round_nonzeros entries
+// (about 32 bytes of text each) are formatted in parallel and written one after another.
+bool WriteMatrixMarket(const std::string& path, const MatrixCRS& matrix, int cols, int round_nonzeros = 1 << 20);
+}  // namespace mironov_omp
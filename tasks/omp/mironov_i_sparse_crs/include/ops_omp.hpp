@@ -20,6 +20,17 @@ class MatrixCRS {
   explicit MatrixCRS(int n = 0, int nz = 0);
   MatrixCRS(const double* matrix, int n, int m, bool transpose = false);
 };
+
+// Replaces data[0..n) with its exclusive prefix sums in parallel; data[n] receives the total.
+void ExclusiveScan(int* data, int n);
+// Symbolic phase of C = A * B, k is the number of columns of B: exact RowIndex and Col of C, Value allocated but
+// not filled. The result can be reused by MultiplicateNumeric for any A and B with the same sparsity pattern.
+MatrixCRS MultiplicateSymbolic(const MatrixCRS& A, const MatrixCRS& B, int k);
+// Numeric phase: fills C.Value for the structure produced by MultiplicateSymbolic.
+void MultiplicateNumeric(const MatrixCRS& A, const MatrixCRS& B, int k, MatrixCRS& C);
+// y = A * x. The rows and nonzeros are split together along the merge path, so every thread gets the same share of
+// work however unevenly the nonzeros are spread over the rows.
+void MultiplicateVector(const MatrixCRS& A, const double* x, double* y);
 }  // namespace mironov_omp
 
 class MironovIOMP : public ppc::core::Task {
@@ -34,9 +45,27 @@ class MironovIOMP : public ppc::core::Task {
 
  private:
   mironov_omp::MatrixCRS A;
-  mironov_omp::MatrixCRS BT;
+  mironov_omp::MatrixCRS B;
   mironov_omp::MatrixCRS C;
   double* c_out{};
   int M{};
   int K{};
 };
+
+// Same multiplication without dense buffers: inputs[0] and inputs[1] point to mironov_omp::MatrixCRS of A (n x m)
+// and B (m x k), inputs_count is {n, m, m, k}, outputs[0] points to the mironov_omp::MatrixCRS receiving C.
+class MironovIOMPSparse : public ppc::core::Task {
+ public:
+  explicit MironovIOMPSparse(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+  bool pre_processing() override;
+  bool validation() override;
+  bool run() override;
+  bool post_processing() override;
+
+ private:
+  const mironov_omp::MatrixCRS* A{};
+  const mironov_omp::MatrixCRS* B{};
+  mironov_omp::MatrixCRS C;
+  mironov_omp::MatrixCRS* c_out{};
+  int K{};
+};
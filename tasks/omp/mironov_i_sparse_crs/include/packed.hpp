@@ -0,0 +1,53 @@
+// Copyright 2024 Mironov Ilya
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "omp/mironov_i_sparse_crs/include/ops_omp.hpp"
+
+namespace mironov_omp {
+enum class IndexEncoding {
+  Int32,        // plain 4 byte column indices
+  Block16,      // columns cut into panels of 65536, 2 byte indices local to the panel
+  DeltaVarint,  // per row, the gap to the previous column as a 7-bit varint; 1 byte for gaps below 128
+};
+
+// CRS with compressed column indices and optionally single precision values. Only the arrays of the chosen encoding
+// and precision are filled. The kernels decode the indices on the fly and always accumulate in double.
+class MatrixPackedCRS {
+ public:
+  int N;
+  int Cols;
+  int NZ;
+  IndexEncoding Encoding;
+  bool SinglePrecision;
+  // Int32 and DeltaVarint: N + 1 nonzero offsets. Block16: every panel is a CRS matrix of its own, with the row
+  // offsets of panel p at RowIndex[p * (N + 1)], and the values are stored panel after panel.
+  std::vector<int> RowIndex;
+  std::vector<int> Col32;
+  std::vector<uint16_t> Col16;
+  std::vector<int> ByteIndex;  // DeltaVarint: N + 1 offsets into ColBytes
+  std::vector<uint8_t> ColBytes;
+  std::vector<double> Value;
+  std::vector<float> ValueF;
+
+  explicit MatrixPackedCRS(int n = 0, int cols = 0, IndexEncoding encoding = IndexEncoding::Int32,
+                           bool single_precision = false);
+  int Panels() const { return Encoding == IndexEncoding::Block16 ? (Cols + 0xffff) / 0x10000 : 1; }
+  // bytes of index and value arrays, i.e. the traffic of one SpMV besides x and y
+  size_t Bytes() const;
+};
+
+// Converts a CRS matrix with cols columns. Single precision rounds the values to float.
+MatrixPackedCRS Pack(const MatrixCRS& A, int cols, IndexEncoding encoding, bool single_precision = false);
+MatrixCRS Unpack(const MatrixPackedCRS& A);
+// The encoding with the fewest index bytes for A, row offsets included.
+IndexEncoding ChooseEncoding(const MatrixCRS& A, int cols);
+
+// y = A * x
+void MultiplicateVector(const MatrixPackedCRS& A, const double* x, double* y);
+// C = A * B in double precision, requires A.Cols == B.N
+MatrixCRS Multiplicate(const MatrixPackedCRS& A, const MatrixPackedCRS& B);
+}  // namespace mironov_omp
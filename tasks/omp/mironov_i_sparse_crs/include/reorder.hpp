@@ -0,0 +1,27 @@
+// Copyright 2024 Mironov Ilya
+#pragma once
+
+#include <vector>
+
+#include "omp/mironov_i_sparse_crs/include/ops_omp.hpp"
+
+namespace mironov_omp {
+// Orderings of a square matrix computed on the pattern of A + A^T. A permutation is stored as perm[new] = old.
+// Reverse Cuthill-McKee: breadth-first levels from a pseudo-peripheral node, neighbours by increasing degree,
+// reversed; keeps the nonzeros close to the diagonal.
+std::vector<int> ReverseCuthillMcKee(const MatrixCRS& A);
+// Nested dissection with level-structure bisection: the middle breadth-first level separates the graph into two
+// halves that are ordered first, recursively up to the given depth, and the separator goes last.
+std::vector<int> NestedDissection(const MatrixCRS& A, int depth = 8);
+std::vector<int> InversePermutation(const std::vector<int>& perm);
+
+// P * A * P^T, i.e. B(i, j) = A(perm[i], perm[j]); columns stay sorted. Applying it with InversePermutation(perm)
+// un-permutes a result computed in the new order, e.g. C = A * B from (P A P^T) (P B P^T).
+MatrixCRS PermuteSymmetric(const MatrixCRS& A, const std::vector<int>& perm);
+// out[i] = x[perm[i]]
+void PermuteVector(const double* x, const std::vector<int>& perm, double* out);
+// out[perm[i]] = x[i], the inverse of PermuteVector
+void UnpermuteVector(const double* x, const std::vector<int>& perm, double* out);
+// max |i - j| over the nonzeros
+int Bandwidth(const MatrixCRS& A);
+}  // namespace mironov_omp
@@ -0,0 +1,38 @@
+// Copyright 2024 Mironov Ilya
+#pragma once
+
+#include <algorithm>
+#include <limits>
+
+#include "omp/mironov_i_sparse_crs/include/ops_omp.hpp"
+
+namespace mironov_omp {
+// A semiring supplies the + and * of the product. Zero() is the identity of Add and stands for a missing entry.
+struct PlusTimes {
+  static double Zero() { return 0.0; }
+  static double Add(double a, double b) { return a + b; }
+  static double Multiply(double a, double b) { return a * b; }
+};
+
+// shortest paths: entries are edge lengths, C(i, j) the shortest two-hop path
+struct MinPlus {
+  static double Zero() { return std::numeric_limits<double>::infinity(); }
+  static double Add(double a, double b) { return std::min(a, b); }
+  static double Multiply(double a, double b) { return a + b; }
+};
+
+// reachability: every stored entry is true, the values are 1.0
+struct OrAnd {
+  static double Zero() { return 0.0; }
+  static double Add(double a, double b) { return a != 0.0 || b != 0.0 ? 1.0 : 0.0; }
+  static double Multiply(double a, double b) { return a != 0.0 && b != 0.0 ? 1.0 : 0.0; }
+};
+
+// C = A * B over the semiring S, k is the number of columns of B. With a mask only the positions stored in mask
+// (n x k, values ignored) are computed, or with complement only the positions it does not store; rows with an empty
+// mask are skipped altogether. C stores every position reached by some product A(i, l) * B(l, j).
+// Instantiated for PlusTimes, MinPlus and OrAnd.
+template <typename S>
+MatrixCRS Multiplicate(const MatrixCRS& A, const MatrixCRS& B, int k, const MatrixCRS* mask = nullptr,
+                       bool complement = false);
+}  // namespace mironov_omp
@@ -0,0 +1,44 @@
+// Copyright 2024 Mironov Ilya
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "omp/mironov_i_sparse_crs/include/ops_omp.hpp"
+
+namespace mironov_omp {
+// Panel files hold a matrix cut into row panels or column panels. Every panel is a CRS block with global column
+// indices, laid out so that it can be used straight from a memory mapping, and a table of panel offsets at the end
+// of the file lets panels be appended one by one.
+
+// Writes A (A.N x cols) as panels of panel_size rows, or of panel_size columns with by_columns.
+bool WritePanels(const std::string& path, const MatrixCRS& A, int cols, int panel_size, bool by_columns);
+// Reads a whole panel file of either kind back into one CRS matrix.
+bool ReadPanels(const std::string& path, MatrixCRS& A, int& rows, int& cols);
+// Reads only the sizes of the matrix in a panel file and whether it is cut into column panels.
+bool ReadPanelShape(const std::string& path, int& rows, int& cols, bool& by_columns);
+// Out-of-core C = A * B: A is a file of row panels, B a file of column panels, C is written to c_path as row panels.
+// The inputs are mapped and streamed panel by panel; only the current A panel, the current and the prefetched B
+// panel and two C panels are resident: the next panels are requested from the kernel while the current ones are
+// multiplied, pages of finished panels are dropped, and every C panel is written by a background thread while the
+// next one is computed. Returns false if a file cannot be read or written or the sizes do not match.
+bool MultiplicateOutOfCore(const std::string& a_path, const std::string& b_path, const std::string& c_path);
+}  // namespace mironov_omp
+
+// MultiplicateOutOfCore as a task: inputs[0] and inputs[1] point to the std::string paths of the A row panel file and
+// of the B column panel file, outputs[0] to the std::string path the C row panels are written to. The sizes are read
+// from the files, so no counts are needed; C stays on disk and post_processing has nothing to copy.
+class MironovIOMPStream : public ppc::core::Task {
+ public:
+  explicit MironovIOMPStream(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+  bool pre_processing() override;
+  bool validation() override;
+  bool run() override;
+  bool post_processing() override;
+
+ private:
+  std::string a_path;
+  std::string b_path;
+  std::string c_path;
+};
@@ -3,10 +3,186 @@
 #include <omp.h>
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "core/perf/include/perf.hpp"
+#include "omp/mironov_i_sparse_crs/include/bcsr.hpp"
+#include "omp/mironov_i_sparse_crs/include/mtx_io.hpp"
 #include "omp/mironov_i_sparse_crs/include/ops_omp.hpp"
+#include "omp/mironov_i_sparse_crs/include/packed.hpp"
+#include "omp/mironov_i_sparse_crs/include/reorder.hpp"
+#include "omp/mironov_i_sparse_crs/include/semiring.hpp"
+#include "omp/mironov_i_sparse_crs/include/stream.hpp"
+
+namespace {
+// n x n matrix with row_nz random entries per row, built directly in CRS; a skewed matrix has power-law rows instead,
+// row i gets max(row_nz, n / (i + 1)) draws, with the dense rows on top as in a degree-sorted graph
+mironov_omp::MatrixCRS GenerateCRS(int n, int row_nz, bool skewed = false) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> col(0, n - 1);
+  std::uniform_real_distribution<double> value(-10.0, 10.0);
+  mironov_omp::MatrixCRS a(n, 0);
+  for (int i = 0; i < n; i++) {
+    std::vector<int> cols(skewed ? std::max(row_nz, n / (i + 1)) : row_nz);
+    for (auto &c : cols) {
+      c = col(gen);
+    }
+    std::sort(cols.begin(), cols.end());
+    cols.erase(std::unique(cols.begin(), cols.end()), cols.end());
+    for (int c : cols) {
+      a.Col.push_back(c);
+      a.Value.push_back(value(gen));
+    }
+    a.RowIndex[i + 1] = static_cast<int>(a.Col.size());
+  }
+  a.NZ = a.RowIndex[n];
+  return a;
+}
+
+// CRS matrix of a side x side grid of nodes with 3 unknowns each, every node coupled to its 8 neighbours, so the
+// nonzeros come in dense 3 x 3 blocks
+mironov_omp::MatrixCRS GenerateFemCRS(int side) {
+  int n = 3 * side * side;
+  mironov_omp::MatrixCRS a(n, 0);
+  for (int row = 0; row < n; row++) {
+    int u = row / 3;
+    for (int dy = -1; dy <= 1; dy++) {
+      for (int dx = -1; dx <= 1; dx++) {
+        int y = u / side + dy;
+        int x = u % side + dx;
+        if (y < 0 || y >= side || x < 0 || x >= side) {
+          continue;
+        }
+        for (int j = 0; j < 3; j++) {
+          a.Col.push_back(3 * (y * side + x) + j);
+          a.Value.push_back(dx == 0 && dy == 0 && row % 3 == j ? 8.0 : -1.0 + 0.1 * j);
+        }
+      }
+    }
+    a.RowIndex[row + 1] = static_cast<int>(a.Col.size());
+  }
+  a.NZ = a.RowIndex[n];
+  return a;
+}
+
+// Largest number of multiply-adds of A * A given to one of parts ranges of equal row count, relative to the average;
+// this is the slowdown over a perfect split that plain row partitioning would suffer on the matrix.
+double RowSplitImbalance(const mironov_omp::MatrixCRS &a, int parts) {
+  std::vector<double> flops(parts, 0.0);
+  for (int i = 0; i < a.N; i++) {
+    for (int j = a.RowIndex[i]; j < a.RowIndex[i + 1]; j++) {
+      flops[static_cast<int64_t>(i) * parts / a.N] += a.RowIndex[a.Col[j] + 1] - a.RowIndex[a.Col[j]];
+    }
+  }
+  double total = 0.0;
+  for (double f : flops) {
+    total += f;
+  }
+  return *std::max_element(flops.begin(), flops.end()) * parts / total;
+}
+
+// the FEM matrix with its unknowns numbered at random, as a mesh generator without locality would hand it over
+mironov_omp::MatrixCRS GenerateShuffledFemCRS(int side) {
+  mironov_omp::MatrixCRS a = GenerateFemCRS(side);
+  std::vector<int> perm(a.N);
+  std::iota(perm.begin(), perm.end(), 0);
+  std::shuffle(perm.begin(), perm.end(), std::mt19937(42));
+  return mironov_omp::PermuteSymmetric(a, perm);
+}
+
+// strictly lower triangle of a random undirected graph with about 2 * degree neighbours per vertex
+mironov_omp::MatrixCRS GenerateLowerGraph(int n, int degree) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> vertex(0, n - 1);
+  std::vector<std::pair<int, int>> edges;
+  for (int v = 0; v < n; v++) {
+    for (int e = 0; e < degree; e++) {
+      int u = vertex(gen);
+      if (u != v) {
+        edges.emplace_back(std::max(u, v), std::min(u, v));
+      }
+    }
+  }
+  std::sort(edges.begin(), edges.end());
+  edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+  mironov_omp::MatrixCRS l(n, static_cast<int>(edges.size()));
+  for (size_t e = 0; e < edges.size(); e++) {
+    l.RowIndex[edges[e].first + 1]++;
+    l.Col[e] = edges[e].second;
+    l.Value[e] = 1.0;
+  }
+  for (int i = 0; i < n; i++) {
+    l.RowIndex[i + 1] += l.RowIndex[i];
+  }
+  return l;
+}
+
+// Task whose run() is body(), so that a kernel without a TaskData interface is measured by ppc::core::Perf.
+class KernelTask : public ppc::core::Task {
+ public:
+  explicit KernelTask(std::function<void()> body_)
+      : Task(std::make_shared<ppc::core::TaskData>()), body(std::move(body_)) {}
+  bool validation() override {
+    internal_order_test();
+    return true;
+  }
+  bool pre_processing() override {
+    internal_order_test();
+    return true;
+  }
+  bool run() override {
+    internal_order_test();
+    body();
+    return true;
+  }
+  bool post_processing() override {
+    internal_order_test();
+    return true;
+  }
+
+ private:
+  std::function<void()> body;
+};
+
+// Measures body() with Perf::task_run and prints the statistic with note under it. A first measurement of a single
+// call picks how many calls fill about a quarter of a second, well inside the bounds the statistic accepts. Returns
+// the seconds of one call.
+double MeasureKernel(const std::string &note, const std::function<void()> &body) {
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 1;
+  perfAttr->current_timer = [&] { return omp_get_wtime(); };
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+  ppc::core::Perf perfAnalyzer(std::make_shared<KernelTask>(body));
+  perfAnalyzer.task_run(perfAttr, perfResults);
+  perfAttr->num_running = std::clamp<uint64_t>(static_cast<uint64_t>(0.25 / std::max(perfResults->time_sec, 1e-6)) + 1,
+                                              1, 1000);
+  perfAnalyzer.task_run(perfAttr, perfResults);
+  perfResults->notes.insert(perfResults->notes.begin(),
+                            note + " (" + std::to_string(perfAttr->num_running) + " calls)");
+  ppc::core::Perf::print_perf_statistic(perfResults);
+  return perfResults->time_sec / static_cast<double>(perfAttr->num_running);
+}
+
+const char *EncodingName(mironov_omp::IndexEncoding encoding) {
+  switch (encoding) {
+    case mironov_omp::IndexEncoding::Int32:
+      return "int32";
+    case mironov_omp::IndexEncoding::Block16:
+      return "block16";
+    default:
+      return "delta varint";
+  }
+}
+}  // namespace
 
 TEST(omp_mironov_i_sparse_crs_perf_test, test_pipeline_run) {
   int n = 2000;
@@ -84,3 +260,477 @@ TEST(omp_mironov_i_sparse_crs_perf_test, test_task_run) {
   perfAnalyzer->task_run(perfAttr, perfResults);
   ppc::core::Perf::print_perf_statistic(perfResults);
 }
+
+// Loading a Matrix Market file has to stay well below the cost of the multiplication it feeds.
+TEST(omp_mironov_i_sparse_crs_mtx_perf_test, test_read) {
+  int n = 200000;
+  mironov_omp::MatrixCRS a = GenerateCRS(n, 10);
+  std::string path = (std::filesystem::temp_directory_path() / "mironov_omp_perf_read.mtx").string();
+  ASSERT_TRUE(mironov_omp::WriteMatrixMarket(path, a, n));
+  auto mib = static_cast<double>(std::filesystem::file_size(path)) / (1 << 20);
+
+  mironov_omp::MatrixCRS b;
+  int rows;
+  int cols;
+  bool read = false;
+  std::ostringstream note;
+  note << "mtx read, " << mib << " MiB";
+  MeasureKernel(note.str(), [&] { read = mironov_omp::ReadMatrixMarket(path, b, rows, cols); });
+  std::filesystem::remove(path);
+  ASSERT_TRUE(read);
+  ASSERT_EQ(a.Col, b.Col);
+
+  MeasureKernel("A * A of the matrix read, nnz(A) = " + std::to_string(b.NZ), [&] {
+    mironov_omp::MatrixCRS c = mironov_omp::MultiplicateSymbolic(b, b, n);
+    mironov_omp::MultiplicateNumeric(b, b, n, c);
+  });
+}
+
+TEST(omp_mironov_i_sparse_crs_mtx_perf_test, test_write) {
+  int n = 200000;
+  mironov_omp::MatrixCRS a = GenerateCRS(n, 10);
+  std::string path = (std::filesystem::temp_directory_path() / "mironov_omp_perf_write.mtx").string();
+
+  bool written = false;
+  MeasureKernel("mtx write, nnz = " + std::to_string(a.NZ),
+                [&] { written = mironov_omp::WriteMatrixMarket(path, a, n); });
+  std::filesystem::remove(path);
+  ASSERT_TRUE(written);
+}
+
+// Power-law rows: the kernels split work by multiply-adds and nonzeros, not by rows, so the dense rows on top
+// do not end up on a single thread. Each kernel is measured against the same product with the rows divided evenly
+// between the threads.
+TEST(omp_mironov_i_sparse_crs_skewed_perf_test, test_spgemm) {
+  int n = 50000;
+  mironov_omp::MatrixCRS a = GenerateCRS(n, 4, true);
+  mironov_omp::MatrixCRS c = mironov_omp::MultiplicateSymbolic(a, a, n);
+  mironov_omp::MatrixCRS c_rows = c;
+  int threads = omp_get_max_threads();
+
+  std::ostringstream note;
+  note << "skewed A * A numeric phase, row split, nnz(A) = " << a.NZ << ", nnz(C) = " << c.NZ
+       << "; the busiest of " << threads << " threads gets " << RowSplitImbalance(a, threads) << "x the average work";
+  double rows_time = MeasureKernel(note.str(), [&] {
+#pragma omp parallel
+    {
+      std::vector<double> acc(n, 0.0);
+#pragma omp for schedule(static)
+      for (int i = 0; i < n; i++) {
+        for (int j = a.RowIndex[i]; j < a.RowIndex[i + 1]; j++) {
+          for (int m = a.RowIndex[a.Col[j]]; m < a.RowIndex[a.Col[j] + 1]; m++) {
+            acc[a.Col[m]] += a.Value[j] * a.Value[m];
+          }
+        }
+        for (int j = c_rows.RowIndex[i]; j < c_rows.RowIndex[i + 1]; j++) {
+          c_rows.Value[j] = acc[c_rows.Col[j]];
+          acc[c_rows.Col[j]] = 0.0;
+        }
+      }
+    }
+  });
+  MeasureKernel("skewed A * A numeric phase, split by multiply-adds; the row split took " + std::to_string(rows_time) +
+                    " s per call",
+                [&] { mironov_omp::MultiplicateNumeric(a, a, n, c); });
+  for (int j = 0; j < c.NZ; j++) {
+    ASSERT_NEAR(c_rows.Value[j], c.Value[j], 1e-9 * (1.0 + std::abs(c_rows.Value[j])));
+  }
+}
+
+TEST(omp_mironov_i_sparse_crs_skewed_perf_test, test_spmv) {
+  int n = 300000;
+  mironov_omp::MatrixCRS a = GenerateCRS(n, 4, true);
+  std::vector<double> x(n, 1.0);
+  std::vector<double> y(n);
+  std::vector<double> y_rows(n);
+  double bytes = 12.0 * a.NZ + 4.0 * (n + 1) + 16.0 * n;
+
+  std::ostringstream note;
+  note << "skewed SpMV, row split, nnz = " << a.NZ << ", " << bytes / (1 << 20) << " MiB moved per call";
+  double rows_time = MeasureKernel(note.str(), [&] {
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; i++) {
+      double sum = 0.0;
+      for (int j = a.RowIndex[i]; j < a.RowIndex[i + 1]; j++) {
+        sum += a.Value[j] * x[a.Col[j]];
+      }
+      y_rows[i] = sum;
+    }
+  });
+  MeasureKernel("skewed SpMV, merge path; the row split took " + std::to_string(rows_time) + " s per call",
+                [&] { mironov_omp::MultiplicateVector(a, x.data(), y.data()); });
+  for (int i = 0; i < n; i++) {
+    ASSERT_NEAR(y_rows[i], y[i], 1e-9 * (1.0 + std::abs(y_rows[i])));
+  }
+}
+// Matrices with dense 3 x 3 blocks: one column index per block instead of one per value
+TEST(omp_mironov_i_sparse_crs_bcsr_perf_test, test_spmv) {
+  int side = 300;
+  mironov_omp::MatrixCRS a = GenerateFemCRS(side);
+  int n = a.N;
+  auto [r, c] = mironov_omp::ChooseBlockSize(a, n);
+  mironov_omp::MatrixBCSR b = mironov_omp::ToBCSR(a, n, r, c);
+  std::vector<double> x(n, 1.0);
+  std::vector<double> y(n);
+  std::vector<double> y_blocks(n);
+
+  MeasureKernel("FEM SpMV, CRS, nnz = " + std::to_string(a.NZ),
+                [&] { mironov_omp::MultiplicateVector(a, x.data(), y.data()); });
+  std::ostringstream note;
+  note << "FEM SpMV, BCSR " << r << "x" << c << ", fill " << mironov_omp::FillRatio(a, n, r, c);
+  MeasureKernel(note.str(), [&] { mironov_omp::MultiplicateVector(b, x.data(), y_blocks.data()); });
+  for (int i = 0; i < n; i++) {
+    ASSERT_NEAR(y[i], y_blocks[i], 1e-9);
+  }
+}
+
+TEST(omp_mironov_i_sparse_crs_bcsr_perf_test, test_spgemm) {
+  int side = 100;
+  mironov_omp::MatrixCRS a = GenerateFemCRS(side);
+  int n = a.N;
+  mironov_omp::MatrixBCSR b = mironov_omp::ToBCSR(a, n, 3, 3);
+
+  mironov_omp::MatrixCRS c;
+  MeasureKernel("FEM A * A, CRS, nnz(A) = " + std::to_string(a.NZ), [&] {
+    c = mironov_omp::MultiplicateSymbolic(a, a, n);
+    mironov_omp::MultiplicateNumeric(a, a, n, c);
+  });
+  mironov_omp::MatrixBCSR c_blocks;
+  MeasureKernel("FEM A * A, BCSR 3x3", [&] { c_blocks = mironov_omp::Multiplicate(b, b); });
+  ASSERT_EQ(c_blocks.Blocks() * 9, c.NZ);
+}
+
+// Same products on a randomly numbered mesh before and after reordering; the orderings are measured separately, as
+// they are paid once per sparsity pattern
+TEST(omp_mironov_i_sparse_crs_reorder_perf_test, test_spmv) {
+  int side = 300;
+  mironov_omp::MatrixCRS a = GenerateShuffledFemCRS(side);
+  int n = a.N;
+  std::vector<double> x(n, 1.0);
+  std::vector<double> y(n);
+  std::vector<double> y_perm(n);
+  std::vector<double> y_back(n);
+  std::vector<double> x_perm(n);
+
+  MeasureKernel("shuffled FEM SpMV, bandwidth " + std::to_string(mironov_omp::Bandwidth(a)),
+                [&] { mironov_omp::MultiplicateVector(a, x.data(), y.data()); });
+
+  for (int ordering = 0; ordering < 2; ordering++) {
+    std::string name = ordering == 0 ? "RCM" : "nested dissection";
+    std::vector<int> perm;
+    mironov_omp::MatrixCRS b;
+    MeasureKernel("shuffled FEM, " + name + " ordering and permutation", [&] {
+      perm = ordering == 0 ? mironov_omp::ReverseCuthillMcKee(a) : mironov_omp::NestedDissection(a);
+      b = mironov_omp::PermuteSymmetric(a, perm);
+    });
+    mironov_omp::PermuteVector(x.data(), perm, x_perm.data());
+    MeasureKernel("shuffled FEM SpMV after " + name + ", bandwidth " + std::to_string(mironov_omp::Bandwidth(b)),
+                  [&] { mironov_omp::MultiplicateVector(b, x_perm.data(), y_perm.data()); });
+    mironov_omp::UnpermuteVector(y_perm.data(), perm, y_back.data());
+    for (int i = 0; i < n; i++) {
+      ASSERT_NEAR(y[i], y_back[i], 1e-9);
+    }
+  }
+}
+
+TEST(omp_mironov_i_sparse_crs_reorder_perf_test, test_spgemm) {
+  int side = 100;
+  mironov_omp::MatrixCRS a = GenerateShuffledFemCRS(side);
+  int n = a.N;
+
+  mironov_omp::MatrixCRS c;
+  MeasureKernel("shuffled FEM A * A, nnz(A) = " + std::to_string(a.NZ), [&] {
+    c = mironov_omp::MultiplicateSymbolic(a, a, n);
+    mironov_omp::MultiplicateNumeric(a, a, n, c);
+  });
+
+  for (int ordering = 0; ordering < 2; ordering++) {
+    std::string name = ordering == 0 ? "RCM" : "nested dissection";
+    std::vector<int> perm = ordering == 0 ? mironov_omp::ReverseCuthillMcKee(a) : mironov_omp::NestedDissection(a);
+    mironov_omp::MatrixCRS b = mironov_omp::PermuteSymmetric(a, perm);
+    mironov_omp::MatrixCRS c_perm;
+    MeasureKernel("shuffled FEM A * A after " + name, [&] {
+      c_perm = mironov_omp::MultiplicateSymbolic(b, b, n);
+      mironov_omp::MultiplicateNumeric(b, b, n, c_perm);
+    });
+    mironov_omp::MatrixCRS c_back;
+    MeasureKernel("un-permuting C of " + name,
+                  [&] { c_back = mironov_omp::PermuteSymmetric(c_perm, mironov_omp::InversePermutation(perm)); });
+    ASSERT_EQ(c.Col, c_back.Col);
+  }
+}
+
+// SpMV and SpGEMM with compressed indices and float values against plain CRS; SpMV is bound by the bytes of A
+TEST(omp_mironov_i_sparse_crs_packed_perf_test, test_spmv) {
+  int side = 300;
+  mironov_omp::MatrixCRS a = GenerateFemCRS(side);
+  int n = a.N;
+  std::vector<double> x(n, 1.0);
+  std::vector<double> y(n);
+  std::vector<double> y_packed(n);
+
+  std::ostringstream note;
+  note << "FEM SpMV, CRS, " << (12.0 * a.NZ + 4.0 * (n + 1)) / a.NZ << " B/nz";
+  MeasureKernel(note.str(), [&] { mironov_omp::MultiplicateVector(a, x.data(), y.data()); });
+
+  for (auto encoding : {mironov_omp::IndexEncoding::Int32, mironov_omp::IndexEncoding::Block16,
+                        mironov_omp::IndexEncoding::DeltaVarint}) {
+    for (bool single_precision : {false, true}) {
+      mironov_omp::MatrixPackedCRS packed = mironov_omp::Pack(a, n, encoding, single_precision);
+      note.str("");
+      note << "FEM SpMV, " << EncodingName(encoding) << (single_precision ? " float, " : " double, ")
+           << static_cast<double>(packed.Bytes()) / a.NZ << " B/nz";
+      MeasureKernel(note.str(), [&] { mironov_omp::MultiplicateVector(packed, x.data(), y_packed.data()); });
+      for (int i = 0; i < n; i++) {
+        ASSERT_NEAR(y[i], y_packed[i], 1e-4);
+      }
+    }
+  }
+}
+
+TEST(omp_mironov_i_sparse_crs_packed_perf_test, test_spgemm) {
+  int side = 100;
+  mironov_omp::MatrixCRS a = GenerateFemCRS(side);
+  int n = a.N;
+
+  mironov_omp::MatrixCRS c;
+  MeasureKernel("FEM A * A, CRS, nnz(A) = " + std::to_string(a.NZ), [&] {
+    c = mironov_omp::MultiplicateSymbolic(a, a, n);
+    mironov_omp::MultiplicateNumeric(a, a, n, c);
+  });
+  mironov_omp::IndexEncoding encoding = mironov_omp::ChooseEncoding(a, n);
+  mironov_omp::MatrixPackedCRS packed = mironov_omp::Pack(a, n, encoding, true);
+  mironov_omp::MatrixCRS c_packed;
+  std::ostringstream note;
+  note << "FEM A * A, packed " << EncodingName(encoding) << " float, " << static_cast<double>(packed.Bytes()) / a.NZ
+       << " B/nz";
+  MeasureKernel(note.str(), [&] { c_packed = mironov_omp::Multiplicate(packed, packed); });
+  ASSERT_EQ(c.Col, c_packed.Col);
+}
+
+// Graph kernels on the semiring engine: the mask keeps the products that are thrown away anyway out of the result
+TEST(omp_mironov_i_sparse_crs_semiring_perf_test, test_triangles) {
+  mironov_omp::MatrixCRS l = GenerateLowerGraph(200000, 16);
+  int n = l.N;
+
+  double triangles = 0.0;
+  MeasureKernel("triangles of a graph with " + std::to_string(l.NZ) + " edges, masked product", [&] {
+    mironov_omp::MatrixCRS c = mironov_omp::Multiplicate<mironov_omp::PlusTimes>(l, l, n, &l);
+    triangles = 0.0;
+    for (double v : c.Value) {
+      triangles += v;
+    }
+  });
+
+  // the same count from the full product, filtered by L afterwards
+  double full_triangles = 0.0;
+  MeasureKernel("the same triangles, full product then filter", [&] {
+    mironov_omp::MatrixCRS full = mironov_omp::Multiplicate<mironov_omp::PlusTimes>(l, l, n);
+    double sum = 0.0;
+#pragma omp parallel for reduction(+ : sum)
+    for (int i = 0; i < n; i++) {
+      int j = full.RowIndex[i];
+      for (int m = l.RowIndex[i]; m < l.RowIndex[i + 1]; m++) {
+        while (j < full.RowIndex[i + 1] && full.Col[j] < l.Col[m]) {
+          j++;
+        }
+        if (j < full.RowIndex[i + 1] && full.Col[j] == l.Col[m]) {
+          sum += full.Value[j];
+        }
+      }
+    }
+    full_triangles = sum;
+  });
+  ASSERT_DOUBLE_EQ(triangles, full_triangles);
+}
+
+TEST(omp_mironov_i_sparse_crs_semiring_perf_test, test_bfs) {
+  mironov_omp::MatrixCRS l = GenerateLowerGraph(200000, 4);
+  int n = l.N;
+  // symmetric adjacency from the lower triangle
+  mironov_omp::MatrixCRS a(n, 0);
+  {
+    std::vector<std::vector<int>> rows(n);
+    for (int i = 0; i < n; i++) {
+      for (int j = l.RowIndex[i]; j < l.RowIndex[i + 1]; j++) {
+        rows[i].push_back(l.Col[j]);
+        rows[l.Col[j]].push_back(i);
+      }
+    }
+    for (int i = 0; i < n; i++) {
+      std::sort(rows[i].begin(), rows[i].end());
+      a.Col.insert(a.Col.end(), rows[i].begin(), rows[i].end());
+      a.RowIndex[i + 1] = static_cast<int>(a.Col.size());
+    }
+    a.NZ = a.RowIndex[n];
+    a.Value.assign(a.NZ, 1.0);
+  }
+  int sources = 16;
+  mironov_omp::MatrixCRS sources_frontier(sources, sources);
+  for (int q = 0; q < sources; q++) {
+    sources_frontier.RowIndex[q + 1] = q + 1;
+    sources_frontier.Col[q] = q * (n / sources);
+    sources_frontier.Value[q] = 1.0;
+  }
+
+  int depth = 0;
+  mironov_omp::MatrixCRS visited;
+  MeasureKernel(std::to_string(sources) + "-source BFS on a graph with " + std::to_string(a.NZ / 2) + " edges", [&] {
+    mironov_omp::MatrixCRS frontier = sources_frontier;
+    visited = sources_frontier;
+    depth = 0;
+    while (frontier.NZ > 0) {
+      frontier = mironov_omp::Multiplicate<mironov_omp::OrAnd>(frontier, a, n, &visited, true);
+      // visited += frontier, row by row; both are sorted
+      mironov_omp::MatrixCRS merged(sources, visited.NZ + frontier.NZ);
+      for (int q = 0; q < sources; q++) {
+        auto v = visited.Col.begin();
+        auto f = frontier.Col.begin();
+        auto end = std::merge(v + visited.RowIndex[q], v + visited.RowIndex[q + 1], f + frontier.RowIndex[q],
+                              f + frontier.RowIndex[q + 1], merged.Col.begin() + merged.RowIndex[q]);
+        merged.RowIndex[q + 1] = static_cast<int>(end - merged.Col.begin());
+      }
+      std::fill(merged.Value.begin(), merged.Value.end(), 1.0);
+      visited = std::move(merged);
+      depth++;
+    }
+  });
+  ASSERT_GT(depth, 1);
+  ASSERT_GT(visited.NZ, sources);
+}
+
+// Out-of-core product from panel files on disk against the same product in memory; the files stay in the page
+// cache here, so this measures the overhead of panelling and of writing C rather than disk speed
+TEST(omp_mironov_i_sparse_crs_stream_perf_test, test_multiplicate) {
+  int n = 100000;
+  mironov_omp::MatrixCRS a = GenerateCRS(n, 8);
+  std::string a_path = (std::filesystem::temp_directory_path() / "mironov_omp_perf_a.panels").string();
+  std::string b_path = (std::filesystem::temp_directory_path() / "mironov_omp_perf_b.panels").string();
+  std::string c_path = (std::filesystem::temp_directory_path() / "mironov_omp_perf_c.panels").string();
+  ASSERT_TRUE(mironov_omp::WritePanels(a_path, a, n, 16384, false));
+  ASSERT_TRUE(mironov_omp::WritePanels(b_path, a, n, 32768, true));
+
+  mironov_omp::MatrixCRS c;
+  MeasureKernel("A * A in memory, nnz(A) = " + std::to_string(a.NZ), [&] {
+    c = mironov_omp::MultiplicateSymbolic(a, a, n);
+    mironov_omp::MultiplicateNumeric(a, a, n, c);
+  });
+  bool streamed = false;
+  MeasureKernel("A * A streamed from panel files",
+                [&] { streamed = mironov_omp::MultiplicateOutOfCore(a_path, b_path, c_path); });
+  ASSERT_TRUE(streamed);
+
+  mironov_omp::MatrixCRS c_stream;
+  int rows = 0;
+  int cols = 0;
+  ASSERT_TRUE(mironov_omp::ReadPanels(c_path, c_stream, rows, cols));
+  ASSERT_EQ(c.Col, c_stream.Col);
+  std::filesystem::remove(a_path);
+  std::filesystem::remove(b_path);
+  std::filesystem::remove(c_path);
+}
+
+TEST(omp_mironov_i_sparse_crs_stream_perf_test, test_pipeline_run) {
+  int n = 50000;
+  mironov_omp::MatrixCRS a = GenerateCRS(n, 8);
+  std::string a_path = (std::filesystem::temp_directory_path() / "mironov_omp_pipeline_a.panels").string();
+  std::string b_path = (std::filesystem::temp_directory_path() / "mironov_omp_pipeline_b.panels").string();
+  std::string c_path = (std::filesystem::temp_directory_path() / "mironov_omp_pipeline_c.panels").string();
+  ASSERT_TRUE(mironov_omp::WritePanels(a_path, a, n, 16384, false));
+  ASSERT_TRUE(mironov_omp::WritePanels(b_path, a, n, 32768, true));
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(&a_path));
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(&b_path));
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(&c_path));
+
+  // Create Task
+  auto testTask = std::make_shared<MironovIOMPStream>(taskData);
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  perfAttr->current_timer = [&] { return omp_get_wtime(); };
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  auto perfAnalyzer = std::make_shared<ppc::core::Perf>(testTask);
+  perfAnalyzer->pipeline_run(perfAttr, perfResults);
+  ppc::core::Perf::print_perf_statistic(perfResults);
+
+  mironov_omp::MatrixCRS c;
+  int rows = 0;
+  int cols = 0;
+  ASSERT_TRUE(mironov_omp::ReadPanels(c_path, c, rows, cols));
+  ASSERT_EQ(n, rows);
+  std::filesystem::remove(a_path);
+  std::filesystem::remove(b_path);
+  std::filesystem::remove(c_path);
+}
+
+TEST(omp_mironov_i_sparse_crs_stream_perf_test, test_task_run) {
+  int n = 50000;
+  mironov_omp::MatrixCRS a = GenerateCRS(n, 8);
+  std::string a_path = (std::filesystem::temp_directory_path() / "mironov_omp_task_a.panels").string();
+  std::string b_path = (std::filesystem::temp_directory_path() / "mironov_omp_task_b.panels").string();
+  std::string c_path = (std::filesystem::temp_directory_path() / "mironov_omp_task_c.panels").string();
+  ASSERT_TRUE(mironov_omp::WritePanels(a_path, a, n, 16384, false));
+  ASSERT_TRUE(mironov_omp::WritePanels(b_path, a, n, 32768, true));
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(&a_path));
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(&b_path));
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(&c_path));
+
+  // Create Task
+  auto testTask = std::make_shared<MironovIOMPStream>(taskData);
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  perfAttr->current_timer = [&] { return omp_get_wtime(); };
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  auto perfAnalyzer = std::make_shared<ppc::core::Perf>(testTask);
+  perfAnalyzer->task_run(perfAttr, perfResults);
+  ppc::core::Perf::print_perf_statistic(perfResults);
+
+  mironov_omp::MatrixCRS c;
+  int rows = 0;
+  int cols = 0;
+  ASSERT_TRUE(mironov_omp::ReadPanels(c_path, c, rows, cols));
+  ASSERT_EQ(n, rows);
+  std::filesystem::remove(a_path);
+  std::filesystem::remove(b_path);
+  std::filesystem::remove(c_path);
+}
+
+TEST(omp_mironov_i_sparse_crs_stream_perf_test, test_write_read) {
+  int n = 300000;
+  mironov_omp::MatrixCRS a = GenerateCRS(n, 16);
+  std::string path = (std::filesystem::temp_directory_path() / "mironov_omp_perf.panels").string();
+
+  bool written = false;
+  MeasureKernel("panel file write, nnz = " + std::to_string(a.NZ),
+                [&] { written = mironov_omp::WritePanels(path, a, n, 50000, false); });
+  ASSERT_TRUE(written);
+  std::ostringstream note;
+  note << "panel file read, " << static_cast<double>(std::filesystem::file_size(path)) / (1 << 20) << " MiB";
+  mironov_omp::MatrixCRS back;
+  bool read = false;
+  MeasureKernel(note.str(), [&] {
+    int rows = 0;
+    int cols = 0;
+    read = mironov_omp::ReadPanels(path, back, rows, cols);
+  });
+  ASSERT_TRUE(read);
+  ASSERT_EQ(a.Col, back.Col);
+  std::filesystem::remove(path);
+}
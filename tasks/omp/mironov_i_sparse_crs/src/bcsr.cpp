@@ -0,0 +1,332 @@
+// Copyright 2024 Mironov Ilya
+#include "omp/mironov_i_sparse_crs/include/bcsr.hpp"
+
+#include <omp.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace {
+// largest block side tried by ChooseBlockSize and unrolled by the kernels
+const int MAX_BLOCK = 4;
+
+// Number of nonzero r x c blocks in every block row of A, written to counts[0..block_rows).
+void CountBlocks(const mironov_omp::MatrixCRS& A, int cols, int r, int c, std::vector<int>& counts) {
+  int block_rows = (A.N + r - 1) / r;
+  int block_cols = (cols + c - 1) / c;
+  counts.assign(block_rows + 1, 0);
+#pragma omp parallel
+  {
+    std::vector<int> mark(block_cols, -1);
+#pragma omp for schedule(dynamic, 64)
+    for (int bi = 0; bi < block_rows; bi++) {
+      int count = 0;
+      for (int i = bi * r; i < std::min(A.N, (bi + 1) * r); i++) {
+        for (int j = A.RowIndex[i]; j < A.RowIndex[i + 1]; j++) {
+          int bj = A.Col[j] / c;
+          if (mark[bj] != bi) {
+            mark[bj] = bi;
+            count++;
+          }
+        }
+      }
+      counts[bi] = count;
+    }
+  }
+}
+
+// y = A * x for R x C blocks; R or C equal to 0 stand for the run-time block size of A.
+template <int R, int C>
+void BlockMultiplicateVector(const mironov_omp::MatrixBCSR& A, const double* x, double* y) {
+  const int r = R > 0 ? R : A.R;
+  const int c = C > 0 ? C : A.C;
+#pragma omp parallel
+  {
+    // with a compile-time R the partial sums of a block row stay in registers
+    std::vector<double> dynamic_sum(R > 0 ? 0 : r);
+#pragma omp for schedule(dynamic, 64)
+    for (int bi = 0; bi < A.BlockRows; bi++) {
+      double fixed_sum[R > 0 ? R : 1] = {};
+      double* sum = R > 0 ? fixed_sum : dynamic_sum.data();
+      if (R == 0) {
+        std::fill(sum, sum + r, 0.0);
+      }
+      const double* v = A.Value.data() + static_cast<size_t>(A.RowIndex[bi]) * r * c;
+      for (int b = A.RowIndex[bi]; b < A.RowIndex[bi + 1]; b++, v += r * c) {
+        const double* xb = x + static_cast<size_t>(A.Col[b]) * c;
+        for (int i = 0; i < r; i++) {
+          for (int j = 0; j < c; j++) {
+            sum[i] += v[i * c + j] * xb[j];
+          }
+        }
+      }
+      int rows = std::min(r, A.Rows - bi * r);
+      for (int i = 0; i < rows; i++) {
+        y[bi * r + i] = sum[i];
+      }
+    }
+  }
+}
+
+template <int R>
+void DispatchColumns(const mironov_omp::MatrixBCSR& A, const double* x, double* y) {
+  switch (A.C) {
+    case 1:
+      BlockMultiplicateVector<R, 1>(A, x, y);
+      break;
+    case 2:
+      BlockMultiplicateVector<R, 2>(A, x, y);
+      break;
+    case 3:
+      BlockMultiplicateVector<R, 3>(A, x, y);
+      break;
+    case 4:
+      BlockMultiplicateVector<R, 4>(A, x, y);
+      break;
+    default:
+      BlockMultiplicateVector<R, 0>(A, x, y);
+  }
+}
+
+// Numeric phase of the block product for R x K blocks of A and K x CB blocks of B, 0 again meaning the run-time size;
+// every thread accumulates a block row of C in a dense row of blocks.
+template <int R, int K, int CB>
+void BlockMultiplicateNumeric(const mironov_omp::MatrixBCSR& A, const mironov_omp::MatrixBCSR& B,
+                              mironov_omp::MatrixBCSR& C) {
+  const int r = R > 0 ? R : A.R;
+  const int k = K > 0 ? K : A.C;
+  const int cb = CB > 0 ? CB : B.C;
+  const int a_size = r * k;
+  const int b_size = k * cb;
+  const int c_size = r * cb;
+#pragma omp parallel
+  {
+    std::vector<double> acc(static_cast<size_t>(B.BlockCols) * c_size, 0.0);
+#pragma omp for schedule(dynamic, 16)
+    for (int bi = 0; bi < A.BlockRows; bi++) {
+      for (int a = A.RowIndex[bi]; a < A.RowIndex[bi + 1]; a++) {
+        const double* av = A.Value.data() + static_cast<size_t>(a) * a_size;
+        int bk = A.Col[a];
+        for (int b = B.RowIndex[bk]; b < B.RowIndex[bk + 1]; b++) {
+          const double* bv = B.Value.data() + static_cast<size_t>(b) * b_size;
+          double* cv = acc.data() + static_cast<size_t>(B.Col[b]) * c_size;
+          for (int i = 0; i < r; i++) {
+            for (int l = 0; l < k; l++) {
+              double a_il = av[i * k + l];
+              for (int j = 0; j < cb; j++) {
+                cv[i * cb + j] += a_il * bv[l * cb + j];
+              }
+            }
+          }
+        }
+      }
+      for (int p = C.RowIndex[bi]; p < C.RowIndex[bi + 1]; p++) {
+        double* cv = acc.data() + static_cast<size_t>(C.Col[p]) * c_size;
+        std::copy(cv, cv + c_size, C.Value.begin() + static_cast<std::ptrdiff_t>(p) * c_size);
+        std::fill(cv, cv + c_size, 0.0);
+      }
+    }
+  }
+}
+}  // namespace
+
+mironov_omp::MatrixBCSR::MatrixBCSR(int r, int c, int rows, int cols)
+    : R(r),
+      C(c),
+      Rows(rows),
+      Cols(cols),
+      BlockRows((rows + r - 1) / r),
+      BlockCols((cols + c - 1) / c),
+      RowIndex(BlockRows + 1, 0) {}
+
+mironov_omp::MatrixBCSR mironov_omp::ToBCSR(const MatrixCRS& A, int cols, int r, int c) {
+  MatrixBCSR bcsr(r, c, A.N, cols);
+  CountBlocks(A, cols, r, c, bcsr.RowIndex);
+  ExclusiveScan(bcsr.RowIndex.data(), bcsr.BlockRows);
+  int blocks = bcsr.RowIndex[bcsr.BlockRows];
+  bcsr.Col.resize(blocks);
+  bcsr.Value.assign(static_cast<size_t>(blocks) * r * c, 0.0);
+#pragma omp parallel
+  {
+    // slot[bj] is the position of block column bj inside the current block row
+    std::vector<int> slot(bcsr.BlockCols, -1);
+#pragma omp for schedule(dynamic, 64)
+    for (int bi = 0; bi < bcsr.BlockRows; bi++) {
+      int first = bcsr.RowIndex[bi];
+      int pos = first;
+      int row_end = std::min(A.N, (bi + 1) * r);
+      for (int i = bi * r; i < row_end; i++) {
+        for (int j = A.RowIndex[i]; j < A.RowIndex[i + 1]; j++) {
+          int bj = A.Col[j] / c;
+          if (slot[bj] < 0) {
+            slot[bj] = 0;
+            bcsr.Col[pos++] = bj;
+          }
+        }
+      }
+      std::sort(bcsr.Col.begin() + first, bcsr.Col.begin() + pos);
+      for (int p = first; p < pos; p++) {
+        slot[bcsr.Col[p]] = p;
+      }
+      for (int i = bi * r; i < row_end; i++) {
+        for (int j = A.RowIndex[i]; j < A.RowIndex[i + 1]; j++) {
+          int p = slot[A.Col[j] / c];
+          bcsr.Value[static_cast<size_t>(p) * r * c + (i - bi * r) * c + A.Col[j] % c] = A.Value[j];
+        }
+      }
+      for (int p = first; p < pos; p++) {
+        slot[bcsr.Col[p]] = -1;
+      }
+    }
+  }
+  return bcsr;
+}
+
+mironov_omp::MatrixCRS mironov_omp::FromBCSR(const MatrixBCSR& A) {
+  const int r = A.R;
+  const int c = A.C;
+  std::vector<int> row_index(A.Rows + 1, 0);
+  // padding and explicit zeros inside the blocks are dropped
+#pragma omp parallel for schedule(dynamic, 64)
+  for (int bi = 0; bi < A.BlockRows; bi++) {
+    for (int b = A.RowIndex[bi]; b < A.RowIndex[bi + 1]; b++) {
+      for (int i = 0; i < r && bi * r + i < A.Rows; i++) {
+        for (int j = 0; j < c; j++) {
+          if (A.Value[static_cast<size_t>(b) * r * c + i * c + j] != 0.0) {
+            row_index[bi * r + i]++;
+          }
+        }
+      }
+    }
+  }
+  ExclusiveScan(row_index.data(), A.Rows);
+
+  MatrixCRS crs(A.Rows, row_index[A.Rows]);
+  crs.RowIndex = std::move(row_index);
+#pragma omp parallel for schedule(dynamic, 64)
+  for (int bi = 0; bi < A.BlockRows; bi++) {
+    for (int i = 0; i < r && bi * r + i < A.Rows; i++) {
+      int pos = crs.RowIndex[bi * r + i];
+      for (int b = A.RowIndex[bi]; b < A.RowIndex[bi + 1]; b++) {
+        for (int j = 0; j < c; j++) {
+          double value = A.Value[static_cast<size_t>(b) * r * c + i * c + j];
+          if (value != 0.0) {
+            crs.Col[pos] = A.Col[b] * c + j;
+            crs.Value[pos++] = value;
+          }
+        }
+      }
+    }
+  }
+  return crs;
+}
+
+double mironov_omp::FillRatio(const MatrixCRS& A, int cols, int r, int c) {
+  std::vector<int> counts;
+  CountBlocks(A, cols, r, c, counts);
+  double blocks = 0.0;
+  for (int count : counts) {
+    blocks += count;
+  }
+  return A.NZ > 0 ? blocks * r * c / A.NZ : 1.0;
+}
+
+std::pair<int, int> mironov_omp::ChooseBlockSize(const MatrixCRS& A, int cols) {
+  std::pair<int, int> best(1, 1);
+  double best_bytes = 0.0;
+  for (int r = 1; r <= MAX_BLOCK; r++) {
+    for (int c = 1; c <= MAX_BLOCK; c++) {
+      double blocks = FillRatio(A, cols, r, c) * A.NZ / (r * c);
+      double bytes = blocks * (8.0 * r * c + 4.0) + 4.0 * ((A.N + r - 1) / r + 1);
+      if (r * c == 1 || bytes < best_bytes) {
+        best = {r, c};
+        best_bytes = bytes;
+      }
+    }
+  }
+  return best;
+}
+
+void mironov_omp::MultiplicateVector(const MatrixBCSR& A, const double* x, double* y) {
+  // the last block column may reach past the end of x
+  std::vector<double> padded;
+  if (A.Cols % A.C != 0) {
+    padded.assign(static_cast<size_t>(A.BlockCols) * A.C, 0.0);
+    std::copy(x, x + A.Cols, padded.begin());
+    x = padded.data();
+  }
+  switch (A.R) {
+    case 1:
+      DispatchColumns<1>(A, x, y);
+      break;
+    case 2:
+      DispatchColumns<2>(A, x, y);
+      break;
+    case 3:
+      DispatchColumns<3>(A, x, y);
+      break;
+    case 4:
+      DispatchColumns<4>(A, x, y);
+      break;
+    default:
+      BlockMultiplicateVector<0, 0>(A, x, y);
+  }
+}
+
+mironov_omp::MatrixBCSR mironov_omp::Multiplicate(const MatrixBCSR& A, const MatrixBCSR& B) {
+  MatrixBCSR C(A.R, B.C, A.Rows, B.Cols);
+  // symbolic phase on the block pattern, the same two passes as MultiplicateSymbolic
+#pragma omp parallel
+  {
+    std::vector<int> mark(B.BlockCols, -1);
+#pragma omp for schedule(dynamic, 16)
+    for (int bi = 0; bi < A.BlockRows; bi++) {
+      int count = 0;
+      for (int a = A.RowIndex[bi]; a < A.RowIndex[bi + 1]; a++) {
+        int bk = A.Col[a];
+        for (int b = B.RowIndex[bk]; b < B.RowIndex[bk + 1]; b++) {
+          if (mark[B.Col[b]] != bi) {
+            mark[B.Col[b]] = bi;
+            count++;
+          }
+        }
+      }
+      C.RowIndex[bi] = count;
+    }
+  }
+  ExclusiveScan(C.RowIndex.data(), C.BlockRows);
+  C.Col.resize(C.RowIndex[C.BlockRows]);
+  C.Value.resize(static_cast<size_t>(C.Blocks()) * C.R * C.C);
+#pragma omp parallel
+  {
+    std::vector<int> mark(B.BlockCols, -1);
+#pragma omp for schedule(dynamic, 16)
+    for (int bi = 0; bi < A.BlockRows; bi++) {
+      int pos = C.RowIndex[bi];
+      for (int a = A.RowIndex[bi]; a < A.RowIndex[bi + 1]; a++) {
+        int bk = A.Col[a];
+        for (int b = B.RowIndex[bk]; b < B.RowIndex[bk + 1]; b++) {
+          if (mark[B.Col[b]] != bi) {
+            mark[B.Col[b]] = bi;
+            C.Col[pos++] = B.Col[b];
+          }
+        }
+      }
+      std::sort(C.Col.begin() + C.RowIndex[bi], C.Col.begin() + pos);
+    }
+  }
+
+  // square blocks are the common case for matrices coming from finite elements
+  if (A.R == A.C && B.R == B.C && A.R == B.R && A.R == 2) {
+    BlockMultiplicateNumeric<2, 2, 2>(A, B, C);
+  } else if (A.R == A.C && B.R == B.C && A.R == B.R && A.R == 3) {
+    BlockMultiplicateNumeric<3, 3, 3>(A, B, C);
+  } else if (A.R == A.C && B.R == B.C && A.R == B.R && A.R == 4) {
+    BlockMultiplicateNumeric<4, 4, 4>(A, B, C);
+  } else {
+    BlockMultiplicateNumeric<0, 0, 0>(A, B, C);
+  }
+  return C;
+}
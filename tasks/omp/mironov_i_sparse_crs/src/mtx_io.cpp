@@ -0,0 +1,399 @@
+// Copyright 2024 Mironov Ilya
+#include "omp/mironov_i_sparse_crs/include/mtx_io.hpp"
+
+#include <omp.h>
+
+#if defined(_WIN32)
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+class MappedFile {
+ public:
+  explicit MappedFile(const std::string& path) {
+#if defined(_WIN32)
+    std::ifstream file(path, std::ios::binary);
+    if (file) {
+      buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+      begin = buffer.data();
+      length = buffer.size();
+      valid = true;
+    }
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return;
+    }
+    struct stat st {};
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+      void* addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (addr != MAP_FAILED) {
+        madvise(addr, st.st_size, MADV_SEQUENTIAL);
+        begin = static_cast<const char*>(addr);
+        length = st.st_size;
+        valid = true;
+      }
+    }
+    close(fd);
+#endif
+  }
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  ~MappedFile() {
+#if !defined(_WIN32)
+    if (valid) {
+      munmap(const_cast<char*>(begin), length);
+    }
+#endif
+  }
+
+  const char* begin{};
+  size_t length{};
+  bool valid{};
+
+ private:
+#if defined(_WIN32)
+  std::string buffer;
+#endif
+};
+
+struct Entry {
+  int row;
+  int col;
+  double re;
+  double im;
+};
+
+enum class Field { REAL, COMPLEX, PATTERN };
+enum class Symmetry { GENERAL, SYMMETRIC, SKEW, HERMITIAN };
+
+const char* SkipSpaces(const char* p, const char* end) {
+  while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) {
+    p++;
+  }
+  return p;
+}
+
+const char* NextLine(const char* p, const char* end) {
+  const char* eol = std::find(p, end, '\n');
+  return eol == end ? end : eol + 1;
+}
+
+const char* ParseInt(const char* p, const char* end, int& value) {
+  p = SkipSpaces(p, end);
+  auto res = std::from_chars(p, end, value);
+  return res.ec == std::errc() ? res.ptr : nullptr;
+}
+
+// end is always the '\n' of the current line (see ParseLine), which also stops strtod inside the mapping.
+const char* ParseDouble(const char* p, const char* end, double& value) {
+  p = SkipSpaces(p, end);
+  if (p == end) {
+    return nullptr;
+  }
+#if defined(__cpp_lib_to_chars)
+  if (*p == '+') {
+    p++;
+  }
+  auto res = std::from_chars(p, end, value);
+  return res.ec == std::errc() ? res.ptr : nullptr;
+#else
+  char* stop = nullptr;
+  value = std::strtod(p, &stop);
+  return (stop == p || stop > end) ? nullptr : stop;
+#endif
+}
+
+// Parses one coordinate line; returns false on malformed input. Blank and comment lines yield no entry.
+bool ParseLine(const char* p, const char* end, Field field, int& row, int& col, double& re, double& im, bool& has) {
+  has = false;
+  end = std::find(p, end, '\n');
+  p = SkipSpaces(p, end);
+  if (p == end || *p == '\n' || *p == '%') {
+    return true;
+  }
+  if ((p = ParseInt(p, end, row)) == nullptr || (p = ParseInt(p, end, col)) == nullptr) {
+    return false;
+  }
+  re = 1.0;
+  im = 0.0;
+  if (field != Field::PATTERN && (p = ParseDouble(p, end, re)) == nullptr) {
+    return false;
+  }
+  if (field == Field::COMPLEX && ParseDouble(p, end, im) == nullptr) {
+    return false;
+  }
+  has = true;
+  return true;
+}
+
+bool ParseBanner(const char*& p, const char* end, Field& field, Symmetry& symmetry) {
+  const char* eol = NextLine(p, end);
+  std::string banner(p, eol);
+  std::transform(banner.begin(), banner.end(), banner.begin(), [](unsigned char c) { return std::tolower(c); });
+  std::istringstream words(banner);
+  std::string head;
+  std::string object;
+  std::string format;
+  std::string type;
+  std::string sym;
+  words >> head >> object >> format >> type >> sym;
+  if (head != "%%matrixmarket" || object != "matrix" || format != "coordinate") {
+    return false;
+  }
+  if (type == "real" || type == "double" || type == "integer") {
+    field = Field::REAL;
+  } else if (type == "complex") {
+    field = Field::COMPLEX;
+  } else if (type == "pattern") {
+    field = Field::PATTERN;
+  } else {
+    return false;
+  }
+  if (sym == "general") {
+    symmetry = Symmetry::GENERAL;
+  } else if (sym == "symmetric") {
+    symmetry = Symmetry::SYMMETRIC;
+  } else if (sym == "skew-symmetric") {
+    symmetry = Symmetry::SKEW;
+  } else if (sym == "hermitian") {
+    symmetry = Symmetry::HERMITIAN;
+  } else {
+    return false;
+  }
+  p = eol;
+  return true;
+}
+}  // namespace
+
+bool mironov_omp::ReadMatrixMarket(const std::string& path, MatrixCRS& matrix, int& rows, int& cols, bool transpose,
+                                   std::vector<double>* imag) {
+  MappedFile file(path);
+  if (!file.valid) {
+    return false;
+  }
+  const char* p = file.begin;
+  const char* end = file.begin + file.length;
+  Field field;
+  Symmetry symmetry;
+  if (!ParseBanner(p, end, field, symmetry) || (field == Field::COMPLEX && imag == nullptr)) {
+    return false;
+  }
+  while (p < end && (*SkipSpaces(p, end) == '%' || *SkipSpaces(p, end) == '\n')) {
+    p = NextLine(p, end);
+  }
+  int declared_nz = 0;
+  if ((p = ParseInt(p, end, rows)) == nullptr || (p = ParseInt(p, end, cols)) == nullptr ||
+      (p = ParseInt(p, end, declared_nz)) == nullptr || rows < 0 || cols < 0 || declared_nz < 0) {
+    return false;
+  }
+  const char* body = NextLine(p, end);
+  int out_rows = transpose ? cols : rows;
+
+  // the last line may lack '\n'; it is parsed from a copy so that strtod never reads past the mapping
+  const char* body_end = end;
+  std::string tail;
+  if (end > body && end[-1] != '\n') {
+    const char* last = body;
+    for (const char* q = body; q < end; q = NextLine(q, end)) {
+      last = q;
+    }
+    tail.assign(last, end);
+    tail.push_back('\n');
+    body_end = last;
+  }
+
+  int num_threads = omp_get_max_threads();
+  std::vector<std::vector<Entry>> parsed(num_threads);
+  std::vector<int> counts(out_rows + 1, 0);
+  int parsed_nz = 0;
+  bool ok = true;
+  size_t body_size = body_end - body;
+#pragma omp parallel num_threads(num_threads) reduction(+ : parsed_nz) reduction(&& : ok)
+  {
+    int tid = omp_get_thread_num();
+    int nt = omp_get_num_threads();
+    std::vector<Entry>& local = parsed[tid];
+    // chunk borders are moved forward to the next line start, so every line belongs to exactly one thread
+    const char* chunk_begin = body + body_size * tid / nt;
+    const char* chunk_end = body + body_size * (tid + 1) / nt;
+    if (tid != 0) {
+      chunk_begin = NextLine(chunk_begin - 1, body_end);
+    }
+    if (tid != nt - 1) {
+      chunk_end = NextLine(chunk_end - 1, body_end);
+    }
+    auto emit = [&](int row, int col, double re, double im) {
+      if (row < 1 || row > rows || col < 1 || col > cols) {
+        ok = false;
+        return;
+      }
+      parsed_nz++;
+      auto push = [&](int r, int c, double v_re, double v_im) {
+        local.push_back(transpose ? Entry{c - 1, r - 1, v_re, v_im} : Entry{r - 1, c - 1, v_re, v_im});
+      };
+      push(row, col, re, im);
+      if (row != col && symmetry == Symmetry::SYMMETRIC) {
+        push(col, row, re, im);
+      } else if (row != col && symmetry == Symmetry::SKEW) {
+        push(col, row, -re, -im);
+      } else if (row != col && symmetry == Symmetry::HERMITIAN) {
+        push(col, row, re, -im);
+      }
+    };
+    int row;
+    int col;
+    double re;
+    double im;
+    bool has;
+    for (const char* line = chunk_begin; line < chunk_end && ok; line = NextLine(line, chunk_end)) {
+      if (!ParseLine(line, chunk_end, field, row, col, re, im, has)) {
+        ok = false;
+      } else if (has) {
+        emit(row, col, re, im);
+      }
+    }
+    if (tid == nt - 1 && !tail.empty() && ok) {
+      if (!ParseLine(tail.data(), tail.data() + tail.size(), field, row, col, re, im, has)) {
+        ok = false;
+      } else if (has) {
+        emit(row, col, re, im);
+      }
+    }
+    for (const Entry& e : local) {
+#pragma omp atomic
+      counts[e.row]++;
+    }
+  }
+  if (!ok || parsed_nz != declared_nz) {
+    return false;
+  }
+
+  // scatter into row buckets, then sort every row by column and sum duplicates in place
+  ExclusiveScan(counts.data(), out_rows);
+  std::vector<int> next(counts.begin(), counts.end() - 1);
+  std::vector<Entry> staged(counts[out_rows]);
+  std::vector<int> unique(out_rows + 1, 0);
+#pragma omp parallel num_threads(num_threads)
+  {
+#pragma omp for schedule(dynamic, 1)
+    for (int t = 0; t < num_threads; t++) {
+      for (const Entry& e : parsed[t]) {
+        int pos;
+#pragma omp atomic capture
+        pos = next[e.row]++;
+        staged[pos] = e;
+      }
+      std::vector<Entry>().swap(parsed[t]);
+    }
+#pragma omp for schedule(dynamic, 256)
+    for (int i = 0; i < out_rows; i++) {
+      auto first = staged.begin() + counts[i];
+      auto last = staged.begin() + counts[i + 1];
+      std::sort(first, last, [](const Entry& a, const Entry& b) { return a.col < b.col; });
+      auto out = first;
+      for (auto it = first; it != last; ++it) {
+        if (out != first && (out - 1)->col == it->col) {
+          (out - 1)->re += it->re;
+          (out - 1)->im += it->im;
+        } else {
+          *out++ = *it;
+        }
+      }
+      unique[i] = static_cast<int>(out - first);
+    }
+  }
+  ExclusiveScan(unique.data(), out_rows);
+
+  matrix = MatrixCRS(out_rows, unique[out_rows]);
+  matrix.RowIndex = unique;
+  if (imag != nullptr) {
+    imag->assign(matrix.NZ, 0.0);
+  }
+#pragma omp parallel for schedule(dynamic, 256) num_threads(num_threads)
+  for (int i = 0; i < out_rows; i++) {
+    int src = counts[i];
+    for (int j = matrix.RowIndex[i]; j < matrix.RowIndex[i + 1]; j++, src++) {
+      matrix.Col[j] = staged[src].col;
+      matrix.Value[j] = staged[src].re;
+      if (imag != nullptr) {
+        (*imag)[j] = staged[src].im;
+      }
+    }
+  }
+  return true;
+}
+
+bool mironov_omp::WriteMatrixMarket(const std::string& path, const MatrixCRS& matrix, int cols, int round_nonzeros) {
+  std::ofstream file(path, std::ios::binary);
+  if (!file) {
+    return false;
+  }
+  file << "%%MatrixMarket matrix coordinate real general\n";
+  file << matrix.N << ' ' << cols << ' ' << matrix.RowIndex[matrix.N] << '\n';
+
+  // The entries are formatted and written in rounds of about round_nonzeros nonzeros, so the text held in memory stays
+  // the same whatever the size of the matrix. A round is split between the threads by nonzeros, every thread fills
+  // its own buffer, and the buffers are written in order before the next round reuses them.
+  std::vector<std::string> chunks(omp_get_max_threads());
+  int nt = static_cast<int>(chunks.size());
+  const int* row_index = matrix.RowIndex.data();
+  int row = 0;
+  while (row < matrix.N && file) {
+    // rows [row, stop) hold at most round_nonzeros nonzeros, or a single longer row
+    auto limit = static_cast<int64_t>(row_index[row]) + round_nonzeros;
+    int stop = static_cast<int>(std::upper_bound(row_index + row + 1, row_index + matrix.N + 1, limit) - row_index) - 1;
+    stop = std::max(stop, row + 1);
+#pragma omp parallel num_threads(nt)
+    {
+      int tid = omp_get_thread_num();
+      auto split = [&](int t) {
+        int64_t goal = row_index[row] + static_cast<int64_t>(row_index[stop] - row_index[row]) * t / nt;
+        return t == nt ? stop : static_cast<int>(std::lower_bound(row_index + row, row_index + stop, goal) - row_index);
+      };
+      int begin = split(tid);
+      int end = split(tid + 1);
+      std::string& out = chunks[tid];
+      out.clear();
+      char line[64];
+      // one byte is kept free for the line break
+      char* last = line + sizeof(line) - 1;
+      for (int i = begin; i < end; i++) {
+        for (int j = row_index[i]; j < row_index[i + 1]; j++) {
+          char* pos = std::to_chars(line, last, i + 1).ptr;
+          *pos++ = ' ';
+          pos = std::to_chars(pos, last, matrix.Col[j] + 1).ptr;
+          *pos++ = ' ';
+#if defined(__cpp_lib_to_chars)
+          pos = std::to_chars(pos, last, matrix.Value[j]).ptr;
+#else
+          pos += std::snprintf(pos, last - pos, "%.17g", matrix.Value[j]);
+#endif
+          *pos++ = '\n';
+          out.append(line, pos);
+        }
+      }
+    }
+    for (const std::string& chunk : chunks) {
+      file.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+    }
+    row = stop;
+  }
+  return file.good();
+}
@@ -0,0 +1,322 @@
+// Copyright 2024 Mironov Ilya
+#include "omp/mironov_i_sparse_crs/include/packed.hpp"
+
+#include <omp.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+const int PANEL_BITS = 16;
+
+int VarintLength(uint32_t v) {
+  int length = 1;
+  while (v >= 0x80) {
+    v >>= 7;
+    length++;
+  }
+  return length;
+}
+
+uint8_t* WriteVarint(uint32_t v, uint8_t* out) {
+  while (v >= 0x80) {
+    *out++ = static_cast<uint8_t>(v | 0x80);
+    v >>= 7;
+  }
+  *out++ = static_cast<uint8_t>(v);
+  return out;
+}
+
+inline uint32_t ReadVarint(const uint8_t*& in) {
+  uint32_t byte = *in++;
+  if (byte < 0x80) {
+    return byte;
+  }
+  uint32_t v = byte & 0x7f;
+  int shift = 7;
+  do {
+    byte = *in++;
+    v |= (byte & 0x7f) << shift;
+    shift += 7;
+  } while (byte >= 0x80);
+  return v;
+}
+
+// Calls f(column, value) for every nonzero of row i in column order, decoding the indices as it goes.
+template <typename V, typename F>
+inline void ForEachInRow(const mironov_omp::MatrixPackedCRS& A, const V* value, int i, F f) {
+  switch (A.Encoding) {
+    case mironov_omp::IndexEncoding::Int32:
+      for (int j = A.RowIndex[i]; j < A.RowIndex[i + 1]; j++) {
+        f(A.Col32[j], value[j]);
+      }
+      break;
+    case mironov_omp::IndexEncoding::Block16:
+      for (int p = 0; p < A.Panels(); p++) {
+        const int* row_index = A.RowIndex.data() + static_cast<size_t>(p) * (A.N + 1);
+        for (int j = row_index[i]; j < row_index[i + 1]; j++) {
+          f((p << PANEL_BITS) + A.Col16[j], value[j]);
+        }
+      }
+      break;
+    case mironov_omp::IndexEncoding::DeltaVarint: {
+      const uint8_t* in = A.ColBytes.data() + A.ByteIndex[i];
+      int col = -1;
+      for (int j = A.RowIndex[i]; j < A.RowIndex[i + 1]; j++) {
+        col += static_cast<int>(ReadVarint(in)) + 1;
+        f(col, value[j]);
+      }
+      break;
+    }
+  }
+}
+
+template <typename V>
+void PackedMultiplicateVector(const mironov_omp::MatrixPackedCRS& A, const V* value, const double* x, double* y) {
+  if (A.Encoding == mironov_omp::IndexEncoding::Block16) {
+    // panel after panel, so only 64K entries of x are live at a time; a static schedule gives every thread the same
+    // rows in each panel, so y needs no barrier between them
+#pragma omp parallel
+    for (int p = 0; p < A.Panels(); p++) {
+      const int* row_index = A.RowIndex.data() + static_cast<size_t>(p) * (A.N + 1);
+      const double* x_panel = x + (static_cast<size_t>(p) << PANEL_BITS);
+#pragma omp for schedule(static) nowait
+      for (int i = 0; i < A.N; i++) {
+        double sum = p == 0 ? 0.0 : y[i];
+        for (int j = row_index[i]; j < row_index[i + 1]; j++) {
+          sum += value[j] * x_panel[A.Col16[j]];
+        }
+        y[i] = sum;
+      }
+    }
+    return;
+  }
+#pragma omp parallel for schedule(static)
+  for (int i = 0; i < A.N; i++) {
+    double sum = 0.0;
+    ForEachInRow(A, value, i, [&](int col, V v) { sum += v * x[col]; });
+    y[i] = sum;
+  }
+}
+
+template <typename VA, typename VB>
+mironov_omp::MatrixCRS PackedMultiplicate(const mironov_omp::MatrixPackedCRS& A, const VA* a_value,
+                                          const mironov_omp::MatrixPackedCRS& B, const VB* b_value) {
+  mironov_omp::MatrixCRS C(A.N, 0);
+  // symbolic pass: distinct columns per row of C
+#pragma omp parallel
+  {
+    std::vector<int> mark(B.Cols, -1);
+#pragma omp for schedule(dynamic, 64)
+    for (int i = 0; i < A.N; i++) {
+      int count = 0;
+      ForEachInRow(A, a_value, i, [&](int row, VA) {
+        ForEachInRow(B, b_value, row, [&](int col, VB) {
+          if (mark[col] != i) {
+            mark[col] = i;
+            count++;
+          }
+        });
+      });
+      C.RowIndex[i] = count;
+    }
+  }
+  mironov_omp::ExclusiveScan(C.RowIndex.data(), A.N);
+  C.NZ = C.RowIndex[A.N];
+  C.Col.resize(C.NZ);
+  C.Value.resize(C.NZ);
+  // numeric pass: dense accumulator, touched columns sorted before they are written out
+#pragma omp parallel
+  {
+    std::vector<double> acc(B.Cols, 0.0);
+    std::vector<int> mark(B.Cols, -1);
+#pragma omp for schedule(dynamic, 64)
+    for (int i = 0; i < A.N; i++) {
+      int* cols = C.Col.data() + C.RowIndex[i];
+      int count = 0;
+      ForEachInRow(A, a_value, i, [&](int row, VA a) {
+        ForEachInRow(B, b_value, row, [&](int col, VB b) {
+          if (mark[col] != i) {
+            mark[col] = i;
+            cols[count++] = col;
+          }
+          acc[col] += static_cast<double>(a) * b;
+        });
+      });
+      std::sort(cols, cols + count);
+      for (int j = 0; j < count; j++) {
+        C.Value[C.RowIndex[i] + j] = acc[cols[j]];
+        acc[cols[j]] = 0.0;
+      }
+    }
+  }
+  return C;
+}
+
+template <typename VA>
+mironov_omp::MatrixCRS PackedMultiplicate(const mironov_omp::MatrixPackedCRS& A, const VA* a_value,
+                                          const mironov_omp::MatrixPackedCRS& B) {
+  if (B.SinglePrecision) {
+    return PackedMultiplicate(A, a_value, B, B.ValueF.data());
+  }
+  return PackedMultiplicate(A, a_value, B, B.Value.data());
+}
+}  // namespace
+
+mironov_omp::MatrixPackedCRS::MatrixPackedCRS(int n, int cols, IndexEncoding encoding, bool single_precision)
+    : N(n), Cols(cols), NZ(0), Encoding(encoding), SinglePrecision(single_precision) {}
+
+size_t mironov_omp::MatrixPackedCRS::Bytes() const {
+  return sizeof(int) * (RowIndex.size() + Col32.size() + ByteIndex.size()) + sizeof(uint16_t) * Col16.size() +
+         ColBytes.size() + sizeof(double) * Value.size() + sizeof(float) * ValueF.size();
+}
+
+mironov_omp::MatrixPackedCRS mironov_omp::Pack(const MatrixCRS& A, int cols, IndexEncoding encoding,
+                                               bool single_precision) {
+  MatrixPackedCRS P(A.N, cols, encoding, single_precision);
+  P.NZ = A.NZ;
+  // position of every nonzero of A in the packed arrays
+  std::vector<int> position;
+  switch (encoding) {
+    case IndexEncoding::Int32:
+      P.RowIndex = A.RowIndex;
+      P.Col32 = A.Col;
+      break;
+    case IndexEncoding::Block16: {
+      int panels = P.Panels();
+      size_t stride = A.N + 1;
+      P.RowIndex.assign(stride * panels, 0);
+      for (int i = 0; i < A.N; i++) {
+        for (int j = A.RowIndex[i]; j < A.RowIndex[i + 1]; j++) {
+          P.RowIndex[(A.Col[j] >> PANEL_BITS) * stride + i + 1]++;
+        }
+      }
+      // one running sum over all panels: panel p starts where panel p - 1 ends
+      for (size_t k = 1; k < P.RowIndex.size(); k++) {
+        P.RowIndex[k] += P.RowIndex[k - 1];
+      }
+      P.Col16.resize(A.NZ);
+      position.resize(A.NZ);
+#pragma omp parallel for schedule(dynamic, 256)
+      for (int i = 0; i < A.N; i++) {
+        int panel = -1;
+        int pos = 0;
+        for (int j = A.RowIndex[i]; j < A.RowIndex[i + 1]; j++) {
+          if (A.Col[j] >> PANEL_BITS != panel) {
+            panel = A.Col[j] >> PANEL_BITS;
+            pos = P.RowIndex[panel * stride + i];
+          }
+          P.Col16[pos] = static_cast<uint16_t>(A.Col[j] & 0xffff);
+          position[j] = pos++;
+        }
+      }
+      break;
+    }
+    case IndexEncoding::DeltaVarint: {
+      P.RowIndex = A.RowIndex;
+      P.ByteIndex.assign(A.N + 1, 0);
+#pragma omp parallel for schedule(dynamic, 256)
+      for (int i = 0; i < A.N; i++) {
+        int length = 0;
+        int prev = -1;
+        for (int j = A.RowIndex[i]; j < A.RowIndex[i + 1]; j++) {
+          length += VarintLength(A.Col[j] - prev - 1);
+          prev = A.Col[j];
+        }
+        P.ByteIndex[i] = length;
+      }
+      ExclusiveScan(P.ByteIndex.data(), A.N);
+      P.ColBytes.resize(P.ByteIndex[A.N]);
+#pragma omp parallel for schedule(dynamic, 256)
+      for (int i = 0; i < A.N; i++) {
+        uint8_t* out = P.ColBytes.data() + P.ByteIndex[i];
+        int prev = -1;
+        for (int j = A.RowIndex[i]; j < A.RowIndex[i + 1]; j++) {
+          out = WriteVarint(A.Col[j] - prev - 1, out);
+          prev = A.Col[j];
+        }
+      }
+      break;
+    }
+  }
+
+  if (single_precision) {
+    P.ValueF.resize(A.NZ);
+  } else {
+    P.Value.resize(A.NZ);
+  }
+#pragma omp parallel for schedule(static)
+  for (int j = 0; j < A.NZ; j++) {
+    int pos = position.empty() ? j : position[j];
+    if (single_precision) {
+      P.ValueF[pos] = static_cast<float>(A.Value[j]);
+    } else {
+      P.Value[pos] = A.Value[j];
+    }
+  }
+  return P;
+}
+
+mironov_omp::MatrixCRS mironov_omp::Unpack(const MatrixPackedCRS& A) {
+  MatrixCRS B(A.N, A.NZ);
+  for (int p = 0; p < A.Panels(); p++) {
+    const int* row_index = A.RowIndex.data() + static_cast<size_t>(p) * (A.N + 1);
+    for (int i = 0; i < A.N; i++) {
+      B.RowIndex[i + 1] += row_index[i + 1] - row_index[i];
+    }
+  }
+  for (int i = 0; i < A.N; i++) {
+    B.RowIndex[i + 1] += B.RowIndex[i];
+  }
+#pragma omp parallel for schedule(dynamic, 256)
+  for (int i = 0; i < A.N; i++) {
+    int pos = B.RowIndex[i];
+    auto store = [&](int col, auto value) {
+      B.Col[pos] = col;
+      B.Value[pos++] = value;
+    };
+    if (A.SinglePrecision) {
+      ForEachInRow(A, A.ValueF.data(), i, store);
+    } else {
+      ForEachInRow(A, A.Value.data(), i, store);
+    }
+  }
+  return B;
+}
+
+mironov_omp::IndexEncoding mironov_omp::ChooseEncoding(const MatrixCRS& A, int cols) {
+  int64_t varint_bytes = 0;
+#pragma omp parallel for schedule(dynamic, 256) reduction(+ : varint_bytes)
+  for (int i = 0; i < A.N; i++) {
+    int prev = -1;
+    for (int j = A.RowIndex[i]; j < A.RowIndex[i + 1]; j++) {
+      varint_bytes += VarintLength(A.Col[j] - prev - 1);
+      prev = A.Col[j];
+    }
+  }
+  int64_t rows = A.N + 1;
+  int64_t int32_bytes = 4 * rows + 4 * static_cast<int64_t>(A.NZ);
+  int64_t block16_bytes = 4 * rows * ((cols + 0xffff) / 0x10000) + 2 * static_cast<int64_t>(A.NZ);
+  varint_bytes += 8 * rows;
+  if (int32_bytes <= std::min(block16_bytes, varint_bytes)) {
+    return IndexEncoding::Int32;
+  }
+  return block16_bytes <= varint_bytes ? IndexEncoding::Block16 : IndexEncoding::DeltaVarint;
+}
+
+void mironov_omp::MultiplicateVector(const MatrixPackedCRS& A, const double* x, double* y) {
+  if (A.SinglePrecision) {
+    PackedMultiplicateVector(A, A.ValueF.data(), x, y);
+  } else {
+    PackedMultiplicateVector(A, A.Value.data(), x, y);
+  }
+}
+
+mironov_omp::MatrixCRS mironov_omp::Multiplicate(const MatrixPackedCRS& A, const MatrixPackedCRS& B) {
+  if (A.SinglePrecision) {
+    return PackedMultiplicate(A, A.ValueF.data(), B);
+  }
+  return PackedMultiplicate(A, A.Value.data(), B);
+}
@@ -0,0 +1,284 @@
+// Copyright 2024 Mironov Ilya
+#include "omp/mironov_i_sparse_crs/include/reorder.hpp"
+
+#include <omp.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+namespace {
+// subsets smaller than this are not worth another bisection
+const int DISSECTION_LEAF = 64;
+
+// adjacency of A + A^T without the diagonal
+struct Graph {
+  int n;
+  std::vector<int> ptr;
+  std::vector<int> adj;
+  int Degree(int v) const { return ptr[v + 1] - ptr[v]; }
+};
+
+Graph SymmetricPattern(const mironov_omp::MatrixCRS& A) {
+  Graph g{A.N, std::vector<int>(A.N + 1, 0), {}};
+  for (int i = 0; i < A.N; i++) {
+    for (int j = A.RowIndex[i]; j < A.RowIndex[i + 1]; j++) {
+      if (A.Col[j] != i) {
+        g.ptr[i + 1]++;
+        g.ptr[A.Col[j] + 1]++;
+      }
+    }
+  }
+  for (int i = 0; i < A.N; i++) {
+    g.ptr[i + 1] += g.ptr[i];
+  }
+  g.adj.resize(g.ptr[A.N]);
+  std::vector<int> pos(g.ptr.begin(), g.ptr.end() - 1);
+  for (int i = 0; i < A.N; i++) {
+    for (int j = A.RowIndex[i]; j < A.RowIndex[i + 1]; j++) {
+      if (A.Col[j] != i) {
+        g.adj[pos[i]++] = A.Col[j];
+        g.adj[pos[A.Col[j]]++] = i;
+      }
+    }
+  }
+  // symmetric entries were added twice; sort and compact every list in place
+  std::vector<int> ptr(A.N + 1, 0);
+#pragma omp parallel for schedule(dynamic, 256)
+  for (int v = 0; v < A.N; v++) {
+    auto first = g.adj.begin() + g.ptr[v];
+    auto last = g.adj.begin() + g.ptr[v + 1];
+    std::sort(first, last);
+    ptr[v + 1] = static_cast<int>(std::unique(first, last) - first);
+  }
+  int length = 0;
+  for (int v = 0; v < A.N; v++) {
+    for (int j = 0; j < ptr[v + 1]; j++) {
+      g.adj[length + j] = g.adj[g.ptr[v] + j];
+    }
+    ptr[v + 1] = (length += ptr[v + 1]);
+  }
+  g.adj.resize(length);
+  g.ptr = std::move(ptr);
+  return g;
+}
+
+// Breadth-first search from root through the vertices v with part[v] == id. Returns the visited vertices in order,
+// level[v] receives the distance from root.
+std::vector<int> Levels(const Graph& g, int root, const std::vector<int>& part, int id, std::vector<int>& level) {
+  std::vector<int> order = {root};
+  level[root] = 0;
+  for (size_t head = 0; head < order.size(); head++) {
+    int v = order[head];
+    for (int j = g.ptr[v]; j < g.ptr[v + 1]; j++) {
+      int w = g.adj[j];
+      if (part[w] == id && level[w] < 0) {
+        level[w] = level[v] + 1;
+        order.push_back(w);
+      }
+    }
+  }
+  return order;
+}
+
+// George-Liu heuristic: restart from the lowest-degree vertex of the last level while the depth keeps growing.
+// level is left filled for the returned root.
+int PseudoPeripheral(const Graph& g, int start, const std::vector<int>& part, int id, std::vector<int>& level,
+                     std::vector<int>& order) {
+  int root = start;
+  order = Levels(g, root, part, id, level);
+  while (true) {
+    int depth = level[order.back()];
+    int candidate = order.back();
+    for (auto it = order.rbegin(); it != order.rend() && level[*it] == depth; ++it) {
+      if (g.Degree(*it) < g.Degree(candidate)) {
+        candidate = *it;
+      }
+    }
+    for (int v : order) {
+      level[v] = -1;
+    }
+    std::vector<int> candidate_order = Levels(g, candidate, part, id, level);
+    if (level[candidate_order.back()] <= depth) {
+      for (int v : candidate_order) {
+        level[v] = -1;
+      }
+      order = Levels(g, root, part, id, level);
+      return root;
+    }
+    root = candidate;
+    order = std::move(candidate_order);
+  }
+}
+
+void Dissect(const Graph& g, std::vector<int> nodes, int depth, std::vector<int>& part, int& next_id,
+             std::vector<int>& level, std::vector<int>& result) {
+  if (depth == 0 || static_cast<int>(nodes.size()) < DISSECTION_LEAF) {
+    result.insert(result.end(), nodes.begin(), nodes.end());
+    return;
+  }
+  int id = part[nodes[0]];
+  std::vector<int> order;
+  PseudoPeripheral(g, nodes[0], part, id, level, order);
+  int middle = level[order.back()] / 2;
+  std::vector<int> first;
+  std::vector<int> second;
+  std::vector<int> separator;
+  for (int v : nodes) {
+    // vertices of other components of the subset were not reached and join the second half
+    bool reached = level[v] >= 0;
+    if (reached && level[v] < middle) {
+      first.push_back(v);
+    } else if (reached && level[v] == middle && middle > 0) {
+      separator.push_back(v);
+    } else {
+      second.push_back(v);
+    }
+  }
+  for (int v : order) {
+    level[v] = -1;
+  }
+  if (first.empty() || second.empty()) {
+    result.insert(result.end(), nodes.begin(), nodes.end());
+    return;
+  }
+  int first_id = next_id++;
+  int second_id = next_id++;
+  for (int v : first) {
+    part[v] = first_id;
+  }
+  for (int v : second) {
+    part[v] = second_id;
+  }
+  for (int v : separator) {
+    part[v] = -1;
+  }
+  Dissect(g, std::move(first), depth - 1, part, next_id, level, result);
+  Dissect(g, std::move(second), depth - 1, part, next_id, level, result);
+  result.insert(result.end(), separator.begin(), separator.end());
+}
+}  // namespace
+
+std::vector<int> mironov_omp::ReverseCuthillMcKee(const MatrixCRS& A) {
+  Graph g = SymmetricPattern(A);
+  std::vector<int> by_degree(g.n);
+  for (int v = 0; v < g.n; v++) {
+    by_degree[v] = v;
+  }
+  std::stable_sort(by_degree.begin(), by_degree.end(), [&](int a, int b) { return g.Degree(a) < g.Degree(b); });
+
+  std::vector<int> part(g.n, 0);
+  std::vector<int> level(g.n, -1);
+  std::vector<int> order;
+  std::vector<int> perm;
+  perm.reserve(g.n);
+  std::vector<char> visited(g.n, 0);
+  std::vector<int> neighbours;
+  // every connected component starts from a pseudo-peripheral vertex
+  for (int start : by_degree) {
+    if (visited[start] != 0) {
+      continue;
+    }
+    int root = PseudoPeripheral(g, start, part, 0, level, order);
+    for (int v : order) {
+      level[v] = -1;
+    }
+    size_t head = perm.size();
+    perm.push_back(root);
+    visited[root] = 1;
+    for (; head < perm.size(); head++) {
+      int v = perm[head];
+      neighbours.clear();
+      for (int j = g.ptr[v]; j < g.ptr[v + 1]; j++) {
+        if (visited[g.adj[j]] == 0) {
+          visited[g.adj[j]] = 1;
+          neighbours.push_back(g.adj[j]);
+        }
+      }
+      std::stable_sort(neighbours.begin(), neighbours.end(),
+                       [&](int a, int b) { return g.Degree(a) < g.Degree(b); });
+      perm.insert(perm.end(), neighbours.begin(), neighbours.end());
+    }
+  }
+  std::reverse(perm.begin(), perm.end());
+  return perm;
+}
+
+std::vector<int> mironov_omp::NestedDissection(const MatrixCRS& A, int depth) {
+  Graph g = SymmetricPattern(A);
+  std::vector<int> part(g.n, 0);
+  std::vector<int> level(g.n, -1);
+  std::vector<int> nodes(g.n);
+  for (int v = 0; v < g.n; v++) {
+    nodes[v] = v;
+  }
+  int next_id = 1;
+  std::vector<int> perm;
+  perm.reserve(g.n);
+  if (g.n > 0) {
+    Dissect(g, std::move(nodes), depth, part, next_id, level, perm);
+  }
+  return perm;
+}
+
+std::vector<int> mironov_omp::InversePermutation(const std::vector<int>& perm) {
+  std::vector<int> inverse(perm.size());
+  for (size_t i = 0; i < perm.size(); i++) {
+    inverse[perm[i]] = static_cast<int>(i);
+  }
+  return inverse;
+}
+
+mironov_omp::MatrixCRS mironov_omp::PermuteSymmetric(const MatrixCRS& A, const std::vector<int>& perm) {
+  std::vector<int> inverse = InversePermutation(perm);
+  MatrixCRS B(A.N, A.NZ);
+  for (int i = 0; i < A.N; i++) {
+    B.RowIndex[i + 1] = B.RowIndex[i] + A.RowIndex[perm[i] + 1] - A.RowIndex[perm[i]];
+  }
+#pragma omp parallel
+  {
+    std::vector<std::pair<int, double>> row;
+#pragma omp for schedule(dynamic, 64)
+    for (int i = 0; i < A.N; i++) {
+      row.clear();
+      for (int j = A.RowIndex[perm[i]]; j < A.RowIndex[perm[i] + 1]; j++) {
+        row.emplace_back(inverse[A.Col[j]], A.Value[j]);
+      }
+      std::sort(row.begin(), row.end());
+      int pos = B.RowIndex[i];
+      for (const auto& [col, value] : row) {
+        B.Col[pos] = col;
+        B.Value[pos++] = value;
+      }
+    }
+  }
+  return B;
+}
+
+void mironov_omp::PermuteVector(const double* x, const std::vector<int>& perm, double* out) {
+  int n = static_cast<int>(perm.size());
+#pragma omp parallel for
+  for (int i = 0; i < n; i++) {
+    out[i] = x[perm[i]];
+  }
+}
+
+void mironov_omp::UnpermuteVector(const double* x, const std::vector<int>& perm, double* out) {
+  int n = static_cast<int>(perm.size());
+#pragma omp parallel for
+  for (int i = 0; i < n; i++) {
+    out[perm[i]] = x[i];
+  }
+}
+
+int mironov_omp::Bandwidth(const MatrixCRS& A) {
+  int bandwidth = 0;
+#pragma omp parallel for reduction(max : bandwidth)
+  for (int i = 0; i < A.N; i++) {
+    for (int j = A.RowIndex[i]; j < A.RowIndex[i + 1]; j++) {
+      bandwidth = std::max(bandwidth, std::abs(A.Col[j] - i));
+    }
+  }
+  return bandwidth;
+}
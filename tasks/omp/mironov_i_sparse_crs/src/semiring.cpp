@@ -0,0 +1,93 @@
+// Copyright 2024 Mironov Ilya
+#include "omp/mironov_i_sparse_crs/include/semiring.hpp"
+
+#include <omp.h>
+
+#include <algorithm>
+#include <vector>
+
+template <typename S>
+mironov_omp::MatrixCRS mironov_omp::Multiplicate(const MatrixCRS& A, const MatrixCRS& B, int k, const MatrixCRS* mask,
+                                                 bool complement) {
+  MatrixCRS C(A.N, 0);
+  // pass 0 counts the entries of every row, pass 1 writes them at their final offsets
+  for (int pass = 0; pass < 2; pass++) {
+#pragma omp parallel
+    {
+      std::vector<int> allowed(mask != nullptr ? k : 0, -1);
+      std::vector<int> seen(k, -1);
+      std::vector<double> acc(pass == 1 ? k : 0);
+#pragma omp for schedule(dynamic, 64)
+      for (int i = 0; i < A.N; i++) {
+        bool mask_empty = mask != nullptr && mask->RowIndex[i] == mask->RowIndex[i + 1];
+        if (mask_empty && !complement) {
+          C.RowIndex[i] = pass == 0 ? 0 : C.RowIndex[i];
+          continue;
+        }
+        if (mask != nullptr) {
+          for (int j = mask->RowIndex[i]; j < mask->RowIndex[i + 1]; j++) {
+            allowed[mask->Col[j]] = i;
+          }
+        }
+        int* cols = pass == 1 ? C.Col.data() + C.RowIndex[i] : nullptr;
+        int count = 0;
+        for (int a_j = A.RowIndex[i]; a_j < A.RowIndex[i + 1]; a_j++) {
+          int row = A.Col[a_j];
+          for (int b_j = B.RowIndex[row]; b_j < B.RowIndex[row + 1]; b_j++) {
+            int col = B.Col[b_j];
+            if (mask != nullptr && (allowed[col] == i) == complement) {
+              continue;
+            }
+            if (pass == 0) {
+              if (seen[col] != i) {
+                seen[col] = i;
+                count++;
+              }
+              continue;
+            }
+            double product = S::Multiply(A.Value[a_j], B.Value[b_j]);
+            if (seen[col] != i) {
+              seen[col] = i;
+              acc[col] = product;
+              cols[count++] = col;
+            } else {
+              acc[col] = S::Add(acc[col], product);
+            }
+          }
+        }
+        if (pass == 0) {
+          C.RowIndex[i] = count;
+          continue;
+        }
+        if (mask != nullptr && !complement) {
+          // the mask row is sorted already: walk it instead of sorting the touched columns
+          count = 0;
+          for (int j = mask->RowIndex[i]; j < mask->RowIndex[i + 1]; j++) {
+            if (seen[mask->Col[j]] == i) {
+              cols[count++] = mask->Col[j];
+            }
+          }
+        } else {
+          std::sort(cols, cols + count);
+        }
+        for (int j = 0; j < count; j++) {
+          C.Value[C.RowIndex[i] + j] = acc[cols[j]];
+        }
+      }
+    }
+    if (pass == 0) {
+      ExclusiveScan(C.RowIndex.data(), A.N);
+      C.NZ = C.RowIndex[A.N];
+      C.Col.resize(C.NZ);
+      C.Value.resize(C.NZ);
+    }
+  }
+  return C;
+}
+
+template mironov_omp::MatrixCRS mironov_omp::Multiplicate<mironov_omp::PlusTimes>(const MatrixCRS&, const MatrixCRS&,
+                                                                                  int, const MatrixCRS*, bool);
+template mironov_omp::MatrixCRS mironov_omp::Multiplicate<mironov_omp::MinPlus>(const MatrixCRS&, const MatrixCRS&,
+                                                                                int, const MatrixCRS*, bool);
+template mironov_omp::MatrixCRS mironov_omp::Multiplicate<mironov_omp::OrAnd>(const MatrixCRS&, const MatrixCRS&, int,
+                                                                              const MatrixCRS*, bool);
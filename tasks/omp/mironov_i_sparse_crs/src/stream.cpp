@@ -0,0 +1,477 @@
+// Copyright 2024 Mironov Ilya
+#include "omp/mironov_i_sparse_crs/include/stream.hpp"
+
+#include <omp.h>
+
+#if defined(_WIN32)
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+const char PANEL_MAGIC[4] = {'C', 'R', 'S', 'P'};
+
+struct FileHeader {
+  char magic[4];
+  int32_t by_columns;
+  int32_t rows;
+  int32_t cols;
+};
+
+// followed by int32 row_index[rows + 1], int32 col[nnz], padding to 8 bytes and double value[nnz]
+struct PanelHeader {
+  int64_t first;  // first row of a row panel, first column of a column panel
+  int64_t count;  // rows or columns covered
+  int64_t rows;   // rows of the stored block
+  int64_t nnz;
+};
+
+int64_t PanelBytes(int64_t rows, int64_t nnz) {
+  int64_t indices = 4 * (rows + 1 + nnz);
+  return static_cast<int64_t>(sizeof(PanelHeader)) + (indices + 7) / 8 * 8 + 8 * nnz;
+}
+
+struct PanelView {
+  int first;
+  int count;
+  int rows;
+  int nnz;
+  const int* row_index;
+  const int* col;
+  const double* value;
+};
+
+class PanelFile {
+ public:
+  enum class Advice { WillNeed, DontNeed };
+
+  explicit PanelFile(const std::string& path) {
+#if defined(_WIN32)
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+      return;
+    }
+    buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    begin = buffer.data();
+    length = buffer.size();
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return;
+    }
+    struct stat st {};
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+      void* addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (addr != MAP_FAILED) {
+        begin = static_cast<const char*>(addr);
+        length = st.st_size;
+        mapped = true;
+      }
+    }
+    close(fd);
+#endif
+    valid = Parse();
+  }
+  PanelFile(const PanelFile&) = delete;
+  PanelFile& operator=(const PanelFile&) = delete;
+  ~PanelFile() {
+#if !defined(_WIN32)
+    if (mapped) {
+      munmap(const_cast<char*>(begin), length);
+    }
+#endif
+  }
+
+  int Panels() const { return static_cast<int>(offsets.size()); }
+
+  PanelView Panel(int p) const {
+    PanelHeader h;
+    std::memcpy(&h, begin + offsets[p], sizeof(h));
+    const char* data = begin + offsets[p] + sizeof(PanelHeader);
+    int64_t indices = 4 * (h.rows + 1 + h.nnz);
+    return {static_cast<int>(h.first),
+            static_cast<int>(h.count),
+            static_cast<int>(h.rows),
+            static_cast<int>(h.nnz),
+            reinterpret_cast<const int*>(data),
+            reinterpret_cast<const int*>(data) + h.rows + 1,
+            reinterpret_cast<const double*>(data + (indices + 7) / 8 * 8)};
+  }
+
+  // Asks the kernel to read a panel ahead or to drop its pages; out-of-range panels are ignored.
+  void Advise(int p, Advice advice) const {
+#if !defined(_WIN32)
+    if (!mapped || p < 0 || p >= Panels()) {
+      return;
+    }
+    PanelView v = Panel(p);
+    size_t page = sysconf(_SC_PAGESIZE);
+    size_t start = offsets[p] / page * page;
+    size_t end = offsets[p] + PanelBytes(v.rows, v.nnz);
+    int flag = advice == Advice::WillNeed ? MADV_WILLNEED : MADV_DONTNEED;
+    madvise(const_cast<char*>(begin) + start, end - start, flag);
+#endif
+  }
+
+  FileHeader header{};
+  std::vector<int64_t> offsets;
+  bool valid{};
+
+ private:
+  // checks the header and that the offset table and every panel lie inside the file
+  bool Parse() {
+    int64_t size = static_cast<int64_t>(length);
+    if (begin == nullptr || size < static_cast<int64_t>(sizeof(FileHeader)) + 8) {
+      return false;
+    }
+    std::memcpy(&header, begin, sizeof(header));
+    int64_t panels = 0;
+    std::memcpy(&panels, begin + size - 8, 8);
+    if (panels < 0 || panels > size / 8) {
+      return false;
+    }
+    int64_t table = size - 8 - 8 * panels;
+    if (std::memcmp(header.magic, PANEL_MAGIC, 4) != 0 || header.rows < 0 || header.cols < 0 ||
+        table < static_cast<int64_t>(sizeof(FileHeader))) {
+      return false;
+    }
+    offsets.resize(panels);
+    std::memcpy(offsets.data(), begin + table, 8 * panels);
+    for (int64_t offset : offsets) {
+      PanelHeader h;
+      if (offset < static_cast<int64_t>(sizeof(FileHeader)) || offset % 8 != 0 ||
+          offset + static_cast<int64_t>(sizeof(h)) > table) {
+        return false;
+      }
+      std::memcpy(&h, begin + offset, sizeof(h));
+      if (h.rows < 0 || h.nnz < 0 || h.nnz > table || offset + PanelBytes(h.rows, h.nnz) > table) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  const char* begin{};
+  size_t length{};
+  bool mapped{};
+#if defined(_WIN32)
+  std::string buffer;
+#endif
+};
+
+class PanelWriter {
+ public:
+  PanelWriter(const std::string& path, bool by_columns, int rows, int cols) : out(path, std::ios::binary) {
+    FileHeader header{};
+    std::memcpy(header.magic, PANEL_MAGIC, 4);
+    header.by_columns = by_columns ? 1 : 0;
+    header.rows = rows;
+    header.cols = cols;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    position = sizeof(header);
+  }
+
+  bool Append(const mironov_omp::MatrixCRS& panel, int first, int count) {
+    PanelHeader h{first, count, panel.N, panel.NZ};
+    int64_t indices = 4 * (h.rows + 1 + h.nnz);
+    const char padding[8] = {};
+    offsets.push_back(position);
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    out.write(reinterpret_cast<const char*>(panel.RowIndex.data()), 4 * (h.rows + 1));
+    out.write(reinterpret_cast<const char*>(panel.Col.data()), 4 * h.nnz);
+    out.write(padding, (indices + 7) / 8 * 8 - indices);
+    out.write(reinterpret_cast<const char*>(panel.Value.data()), 8 * h.nnz);
+    position += PanelBytes(h.rows, h.nnz);
+    return static_cast<bool>(out);
+  }
+
+  bool Close() {
+    int64_t panels = static_cast<int64_t>(offsets.size());
+    out.write(reinterpret_cast<const char*>(offsets.data()), 8 * panels);
+    out.write(reinterpret_cast<const char*>(&panels), 8);
+    out.close();
+    return static_cast<bool>(out);
+  }
+
+ private:
+  std::ofstream out;
+  std::vector<int64_t> offsets;
+  int64_t position;
+};
+
+// C block = A panel * B column panel: the rows of the A panel, global columns inside the B panel
+mironov_omp::MatrixCRS MultiplicateBlock(const PanelView& a, const PanelView& b) {
+  mironov_omp::MatrixCRS C(a.rows, 0);
+#pragma omp parallel
+  {
+    std::vector<int> mark(b.count, -1);
+#pragma omp for schedule(dynamic, 64)
+    for (int i = 0; i < a.rows; i++) {
+      int count = 0;
+      for (int a_j = a.row_index[i]; a_j < a.row_index[i + 1]; a_j++) {
+        int row = a.col[a_j];
+        for (int b_j = b.row_index[row]; b_j < b.row_index[row + 1]; b_j++) {
+          int local = b.col[b_j] - b.first;
+          if (mark[local] != i) {
+            mark[local] = i;
+            count++;
+          }
+        }
+      }
+      C.RowIndex[i] = count;
+    }
+  }
+  mironov_omp::ExclusiveScan(C.RowIndex.data(), a.rows);
+  C.NZ = C.RowIndex[a.rows];
+  C.Col.resize(C.NZ);
+  C.Value.resize(C.NZ);
+#pragma omp parallel
+  {
+    std::vector<int> mark(b.count, -1);
+    std::vector<double> acc(b.count, 0.0);
+#pragma omp for schedule(dynamic, 64)
+    for (int i = 0; i < a.rows; i++) {
+      int* cols = C.Col.data() + C.RowIndex[i];
+      int count = 0;
+      for (int a_j = a.row_index[i]; a_j < a.row_index[i + 1]; a_j++) {
+        int row = a.col[a_j];
+        double a_val = a.value[a_j];
+        for (int b_j = b.row_index[row]; b_j < b.row_index[row + 1]; b_j++) {
+          int local = b.col[b_j] - b.first;
+          if (mark[local] != i) {
+            mark[local] = i;
+            cols[count++] = local;
+          }
+          acc[local] += a_val * b.value[b_j];
+        }
+      }
+      std::sort(cols, cols + count);
+      for (int j = 0; j < count; j++) {
+        C.Value[C.RowIndex[i] + j] = acc[cols[j]];
+        acc[cols[j]] = 0.0;
+        cols[j] += b.first;
+      }
+    }
+  }
+  return C;
+}
+
+// Joins blocks holding disjoint, increasing column ranges of the same rows.
+mironov_omp::MatrixCRS ConcatColumns(const std::vector<mironov_omp::MatrixCRS>& blocks, int rows) {
+  mironov_omp::MatrixCRS C(rows, 0);
+  for (const auto& block : blocks) {
+    for (int i = 0; i < rows; i++) {
+      C.RowIndex[i + 1] += block.RowIndex[i + 1] - block.RowIndex[i];
+    }
+  }
+  for (int i = 0; i < rows; i++) {
+    C.RowIndex[i + 1] += C.RowIndex[i];
+  }
+  C.NZ = C.RowIndex[rows];
+  C.Col.resize(C.NZ);
+  C.Value.resize(C.NZ);
+#pragma omp parallel for schedule(dynamic, 256)
+  for (int i = 0; i < rows; i++) {
+    int pos = C.RowIndex[i];
+    for (const auto& block : blocks) {
+      for (int j = block.RowIndex[i]; j < block.RowIndex[i + 1]; j++) {
+        C.Col[pos] = block.Col[j];
+        C.Value[pos++] = block.Value[j];
+      }
+    }
+  }
+  return C;
+}
+
+mironov_omp::MatrixCRS ToMatrix(const PanelView& v) {
+  mironov_omp::MatrixCRS A(v.rows, v.nnz);
+  std::copy(v.row_index, v.row_index + v.rows + 1, A.RowIndex.begin());
+  std::copy(v.col, v.col + v.nnz, A.Col.begin());
+  std::copy(v.value, v.value + v.nnz, A.Value.begin());
+  return A;
+}
+}  // namespace
+
+bool mironov_omp::WritePanels(const std::string& path, const MatrixCRS& A, int cols, int panel_size,
+                              bool by_columns) {
+  if (panel_size <= 0) {
+    return false;
+  }
+  PanelWriter writer(path, by_columns, A.N, cols);
+  int extent = by_columns ? cols : A.N;
+  for (int first = 0; first < extent; first += panel_size) {
+    int last = std::min(extent, first + panel_size);
+    MatrixCRS panel(by_columns ? A.N : last - first, 0);
+    for (int i = 0; i < panel.N; i++) {
+      int row = by_columns ? i : first + i;
+      auto begin = A.Col.begin() + A.RowIndex[row];
+      auto end = A.Col.begin() + A.RowIndex[row + 1];
+      if (by_columns) {
+        begin = std::lower_bound(begin, end, first);
+        end = std::lower_bound(begin, end, last);
+      }
+      panel.Col.insert(panel.Col.end(), begin, end);
+      panel.Value.insert(panel.Value.end(), A.Value.begin() + (begin - A.Col.begin()),
+                         A.Value.begin() + (end - A.Col.begin()));
+      panel.RowIndex[i + 1] = static_cast<int>(panel.Col.size());
+    }
+    panel.NZ = panel.RowIndex[panel.N];
+    if (!writer.Append(panel, first, last - first)) {
+      return false;
+    }
+  }
+  return writer.Close();
+}
+
+bool mironov_omp::ReadPanels(const std::string& path, MatrixCRS& A, int& rows, int& cols) {
+  PanelFile file(path);
+  if (!file.valid) {
+    return false;
+  }
+  rows = file.header.rows;
+  cols = file.header.cols;
+  if (file.header.by_columns != 0) {
+    std::vector<MatrixCRS> blocks;
+    for (int p = 0; p < file.Panels(); p++) {
+      if (file.Panel(p).rows != rows) {
+        return false;
+      }
+      blocks.push_back(ToMatrix(file.Panel(p)));
+    }
+    A = ConcatColumns(blocks, rows);
+    return true;
+  }
+  A = MatrixCRS(rows, 0);
+  int next_row = 0;
+  for (int p = 0; p < file.Panels(); p++) {
+    PanelView v = file.Panel(p);
+    if (v.first != next_row || v.rows != v.count || v.first + v.rows > rows) {
+      return false;
+    }
+    next_row += v.rows;
+    for (int i = 0; i < v.rows; i++) {
+      A.RowIndex[v.first + i + 1] = v.row_index[i + 1] - v.row_index[i];
+    }
+    A.Col.insert(A.Col.end(), v.col, v.col + v.nnz);
+    A.Value.insert(A.Value.end(), v.value, v.value + v.nnz);
+  }
+  for (int i = 0; i < rows; i++) {
+    A.RowIndex[i + 1] += A.RowIndex[i];
+  }
+  A.NZ = A.RowIndex[rows];
+  return next_row == rows;
+}
+
+bool mironov_omp::ReadPanelShape(const std::string& path, int& rows, int& cols, bool& by_columns) {
+  PanelFile file(path);
+  if (!file.valid) {
+    return false;
+  }
+  rows = file.header.rows;
+  cols = file.header.cols;
+  by_columns = file.header.by_columns != 0;
+  return true;
+}
+
+bool mironov_omp::MultiplicateOutOfCore(const std::string& a_path, const std::string& b_path,
+                                        const std::string& c_path) {
+  PanelFile a(a_path);
+  PanelFile b(b_path);
+  if (!a.valid || !b.valid || a.header.by_columns != 0 || b.header.by_columns == 0 ||
+      a.header.cols != b.header.rows) {
+    return false;
+  }
+  for (int p = 0; p < b.Panels(); p++) {
+    PanelView v = b.Panel(p);
+    if (v.rows != b.header.rows || v.first < 0 || v.count < 0 || v.first + v.count > b.header.cols) {
+      return false;
+    }
+  }
+  PanelWriter writer(c_path, false, a.header.rows, b.header.cols);
+  // the C panel being written while the next one is computed
+  std::future<bool> pending;
+  a.Advise(0, PanelFile::Advice::WillNeed);
+  b.Advise(0, PanelFile::Advice::WillNeed);
+  for (int ap = 0; ap < a.Panels(); ap++) {
+    a.Advise(ap + 1, PanelFile::Advice::WillNeed);
+    PanelView a_panel = a.Panel(ap);
+    if (a_panel.rows != a_panel.count) {
+      return false;
+    }
+    std::vector<MatrixCRS> blocks;
+    for (int bp = 0; bp < b.Panels(); bp++) {
+      // B is streamed once per A panel; after its last panel the first one is needed again
+      int next = bp + 1 < b.Panels() ? bp + 1 : (ap + 1 < a.Panels() ? 0 : -1);
+      b.Advise(next, PanelFile::Advice::WillNeed);
+      blocks.push_back(MultiplicateBlock(a_panel, b.Panel(bp)));
+      if (next != bp) {
+        b.Advise(bp, PanelFile::Advice::DontNeed);
+      }
+    }
+    MatrixCRS c_panel = ConcatColumns(blocks, a_panel.rows);
+    blocks.clear();
+    a.Advise(ap, PanelFile::Advice::DontNeed);
+    if (pending.valid() && !pending.get()) {
+      return false;
+    }
+    pending = std::async(std::launch::async, [&writer, panel = std::move(c_panel), first = a_panel.first]() {
+      return writer.Append(panel, first, panel.N);
+    });
+  }
+  if (pending.valid() && !pending.get()) {
+    return false;
+  }
+  return writer.Close();
+}
+
+bool MironovIOMPStream::validation() {
+  internal_order_test();
+  if (taskData->inputs.size() != 2 || taskData->outputs.size() != 1) {
+    return false;
+  }
+  if (taskData->inputs[0] == nullptr || taskData->inputs[1] == nullptr || taskData->outputs[0] == nullptr) {
+    return false;
+  }
+  int a_rows = 0;
+  int a_cols = 0;
+  int b_rows = 0;
+  int b_cols = 0;
+  bool a_by_columns = false;
+  bool b_by_columns = false;
+  return mironov_omp::ReadPanelShape(*reinterpret_cast<std::string*>(taskData->inputs[0]), a_rows, a_cols,
+                                     a_by_columns) &&
+         mironov_omp::ReadPanelShape(*reinterpret_cast<std::string*>(taskData->inputs[1]), b_rows, b_cols,
+                                     b_by_columns) &&
+         !a_by_columns && b_by_columns && a_cols == b_rows;
+}
+
+bool MironovIOMPStream::pre_processing() {
+  internal_order_test();
+  a_path = *reinterpret_cast<std::string*>(taskData->inputs[0]);
+  b_path = *reinterpret_cast<std::string*>(taskData->inputs[1]);
+  c_path = *reinterpret_cast<std::string*>(taskData->outputs[0]);
+  return true;
+}
+
+bool MironovIOMPStream::run() {
+  internal_order_test();
+  return mironov_omp::MultiplicateOutOfCore(a_path, b_path, c_path);
+}
+
+bool MironovIOMPStream::post_processing() {
+  internal_order_test();
+  return true;
+}
@@ -7,6 +7,7 @@
 #include <utility>
 #include <vector>
 
+#include "core/gemm/include/strassen.hpp"
 #include "core/task/include/task.hpp"
 
 class TestTaskOMPParallelPivovarovStrassen : public ppc::core::Task {
@@ -23,6 +24,10 @@ class TestTaskOMPParallelPivovarovStrassen : public ppc::core::Task {
   std::vector<double> B;
   std::vector<double> result;
   int n = 0, m = 0;
+  // operand sums and products of the levels run as tasks, then a leaf workspace for each thread
+  std::vector<double> work;
+  ppc::core::StrassenTuning tuning{};
+  int levels = 0;
 };
 
 inline std::vector<double> createRndMatrix(int n) {
@@ -42,11 +47,3 @@ inline std::vector<double> createRndMatrix(int n) {
 }
 
 std::vector<double> multiplyMatrix(const std::vector<double>& A, const std::vector<double>& B, int n);
-
-void split(const std::vector<double>& mSplit, std::vector<double>& a11, std::vector<double>& a12,
-           std::vector<double>& a21, std::vector<double>& a22);
-
-std::vector<double> merge(std::vector<double> a11, std::vector<double> a12, std::vector<double> a21,
-                          std::vector<double> a22);
-
-std::vector<double> strassenMatrixMult(const std::vector<double>& A, const std::vector<double>& B, int n);
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include <utility>
 #include <vector>
 
+#include "core/gemm/include/tiled.hpp"
 #include "core/task/include/task.hpp"
 
 class SafronovSeqFoxAlgTaskOMP : public ppc::core::Task {
@@ -17,7 +18,9 @@ class SafronovSeqFoxAlgTaskOMP : public ppc::core::Task {
   bool post_processing() override;
 
  private:
-  double *A{}, *B{}, *C{};
+  ppc::core::TiledMatrix A;
+  ppc::core::TiledMatrix B;
+  ppc::core::TiledMatrix C;
   size_t n{};
 };
 
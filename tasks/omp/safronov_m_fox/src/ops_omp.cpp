@@ -4,14 +4,22 @@
 
 #include <omp.h>
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <random>
-#include <stdexcept>
 #include <vector>
 
-using std::cout;
-using std::endl;
+#include "core/gemm/include/blocking.hpp"
+#include "core/gemm/include/gemm.hpp"
+
+namespace {
+void multiplyBlock(const ppc::core::TiledMatrix& A, const ppc::core::TiledMatrix& B, ppc::core::TiledMatrix& C, int i,
+                   int j, int k) {
+  int t = C.Tile();
+  ppc::core::Gemm(t, t, t, A.Block(i, k), t, B.Block(k, j), t, C.Block(i, j), t);
+}
+}  // namespace
 
 bool SafronovSeqFoxAlgTaskOMP::validation() {
   internal_order_test();
@@ -35,66 +43,38 @@ bool SafronovSeqFoxAlgTaskOMP::validation() {
 
 bool SafronovSeqFoxAlgTaskOMP::pre_processing() {
   internal_order_test();
-  int num_threads = 2;
-  size_t matrix_size = taskData->inputs_count[0];
-  if (matrix_size % num_threads != 0) {
-    std::cerr << "Matrix size must be divisible by the number of threads\n";
-    return false;
-  }
-  A = reinterpret_cast<double*>(taskData->inputs[0]);
-  B = reinterpret_cast<double*>(taskData->inputs[1]);
-  C = reinterpret_cast<double*>(taskData->outputs[0]);
+  int n_int = static_cast<int>(n);
+  // blocks are contiguous tiles that Gemm reads in place; edge blocks are padded with zeros, so the block size
+  // measured for this host does not have to divide n
+  int block = n_int > 0 ? ppc::core::TuneBlockSize("fox", n_int, omp_get_max_threads()) : 1;
+  A = ppc::core::TiledMatrix(n_int, n_int, block);
+  B = ppc::core::TiledMatrix(n_int, n_int, block);
+  C = ppc::core::TiledMatrix(n_int, n_int, block);
+  A.FromRowMajor(reinterpret_cast<double*>(taskData->inputs[0]), n_int);
+  B.FromRowMajor(reinterpret_cast<double*>(taskData->inputs[1]), n_int);
   return true;
 }
 
 bool SafronovSeqFoxAlgTaskOMP::run() {
   internal_order_test();
-  try {
-    int num_threads = 2;
-    size_t block_size = n / num_threads;
-
-    double* result_row;
-    double* matrix_a_block_row;
-    double* matrix_b_block_row;
-
-    double tmp;
-
-    size_t result_row_index;
-
-    int n_int = static_cast<int>(n);
-    int block_size_int = static_cast<int>(block_size);
-
-#pragma omp parallel for num_threads(num_threads) private(matrix_a_block_row, matrix_b_block_row, result_row, tmp, \
-                                                              result_row_index)
-    for (int i = 0; i < n_int; i += block_size_int) {
-      for (int k = 0; k < n_int; k += block_size_int) {
-        for (int l = 0; l < n_int; l += block_size_int) {
-          result_row_index = static_cast<size_t>((i + l) % n_int);
-          for (int ii = 0; ii < block_size_int; ii++) {
-            matrix_a_block_row = A + (i + ii) * n + result_row_index;
-            result_row = C + (i + ii) * n + k;
-            for (int jj = 0; jj < block_size_int; jj++) {
-              matrix_b_block_row = B + result_row_index * n + (k + jj);
-              tmp = 0;
-              for (int kk = 0; kk < block_size_int; kk++) {
-                tmp += matrix_a_block_row[kk] * matrix_b_block_row[kk * n];
-              }
-#pragma omp atomic
-              result_row[jj] += tmp;
-            }
-          }
-        }
+  // every block of C belongs to one thread, which runs all of Fox's stages on it, so the block products are
+  // accumulated without atomics
+  int q = C.BlockRows();
+  C.SetZero();
+#pragma omp parallel for collapse(2) schedule(static)
+  for (int i = 0; i < q; ++i) {
+    for (int j = 0; j < q; ++j) {
+      for (int stage = 0; stage < q; ++stage) {
+        multiplyBlock(A, B, C, i, j, (i + stage) % q);
       }
     }
-  } catch (const std::exception& e) {
-    cout << e.what() << endl;
-    return false;
   }
   return true;
 }
 
 bool SafronovSeqFoxAlgTaskOMP::post_processing() {
   internal_order_test();
+  C.ToRowMajor(reinterpret_cast<double*>(taskData->outputs[0]), C.Cols());
   return true;
 }
 
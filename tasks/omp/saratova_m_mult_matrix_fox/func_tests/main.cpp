@@ -226,4 +226,55 @@ TEST(Saratova_M_Mult_Matrix_Fox, Matrix_Mult_On_Another_Identity) {
       EXPECT_DOUBLE_EQ(out_par[i * n + j], par_in1[i * n + (n - j - 1)]);
     }
   }
-}
\ No newline at end of file
+}
+
+TEST(Saratova_M_Mult_Matrix_Fox, Random_Mult_Several_Blocks) {
+  // larger than a block and not a multiple of it
+  size_t n = 150;
+  std::vector<double> in1(n * n);
+  std::vector<double> in2(n * n);
+  FillRandomValues(in1.data(), n * n);
+  FillRandomValues(in2.data(), n * n);
+  std::vector<double> expected(n * n, 0.0);
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t k = 0; k < n; ++k) {
+      for (size_t j = 0; j < n; ++j) {
+        expected[i * n + j] += in1[i * n + k] * in2[k * n + j];
+      }
+    }
+  }
+
+  std::vector<double> out_seq(n * n);
+  std::vector<double> out_par(n * n);
+
+  std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(in1.data()));
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(in2.data()));
+  taskDataSeq->inputs_count.emplace_back(in1.size());
+  taskDataSeq->inputs_count.emplace_back(in2.size());
+  taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(out_seq.data()));
+  taskDataSeq->outputs_count.emplace_back(out_seq.size());
+  SaratovaTaskSequential taskSeq(taskDataSeq);
+  ASSERT_TRUE(taskSeq.validation());
+  taskSeq.pre_processing();
+  taskSeq.run();
+  taskSeq.post_processing();
+
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(in1.data()));
+  taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(in2.data()));
+  taskDataPar->inputs_count.emplace_back(in1.size());
+  taskDataPar->inputs_count.emplace_back(in2.size());
+  taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t *>(out_par.data()));
+  taskDataPar->outputs_count.emplace_back(out_par.size());
+  SaratovaTaskOmp taskPar(taskDataPar);
+  ASSERT_TRUE(taskPar.validation());
+  taskPar.pre_processing();
+  taskPar.run();
+  taskPar.post_processing();
+
+  for (size_t i = 0; i < n * n; ++i) {
+    ASSERT_DOUBLE_EQ(out_seq[i], expected[i]);
+    ASSERT_DOUBLE_EQ(out_par[i], expected[i]);
+  }
+}
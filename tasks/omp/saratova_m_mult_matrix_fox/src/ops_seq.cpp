@@ -3,11 +3,21 @@
 
 #include <omp.h>
 
+#include <algorithm>
 #include <cmath>
-#include <cstring>
-#include <iostream>
 #include <random>
 
+#include "core/gemm/include/blocking.hpp"
+#include "core/gemm/include/gemm.hpp"
+
+namespace {
+void multiplyBlock(const ppc::core::TiledMatrix& A, const ppc::core::TiledMatrix& B, ppc::core::TiledMatrix& C, int i,
+                   int j, int k) {
+  int t = C.Tile();
+  ppc::core::Gemm(t, t, t, A.Block(i, k), t, B.Block(k, j), t, C.Block(i, j), t);
+}
+}  // namespace
+
 void saratova_omp::GenerateIdentityMatrix(double* matrix, int size, double scale) {
   std::fill(matrix, matrix + size * size, 0.0);
   for (int i = 0; i < size; ++i) {
@@ -40,35 +50,37 @@ bool saratova_omp::SaratovaTaskSequential::validation() {
 
 bool saratova_omp::SaratovaTaskSequential::pre_processing() {
   internal_order_test();
-  matrixA = reinterpret_cast<double*>(taskData->inputs[0]);
-  matrixB = reinterpret_cast<double*>(taskData->inputs[1]);
-  matrixC = reinterpret_cast<double*>(taskData->outputs[0]);
-  dimension = static_cast<size_t>(std::sqrt(taskData->inputs_count[0]));
-  std::fill(matrixC, matrixC + dimension * dimension, 0.0);
+  int n = static_cast<int>(std::round(std::sqrt(taskData->inputs_count[0])));
+  // blocks are contiguous tiles that Gemm reads in place; edge blocks are padded with zeros, so the block size
+  // measured for this host does not have to divide the matrix size
+  int block = n > 0 ? ppc::core::TuneBlockSize("fox", n, 1) : 1;
+  matrixA = ppc::core::TiledMatrix(n, n, block);
+  matrixB = ppc::core::TiledMatrix(n, n, block);
+  matrixC = ppc::core::TiledMatrix(n, n, block);
+  matrixA.FromRowMajor(reinterpret_cast<double*>(taskData->inputs[0]), n);
+  matrixB.FromRowMajor(reinterpret_cast<double*>(taskData->inputs[1]), n);
   return true;
 }
 
 bool saratova_omp::SaratovaTaskSequential::run() {
   internal_order_test();
-  try {
-    for (size_t i = 0; i < dimension; ++i) {
-      for (size_t j = 0; j < dimension; ++j) {
-        double sum = 0.0;
-        for (size_t k = 0; k < dimension; ++k) {
-          sum += matrixA[i * dimension + k] * matrixB[k * dimension + j];
-        }
-        matrixC[i * dimension + j] = sum;
+  // Fox's stages: at stage s block (i, j) of C adds the product of block (i, (i + s) mod q) of A, broadcast along
+  // block row i, and the matching block of B
+  int q = matrixC.BlockRows();
+  matrixC.SetZero();
+  for (int stage = 0; stage < q; ++stage) {
+    for (int i = 0; i < q; ++i) {
+      for (int j = 0; j < q; ++j) {
+        multiplyBlock(matrixA, matrixB, matrixC, i, j, (i + stage) % q);
       }
     }
-  } catch (const std::exception& ex) {
-    std::cerr << ex.what() << std::endl;
-    return false;
   }
   return true;
 }
 
 bool saratova_omp::SaratovaTaskSequential::post_processing() {
   internal_order_test();
+  matrixC.ToRowMajor(reinterpret_cast<double*>(taskData->outputs[0]), matrixC.Cols());
   return true;
 }
 
@@ -81,43 +93,36 @@ bool saratova_omp::SaratovaTaskOmp::validation() {
 
 bool saratova_omp::SaratovaTaskOmp::pre_processing() {
   internal_order_test();
-  matrixA = reinterpret_cast<double*>(taskData->inputs[0]);
-  matrixB = reinterpret_cast<double*>(taskData->inputs[1]);
-  matrixC = reinterpret_cast<double*>(taskData->outputs[0]);
-  dimension = static_cast<int>(std::sqrt(taskData->inputs_count[0]));
-  std::fill(matrixC, matrixC + dimension * dimension, 0.0);
+  int n = static_cast<int>(std::round(std::sqrt(taskData->inputs_count[0])));
+  // blocks are contiguous tiles that Gemm reads in place; edge blocks are padded with zeros, so the block size
+  // measured for this host does not have to divide the matrix size
+  int block = n > 0 ? ppc::core::TuneBlockSize("fox", n, omp_get_max_threads()) : 1;
+  matrixA = ppc::core::TiledMatrix(n, n, block);
+  matrixB = ppc::core::TiledMatrix(n, n, block);
+  matrixC = ppc::core::TiledMatrix(n, n, block);
+  matrixA.FromRowMajor(reinterpret_cast<double*>(taskData->inputs[0]), n);
+  matrixB.FromRowMajor(reinterpret_cast<double*>(taskData->inputs[1]), n);
   return true;
 }
 
 bool saratova_omp::SaratovaTaskOmp::run() {
   internal_order_test();
-  try {
-    const int numThreads = 2;
-    const int blockSize = dimension / numThreads;
-#pragma omp parallel for num_threads(numThreads)
-    for (int bi = 0; bi < dimension; bi += blockSize) {
-      for (int bj = 0; bj < dimension; bj += blockSize) {
-        for (int bk = 0; bk < dimension; bk += blockSize) {
-          for (int i = bi; i < bi + blockSize; ++i) {
-            for (int j = bj; j < bj + blockSize; ++j) {
-              double sum = 0.0;
-              for (int k = bk; k < bk + blockSize; ++k) {
-                sum += matrixA[i * dimension + k] * matrixB[k * dimension + j];
-              }
-              matrixC[i * dimension + j] += sum;
-            }
-          }
-        }
+  // every block of C belongs to one thread, which runs all of Fox's stages on it
+  int q = matrixC.BlockRows();
+  matrixC.SetZero();
+#pragma omp parallel for collapse(2) schedule(static)
+  for (int i = 0; i < q; ++i) {
+    for (int j = 0; j < q; ++j) {
+      for (int stage = 0; stage < q; ++stage) {
+        multiplyBlock(matrixA, matrixB, matrixC, i, j, (i + stage) % q);
       }
     }
-  } catch (const std::exception& ex) {
-    std::cerr << ex.what() << std::endl;
-    return false;
   }
   return true;
 }
 
 bool saratova_omp::SaratovaTaskOmp::post_processing() {
   internal_order_test();
+  matrixC.ToRowMajor(reinterpret_cast<double*>(taskData->outputs[0]), matrixC.Cols());
   return true;
 }
@@ -2,10 +2,10 @@
 #pragma once
 
 #include <memory>
-#include <string>
 #include <utility>
 #include <vector>
 
+#include "core/gemm/include/tiled.hpp"
 #include "core/task/include/task.hpp"
 
 class SkotinMatrixMultiplicationOMPSeq : public ppc::core::Task {
@@ -19,12 +19,9 @@ class SkotinMatrixMultiplicationOMPSeq : public ppc::core::Task {
   bool post_processing() override;
 
  private:
-  std::vector<std::vector<double>> matrixA;
-  std::vector<std::vector<double>> matrixB;
-  std::vector<std::vector<double>> resultMatrix;
-
-  static bool loadMatrix(const std::vector<double>& inputData, std::vector<std::vector<double>>& matrix, size_t size);
-  bool saveResult();
+  ppc::core::TiledMatrix matrixA;
+  ppc::core::TiledMatrix matrixB;
+  ppc::core::TiledMatrix resultMatrix;
 };
 
 class SkotinMatrixMultiplicationOMPParallel : public ppc::core::Task {
@@ -38,10 +35,7 @@ class SkotinMatrixMultiplicationOMPParallel : public ppc::core::Task {
   bool post_processing() override;
 
  private:
-  std::vector<std::vector<double>> matrixA;
-  std::vector<std::vector<double>> matrixB;
-  std::vector<std::vector<double>> resultMatrix;
-
-  static bool loadMatrix(const std::vector<double>& inputData, std::vector<std::vector<double>>& matrix, size_t size);
-  bool saveResult();
+  ppc::core::TiledMatrix matrixA;
+  ppc::core::TiledMatrix matrixB;
+  ppc::core::TiledMatrix resultMatrix;
 };
@@ -1,6 +1,7 @@
 // Copyright 2024 Ustinov Alexander
 #pragma once
 
+#include <algorithm>
 #include <complex>
 #include <random>
 #include <vector>
@@ -20,4 +21,46 @@ struct sparse_matrix {
         col_ptr(row_num + 1),
         rows(nonzeros),
         values(nonzeros) {}
-};
\ No newline at end of file
+};
+
+// the same CSC matrix with real and imaginary parts in separate arrays (structure of arrays): the multiply-add
+// kernels then work on plain doubles, vectorize, and skip the NaN recovery of std::complex multiplication
+struct sparse_matrix_soa {
+  int row_num, col_num;      // number of rows and columns in matrix
+  int nonzeros;              // number of non-zero elements
+  std::vector<int> col_ptr;  // index at which column data in `rows`, `re` and `im` begins
+  std::vector<int> rows;     // rows of non-zero elements of matrix
+  std::vector<double> re;    // real parts of non-zero elements
+  std::vector<double> im;    // imaginary parts of non-zero elements
+
+  sparse_matrix_soa(int row_num_ = 0, int col_num_ = 0, int nonzeros_ = 0)
+      : row_num(row_num_),
+        col_num(col_num_),
+        nonzeros(nonzeros_),
+        col_ptr(col_num + 1),
+        rows(nonzeros),
+        re(nonzeros),
+        im(nonzeros) {}
+};
+
+inline sparse_matrix_soa to_soa(const sparse_matrix &m) {
+  sparse_matrix_soa soa(m.row_num, m.col_num, m.nonzeros);
+  std::copy(m.col_ptr.begin(), m.col_ptr.begin() + m.col_num + 1, soa.col_ptr.begin());
+  soa.rows = m.rows;
+  for (int i = 0; i < m.nonzeros; ++i) {
+    soa.re[i] = m.values[i].real();
+    soa.im[i] = m.values[i].imag();
+  }
+  return soa;
+}
+
+inline sparse_matrix from_soa(const sparse_matrix_soa &soa) {
+  sparse_matrix m(soa.row_num, soa.col_num, soa.nonzeros);
+  m.col_ptr.resize(soa.col_num + 1);
+  std::copy(soa.col_ptr.begin(), soa.col_ptr.end(), m.col_ptr.begin());
+  m.rows = soa.rows;
+  for (int i = 0; i < soa.nonzeros; ++i) {
+    m.values[i] = {soa.re[i], soa.im[i]};
+  }
+  return m;
+}
@@ -2,6 +2,9 @@
 #include <gtest/gtest.h>
 #include <omp.h>
 
+#include <algorithm>
+#include <iostream>
+#include <random>
 #include <vector>
 
 #include "core/perf/include/perf.hpp"
@@ -107,4 +110,64 @@ TEST(ustinov_a_spgemm_csc_complex_omp, test_task_run_dft384x384) {
   auto perfAnalyzer = std::make_shared<ppc::core::Perf>(testTaskParallel);
   perfAnalyzer->task_run(perfAttr, perfResults);
   ppc::core::Perf::print_perf_statistic(perfResults);
-}
\ No newline at end of file
+}
+
+// random n x n matrix with col_nz entries per column
+sparse_matrix random_matrix(int n, int col_nz) {
+  std::mt19937 gen(384);
+  std::uniform_real_distribution<double> value(-1.0, 1.0);
+  sparse_matrix m(n, n, n * col_nz);
+  for (int j = 0; j < n; ++j) {
+    m.col_ptr[j + 1] = (j + 1) * col_nz;
+    for (int k = 0; k < col_nz; ++k) {
+      m.rows[j * col_nz + k] = (j * 7 + k * (n / col_nz)) % n;
+      m.values[j * col_nz + k] = {value(gen), value(gen)};
+    }
+    std::sort(m.rows.begin() + j * col_nz, m.rows.begin() + (j + 1) * col_nz);
+  }
+  return m;
+}
+
+// average time of `runs` multiplications done by a task of type Task on matrices of type Matrix
+template <typename Task, typename Matrix>
+double multiply_seconds(Matrix &A, Matrix &B, int runs) {
+  double total = 0.0;
+  for (int r = 0; r < runs; ++r) {
+    Matrix C;
+    std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+    taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(&A));
+    taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(&B));
+    taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(&C));
+    Task task(taskData);
+    const auto t0 = omp_get_wtime();
+    task.validation();
+    task.pre_processing();
+    task.run();
+    task.post_processing();
+    total += omp_get_wtime() - t0;
+  }
+  return total / runs;
+}
+
+void compare_layouts(const char *name, sparse_matrix &A, sparse_matrix &B, int runs) {
+  sparse_matrix_soa A_soa = to_soa(A);
+  sparse_matrix_soa B_soa = to_soa(B);
+  double aos = multiply_seconds<SpgemmCSCComplexOmpPar>(A, B, runs);
+  double soa = multiply_seconds<SpgemmCSCComplexOmpParSoA>(A_soa, B_soa, runs);
+  std::cout << name << ": std::complex (AoS) " << aos << " s, split re/im (SoA) " << soa << " s, speedup "
+            << aos / soa << std::endl;
+}
+
+TEST(ustinov_a_spgemm_csc_complex_soa_omp, test_dft384x384) {
+  int n = 384;
+  sparse_matrix A = dft_matrix(n);
+  sparse_matrix B = dft_conj_matrix(n);
+  compare_layouts("dft 384", A, B, 3);
+}
+
+TEST(ustinov_a_spgemm_csc_complex_soa_omp, test_random_sparse) {
+  int n = 8192;
+  sparse_matrix A = random_matrix(n, 24);
+  sparse_matrix B = random_matrix(n, 24);
+  compare_layouts("random 8192, 24 per column", A, B, 3);
+}
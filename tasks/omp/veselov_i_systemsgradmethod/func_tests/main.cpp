@@ -133,3 +133,81 @@ TEST(veslov_i_systems_grad_method_omp, Test_triple_diag_matrix) {
     ASSERT_LE(abs(excepted_res[i] - res[i]), 1e-6);
   }
 }
+
+namespace {
+std::shared_ptr<ppc::core::TaskData> csrTaskData(CsrMatrix &matrix, std::vector<double> &vec,
+                                                 std::vector<double> &res) {
+  std::shared_ptr<ppc::core::TaskData> taskDataOmp = std::make_shared<ppc::core::TaskData>();
+  taskDataOmp->inputs.emplace_back(reinterpret_cast<uint8_t *>(matrix.rowPtr.data()));
+  taskDataOmp->inputs_count.emplace_back(matrix.rowPtr.size());
+  taskDataOmp->inputs.emplace_back(reinterpret_cast<uint8_t *>(matrix.cols.data()));
+  taskDataOmp->inputs_count.emplace_back(matrix.cols.size());
+  taskDataOmp->inputs.emplace_back(reinterpret_cast<uint8_t *>(matrix.vals.data()));
+  taskDataOmp->inputs_count.emplace_back(matrix.vals.size());
+  taskDataOmp->inputs.emplace_back(reinterpret_cast<uint8_t *>(vec.data()));
+  taskDataOmp->inputs_count.emplace_back(vec.size());
+  taskDataOmp->outputs.emplace_back(reinterpret_cast<uint8_t *>(res.data()));
+  taskDataOmp->outputs_count.emplace_back(res.size());
+  return taskDataOmp;
+}
+}  // namespace
+
+TEST(veslov_i_systems_grad_method_omp, Test_csr_triple_diag_matrix) {
+  CsrMatrix matrix{{0, 2, 5, 8, 10}, {0, 1, 0, 1, 2, 1, 2, 3, 2, 3}, {2, -1, -1, 2, -1, -1, 2, -1, -1, 2}};
+  std::vector<double> vec = {1, 2, 3, 4};
+  std::vector<double> res(vec.size());
+  std::vector<double> excepted_res = {4, 7, 8, 6};
+
+  SystemsGradMethodCsrOmp systemsGradMethodOmp(csrTaskData(matrix, vec, res));
+  ASSERT_TRUE(systemsGradMethodOmp.validation());
+  ASSERT_TRUE(systemsGradMethodOmp.pre_processing());
+  ASSERT_TRUE(systemsGradMethodOmp.run());
+  ASSERT_TRUE(systemsGradMethodOmp.post_processing());
+  for (size_t i = 0; i < res.size(); i++) {
+    ASSERT_LE(abs(excepted_res[i] - res[i]), 1e-6);
+  }
+}
+
+TEST(veslov_i_systems_grad_method_omp, Test_csr_poisson) {
+  CsrMatrix matrix = genPoissonCsr(30);
+  std::vector<double> vec = genRandomVector(30 * 30, 10);
+  std::vector<double> res(vec.size());
+
+  SystemsGradMethodCsrOmp systemsGradMethodOmp(csrTaskData(matrix, vec, res));
+  ASSERT_TRUE(systemsGradMethodOmp.validation());
+  ASSERT_TRUE(systemsGradMethodOmp.pre_processing());
+  ASSERT_TRUE(systemsGradMethodOmp.run());
+  ASSERT_TRUE(systemsGradMethodOmp.post_processing());
+  ASSERT_TRUE(checkSolution(matrix, vec, res));
+}
+
+TEST(veslov_i_systems_grad_method_omp, Test_csr_validation) {
+  CsrMatrix matrix = genPoissonCsr(3);
+  std::vector<double> vec(9, 1.0);
+  std::vector<double> res(8);
+
+  SystemsGradMethodCsrOmp systemsGradMethodOmp(csrTaskData(matrix, vec, res));
+  ASSERT_FALSE(systemsGradMethodOmp.validation());
+}
+
+TEST(veslov_i_systems_grad_method_omp, Test_csr_without_output_count) {
+  CsrMatrix matrix = genPoissonCsr(3);
+  std::vector<double> vec(9, 1.0);
+  std::vector<double> res(9);
+
+  std::shared_ptr<ppc::core::TaskData> taskDataOmp = csrTaskData(matrix, vec, res);
+  taskDataOmp->outputs_count.clear();
+  SystemsGradMethodCsrOmp systemsGradMethodOmp(taskDataOmp);
+  ASSERT_FALSE(systemsGradMethodOmp.validation());
+}
+
+TEST(veslov_i_systems_grad_method_omp, Test_csr_not_positive_definite) {
+  CsrMatrix matrix{{0, 1, 2}, {0, 1}, {1, -1}};
+  std::vector<double> vec = {1, 1};
+  std::vector<double> res(vec.size());
+
+  SystemsGradMethodCsrOmp systemsGradMethodOmp(csrTaskData(matrix, vec, res));
+  ASSERT_TRUE(systemsGradMethodOmp.validation());
+  ASSERT_TRUE(systemsGradMethodOmp.pre_processing());
+  ASSERT_FALSE(systemsGradMethodOmp.run());
+}
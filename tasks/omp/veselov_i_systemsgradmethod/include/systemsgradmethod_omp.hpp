@@ -20,8 +20,36 @@ class SystemsGradMethodOmp : public ppc::core::Task {
   bool post_processing() override;
 };
 
+// Square matrix in compressed sparse rows.
+struct CsrMatrix {
+  std::vector<int> rowPtr;
+  std::vector<int> cols;
+  std::vector<double> vals;
+};
+
+// The same method for a sparse matrix: inputs are rowPtr (rows + 1 ints), cols and vals (one int and one double per
+// nonzero) and b. No rows x rows array is stored, so systems of millions of unknowns fit in memory.
+class SystemsGradMethodCsrOmp : public ppc::core::Task {
+  CsrMatrix A;
+  std::vector<double> b;
+  std::vector<double> x;
+  int rows;
+
+ public:
+  explicit SystemsGradMethodCsrOmp(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+  bool pre_processing() override;
+  bool validation() override;
+  bool run() override;
+  bool post_processing() override;
+};
+
 bool checkSolution(const std::vector<double> &Aa, const std::vector<double> &bb, const std::vector<double> &xx,
                    double tol = 1e-6);
+bool checkSolution(const CsrMatrix &Aa, const std::vector<double> &bb, const std::vector<double> &xx,
+                   double tol = 1e-6);
+std::vector<double> csrMatrixVectorProduct(const CsrMatrix &Aa, const std::vector<double> &xx);
+// 5-point Laplacian on a side x side grid
+CsrMatrix genPoissonCsr(int side);
 std::vector<double> genRandomVector(int size, int maxVal);
 std::vector<double> genRandomMatrix(int size, int maxVal);
 }  // namespace veselov_i_omp
@@ -2,8 +2,11 @@
 
 #include "seq/bakhtiarov_a_matrix_mult_ccs/include/ops_seq.hpp"
 
+#include <algorithm>
 #include <thread>
 
+#include "core/sparse/include/compress.hpp"
+
 using namespace std::chrono_literals;
 using namespace std;
 
@@ -20,33 +23,9 @@ bool SparseMatrixMultiSequential::pre_processing() {
 
   result = new double[numRows1 * numCols2]{0};
 
-  int notNullNumbers = 0;
-  for (int j = 0; j < numCols1; ++j) {
-    colPtr1.push_back(notNullNumbers);
-    for (int i = 0; i < numRows1; ++i) {
-      int index = i * numRows1 + j;
-      if (matrix1[index] != 0) {
-        values1.push_back(matrix1[index]);
-        rows1.push_back(i);
-        notNullNumbers++;
-      }
-    }
-  }
-  colPtr1.push_back(notNullNumbers);
-
-  notNullNumbers = 0;
-  for (int j = 0; j < numCols2; ++j) {
-    colPtr2.push_back(notNullNumbers);
-    for (int i = 0; i < numRows2; ++i) {
-      int index = i * numRows2 + j;
-      if (matrix2[index] != 0) {
-        values2.push_back(matrix2[index]);
-        rows2.push_back(i);
-        notNullNumbers++;
-      }
-    }
-  }
-  colPtr2.push_back(notNullNumbers);
+  auto nonzero = [](double v) { return v != 0; };
+  ppc::core::DenseToCompressed(matrix1, numRows1, numCols1, true, nonzero, values1, rows1, colPtr1);
+  ppc::core::DenseToCompressed(matrix2, numRows2, numCols2, true, nonzero, values2, rows2, colPtr2);
 
   return true;
 }
@@ -102,3 +81,87 @@ bool SparseMatrixMultiSequential::post_processing() {
 
   return true;
 }
+
+namespace BakhtiarovSeq {
+
+MatrixCCS MultiplyCCS(const MatrixCCS& a, const MatrixCCS& b) {
+  MatrixCCS c;
+  c.numRows = a.numRows;
+  c.numCols = b.numCols;
+  c.colPtr.push_back(0);
+
+  std::vector<double> column(a.numRows);
+  std::vector<int> mark(a.numRows, -1);
+  for (int j = 0; j < b.numCols; j++) {
+    int start = static_cast<int>(c.rows.size());
+    for (int k = b.colPtr[j]; k < b.colPtr[j + 1]; k++) {
+      int rowB = b.rows[k];
+      double y = b.values[k];
+      for (int i = a.colPtr[rowB]; i < a.colPtr[rowB + 1]; i++) {
+        int rowA = a.rows[i];
+        double x = a.values[i];
+        if (mark[rowA] != j) {
+          mark[rowA] = j;
+          c.rows.push_back(rowA);
+        }
+        column[rowA] += x * y;
+      }
+    }
+    std::sort(c.rows.begin() + start, c.rows.end());
+    for (size_t p = start; p < c.rows.size(); p++) {
+      c.values.push_back(column[c.rows[p]]);
+      column[c.rows[p]] = 0.0;
+    }
+    c.colPtr.push_back(static_cast<int>(c.rows.size()));
+  }
+
+  return c;
+}
+
+bool SparseMatrixMultiCCS::validation() {
+  internal_order_test();
+
+  if (taskData->inputs.size() != 2 || taskData->inputs_count.size() != 4 || taskData->outputs.size() != 1) {
+    return false;
+  }
+  if (taskData->inputs[0] == nullptr || taskData->inputs[1] == nullptr || taskData->outputs[0] == nullptr) {
+    return false;
+  }
+  const auto* matrix1 = reinterpret_cast<MatrixCCS*>(taskData->inputs[0]);
+  const auto* matrix2 = reinterpret_cast<MatrixCCS*>(taskData->inputs[1]);
+  return taskData->inputs_count[1] == taskData->inputs_count[2] &&
+         matrix1->numRows == static_cast<int>(taskData->inputs_count[0]) &&
+         matrix1->numCols == static_cast<int>(taskData->inputs_count[1]) &&
+         matrix2->numRows == static_cast<int>(taskData->inputs_count[2]) &&
+         matrix2->numCols == static_cast<int>(taskData->inputs_count[3]) &&
+         matrix1->colPtr.size() == static_cast<size_t>(matrix1->numCols) + 1 &&
+         matrix2->colPtr.size() == static_cast<size_t>(matrix2->numCols) + 1;
+}
+
+bool SparseMatrixMultiCCS::pre_processing() {
+  internal_order_test();
+
+  a = reinterpret_cast<MatrixCCS*>(taskData->inputs[0]);
+  b = reinterpret_cast<MatrixCCS*>(taskData->inputs[1]);
+  out = reinterpret_cast<MatrixCCS*>(taskData->outputs[0]);
+
+  return true;
+}
+
+bool SparseMatrixMultiCCS::run() {
+  internal_order_test();
+
+  c = MultiplyCCS(*a, *b);
+
+  return true;
+}
+
+bool SparseMatrixMultiCCS::post_processing() {
+  internal_order_test();
+
+  *out = std::move(c);
+
+  return true;
+}
+
+}  // namespace BakhtiarovSeq
@@ -172,3 +172,48 @@ TEST(MatrixMulFox, Test_Matrix_Mul_5x5) {
     ASSERT_DOUBLE_EQ(matrix_c[i], expected_result[i]);
   }
 }
+
+TEST(MatrixMulFox, Test_Matrix_Mul_6x6_Blocks_2x2) {
+  const int n = 6;
+  const int block_size = 2;
+
+  std::vector<int> input(2, 0);
+  input[0] = n;
+  input[1] = block_size;
+
+  std::vector<double> matrix_a(n * n);
+  std::vector<double> matrix_b(n * n);
+  std::vector<double> matrix_c(n * n, 0.0);
+  for (int i = 0; i < n * n; i++) {
+    matrix_a[i] = i + 1;
+    matrix_b[i] = i % 3 - 1;
+  }
+
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(input.data()));
+  taskData->inputs_count.emplace_back(input.size());
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(matrix_a.data()));
+  taskData->inputs_count.emplace_back(matrix_a.size());
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(matrix_b.data()));
+  taskData->inputs_count.emplace_back(matrix_b.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(matrix_c.data()));
+  taskData->outputs_count.emplace_back(matrix_c.size());
+
+  MatrixMulFox matrixMulFox(taskData);
+  ASSERT_EQ(matrixMulFox.validation(), true);
+  ASSERT_TRUE(matrixMulFox.pre_processing());
+  matrixMulFox.run();
+  matrixMulFox.post_processing();
+
+  std::vector<double> expected_result(n * n, 0.0);
+  for (int i = 0; i < n; i++) {
+    for (int k = 0; k < n; k++) {
+      for (int j = 0; j < n; j++) {
+        expected_result[i * n + j] += matrix_a[i * n + k] * matrix_b[k * n + j];
+      }
+    }
+  }
+  for (int i = 0; i < n * n; i++) {
+    ASSERT_DOUBLE_EQ(matrix_c[i], expected_result[i]);
+  }
+}
@@ -6,6 +6,7 @@
 #include <utility>
 #include <vector>
 
+#include "core/gemm/include/tiled.hpp"
 #include "core/task/include/task.hpp"
 
 class MatrixMulFox : public ppc::core::Task {
@@ -18,7 +19,7 @@ class MatrixMulFox : public ppc::core::Task {
 
  private:
   int n_{}, block_size_{};
-  std::vector<double> matrix_a_, matrix_b_, matrix_c_;
+  ppc::core::TiledMatrix matrix_a_, matrix_b_, matrix_c_;
 
   void fox_algorithm();
 };
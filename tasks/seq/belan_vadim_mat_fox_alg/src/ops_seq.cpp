@@ -1,24 +1,22 @@
 // Copyright 2023 Belan Vadim
 #include "seq/belan_vadim_mat_fox_alg/include/ops_seq.hpp"
 
-#include <cmath>
-#include <cstring>
+#include "core/gemm/include/gemm.hpp"
 
 bool MatrixMulFox::pre_processing() {
   int n = reinterpret_cast<int*>(taskData->inputs[0])[0];
   int block_size = reinterpret_cast<int*>(taskData->inputs[0])[1];
 
-  matrix_a_.resize(n * n);
-  matrix_b_.resize(n * n);
-  matrix_c_.resize(n * n);
-  std::memcpy(matrix_a_.data(), taskData->inputs[1], n * n * sizeof(double));
-  std::memcpy(matrix_b_.data(), taskData->inputs[2], n * n * sizeof(double));
-
   if (n <= 0 || block_size <= 0 || n % block_size != 0) {
     return false;
   }
 
-  std::fill(matrix_c_.begin(), matrix_c_.end(), 0.0);
+  // blocks of block_size x block_size are contiguous tiles that Gemm reads in place
+  matrix_a_ = ppc::core::TiledMatrix(n, n, block_size);
+  matrix_b_ = ppc::core::TiledMatrix(n, n, block_size);
+  matrix_c_ = ppc::core::TiledMatrix(n, n, block_size);
+  matrix_a_.FromRowMajor(reinterpret_cast<double*>(taskData->inputs[1]), n);
+  matrix_b_.FromRowMajor(reinterpret_cast<double*>(taskData->inputs[2]), n);
 
   n_ = n;
   block_size_ = block_size;
@@ -34,31 +32,22 @@ bool MatrixMulFox::run() {
 }
 
 bool MatrixMulFox::post_processing() {
-  std::memcpy(taskData->outputs[0], matrix_c_.data(), n_ * n_ * sizeof(double));
+  matrix_c_.ToRowMajor(reinterpret_cast<double*>(taskData->outputs[0]), n_);
   return true;
 }
 
 void MatrixMulFox::fox_algorithm() {
   int num_blocks = n_ / block_size_;
+  int t = block_size_;
 
+  // at stage k block (i, j) of C adds the product of block (i, (i + k) mod q) of A, broadcast along block row i, and
+  // the matching block of B
+  matrix_c_.SetZero();
   for (int k = 0; k < num_blocks; k++) {
     for (int i = 0; i < num_blocks; i++) {
+      int l = (i + k) % num_blocks;
       for (int j = 0; j < num_blocks; j++) {
-        for (int ii = 0; ii < block_size_; ii++) {
-          for (int jj = 0; jj < block_size_; jj++) {
-            for (int kk = 0; kk < block_size_; kk++) {
-              int row_a = (i + ii) % num_blocks;
-              int col_a = (k + kk) % num_blocks;
-              int row_b = (k + kk) % num_blocks;
-              int col_b = (j + jj) % num_blocks;
-              int row_c = (i + ii) % num_blocks;
-              int col_c = (j + jj) % num_blocks;
-              matrix_c_[(row_c * block_size_ + ii) * n_ + col_c * block_size_ + jj] +=
-                  matrix_a_[(row_a * block_size_ + ii) * n_ + col_a * block_size_ + kk] *
-                  matrix_b_[(row_b * block_size_ + kk) * n_ + col_b * block_size_ + jj];
-            }
-          }
-        }
+        ppc::core::Gemm(t, t, t, matrix_a_.Block(i, l), t, matrix_b_.Block(l, j), t, matrix_c_.Block(i, j), t);
       }
     }
   }
@@ -202,3 +202,107 @@ TEST(dostavalov_s_sop_gradient, Test_Rand_0) {
 
   ASSERT_TRUE(testTaskSequential.check_solution(matrix, vector, result));
 }  // namespace dostavalov_s_seq
+
+std::shared_ptr<ppc::core::TaskData> createCsrTaskData(CsrMatrix &matrix, std::vector<double> &vector,
+                                                       std::vector<double> &result) {
+  std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
+
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(matrix.row_ptr.data()));
+  taskDataSeq->inputs_count.emplace_back(matrix.row_ptr.size());
+
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(matrix.cols.data()));
+  taskDataSeq->inputs_count.emplace_back(matrix.cols.size());
+
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(matrix.vals.data()));
+  taskDataSeq->inputs_count.emplace_back(matrix.vals.size());
+
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(vector.data()));
+  taskDataSeq->inputs_count.emplace_back(vector.size());
+
+  taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(result.data()));
+  taskDataSeq->outputs_count.emplace_back(result.size());
+
+  return taskDataSeq;
+}
+
+TEST(dostavalov_s_sop_gradient, Test_Csr_Size_4) {
+  CsrMatrix matrix{{0, 2, 5, 8, 10}, {0, 1, 0, 1, 2, 1, 2, 3, 2, 3}, {2, -1, -1, 2, -1, -1, 2, -1, -1, 2}};
+  std::vector<double> vector = {1, 2, 3, 4};
+
+  std::vector<double> result(vector.size(), 0.0);
+  std::vector<double> true_result = {4, 7, 8, 6};
+
+  std::shared_ptr<ppc::core::TaskData> taskDataSeq = createCsrTaskData(matrix, vector, result);
+
+  SeqSLAYGradientCsr testTaskSequential(taskDataSeq);
+
+  ASSERT_TRUE(testTaskSequential.validation());
+  ASSERT_TRUE(testTaskSequential.pre_processing());
+  ASSERT_TRUE(testTaskSequential.run());
+  ASSERT_TRUE(testTaskSequential.post_processing());
+
+  for (size_t i = 0; i < result.size(); ++i) {
+    ASSERT_NEAR(result[i], true_result[i], TOLERANCE);
+  }
+}
+
+TEST(dostavalov_s_sop_gradient, Test_Csr_Poisson_30) {
+  CsrMatrix matrix = poissonMatrix(30);
+  std::vector<double> vector = randVector(30 * 30);
+
+  std::vector<double> result(vector.size(), 0.0);
+
+  std::shared_ptr<ppc::core::TaskData> taskDataSeq = createCsrTaskData(matrix, vector, result);
+
+  SeqSLAYGradientCsr testTaskSequential(taskDataSeq);
+
+  ASSERT_TRUE(testTaskSequential.validation());
+  ASSERT_TRUE(testTaskSequential.pre_processing());
+  ASSERT_TRUE(testTaskSequential.run());
+  ASSERT_TRUE(testTaskSequential.post_processing());
+
+  ASSERT_TRUE(SeqSLAYGradient::check_solution(matrix, vector, result));
+}
+
+TEST(dostavalov_s_sop_gradient, Test_Csr_Wrong_Size) {
+  CsrMatrix matrix = poissonMatrix(3);
+  std::vector<double> vector(8, 1.0);
+
+  std::vector<double> result(vector.size(), 0.0);
+
+  std::shared_ptr<ppc::core::TaskData> taskDataSeq = createCsrTaskData(matrix, vector, result);
+
+  SeqSLAYGradientCsr testTaskSequential(taskDataSeq);
+
+  ASSERT_FALSE(testTaskSequential.validation());
+}
+
+TEST(dostavalov_s_sop_gradient, Test_Csr_Without_Output_Count) {
+  CsrMatrix matrix = poissonMatrix(3);
+  std::vector<double> vector(9, 1.0);
+
+  std::vector<double> result(vector.size(), 0.0);
+
+  std::shared_ptr<ppc::core::TaskData> taskDataSeq = createCsrTaskData(matrix, vector, result);
+  taskDataSeq->outputs_count.clear();
+
+  SeqSLAYGradientCsr testTaskSequential(taskDataSeq);
+
+  ASSERT_FALSE(testTaskSequential.validation());
+}
+
+TEST(dostavalov_s_sop_gradient, Test_Csr_Not_Positive_Definite) {
+  // the residual turns into NaN and never drops below the tolerance
+  CsrMatrix matrix{{0, 1, 2}, {0, 1}, {1, -1}};
+  std::vector<double> vector = {1, 1};
+
+  std::vector<double> result(vector.size(), 0.0);
+
+  std::shared_ptr<ppc::core::TaskData> taskDataSeq = createCsrTaskData(matrix, vector, result);
+
+  SeqSLAYGradientCsr testTaskSequential(taskDataSeq);
+
+  ASSERT_TRUE(testTaskSequential.validation());
+  ASSERT_TRUE(testTaskSequential.pre_processing());
+  ASSERT_FALSE(testTaskSequential.run());
+}
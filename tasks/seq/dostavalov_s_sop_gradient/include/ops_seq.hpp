@@ -7,12 +7,23 @@
 
 namespace dostavalov_s_seq {
 const double TOLERANCE = 0.0001;
+const int MAX_ITERATIONS = 100000;
 const double MIN_VALUE = 0.0;
 const double MAX_VALUE = 50.0;
 
 std::vector<double> randVector(int size);
 std::vector<double> randMatrix(int size);
 
+// Square matrix in compressed sparse rows.
+struct CsrMatrix {
+  std::vector<int> row_ptr;
+  std::vector<int> cols;
+  std::vector<double> vals;
+};
+
+// 5-point Laplacian on a side x side grid
+CsrMatrix poissonMatrix(int side);
+
 class SeqSLAYGradient : public ppc::core::Task {
  public:
   explicit SeqSLAYGradient(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
@@ -23,9 +34,27 @@ class SeqSLAYGradient : public ppc::core::Task {
   bool post_processing() override;
   static bool check_solution(const std::vector<double>& matrixA, const std::vector<double>& vectorB,
                              const std::vector<double>& solutionC);
+  static bool check_solution(const CsrMatrix& matrixA, const std::vector<double>& vectorB,
+                             const std::vector<double>& solutionC);
 
  private:
   std::vector<double> matrix, vector, answer;
 };
 
+// The same method for a sparse matrix: inputs are row_ptr (n + 1 ints), cols and vals (one int and one double per
+// nonzero) and the right-hand side, so that no n x n array is stored.
+class SeqSLAYGradientCsr : public ppc::core::Task {
+ public:
+  explicit SeqSLAYGradientCsr(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+
+  bool pre_processing() override;
+  bool validation() override;
+  bool run() override;
+  bool post_processing() override;
+
+ private:
+  CsrMatrix matrix;
+  std::vector<double> vector, answer;
+};
+
 }  // namespace dostavalov_s_seq
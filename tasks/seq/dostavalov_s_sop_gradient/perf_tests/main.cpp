@@ -8,6 +8,8 @@
 
 using namespace dostavalov_s_seq;
 const int SIZE = 300;
+// side of the grid of the sparse system, 40000 unknowns
+const int SIDE = 200;
 
 std::shared_ptr<ppc::core::TaskData> createTaskData(std::vector<double> &matrix, std::vector<double> &vector,
                                                     std::vector<double> &result) {
@@ -79,4 +81,44 @@ TEST(dostavalov_s_sop_gradient, test_task_run) {
   perfAnalyzer->task_run(perfAttr, perfResults);
   ppc::core::Perf::print_perf_statistic(perfResults);
   ASSERT_TRUE(testTaskSequential.check_solution(matrix, vector, result));
-}  // namespace dostavalov_s_seq
\ No newline at end of file
+}  // namespace dostavalov_s_seq
+std::shared_ptr<ppc::core::TaskData> createCsrTaskData(CsrMatrix &matrix, std::vector<double> &vector,
+                                                       std::vector<double> &result) {
+  std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
+
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(matrix.row_ptr.data()));
+  taskDataSeq->inputs_count.emplace_back(matrix.row_ptr.size());
+
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(matrix.cols.data()));
+  taskDataSeq->inputs_count.emplace_back(matrix.cols.size());
+
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(matrix.vals.data()));
+  taskDataSeq->inputs_count.emplace_back(matrix.vals.size());
+
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(vector.data()));
+  taskDataSeq->inputs_count.emplace_back(vector.size());
+
+  taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(result.data()));
+  taskDataSeq->outputs_count.emplace_back(result.size());
+
+  return taskDataSeq;
+}
+
+TEST(dostavalov_s_sop_gradient, test_task_run_csr) {
+  CsrMatrix matrix = poissonMatrix(SIDE);
+  std::vector<double> vector = randVector(SIDE * SIDE);
+  std::vector<double> result(vector.size());
+
+  std::shared_ptr<ppc::core::TaskData> taskDataSeq = createCsrTaskData(matrix, vector, result);
+
+  auto testTaskSeq = std::make_shared<SeqSLAYGradientCsr>(taskDataSeq);
+
+  auto perfAttr = start_performance_timer();
+
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  auto perfAnalyzer = std::make_shared<ppc::core::Perf>(testTaskSeq);
+  perfAnalyzer->task_run(perfAttr, perfResults);
+  ppc::core::Perf::print_perf_statistic(perfResults);
+  ASSERT_TRUE(SeqSLAYGradient::check_solution(matrix, vector, result));
+}
@@ -2,11 +2,76 @@
 
 #include "seq/dostavalov_s_sop_gradient/include/ops_seq.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <random>
 #include <vector>
 
 namespace dostavalov_s_seq {
+namespace {
+// the method needs the matrix only through multiply(direction, A_Dir), which adds A * direction to A_Dir; false when
+// the residual is still above TOLERANCE after MAX_ITERATIONS steps, e.g. for a matrix that is not positive definite
+template <typename Multiply>
+bool gradientSolve(const Multiply& multiply, const std::vector<double>& vector, std::vector<double>& result) {
+  size_t size = vector.size();
+  result.assign(size, 0.0);
+  std::vector<double> residual = vector;
+  std::vector<double> direction = residual;
+  std::vector<double> prev_residual = vector;
+
+  for (int iteration = 0; iteration < MAX_ITERATIONS; iteration++) {
+    std::vector<double> A_Dir(size, 0.0);
+
+    multiply(direction, A_Dir);
+
+    double residual_dot_residual = 0.0;
+    double A_Dir_dot_direction = 0.0;
+
+    for (size_t i = 0; i < size; ++i) {
+      residual_dot_residual += residual[i] * residual[i];
+      A_Dir_dot_direction += A_Dir[i] * direction[i];
+    }
+
+    double alpha = residual_dot_residual / A_Dir_dot_direction;
+
+    for (size_t i = 0; i < result.size(); ++i) {
+      result[i] += alpha * direction[i];
+    }
+
+    for (size_t i = 0; i < residual.size(); ++i) {
+      residual[i] = prev_residual[i] - alpha * A_Dir[i];
+    }
+
+    double new_residual = 0.0;
+
+    for (size_t i = 0; i < residual.size(); ++i) {
+      new_residual += residual[i] * residual[i];
+    }
+
+    if (sqrt(new_residual) < TOLERANCE) {
+      return true;
+    }
+
+    double beta = new_residual / residual_dot_residual;
+
+    for (size_t i = 0; i < size; ++i) {
+      direction[i] = residual[i] + beta * direction[i];
+    }
+
+    prev_residual = residual;
+  }
+  return false;
+}
+
+void csrMultiply(const CsrMatrix& matrix, const std::vector<double>& x, std::vector<double>& y) {
+  for (size_t i = 0; i + 1 < matrix.row_ptr.size(); ++i) {
+    for (int j = matrix.row_ptr[i]; j < matrix.row_ptr[i + 1]; ++j) {
+      y[i] += matrix.vals[j] * x[matrix.cols[j]];
+    }
+  }
+}
+}  // namespace
+
 std::vector<double> randVector(int size) {
   std::vector<double> random_vector(size);
 
@@ -42,6 +107,26 @@ std::vector<double> randMatrix(int size) {
   return random_matrix;
 }
 
+CsrMatrix poissonMatrix(int side) {
+  CsrMatrix matrix;
+  int size = side * side;
+  matrix.row_ptr.reserve(size + 1);
+  matrix.cols.reserve(5 * size);
+  matrix.vals.reserve(5 * size);
+  matrix.row_ptr.push_back(0);
+  for (int i = 0; i < size; ++i) {
+    // neighbours in column order; the left and right ones only within the same grid row
+    for (int j : {i - side, i - 1, i, i + 1, i + side}) {
+      if (j >= 0 && j < size && (j / side == i / side || j % side == i % side)) {
+        matrix.cols.push_back(j);
+        matrix.vals.push_back(j == i ? 4.0 : -1.0);
+      }
+    }
+    matrix.row_ptr.push_back(static_cast<int>(matrix.cols.size()));
+  }
+  return matrix;
+}
+
 bool SeqSLAYGradient::pre_processing() {
   internal_order_test();
 
@@ -78,58 +163,15 @@ bool SeqSLAYGradient::run() {
   internal_order_test();
 
   size_t size = vector.size();
-  std::vector<double> result(size, 0.0);
-  std::vector<double> residual = vector;
-  std::vector<double> direction = residual;
-  std::vector<double> prev_residual = vector;
-
-  while (true) {
-    std::vector<double> A_Dir(size, 0.0);
-
-    for (size_t i = 0; i < size; ++i) {
-      for (size_t j = 0; j < size; ++j) {
-        A_Dir[i] += matrix[i * size + j] * direction[j];
-      }
-    }
-
-    double residual_dot_residual = 0.0;
-    double A_Dir_dot_direction = 0.0;
-
-    for (size_t i = 0; i < size; ++i) {
-      residual_dot_residual += residual[i] * residual[i];
-      A_Dir_dot_direction += A_Dir[i] * direction[i];
-    }
-
-    double alpha = residual_dot_residual / A_Dir_dot_direction;
-
-    for (size_t i = 0; i < result.size(); ++i) {
-      result[i] += alpha * direction[i];
-    }
-
-    for (size_t i = 0; i < residual.size(); ++i) {
-      residual[i] = prev_residual[i] - alpha * A_Dir[i];
-    }
-
-    double new_residual = 0.0;
-
-    for (size_t i = 0; i < residual.size(); ++i) {
-      new_residual += residual[i] * residual[i];
-    }
-
-    if (sqrt(new_residual) < TOLERANCE) {
-      break;
-    }
-
-    double beta = new_residual / residual_dot_residual;
-
-    for (size_t i = 0; i < size; ++i) {
-      direction[i] = residual[i] + beta * direction[i];
-    }
-
-    prev_residual = residual;
-  }
-  answer = result;
-  return true;
+  return gradientSolve(
+      [&](const std::vector<double>& direction, std::vector<double>& A_Dir) {
+        for (size_t i = 0; i < size; ++i) {
+          for (size_t j = 0; j < size; ++j) {
+            A_Dir[i] += matrix[i * size + j] * direction[j];
+          }
+        }
+      },
+      vector, answer);
 }
 
 bool SeqSLAYGradient::post_processing() {
@@ -164,4 +206,69 @@ bool SeqSLAYGradient::check_solution(const std::vector<double>& matrixA, const s
   return solution_correct;
 }
 
+bool SeqSLAYGradient::check_solution(const CsrMatrix& matrixA, const std::vector<double>& vectorB,
+                                     const std::vector<double>& solutionC) {
+  std::vector<double> A_Sol(vectorB.size(), 0.0);
+  csrMultiply(matrixA, solutionC, A_Sol);
+
+  for (size_t i = 0; i < vectorB.size(); ++i) {
+    if (std::abs(A_Sol[i] - vectorB[i]) > TOLERANCE) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SeqSLAYGradientCsr::pre_processing() {
+  internal_order_test();
+
+  const int* row_ptr = reinterpret_cast<int*>(taskData->inputs[0]);
+  matrix.row_ptr.assign(row_ptr, row_ptr + taskData->inputs_count[0]);
+  const int* cols = reinterpret_cast<int*>(taskData->inputs[1]);
+  matrix.cols.assign(cols, cols + taskData->inputs_count[1]);
+  const double* vals = reinterpret_cast<double*>(taskData->inputs[2]);
+  matrix.vals.assign(vals, vals + taskData->inputs_count[2]);
+
+  const double* input_data_B = reinterpret_cast<double*>(taskData->inputs[3]);
+  vector.assign(input_data_B, input_data_B + taskData->inputs_count[3]);
+
+  answer.resize(vector.size(), 0);
+
+  return true;
+}
+
+bool SeqSLAYGradientCsr::validation() {
+  internal_order_test();
+
+  if (taskData->inputs_count.size() != 4 || taskData->outputs_count.size() != 1 ||
+      taskData->inputs_count[0] != taskData->inputs_count[3] + 1) {
+    return false;
+  }
+
+  if (taskData->inputs_count[1] != taskData->inputs_count[2]) {
+    return false;
+  }
+
+  if (taskData->inputs_count[3] != taskData->outputs_count[0]) {
+    return false;
+  }
+
+  return true;
+}
+
+bool SeqSLAYGradientCsr::run() {
+  internal_order_test();
+
+  return gradientSolve(
+      [&](const std::vector<double>& direction, std::vector<double>& A_Dir) { csrMultiply(matrix, direction, A_Dir); },
+      vector, answer);
+}
+
+bool SeqSLAYGradientCsr::post_processing() {
+  internal_order_test();
+
+  std::copy(answer.begin(), answer.end(), reinterpret_cast<double*>(taskData->outputs[0]));
+  return true;
+}
+
 }  // namespace dostavalov_s_seq
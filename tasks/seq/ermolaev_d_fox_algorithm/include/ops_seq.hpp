@@ -5,6 +5,7 @@
 #include <string>
 #include <vector>
 
+#include "core/gemm/include/tiled.hpp"
 #include "core/task/include/task.hpp"
 
 class FoxAlgorithm : public ppc::core::Task {
@@ -20,4 +21,12 @@ class FoxAlgorithm : public ppc::core::Task {
   double* matrix_B;
   double* matrix_C;
   size_t data_size;
-};
\ No newline at end of file
+  ppc::core::TiledMatrix tile_A;
+  ppc::core::TiledMatrix tile_B;
+  ppc::core::TiledMatrix tile_C;
+};
+
+// Fox's algorithm on n x n row-major matrices in single precision, and with float operands whose block products are
+// accumulated in double; the block size is the one measured for this host.
+std::vector<float> FoxMultiply(const std::vector<float>& A, const std::vector<float>& B, int n);
+std::vector<double> FoxMultiplyMixed(const std::vector<float>& A, const std::vector<float>& B, int n);
@@ -5,32 +5,56 @@
 #include <iostream>
 #include <thread>
 
+#include "core/gemm/include/blocking.hpp"
+#include "core/gemm/include/gemm.hpp"
+
 using namespace std::chrono_literals;
 namespace {
-std::vector<std::vector<double>> multiply_block(const std::vector<std::vector<double>>& block_A,
-                                                const std::vector<std::vector<double>>& block_B) {
-  size_t blockSize = block_A.size();
-  std::vector<std::vector<double>> block_C(blockSize, std::vector<double>(blockSize, 0.0));
-  for (size_t i = 0; i < blockSize; ++i) {
-    for (size_t j = 0; j < blockSize; ++j) {
-      for (size_t k = 0; k < blockSize; ++k) {
-        block_C[i][j] += block_A[i][k] * block_B[k][j];
+template <typename T, typename Acc>
+void multiplyBlock(const ppc::core::BasicTiledMatrix<T>& A, const ppc::core::BasicTiledMatrix<T>& B,
+                   ppc::core::BasicTiledMatrix<Acc>& C, int i, int j, int k) {
+  int t = C.Tile();
+  ppc::core::Gemm(t, t, t, A.Block(i, k), t, B.Block(k, j), t, C.Block(i, j), t);
+}
+
+// C = A * B: at stage s, block (i, i + s) of A is broadcast along row i and multiplied by the blocks of B below it
+template <typename T, typename Acc>
+void foxStages(const ppc::core::BasicTiledMatrix<T>& A, const ppc::core::BasicTiledMatrix<T>& B,
+               ppc::core::BasicTiledMatrix<Acc>& C) {
+  int numBlocks = C.BlockRows();
+  C.SetZero();
+  for (int stage = 0; stage < numBlocks; ++stage) {
+    for (int i = 0; i < numBlocks; ++i) {
+      for (int j = 0; j < numBlocks; ++j) {
+        multiplyBlock(A, B, C, i, j, (i + stage) % numBlocks);
       }
     }
   }
-  return block_C;
 }
 
-int calculateBlockSize(int n, int cacheSize = 1024, int elementSize = 8) {
-  int b = std::sqrt((cacheSize) / (elementSize * 2));
-
-  while (n % b != 0) {
-    b--;
-  }
-  return b;
+template <typename T, typename Acc>
+std::vector<Acc> foxMultiply(const std::vector<T>& A, const std::vector<T>& B, int n) {
+  int block = ppc::core::TuneBlockSize("fox", n, 1);
+  ppc::core::BasicTiledMatrix<T> tileA(n, n, block);
+  ppc::core::BasicTiledMatrix<T> tileB(n, n, block);
+  ppc::core::BasicTiledMatrix<Acc> tileC(n, n, block);
+  tileA.FromRowMajor(A.data(), n);
+  tileB.FromRowMajor(B.data(), n);
+  foxStages(tileA, tileB, tileC);
+  std::vector<Acc> C(static_cast<size_t>(n) * n);
+  tileC.ToRowMajor(C.data(), n);
+  return C;
 }
 }  // namespace
 
+std::vector<float> FoxMultiply(const std::vector<float>& A, const std::vector<float>& B, int n) {
+  return foxMultiply<float, float>(A, B, n);
+}
+
+std::vector<double> FoxMultiplyMixed(const std::vector<float>& A, const std::vector<float>& B, int n) {
+  return foxMultiply<float, double>(A, B, n);
+}
+
 bool FoxAlgorithm::validation() {
   internal_order_test();
   return !taskData->inputs_count.empty() && taskData->inputs_count.size() == 2 &&
@@ -55,6 +79,15 @@ bool FoxAlgorithm::pre_processing() {
         matrix_C[i * data_size + j] = 0;
       }
     }
+    // blocks are contiguous tiles, so each block product reads them in place; edge blocks are padded with zeros, so
+    // the block size measured for this host does not have to divide n
+    int n = static_cast<int>(data_size);
+    int block = ppc::core::TuneBlockSize("fox", n, 1);
+    tile_A = ppc::core::TiledMatrix(n, n, block);
+    tile_B = ppc::core::TiledMatrix(n, n, block);
+    tile_C = ppc::core::TiledMatrix(n, n, block);
+    tile_A.FromRowMajor(matrix_A, n);
+    tile_B.FromRowMajor(matrix_B, n);
   } catch (...) {
     return false;
   }
@@ -64,31 +97,8 @@ bool FoxAlgorithm::pre_processing() {
 bool FoxAlgorithm::run() {
   internal_order_test();
   try {
-    int n = static_cast<int>(data_size);
-    int blockSize = calculateBlockSize(n);
-    int numBlocks = n / blockSize;
-
-    for (int stage = 0; stage < numBlocks; ++stage) {
-      for (int i = 0; i < numBlocks; ++i) {
-        for (int j = 0; j < numBlocks; ++j) {
-          int k = (i + stage) % numBlocks;
-          std::vector<std::vector<double>> block_A(blockSize, std::vector<double>(blockSize));
-          std::vector<std::vector<double>> block_B(blockSize, std::vector<double>(blockSize));
-          for (int row = 0; row < blockSize; ++row) {
-            for (int col = 0; col < blockSize; ++col) {
-              block_A[row][col] = matrix_A[((i * blockSize) + row) * data_size + (k * blockSize) + col];
-              block_B[row][col] = matrix_B[((k * blockSize) + row) * data_size + (j * blockSize) + col];
-            }
-          }
-          std::vector<std::vector<double>> block_C = multiply_block(block_A, block_B);
-          for (int row = 0; row < blockSize; ++row) {
-            for (int col = 0; col < blockSize; ++col) {
-              matrix_C[((i * blockSize) + row) * data_size + (j * blockSize) + col] += block_C[row][col];
-            }
-          }
-        }
-      }
-    }
+    foxStages(tile_A, tile_B, tile_C);
+    tile_C.ToRowMajor(matrix_C, static_cast<int>(data_size));
   } catch (...) {
     return false;
   }
@@ -20,6 +20,7 @@ class MatMulStrassenSec : public ppc::core::Task {
   std::vector<double> B;
   std::vector<double> result;
   int n = 0, m = 0;
+  int leaf = 0;
 };
 
 inline std::vector<double> getRandomMatrix(int n) {
@@ -17,15 +17,18 @@ class StrassenMatrixMultSequential : public ppc::core::Task {
 
  private:
   std::vector<double> A, B, C;
+  // scratch space of the whole recursion, sized once in pre_processing
+  std::vector<double> work;
   int n = 0;
 };
 
+// Doubles of workspace the view version of strassenKirillov needs for an n x n product.
+size_t strassenWorkspaceKirillov(int n);
+// C = A * B for n x n row-major views with row strides lda, ldb and ldc, all temporaries taken from work. The cutoff
+// and the variant are the ones measured for this host.
+void strassenKirillov(int n, const double* A, int lda, const double* B, int ldb, double* C, int ldc, double* work);
 std::vector<double> strassenKirillov(const std::vector<double>& A, const std::vector<double>& B, int n);
-std::vector<double> addKirillov(const std::vector<double>& A, const std::vector<double>& B);
-std::vector<double> subKirillov(const std::vector<double>& A, const std::vector<double>& B);
+// Single precision with the cutoff and variant measured for double.
+std::vector<float> strassenKirillov(const std::vector<float>& A, const std::vector<float>& B, int n);
 std::vector<double> mulKirillov(const std::vector<double>& A, const std::vector<double>& B, int n);
-void splitMatrixKirillov(const std::vector<double>& A, std::vector<double>& A11, std::vector<double>& A12,
-                         std::vector<double>& A21, std::vector<double>& A22);
-std::vector<double> joinMatricesKirillov(const std::vector<double>& A11, const std::vector<double>& A12,
-                                         const std::vector<double>& A21, const std::vector<double>& A22, int n);
 std::vector<double> generateRandomMatrixKirillov(int n);
@@ -1,9 +1,14 @@
 // Copyright 2024 Kostin Artem
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <vector>
 
 #include "seq/kostin_a_sle_conjugate_gradient/include/ops_seq.hpp"
+#include "seq/kostin_a_sle_conjugate_gradient/include/precond.hpp"
+#include "seq/kostin_a_sle_conjugate_gradient/include/spmv.hpp"
 
 TEST(kostin_a_sle_conjugate_gradient_seq, Test_SLE_size_2) {
   int size = 2;
@@ -146,3 +151,271 @@ TEST(kostin_a_sle_conjugate_gradient_seq, Test_generated_SLE_size_1) {
   testTaskSequential.post_processing();
   ASSERT_TRUE(check_solution(in_A, size, in_b, out, 1e-6));
 }
+
+TEST(kostin_a_sle_conjugate_gradient_seq, Test_spmv_formats_irregular) {
+  // empty rows, a row longer than one CSR5 tile and a tail shorter than one tile
+  int size = 300;
+  std::vector<double> in_A(size * size, 0.0);
+  for (int i = 0; i < size; i++) {
+    if (i % 7 == 3) {
+      continue;
+    }
+    int step = i == 5 ? 1 : 1 + (i * 13) % 41;
+    for (int j = i % 5; j < size; j += step) {
+      in_A[i * size + j] = (i + j) % 9 - 4.0;
+    }
+  }
+  std::vector<double> x(size);
+  for (int j = 0; j < size; j++) {
+    x[j] = j % 11 - 5.0;
+  }
+
+  KostinArtemSEQ::CsrMatrix csr = KostinArtemSEQ::dense_to_csr(in_A, size);
+  KostinArtemSEQ::SellMatrix sell = KostinArtemSEQ::csr_to_sell(csr, 32);
+  KostinArtemSEQ::Csr5Matrix csr5 = KostinArtemSEQ::csr_to_csr5(csr);
+  std::vector<double> y_csr(size, -1.0);
+  std::vector<double> y_sell(size, -1.0);
+  std::vector<double> y_csr5(size, -1.0);
+  KostinArtemSEQ::spmv(csr, x.data(), y_csr.data());
+  KostinArtemSEQ::spmv(sell, x.data(), y_sell.data());
+  KostinArtemSEQ::spmv(csr5, x.data(), y_csr5.data());
+  for (int i = 0; i < size; i++) {
+    double expected = 0.0;
+    for (int j = 0; j < size; j++) {
+      expected += in_A[i * size + j] * x[j];
+    }
+    ASSERT_DOUBLE_EQ(expected, y_csr[i]);
+    ASSERT_DOUBLE_EQ(expected, y_sell[i]);
+    ASSERT_DOUBLE_EQ(expected, y_csr5[i]);
+  }
+}
+
+TEST(kostin_a_sle_conjugate_gradient_seq, Test_spmv_formats_small) {
+  int size = 3;
+  std::vector<double> in_A = {2.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 3.0, 4.0};
+  std::vector<double> x = {1.0, 2.0, 3.0};
+  std::vector<double> expected = {5.0, 0.0, 18.0};
+
+  KostinArtemSEQ::CsrMatrix csr = KostinArtemSEQ::dense_to_csr(in_A, size);
+  ASSERT_EQ(csr.row_ptr, std::vector<int>({0, 2, 2, 4}));
+  std::vector<double> y(size, -1.0);
+  KostinArtemSEQ::spmv(KostinArtemSEQ::csr_to_sell(csr), x.data(), y.data());
+  ASSERT_EQ(expected, y);
+  y.assign(size, -1.0);
+  KostinArtemSEQ::spmv(KostinArtemSEQ::csr_to_csr5(csr), x.data(), y.data());
+  ASSERT_EQ(expected, y);
+}
+
+TEST(kostin_a_sle_conjugate_gradient_seq, Test_spmv_formats_non_finite_x) {
+  // rows 1 and 2 do not read x[0], so an infinite x[0] must not reach them through the padding
+  int size = 3;
+  std::vector<double> in_A = {2.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 3.0, 4.0};
+  std::vector<double> x = {std::numeric_limits<double>::infinity(), 2.0, 3.0};
+
+  KostinArtemSEQ::CsrMatrix csr = KostinArtemSEQ::dense_to_csr(in_A, size);
+  std::vector<double> y(size, -1.0);
+  KostinArtemSEQ::spmv(KostinArtemSEQ::csr_to_sell(csr), x.data(), y.data());
+  ASSERT_TRUE(std::isinf(y[0]));
+  ASSERT_EQ(0.0, y[1]);
+  ASSERT_EQ(18.0, y[2]);
+}
+
+namespace {
+double max_residual(const KostinArtemSEQ::CsrMatrix &A, const std::vector<double> &b, const std::vector<double> &x) {
+  std::vector<double> Ax(A.n);
+  KostinArtemSEQ::spmv(A, x.data(), Ax.data());
+  double residual = 0.0;
+  for (int i = 0; i < A.n; i++) {
+    residual = std::max(residual, std::abs(Ax[i] - b[i]));
+  }
+  return residual;
+}
+}  // namespace
+
+TEST(kostin_a_sle_conjugate_gradient_seq, Test_pcg_preconditioners_diffusion) {
+  KostinArtemSEQ::CsrMatrix A = KostinArtemSEQ::generate_diffusion_csr(24, 1e4);
+  std::vector<double> b(A.n, 1.0);
+  int iterations[4];
+  for (auto kind : {KostinArtemSEQ::PreconditionerKind::None, KostinArtemSEQ::PreconditionerKind::Jacobi,
+                    KostinArtemSEQ::PreconditionerKind::Ssor, KostinArtemSEQ::PreconditionerKind::IncompleteCholesky}) {
+    auto M = KostinArtemSEQ::make_preconditioner(kind, A);
+    KostinArtemSEQ::CgResult result = KostinArtemSEQ::preconditioned_conjugate_gradient(A, b, *M, 1e-8);
+    ASSERT_LT(result.residual, 1e-8);
+    ASSERT_LT(max_residual(A, b, result.x), 1e-7);
+    iterations[static_cast<int>(kind)] = result.iterations;
+  }
+  // the coefficient jumps by 10^4: diagonal scaling removes most of that, the triangular preconditioners more
+  ASSERT_LT(iterations[1] * 4, iterations[0]);
+  ASSERT_LT(iterations[2], iterations[1]);
+  ASSERT_LT(iterations[3], iterations[1]);
+}
+
+TEST(kostin_a_sle_conjugate_gradient_seq, Test_ic0_exact_on_tridiagonal) {
+  // no fill-in: IC(0) is the complete Cholesky factor and CG converges in one step
+  int size = 50;
+  std::vector<double> in_A(size * size, 0.0);
+  for (int i = 0; i < size; i++) {
+    in_A[i * size + i] = 2.0 + i % 3;
+    if (i > 0) {
+      in_A[i * size + i - 1] = in_A[(i - 1) * size + i] = -1.0;
+    }
+  }
+  KostinArtemSEQ::CsrMatrix A = KostinArtemSEQ::dense_to_csr(in_A, size);
+  std::vector<double> b = generatePDVector(size, 100);
+  KostinArtemSEQ::IncompleteCholeskyPreconditioner M(A);
+  KostinArtemSEQ::CgResult result = KostinArtemSEQ::preconditioned_conjugate_gradient(A, b, M, 1e-6);
+  ASSERT_EQ(M.diagonal_shift(), 0.0);
+  ASSERT_EQ(result.iterations, 1);
+  ASSERT_TRUE(check_solution(in_A, size, b, result.x, 1e-6));
+}
+
+TEST(kostin_a_sle_conjugate_gradient_seq, Test_ic0_shifted_on_generated_SLE) {
+  // generateSPDMatrix is symmetric but not positive definite, IC(0) goes through only with a diagonal shift
+  int size = 50;
+  std::vector<double> in_A = generateSPDMatrix(size, 100);
+  std::vector<double> in_b = generatePDVector(size, 100);
+  KostinArtemSEQ::CsrMatrix A = KostinArtemSEQ::dense_to_csr(in_A, size);
+  KostinArtemSEQ::IncompleteCholeskyPreconditioner M(A);
+  KostinArtemSEQ::CgResult result = KostinArtemSEQ::preconditioned_conjugate_gradient(A, in_b, M, 1e-7);
+  ASSERT_GT(M.diagonal_shift(), 0.0);
+  ASSERT_TRUE(check_solution(in_A, size, in_b, result.x, 1e-6));
+}
+
+TEST(kostin_a_sle_conjugate_gradient_seq, Test_pcg_wide_levels) {
+  // 2048 interleaved tridiagonal chains of 4 rows: the triangular factors have 4 levels of 2048 rows each
+  const int chains = 2048;
+  KostinArtemSEQ::CsrMatrix A;
+  A.n = 4 * chains;
+  A.row_ptr.push_back(0);
+  for (int i = 0; i < A.n; i++) {
+    for (int j : {i - chains, i, i + chains}) {
+      if (j >= 0 && j < A.n) {
+        A.col.push_back(j);
+        A.val.push_back(j == i ? 2.0 + i % 5 : -1.0);
+      }
+    }
+    A.row_ptr.push_back(static_cast<int>(A.col.size()));
+  }
+  std::vector<double> b(A.n);
+  for (int i = 0; i < A.n; i++) {
+    b[i] = i % 7 - 3.0;
+  }
+
+  // no fill-in in any chain, IC(0) is exact
+  KostinArtemSEQ::IncompleteCholeskyPreconditioner ic(A);
+  KostinArtemSEQ::CgResult result = KostinArtemSEQ::preconditioned_conjugate_gradient(A, b, ic, 1e-8);
+  ASSERT_EQ(result.iterations, 1);
+  ASSERT_LT(max_residual(A, b, result.x), 1e-8);
+  KostinArtemSEQ::SsorPreconditioner ssor(A, 1.2);
+  result = KostinArtemSEQ::preconditioned_conjugate_gradient(A, b, ssor, 1e-8);
+  ASSERT_LT(max_residual(A, b, result.x), 1e-8);
+}
+
+TEST(kostin_a_sle_conjugate_gradient_seq, Test_task_preconditioned) {
+  KostinArtemSEQ::CsrMatrix A = KostinArtemSEQ::generate_diffusion_csr(10, 100.0);
+  int size = A.n;
+  std::vector<double> in_A(size * size, 0.0);
+  for (int i = 0; i < size; i++) {
+    for (int j = A.row_ptr[i]; j < A.row_ptr[i + 1]; j++) {
+      in_A[i * size + A.col[j]] = A.val[j];
+    }
+  }
+  std::vector<double> in_b = generatePDVector(size, 100);
+
+  for (auto kind : {KostinArtemSEQ::PreconditionerKind::Jacobi, KostinArtemSEQ::PreconditionerKind::Ssor,
+                    KostinArtemSEQ::PreconditionerKind::IncompleteCholesky}) {
+    std::vector<double> out(size, 0.0);
+    std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
+    taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(in_A.data()));
+    taskDataSeq->inputs_count.emplace_back(in_A.size());
+    taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(in_b.data()));
+    taskDataSeq->inputs_count.emplace_back(in_b.size());
+    taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(&size));
+    taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+    taskDataSeq->outputs_count.emplace_back(out.size());
+
+    ConjugateGradientMethodSequential testTaskSequential(taskDataSeq, kind);
+    ASSERT_EQ(testTaskSequential.validation(), true);
+    testTaskSequential.pre_processing();
+    testTaskSequential.run();
+    testTaskSequential.post_processing();
+    ASSERT_TRUE(check_solution(in_A, size, in_b, out, 1e-6));
+  }
+}
+
+TEST(kostin_a_sle_conjugate_gradient_seq, Test_task_preconditioned_not_positive_definite) {
+  // symmetric, but with a negative diagonal entry: no preconditioner can be set up
+  int size = 2;
+  std::vector<double> in_A = {-2.0, 1.0, 1.0, 3.0};
+  std::vector<double> in_b = {1.0, 1.0};
+
+  for (auto kind : {KostinArtemSEQ::PreconditionerKind::Jacobi, KostinArtemSEQ::PreconditionerKind::Ssor,
+                    KostinArtemSEQ::PreconditionerKind::IncompleteCholesky}) {
+    std::vector<double> out(size, 0.0);
+    std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
+    taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(in_A.data()));
+    taskDataSeq->inputs_count.emplace_back(in_A.size());
+    taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(in_b.data()));
+    taskDataSeq->inputs_count.emplace_back(in_b.size());
+    taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(&size));
+    taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+    taskDataSeq->outputs_count.emplace_back(out.size());
+
+    ConjugateGradientMethodSequential testTaskSequential(taskDataSeq, kind);
+    ASSERT_EQ(testTaskSequential.validation(), true);
+    testTaskSequential.pre_processing();
+    ASSERT_EQ(testTaskSequential.run(), false);
+  }
+}
+
+TEST(kostin_a_sle_conjugate_gradient_seq, Test_sparse_task_poisson) {
+  // contrast 1: the Poisson matrix
+  KostinArtemSEQ::CsrMatrix A = KostinArtemSEQ::generate_diffusion_csr(40, 1.0);
+  int size = A.n;
+  std::vector<double> in_b = generatePDVector(size, 100);
+
+  for (auto kind : {KostinArtemSEQ::PreconditionerKind::None, KostinArtemSEQ::PreconditionerKind::Jacobi,
+                    KostinArtemSEQ::PreconditionerKind::Ssor, KostinArtemSEQ::PreconditionerKind::IncompleteCholesky}) {
+    std::vector<double> out(size, 0.0);
+    std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
+    taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(A.row_ptr.data()));
+    taskDataSeq->inputs_count.emplace_back(A.row_ptr.size());
+    taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(A.col.data()));
+    taskDataSeq->inputs_count.emplace_back(A.col.size());
+    taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(A.val.data()));
+    taskDataSeq->inputs_count.emplace_back(A.val.size());
+    taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(in_b.data()));
+    taskDataSeq->inputs_count.emplace_back(in_b.size());
+    taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+    taskDataSeq->outputs_count.emplace_back(out.size());
+
+    SparseConjugateGradientMethodSequential testTaskSequential(taskDataSeq, kind, 1e-8);
+    ASSERT_EQ(testTaskSequential.validation(), true);
+    ASSERT_TRUE(testTaskSequential.pre_processing());
+    ASSERT_TRUE(testTaskSequential.run());
+    ASSERT_TRUE(testTaskSequential.post_processing());
+    ASSERT_GT(testTaskSequential.iterations(), 0);
+    ASSERT_LT(max_residual(A, in_b, out), 1e-8);
+  }
+}
+
+TEST(kostin_a_sle_conjugate_gradient_seq, Test_sparse_task_validation) {
+  KostinArtemSEQ::CsrMatrix A = KostinArtemSEQ::generate_diffusion_csr(4, 1.0);
+  std::vector<double> in_b(A.n, 1.0);
+  std::vector<double> out(A.n, 0.0);
+  std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(A.row_ptr.data()));
+  taskDataSeq->inputs_count.emplace_back(A.row_ptr.size());
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(A.col.data()));
+  taskDataSeq->inputs_count.emplace_back(A.col.size());
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(A.val.data()));
+  // one value short of the column indices
+  taskDataSeq->inputs_count.emplace_back(A.val.size() - 1);
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(in_b.data()));
+  taskDataSeq->inputs_count.emplace_back(in_b.size());
+  taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskDataSeq->outputs_count.emplace_back(out.size());
+
+  SparseConjugateGradientMethodSequential testTaskSequential(taskDataSeq);
+  ASSERT_EQ(testTaskSequential.validation(), false);
+}
@@ -1,10 +1,170 @@
 // Copyright 2024 Kostin Artem
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
 #include <vector>
 
 #include "core/perf/include/perf.hpp"
 #include "seq/kostin_a_sle_conjugate_gradient/include/ops_seq.hpp"
+#include "seq/kostin_a_sle_conjugate_gradient/include/precond.hpp"
+#include "seq/kostin_a_sle_conjugate_gradient/include/spmv.hpp"
+
+namespace {
+// 5-point Laplacian on a side x side grid: short rows of equal length, the friendliest case for SELL-C-sigma
+KostinArtemSEQ::CsrMatrix generate_banded_csr(int side) {
+  KostinArtemSEQ::CsrMatrix a;
+  a.n = side * side;
+  a.row_ptr.push_back(0);
+  for (int i = 0; i < a.n; i++) {
+    int row = i / side;
+    int col = i % side;
+    for (int j : {i - side, i - 1, i, i + 1, i + side}) {
+      bool neighbour = j >= 0 && j < a.n && (j / side == row || j % side == col);
+      if (neighbour) {
+        a.col.push_back(j);
+        a.val.push_back(j == i ? 4.0 : -1.0);
+      }
+    }
+    a.row_ptr.push_back(static_cast<int>(a.col.size()));
+  }
+  return a;
+}
+
+// power-law rows, row i holds about n / (i + 1) random entries and at least 4
+KostinArtemSEQ::CsrMatrix generate_power_law_csr(int n) {
+  std::mt19937 gen(4041);
+  std::uniform_int_distribution<int> col(0, n - 1);
+  KostinArtemSEQ::CsrMatrix a;
+  a.n = n;
+  a.row_ptr.push_back(0);
+  for (int i = 0; i < n; i++) {
+    std::vector<int> cols(std::max(4, n / (i + 1)));
+    for (auto &c : cols) {
+      c = col(gen);
+    }
+    std::sort(cols.begin(), cols.end());
+    cols.erase(std::unique(cols.begin(), cols.end()), cols.end());
+    for (int c : cols) {
+      a.col.push_back(c);
+      a.val.push_back(static_cast<double>(gen() % 100 + 1));
+    }
+    a.row_ptr.push_back(static_cast<int>(a.col.size()));
+  }
+  return a;
+}
+
+template <typename Matrix>
+double spmv_seconds(const Matrix &a, const std::vector<double> &x, std::vector<double> &y, int runs) {
+  auto start = std::chrono::high_resolution_clock::now();
+  for (int r = 0; r < runs; r++) {
+    KostinArtemSEQ::spmv(a, x.data(), y.data());
+  }
+  std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+  return elapsed.count() / runs;
+}
+
+// Effective bandwidth of every format, counted with the bytes a CSR product has to move
+void compare_formats(const char *name, const KostinArtemSEQ::CsrMatrix &csr, int runs) {
+  KostinArtemSEQ::SellMatrix sell = KostinArtemSEQ::csr_to_sell(csr);
+  KostinArtemSEQ::Csr5Matrix csr5 = KostinArtemSEQ::csr_to_csr5(csr);
+  std::vector<double> x(csr.n, 1.0);
+  std::vector<double> y_csr(csr.n);
+  std::vector<double> y(csr.n);
+  double csr_time = spmv_seconds(csr, x, y_csr, runs);
+  double sell_time = spmv_seconds(sell, x, y, runs);
+  for (int i = 0; i < csr.n; i++) {
+    ASSERT_NEAR(y_csr[i], y[i], 1e-9 * std::abs(y_csr[i]));
+  }
+  double csr5_time = spmv_seconds(csr5, x, y, runs);
+  for (int i = 0; i < csr.n; i++) {
+    ASSERT_NEAR(y_csr[i], y[i], 1e-9 * std::abs(y_csr[i]));
+  }
+
+  double nnz = csr.row_ptr[csr.n];
+  double gbytes = (12.0 * nnz + 20.0 * csr.n) / (1 << 30);
+  std::cout << name << ": n = " << csr.n << ", nnz = " << nnz << ", SELL padding "
+            << static_cast<double>(sell.val.size()) / nnz << "x; GB/s CSR " << gbytes / csr_time << ", SELL-C-sigma "
+            << gbytes / sell_time << ", CSR5 " << gbytes / csr5_time << std::endl;
+}
+
+// Time to reach the tolerance with every preconditioner, setup included, next to the iterations it took: a cheap
+// iteration does not pay off when many more of them are needed
+void compare_preconditioners(int side, double contrast) {
+  KostinArtemSEQ::CsrMatrix A = KostinArtemSEQ::generate_diffusion_csr(side, contrast);
+  std::vector<double> b(A.n, 1.0);
+  // 1e-6 relative to the norm of b
+  double tolerance = 1e-6 * side;
+  const char *names[] = {"none", "Jacobi", "SSOR", "IC(0)"};
+  for (auto kind : {KostinArtemSEQ::PreconditionerKind::None, KostinArtemSEQ::PreconditionerKind::Jacobi,
+                    KostinArtemSEQ::PreconditionerKind::Ssor, KostinArtemSEQ::PreconditionerKind::IncompleteCholesky}) {
+    auto start = std::chrono::high_resolution_clock::now();
+    auto M = KostinArtemSEQ::make_preconditioner(kind, A);
+    std::chrono::duration<double> setup = std::chrono::high_resolution_clock::now() - start;
+    KostinArtemSEQ::CgResult result = KostinArtemSEQ::preconditioned_conjugate_gradient(A, b, *M, tolerance);
+    std::chrono::duration<double> total = std::chrono::high_resolution_clock::now() - start;
+    ASSERT_LT(result.residual, tolerance);
+    std::cout << "diffusion " << side << " x " << side << ", contrast " << contrast << ", "
+              << names[static_cast<int>(kind)] << ": " << result.iterations << " iterations, setup " << setup.count()
+              << " s, time to tolerance " << total.count() << " s, "
+              << 1e3 * (total - setup).count() / result.iterations << " ms per iteration" << std::endl;
+  }
+}
+
+// Poisson matrix on a side x side grid given to the CSR task, solved with IC(0) to 1e-6 relative to the norm of b
+void run_sparse_perf(int side, bool pipeline) {
+  KostinArtemSEQ::CsrMatrix A = KostinArtemSEQ::generate_diffusion_csr(side, 1.0);
+  std::vector<double> in_b(A.n, 1.0);
+  std::vector<double> out(A.n, 0.0);
+  double tolerance = 1e-6 * side;
+
+  std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(A.row_ptr.data()));
+  taskDataSeq->inputs_count.emplace_back(A.row_ptr.size());
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(A.col.data()));
+  taskDataSeq->inputs_count.emplace_back(A.col.size());
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(A.val.data()));
+  taskDataSeq->inputs_count.emplace_back(A.val.size());
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(in_b.data()));
+  taskDataSeq->inputs_count.emplace_back(in_b.size());
+  taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskDataSeq->outputs_count.emplace_back(out.size());
+
+  auto testTaskSequential = std::make_shared<SparseConjugateGradientMethodSequential>(
+      taskDataSeq, KostinArtemSEQ::PreconditionerKind::IncompleteCholesky, tolerance);
+
+  // a single solve of a quarter million unknowns takes seconds
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 1;
+  const auto t0 = std::chrono::high_resolution_clock::now();
+  perfAttr->current_timer = [&] {
+    auto current_time_point = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(current_time_point - t0).count();
+    return static_cast<double>(duration) * 1e-9;
+  };
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+  auto perfAnalyzer = std::make_shared<ppc::core::Perf>(testTaskSequential);
+  if (pipeline) {
+    perfAnalyzer->pipeline_run(perfAttr, perfResults);
+  } else {
+    perfAnalyzer->task_run(perfAttr, perfResults);
+  }
+  ppc::core::Perf::print_perf_statistic(perfResults);
+  std::cout << "Poisson " << side << " x " << side << " in CSR, IC(0): " << testTaskSequential->iterations()
+            << " iterations" << std::endl;
+
+  std::vector<double> Ax(A.n);
+  KostinArtemSEQ::spmv(A, out.data(), Ax.data());
+  double residual = 0.0;
+  for (int i = 0; i < A.n; i++) {
+    residual += (Ax[i] - in_b[i]) * (Ax[i] - in_b[i]);
+  }
+  ASSERT_LT(std::sqrt(residual), 1.01 * tolerance);
+}
+}  // namespace
 
 TEST(kostin_a_sle_conjugate_gradient_seq, test_pipeline_run) {
   int size = 360;
@@ -87,3 +247,17 @@ TEST(kostin_a_sle_conjugate_gradient_seq, test_task_run) {
   ppc::core::Perf::print_perf_statistic(perfResults);
   ASSERT_TRUE(check_solution(in_A, size, in_b, out, 1e-6));
 }
+
+TEST(kostin_a_sle_conjugate_gradient_spmv_seq, test_banded) {
+  compare_formats("banded", generate_banded_csr(700), 20);
+}
+
+TEST(kostin_a_sle_conjugate_gradient_spmv_seq, test_power_law) {
+  compare_formats("power law", generate_power_law_csr(200000), 20);
+}
+
+TEST(kostin_a_sle_conjugate_gradient_pcg_seq, test_time_to_tolerance) { compare_preconditioners(150, 1e4); }
+
+TEST(kostin_a_sle_conjugate_gradient_seq, test_pipeline_run_sparse) { run_sparse_perf(500, true); }
+
+TEST(kostin_a_sle_conjugate_gradient_seq, test_task_run_sparse) { run_sparse_perf(500, false); }
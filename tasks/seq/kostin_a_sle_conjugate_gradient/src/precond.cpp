@@ -0,0 +1,270 @@
+// Copyright 2024 Kostin Artem
+#include "seq/kostin_a_sle_conjugate_gradient/include/precond.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace KostinArtemSEQ {
+namespace {
+double dot(const std::vector<double>& a, const std::vector<double>& b) {
+  double sum = 0.0;
+  for (size_t i = 0; i < a.size(); i++) {
+    sum += a[i] * b[i];
+  }
+  return sum;
+}
+
+std::vector<double> diagonal(CsrView A) {
+  std::vector<double> d(A.n, 0.0);
+  for (int i = 0; i < A.n; i++) {
+    for (int j = A.row_ptr[i]; j < A.row_ptr[i + 1]; j++) {
+      if (A.col[j] == i) {
+        d[i] = A.val[j];
+      }
+    }
+  }
+  for (double v : d) {
+    if (!(v > 0.0)) {
+      throw std::invalid_argument("matrix has a non-positive diagonal entry, it is not positive definite");
+    }
+  }
+  return d;
+}
+
+// the entries strictly below (lower) or strictly above the diagonal
+CsrMatrix strict_triangle(CsrView A, bool lower) {
+  CsrMatrix T;
+  T.n = A.n;
+  T.row_ptr.push_back(0);
+  for (int i = 0; i < A.n; i++) {
+    for (int j = A.row_ptr[i]; j < A.row_ptr[i + 1]; j++) {
+      if (lower ? A.col[j] < i : A.col[j] > i) {
+        T.col.push_back(A.col[j]);
+        T.val.push_back(A.val[j]);
+      }
+    }
+    T.row_ptr.push_back(static_cast<int>(T.col.size()));
+  }
+  return T;
+}
+
+CsrMatrix transpose(const CsrMatrix& A) {
+  CsrMatrix T;
+  T.n = A.n;
+  T.row_ptr.assign(A.n + 1, 0);
+  for (int c : A.col) {
+    T.row_ptr[c + 1]++;
+  }
+  for (int i = 0; i < A.n; i++) {
+    T.row_ptr[i + 1] += T.row_ptr[i];
+  }
+  T.col.resize(A.col.size());
+  T.val.resize(A.val.size());
+  std::vector<int> pos(T.row_ptr.begin(), T.row_ptr.end() - 1);
+  for (int i = 0; i < A.n; i++) {
+    for (int j = A.row_ptr[i]; j < A.row_ptr[i + 1]; j++) {
+      T.col[pos[A.col[j]]] = i;
+      T.val[pos[A.col[j]]++] = A.val[j];
+    }
+  }
+  return T;
+}
+
+// IC(0) of A + shift * diag(A) on the strict lower triangle L of A: fills L's values and d with the diagonal of the
+// factor, or returns false on a non-positive pivot. Rows of L are sorted, so the sum over the common columns of
+// rows i and k is a merge.
+bool factorize_ic0(CsrMatrix& L, std::vector<double>& d, const CsrMatrix& lowerA, const std::vector<double>& diagA,
+                   double shift) {
+  for (int i = 0; i < L.n; i++) {
+    double pivot = diagA[i] * (1.0 + shift);
+    for (int p = L.row_ptr[i]; p < L.row_ptr[i + 1]; p++) {
+      int k = L.col[p];
+      double s = lowerA.val[p];
+      int a = L.row_ptr[i];
+      int b = L.row_ptr[k];
+      while (a < p && b < L.row_ptr[k + 1]) {
+        if (L.col[a] < L.col[b]) {
+          a++;
+        } else if (L.col[a] > L.col[b]) {
+          b++;
+        } else {
+          s -= L.val[a++] * L.val[b++];
+        }
+      }
+      L.val[p] = s / d[k];
+      pivot -= L.val[p] * L.val[p];
+    }
+    if (!(pivot > 0.0)) {
+      return false;
+    }
+    d[i] = std::sqrt(pivot);
+  }
+  return true;
+}
+}  // namespace
+
+void IdentityPreconditioner::apply(const double* r, double* z) const { std::copy(r, r + n, z); }
+
+JacobiPreconditioner::JacobiPreconditioner(CsrView A) : inv_diag(diagonal(A)) {
+  for (double& v : inv_diag) {
+    v = 1.0 / v;
+  }
+}
+
+void JacobiPreconditioner::apply(const double* r, double* z) const {
+  for (size_t i = 0; i < inv_diag.size(); i++) {
+    z[i] = r[i] * inv_diag[i];
+  }
+}
+
+void TriangularMatrix::solve(const double* rhs, double* x) const {
+  for (int k = 0; k < strict.n; k++) {
+    int i = lower ? k : strict.n - 1 - k;
+    double sum = rhs[i];
+    for (int j = strict.row_ptr[i]; j < strict.row_ptr[i + 1]; j++) {
+      sum -= strict.val[j] * x[strict.col[j]];
+    }
+    x[i] = sum / diag[i];
+  }
+}
+
+SsorPreconditioner::SsorPreconditioner(CsrView A, double omega) : work(A.n) {
+  std::vector<double> d = diagonal(A);
+  std::vector<double> scaled(A.n);
+  middle.resize(A.n);
+  for (int i = 0; i < A.n; i++) {
+    scaled[i] = d[i] / omega;
+    middle[i] = (2.0 - omega) * d[i] / (omega * omega);
+  }
+  lower = {strict_triangle(A, true), scaled, true};
+  upper = {strict_triangle(A, false), scaled, false};
+}
+
+void SsorPreconditioner::apply(const double* r, double* z) const {
+  lower.solve(r, work.data());
+  for (size_t i = 0; i < work.size(); i++) {
+    work[i] *= middle[i];
+  }
+  upper.solve(work.data(), z);
+}
+
+IncompleteCholeskyPreconditioner::IncompleteCholeskyPreconditioner(CsrView A) : work(A.n) {
+  std::vector<double> diagA = diagonal(A);
+  CsrMatrix lowerA = strict_triangle(A, true);
+  CsrMatrix L = lowerA;
+  std::vector<double> d(A.n);
+  // Manteuffel's shift: doubling from 1e-3 until the factorization goes through; large enough a shift always does
+  while (!factorize_ic0(L, d, lowerA, diagA, shift)) {
+    shift = shift == 0.0 ? 1e-3 : 2.0 * shift;
+  }
+  upper = {transpose(L), d, false};
+  lower = {std::move(L), std::move(d), true};
+}
+
+void IncompleteCholeskyPreconditioner::apply(const double* r, double* z) const {
+  lower.solve(r, work.data());
+  upper.solve(work.data(), z);
+}
+
+std::unique_ptr<Preconditioner> make_preconditioner(PreconditionerKind kind, CsrView A) {
+  switch (kind) {
+    case PreconditionerKind::Jacobi:
+      return std::make_unique<JacobiPreconditioner>(A);
+    case PreconditionerKind::Ssor:
+      return std::make_unique<SsorPreconditioner>(A);
+    case PreconditionerKind::IncompleteCholesky:
+      return std::make_unique<IncompleteCholeskyPreconditioner>(A);
+    default:
+      return std::make_unique<IdentityPreconditioner>(A);
+  }
+}
+
+CgResult preconditioned_conjugate_gradient(CsrView A, const std::vector<double>& b, const Preconditioner& M,
+                                           double tolerance, int max_iterations) {
+  int n = A.n;
+  CgResult result;
+  result.x.assign(n, 0.0);
+  std::vector<double> r = b;
+  std::vector<double> z(n);
+  std::vector<double> q(n);
+  M.apply(r.data(), z.data());
+  std::vector<double> p = z;
+  double rz = dot(r, z);
+  double rr = dot(r, r);
+  while (std::sqrt(rr) >= tolerance && result.iterations < max_iterations) {
+    spmv(A, p.data(), q.data());
+    double alpha = rz / dot(p, q);
+    rr = 0.0;
+    for (int i = 0; i < n; i++) {
+      result.x[i] += alpha * p[i];
+      r[i] -= alpha * q[i];
+      rr += r[i] * r[i];
+    }
+    result.iterations++;
+    if (std::sqrt(rr) < tolerance) {
+      break;
+    }
+    M.apply(r.data(), z.data());
+    double rz_next = dot(r, z);
+    double beta = rz_next / rz;
+    rz = rz_next;
+    for (int i = 0; i < n; i++) {
+      p[i] = z[i] + beta * p[i];
+    }
+  }
+  result.residual = std::sqrt(rr);
+  return result;
+}
+
+CsrMatrix generate_diffusion_csr(int side, double contrast) {
+  const int BLOCK = 8;
+  int blocks = (side + BLOCK - 1) / BLOCK;
+  std::mt19937 gen(4041);
+  std::uniform_real_distribution<double> exponent(0.0, 1.0);
+  std::vector<double> coefficient(blocks * blocks);
+  for (double& k : coefficient) {
+    k = std::pow(contrast, exponent(gen));
+  }
+  auto k = [&](int r, int c) { return coefficient[(r / BLOCK) * blocks + c / BLOCK]; };
+
+  CsrMatrix A;
+  A.n = side * side;
+  A.row_ptr.reserve(A.n + 1);
+  A.col.reserve(5 * A.n);
+  A.val.reserve(5 * A.n);
+  A.row_ptr.push_back(0);
+  // neighbours in column order: up, left, the cell itself, right, down
+  const int offsets[5][2] = {{-1, 0}, {0, -1}, {0, 0}, {0, 1}, {1, 0}};
+  for (int r = 0; r < side; r++) {
+    for (int c = 0; c < side; c++) {
+      double diag = 0.0;
+      int diag_pos = 0;
+      for (const auto& offset : offsets) {
+        int nr = r + offset[0];
+        int nc = c + offset[1];
+        if (nr == r && nc == c) {
+          diag_pos = static_cast<int>(A.val.size());
+          A.col.push_back(r * side + c);
+          A.val.push_back(0.0);
+        } else if (nr < 0 || nr >= side || nc < 0 || nc >= side) {
+          // the boundary is half a cell away
+          diag += 2.0 * k(r, c);
+        } else {
+          // harmonic mean of the two cells across the face
+          double w = 2.0 * k(r, c) * k(nr, nc) / (k(r, c) + k(nr, nc));
+          diag += w;
+          A.col.push_back(nr * side + nc);
+          A.val.push_back(-w);
+        }
+      }
+      A.val[diag_pos] = diag;
+      A.row_ptr.push_back(static_cast<int>(A.col.size()));
+    }
+  }
+  return A;
+}
+}  // namespace KostinArtemSEQ
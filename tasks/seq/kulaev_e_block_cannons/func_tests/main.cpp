@@ -1,6 +1,7 @@
 // Copyright 2024 Kulaev Zhenya
 #include <gtest/gtest.h>
 
+#include <cmath>
 #include <vector>
 
 #include "seq/kulaev_e_block_cannons/include/ops_seq.hpp"
@@ -38,7 +39,7 @@ TEST(Kulaev_e_block_cannons_seq, Multiplication_3x3) {
   testTaskSequential.post_processing();
 
   for (size_t i = 0; i < res.size(); ++i) {
-    ASSERT_EQ(res[i], out[i]);
+    ASSERT_NEAR(res[i], out[i], 1e-12 * std::abs(out[i]));
   }
 }
 
@@ -75,7 +76,7 @@ TEST(Kulaev_e_block_cannons_seq, Multiplication_2x2) {
   testTaskSequential.post_processing();
 
   for (size_t i = 0; i < res.size(); ++i) {
-    ASSERT_EQ(res[i], out[i]);
+    ASSERT_NEAR(res[i], out[i], 1e-12 * std::abs(out[i]));
   }
 }
 
@@ -112,7 +113,7 @@ TEST(Kulaev_e_block_cannons_seq, Multiplication_5x5) {
   testTaskSequential.post_processing();
 
   for (size_t i = 0; i < res.size(); ++i) {
-    ASSERT_EQ(res[i], out[i]);
+    ASSERT_NEAR(res[i], out[i], 1e-12 * std::abs(out[i]));
   }
 }
 
@@ -149,7 +150,7 @@ TEST(Kulaev_e_block_cannons_seq, Multiplication_0x0) {
   testTaskSequential.post_processing();
 
   for (size_t i = 0; i < res.size(); ++i) {
-    ASSERT_EQ(res[i], out[i]);
+    ASSERT_NEAR(res[i], out[i], 1e-12 * std::abs(out[i]));
   }
 }
 
@@ -186,6 +187,6 @@ TEST(Kulaev_e_block_cannons_seq, Multiplication_100x100) {
   testTaskSequential.post_processing();
 
   for (size_t i = 0; i < res.size(); ++i) {
-    ASSERT_EQ(res[i], out[i]);
+    ASSERT_NEAR(res[i], out[i], 1e-12 * std::abs(out[i]));
   }
 }
@@ -1,6 +1,7 @@
 // Copyright 2024 Kulaev Zhenya
 #include <gtest/gtest.h>
 
+#include <cmath>
 #include <vector>
 
 #include "core/perf/include/perf.hpp"
@@ -53,7 +54,7 @@ TEST(sequential_kulaev_e_block_cannons_perf_test, test_pipeline_run) {
   ppc::core::Perf::print_perf_statistic(perfResults);
 
   for (size_t i = 0; i < res.size(); ++i) {
-    ASSERT_EQ(res[i], out[i]);
+    ASSERT_NEAR(res[i], out[i], 1e-12 * std::abs(out[i]));
   }
 }
 
@@ -104,6 +105,6 @@ TEST(sequential_kulaev_e_block_cannons_perf_test, test_task_run) {
   ppc::core::Perf::print_perf_statistic(perfResults);
 
   for (size_t i = 0; i < res.size(); ++i) {
-    ASSERT_EQ(res[i], out[i]);
+    ASSERT_NEAR(res[i], out[i], 1e-12 * std::abs(out[i]));
   }
 }
@@ -1,8 +1,10 @@
 // Copyright 2023 Kuznetsov Artem
 #include <gtest/gtest.h>
 
+#include <iostream>
 #include <vector>
 
+#include "core/gemm/include/gemm.hpp"
 #include "seq/kuznetsov_a_cannon_matr_mult/include/ops_seq.hpp"
 
 TEST(Kuznetsov_a_cannon_matr_mult_seq_func_tests, mult_3x3) {
@@ -247,3 +249,75 @@ TEST(Kuznetsov_a_cannon_matr_mult_seq_func_tests, mult_7x7) {
     ASSERT_TRUE(KuznetsovArtyomSeq::isEqual(resSeq[i], outputMatr[i]));
   }
 }
+
+TEST(Kuznetsov_a_cannon_matr_mult_seq_func_tests, mult_tuned_block) {
+  // Create data
+  size_t size = 100;
+  // 0: the task picks the block size itself
+  size_t block = 0;
+
+  auto inputMatrOne = KuznetsovArtyomSeq::getRandomSquareMatrix(size, -100.0, 100.0);
+  auto inputMatrTwo = KuznetsovArtyomSeq::getRandomSquareMatrix(size, -100.0, 100.0);
+  std::vector<double> outputMatr(size * size, 0.0);
+
+  // Create TaskData
+  auto taskDataSeq = std::make_shared<ppc::core::TaskData>();
+
+  // Add matrOne
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(inputMatrOne.data()));
+  taskDataSeq->inputs_count.emplace_back(inputMatrOne.size());
+
+  // Add matrTwo
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(inputMatrTwo.data()));
+  taskDataSeq->inputs_count.emplace_back(inputMatrTwo.size());
+
+  // Add size
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(&size));
+
+  // Add block
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(&block));
+
+  // Add out matr
+  taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(outputMatr.data()));
+  taskDataSeq->outputs_count.emplace_back(outputMatr.size());
+
+  auto resSeq = KuznetsovArtyomSeq::multMatrSquare(inputMatrOne, inputMatrTwo, size);
+
+  // Create Task
+  KuznetsovArtyomSeq::KuznetsovCannonMatrMultSeq testTaskSequential(taskDataSeq);
+
+  ASSERT_TRUE(testTaskSequential.validation());
+  testTaskSequential.pre_processing();
+  testTaskSequential.run();
+  testTaskSequential.post_processing();
+
+  auto resSize = resSeq.size();
+
+  for (size_t i = 0; i < resSize; ++i) {
+    ASSERT_TRUE(KuznetsovArtyomSeq::isEqual(resSeq[i], outputMatr[i]));
+  }
+}
+
+TEST(Kuznetsov_a_cannon_matr_mult_seq_func_tests, mult_reduced_precision) {
+  int size = 300;
+  int block = 64;
+
+  auto matrOne = KuznetsovArtyomSeq::getRandomSquareMatrix(size, -100.0, 100.0);
+  auto matrTwo = KuznetsovArtyomSeq::getRandomSquareMatrix(size, -100.0, 100.0);
+  std::vector<float> floatOne(matrOne.begin(), matrOne.end());
+  std::vector<float> floatTwo(matrTwo.begin(), matrTwo.end());
+
+  // the double product of the inputs as rounded to float: what is left is the error of the computation
+  auto resDouble = KuznetsovArtyomSeq::CannonMatrixMultSeq(std::vector<double>(floatOne.begin(), floatOne.end()),
+                                                           std::vector<double>(floatTwo.begin(), floatTwo.end()),
+                                                           size, block);
+  auto resFloat = KuznetsovArtyomSeq::CannonMatrixMultSeq(floatOne, floatTwo, size, block);
+  auto resMixed = KuznetsovArtyomSeq::CannonMatrixMultMixed(floatOne, floatTwo, size, block);
+
+  double errorFloat = ppc::core::RelativeError(resFloat, resDouble);
+  double errorMixed = ppc::core::RelativeError(resMixed, resDouble);
+  std::cout << "relative error for n = " << size << ": float " << errorFloat << ", mixed " << errorMixed << std::endl;
+  EXPECT_LT(errorFloat, size * 6e-8);
+  // float products are exact in double and summed in the same order
+  EXPECT_EQ(0.0, errorMixed);
+}
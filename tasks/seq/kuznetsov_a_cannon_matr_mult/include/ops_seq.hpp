@@ -15,6 +15,12 @@ bool validateMatrix(size_t sizeOne, size_t sizeTwo);
 
 std::vector<double> CannonMatrixMultSeq(const std::vector<double>& matrOne, const std::vector<double>& matrTwo,
                                         int size, int block);
+// single precision: half the memory and twice the elements per vector instruction
+std::vector<float> CannonMatrixMultSeq(const std::vector<float>& matrOne, const std::vector<float>& matrTwo, int size,
+                                       int block);
+// float operands with every block product accumulated in double
+std::vector<double> CannonMatrixMultMixed(const std::vector<float>& matrOne, const std::vector<float>& matrTwo,
+                                          int size, int block);
 
 std::vector<double> multMatrSquare(const std::vector<double>& matrOne, const std::vector<double>& matrTwo, size_t size);
 
@@ -9,7 +9,6 @@
 TEST(Kuznetsov_a_cannon_matr_mult_seq_perf_tests, test_900x900) {
   // Create data
   size_t size = 900;
-  size_t block = 450;
 
   double minVal = -100.0;
   double maxVal = 100.0;
@@ -32,7 +31,8 @@ TEST(Kuznetsov_a_cannon_matr_mult_seq_perf_tests, test_900x900) {
   // Add size
   taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(&size));
 
-  // Add block
+  // Add block: 0, the task picks the block size itself and the perf statistics report it
+  size_t block = 0;
   taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(&block));
 
   // Add out matr
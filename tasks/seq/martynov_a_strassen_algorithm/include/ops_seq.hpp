@@ -37,4 +37,5 @@ class Strssn_alg : public ppc::core::Task {
   std::vector<double> first_matrix;
   std::vector<double> second_matrix;
   std::vector<double> result;
+  int leaf = 0;
 };
@@ -8,7 +8,7 @@
 #include "seq/martynov_a_strassen_algorithm/include/ops_seq.hpp"
 
 TEST(martynov_a_strassen_alg_seq_perf, test_pipeline_run) {
-  const int n = 64;
+  const int n = 512;
   int m = n * n;
   // Create data
   std::vector<double> first_matrix = fillMatrix(n);
@@ -54,7 +54,7 @@ TEST(martynov_a_strassen_alg_seq_perf, test_pipeline_run) {
 }
 
 TEST(martynov_a_strassen_alg_seq_perf, test_task_run) {
-  const int n = 64;
+  const int n = 512;
   int m = n * n;
   // Create data
   std::vector<double> result(m);
@@ -155,3 +155,131 @@ TEST(mironov_i_sparse_crs_seq, TestRandom) {
   testTask.run();
   testTask.post_processing();
 }
+
+TEST(mironov_i_sparse_crs_seq, TestSymbolicReuse) {
+  std::vector<double> A = {2, 0, 2, 0, 0, 1, 0, 2, -2, 0, 3, 0};
+  std::vector<double> B = {2, 0, 0, 0, -3, 0, 0, 1, 4, 1, 2, 3};
+  std::vector<double> res = {4, 2, 8, 2, 1, 6, -4, 3, 12};
+  int n = 3;
+  int m = 4;
+  int k = 3;
+
+  MatrixCRS a(A.data(), n, m);
+  MatrixCRS b(B.data(), m, k);
+  MatrixCRS c = MultiplicateSymbolic(a, b, k);
+  ASSERT_EQ(c.NZ, c.RowIndex[n]);
+
+  for (int scale = 1; scale <= 3; scale++) {
+    for (auto &value : a.Value) {
+      value *= scale;
+    }
+    MultiplicateNumeric(a, b, k, c);
+    std::vector<double> C(n * k, 0.0);
+    for (int i = 0; i < n; i++) {
+      for (int c_j = c.RowIndex[i]; c_j < c.RowIndex[i + 1]; c_j++) {
+        C[i * k + c.Col[c_j]] = c.Value[c_j];
+      }
+    }
+    for (size_t i = 0; i < C.size(); i++) {
+      EXPECT_DOUBLE_EQ(res[i] * scale, C[i]);
+      res[i] *= scale;
+    }
+  }
+}
+
+TEST(mironov_i_sparse_crs_seq, TestSparseInputOutput) {
+  // A = {{2, 0, 2, 0}, {0, 1, 0, 2}, {-2, 0, 3, 0}}, B = {{2, 0, 0}, {0, -3, 0}, {0, 1, 4}, {1, 2, 3}}
+  MatrixCRS A(3, 6);
+  A.Value = {2, 2, 1, 2, -2, 3};
+  A.Col = {0, 2, 1, 3, 0, 2};
+  A.RowIndex = {0, 2, 4, 6};
+  MatrixCRS B(4, 7);
+  B.Value = {2, -3, 1, 4, 1, 2, 3};
+  B.Col = {0, 1, 1, 2, 0, 1, 2};
+  B.RowIndex = {0, 1, 2, 4, 7};
+  MatrixCRS C;
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(&A));
+  taskData->inputs_count.emplace_back(3);
+  taskData->inputs_count.emplace_back(4);
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(&B));
+  taskData->inputs_count.emplace_back(4);
+  taskData->inputs_count.emplace_back(3);
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(&C));
+  taskData->outputs_count.emplace_back(1);
+
+  // Create Task
+  MironovISequentialSparse testTask(taskData);
+  ASSERT_EQ(testTask.validation(), true);
+  testTask.pre_processing();
+  testTask.run();
+  testTask.post_processing();
+
+  ASSERT_EQ(C.N, 3);
+  EXPECT_EQ(C.RowIndex, std::vector<int>({0, 3, 6, 9}));
+  EXPECT_EQ(C.Col, std::vector<int>({0, 1, 2, 0, 1, 2, 0, 1, 2}));
+  std::vector<double> res = {4, 2, 8, 2, 1, 6, -4, 3, 12};
+  for (size_t i = 0; i < res.size(); i++) {
+    EXPECT_DOUBLE_EQ(res[i], C.Value[i]);
+  }
+}
+
+TEST(mironov_i_sparse_crs_seq, TestSparseDimensionMismatch) {
+  MatrixCRS A(3, 0);
+  MatrixCRS B(5, 0);
+  MatrixCRS C;
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(&A));
+  taskData->inputs_count.emplace_back(3);
+  taskData->inputs_count.emplace_back(4);
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(&B));
+  taskData->inputs_count.emplace_back(5);
+  taskData->inputs_count.emplace_back(3);
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(&C));
+  taskData->outputs_count.emplace_back(1);
+
+  // Create Task
+  MironovISequentialSparse testTask(taskData);
+  ASSERT_EQ(testTask.validation(), false);
+}
+
+TEST(mironov_i_sparse_crs_seq, TestDenseToCCS) {
+  // wider than one conversion block, so several column slabs are filled independently
+  int n = 7;
+  int m = 150;
+  std::vector<double> A(n * m, 0.0);
+  for (int i = 0; i < n; i++) {
+    for (int j = (i * 3) % 5; j < m; j += 4 + i) {
+      A[i * m + j] = i * 1000 + j + 1;
+    }
+  }
+
+  MatrixCRS a(A.data(), n, m);
+  MatrixCRS at(A.data(), n, m, true);
+  ASSERT_EQ(a.N, n);
+  ASSERT_EQ(at.N, m);
+  ASSERT_EQ(a.NZ, at.NZ);
+  ASSERT_EQ(at.RowIndex[m], at.NZ);
+
+  std::vector<double> A_from_rows(n * m, 0.0);
+  std::vector<double> A_from_cols(n * m, 0.0);
+  for (int i = 0; i < n; i++) {
+    for (int j = a.RowIndex[i]; j < a.RowIndex[i + 1]; j++) {
+      A_from_rows[i * m + a.Col[j]] = a.Value[j];
+    }
+  }
+  for (int j = 0; j < m; j++) {
+    for (int k = at.RowIndex[j]; k < at.RowIndex[j + 1]; k++) {
+      if (k > at.RowIndex[j]) {
+        EXPECT_LT(at.Col[k - 1], at.Col[k]);
+      }
+      A_from_cols[at.Col[k] * m + j] = at.Value[k];
+    }
+  }
+  EXPECT_EQ(A, A_from_rows);
+  EXPECT_EQ(A, A_from_cols);
+}
@@ -20,6 +20,12 @@ class MatrixCRS {
   MatrixCRS(const double* matrix, int n, int m, bool transpose = false);
 };
 
+// Symbolic phase of C = A * B, k is the number of columns of B: exact RowIndex and Col of C, Value allocated but
+// not filled. The result can be reused by MultiplicateNumeric for any A and B with the same sparsity pattern.
+MatrixCRS MultiplicateSymbolic(const MatrixCRS& A, const MatrixCRS& B, int k);
+// Numeric phase: fills C.Value for the structure produced by MultiplicateSymbolic.
+void MultiplicateNumeric(const MatrixCRS& A, const MatrixCRS& B, int k, MatrixCRS& C);
+
 class MironovISequential : public ppc::core::Task {
  public:
   explicit MironovISequential(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
@@ -32,8 +38,27 @@ class MironovISequential : public ppc::core::Task {
 
  private:
   MatrixCRS A;
-  MatrixCRS BT;
+  MatrixCRS B;
   MatrixCRS C;
   double* c_out{};
   int M{};
+  int K{};
+};
+
+// Same multiplication without dense buffers: inputs[0] and inputs[1] point to MatrixCRS of A (n x m)
+// and B (m x k), inputs_count is {n, m, m, k}, outputs[0] points to the MatrixCRS receiving C.
+class MironovISequentialSparse : public ppc::core::Task {
+ public:
+  explicit MironovISequentialSparse(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+  bool pre_processing() override;
+  bool validation() override;
+  bool run() override;
+  bool post_processing() override;
+
+ private:
+  const MatrixCRS* A{};
+  const MatrixCRS* B{};
+  MatrixCRS C;
+  MatrixCRS* c_out{};
+  int K{};
 };
@@ -1,96 +1,95 @@
 // Copyright 2024 Nesterov Alexander
 #include "seq/mironov_i_sparse_crs/include/ops_seq.hpp"
 
-#include <cstring>
+#include <algorithm>
+#include <cmath>
 #include <random>
 #include <vector>
+
+#include "core/sparse/include/compress.hpp"
 const double EPS = 1e-6;
 
 MatrixCRS::MatrixCRS(int n, int nz) : N(n), NZ(nz) {
-  Value.reserve(nz);
-  Col.reserve(nz);
-  RowIndex.reserve(n + 1);
-}
-
-MatrixCRS::MatrixCRS(const double* matrix, int n, int m, bool transpose) {
-  int index;
-  if (transpose) {
-    N = m;
-    m = n;
-  } else {
-    N = n;
-  }
-  RowIndex.reserve(N + 1);
-  NZ = 0;
-  for (int i = 0; i < N; i++) {
-    RowIndex[i] = NZ;
-    for (int j = 0; j < m; j++) {
-      index = transpose ? i + N * j : i * m + j;
-      if (std::fabs(matrix[index]) >= EPS) {
-        Value.push_back(matrix[index]);
-        Col.push_back(j);
-        NZ++;
-      }
-    }
-  }
-  RowIndex[N] = NZ;
+  Value.resize(nz);
+  Col.resize(nz);
+  RowIndex.resize(n + 1);
 }
 
-MatrixCRS Multiplicate2(const MatrixCRS& A, const MatrixCRS& BT, int m) {
-  int N = A.N;
-  int nz_expected = A.NZ * BT.NZ / N + 1;
-  std::vector<int> columns;
-  std::vector<double> values;
-  std::vector<int> row_index(N + 1);
-  values.reserve(nz_expected);
-  columns.reserve(nz_expected);
-  std::vector<int> temp(m);
-  int nz = 0;
+MatrixCRS::MatrixCRS(const double* matrix, int n, int m, bool transpose) : N(transpose ? m : n) {
+  // transposed, the rows of the result are the columns of matrix, so it is compressed by columns
+  auto nonzero = [](double v) { return std::fabs(v) >= EPS; };
+  ppc::core::DenseToCompressed(matrix, n, m, transpose, nonzero, Value, Col, RowIndex);
+  NZ = RowIndex[N];
+}
 
+MatrixCRS MultiplicateSymbolic(const MatrixCRS& A, const MatrixCRS& B, int k) {
+  int N = A.N;
+  std::vector<int> row_index(N + 1, 0);
+  std::vector<int> mark(k, -1);
+  // first pass: exact number of structural nonzeros in every row of C
   for (int i = 0; i < N; i++) {
-    row_index[i] = nz;
-
-    memset(temp.data(), 0, m * sizeof(*temp.data()));
-    int ind1 = A.RowIndex[i];
-    int ind2 = A.RowIndex[i + 1];
-    for (int k = ind1; k < ind2; k++) {
-      temp[A.Col[k]] = k + 1;
+    int count = 0;
+    for (int a_j = A.RowIndex[i]; a_j < A.RowIndex[i + 1]; a_j++) {
+      int row = A.Col[a_j];
+      for (int b_j = B.RowIndex[row]; b_j < B.RowIndex[row + 1]; b_j++) {
+        if (mark[B.Col[b_j]] != i) {
+          mark[B.Col[b_j]] = i;
+          count++;
+        }
+      }
     }
+    row_index[i + 1] = row_index[i] + count;
+  }
 
-    for (int j = 0; j < BT.N; j++) {
-      double sum = 0;
-
-      int ind3 = BT.RowIndex[j];
-      int ind4 = BT.RowIndex[j + 1];
-      for (int k = ind3; k < ind4; k++) {
-        int aind = temp[BT.Col[k]];
-        if (aind != 0) {
-          sum += A.Value[aind - 1] * BT.Value[k];
+  MatrixCRS C(N, row_index[N]);
+  C.RowIndex = std::move(row_index);
+  // second pass: column indices are written straight into their final place
+  std::fill(mark.begin(), mark.end(), -1);
+  for (int i = 0; i < N; i++) {
+    int pos = C.RowIndex[i];
+    for (int a_j = A.RowIndex[i]; a_j < A.RowIndex[i + 1]; a_j++) {
+      int row = A.Col[a_j];
+      for (int b_j = B.RowIndex[row]; b_j < B.RowIndex[row + 1]; b_j++) {
+        if (mark[B.Col[b_j]] != i) {
+          mark[B.Col[b_j]] = i;
+          C.Col[pos++] = B.Col[b_j];
         }
       }
+    }
+    std::sort(C.Col.begin() + C.RowIndex[i], C.Col.begin() + pos);
+  }
+  return C;
+}
 
-      if (std::fabs(sum) > EPS) {
-        columns.push_back(j);
-        values.push_back(sum);
-        nz++;
+void MultiplicateNumeric(const MatrixCRS& A, const MatrixCRS& B, int k, MatrixCRS& C) {
+  std::vector<double> acc(k, 0.0);
+  for (int i = 0; i < A.N; i++) {
+    for (int a_j = A.RowIndex[i]; a_j < A.RowIndex[i + 1]; a_j++) {
+      int row = A.Col[a_j];
+      double a_val = A.Value[a_j];
+      for (int b_j = B.RowIndex[row]; b_j < B.RowIndex[row + 1]; b_j++) {
+        acc[B.Col[b_j]] += a_val * B.Value[b_j];
       }
     }
+    for (int c_j = C.RowIndex[i]; c_j < C.RowIndex[i + 1]; c_j++) {
+      C.Value[c_j] = acc[C.Col[c_j]];
+      acc[C.Col[c_j]] = 0.0;
+    }
   }
-  row_index[N] = nz;
+}
 
-  MatrixCRS C(N, nz);
-  std::move(values.begin(), values.end(), C.Value.begin());
-  std::move(columns.begin(), columns.end(), C.Col.begin());
-  std::move(row_index.begin(), row_index.end(), C.RowIndex.begin());
+MatrixCRS Multiplicate2(const MatrixCRS& A, const MatrixCRS& B, int k) {
+  MatrixCRS C = MultiplicateSymbolic(A, B, k);
+  MultiplicateNumeric(A, B, k, C);
   return C;
 }
 
 bool MironovISequential::pre_processing() {
   internal_order_test();
   M = taskData->inputs_count[1];
+  K = taskData->inputs_count[3];
   A = MatrixCRS(reinterpret_cast<double*>(taskData->inputs[0]), taskData->inputs_count[0], M, false);
-  BT = MatrixCRS(reinterpret_cast<double*>(taskData->inputs[1]), taskData->inputs_count[2], taskData->inputs_count[3],
-                 true);
+  B = MatrixCRS(reinterpret_cast<double*>(taskData->inputs[1]), taskData->inputs_count[2], K, false);
   c_out = reinterpret_cast<double*>(taskData->outputs[0]);
   return true;
 }
@@ -123,13 +122,13 @@ void PrintCRSMatrix(const MatrixCRS& matrix, int m) {
 
 bool MironovISequential::run() {
   internal_order_test();
-  C = Multiplicate2(A, BT, M);
+  C = Multiplicate2(A, B, K);
   return true;
 }
 
 bool MironovISequential::post_processing() {
   internal_order_test();
-  int m = BT.N;
+  int m = K;
   int j;
   int c_j;
 
@@ -152,6 +151,42 @@ bool MironovISequential::post_processing() {
   return true;
 }
 
+bool MironovISequentialSparse::pre_processing() {
+  internal_order_test();
+  A = reinterpret_cast<MatrixCRS*>(taskData->inputs[0]);
+  B = reinterpret_cast<MatrixCRS*>(taskData->inputs[1]);
+  K = taskData->inputs_count[3];
+  c_out = reinterpret_cast<MatrixCRS*>(taskData->outputs[0]);
+  return true;
+}
+
+bool MironovISequentialSparse::validation() {
+  internal_order_test();
+  if (taskData->inputs.size() != 2 || taskData->inputs_count.size() != 4 || taskData->outputs.size() != 1) {
+    return false;
+  }
+  if (taskData->inputs[0] == nullptr || taskData->inputs[1] == nullptr || taskData->outputs[0] == nullptr) {
+    return false;
+  }
+  const auto* a = reinterpret_cast<MatrixCRS*>(taskData->inputs[0]);
+  const auto* b = reinterpret_cast<MatrixCRS*>(taskData->inputs[1]);
+  return taskData->inputs_count[1] == taskData->inputs_count[2] &&
+         a->N == static_cast<int>(taskData->inputs_count[0]) && b->N == static_cast<int>(taskData->inputs_count[2]) &&
+         taskData->inputs_count[3] != 0u;
+}
+
+bool MironovISequentialSparse::run() {
+  internal_order_test();
+  C = Multiplicate2(*A, *B, K);
+  return true;
+}
+
+bool MironovISequentialSparse::post_processing() {
+  internal_order_test();
+  *c_out = std::move(C);
+  return true;
+}
+
 void MironovISequential::genrateSparseMatrix(double* matrix, int sz, double ro) {
   int nz = sz * ro;
   std::uniform_int_distribution<int> distribution(0, sz - 1);
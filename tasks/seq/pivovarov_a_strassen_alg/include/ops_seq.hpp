@@ -23,6 +23,7 @@ class TestTaskSequentialPivovarovStrassen : public ppc::core::Task {
   std::vector<double> B;
   std::vector<double> result;
   int n = 0, m = 0;
+  int leaf = 0;
 };
 
 inline std::vector<double> createRndMatrix(int n) {
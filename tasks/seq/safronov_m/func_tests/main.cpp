@@ -137,4 +137,33 @@ TEST(Safronov_mult_m_fox, mult5) {
       EXPECT_DOUBLE_EQ(out[i * n + j], expected_result[i * n + j]);
     }
   }
-}
\ No newline at end of file
+}
+
+TEST(Safronov_mult_m_fox, multSeveralBlocks) {
+  // larger than a block and not a multiple of it
+  size_t n = 150;
+  std::vector<double> in1(n * n);
+  std::vector<double> in2(n * n);
+  GetRandomValue(in1.data(), n * n);
+  GetRandomValue(in2.data(), n * n);
+  std::vector<double> out(n * n);
+
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in1.data()));
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in2.data()));
+  taskData->inputs_count.emplace_back(in1.size());
+  taskData->inputs_count.emplace_back(in2.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  SafronovSeqFoxAlgTask safronovTask(taskData);
+  ASSERT_EQ(safronovTask.validation(), true);
+  ASSERT_TRUE(safronovTask.pre_processing());
+  safronovTask.run();
+  safronovTask.post_processing();
+
+  std::vector<double> expected_result = mulSafronov(in1, in2, n);
+  for (size_t i = 0; i < n * n; i++) {
+    ASSERT_DOUBLE_EQ(out[i], expected_result[i]);
+  }
+}
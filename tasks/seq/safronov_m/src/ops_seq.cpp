@@ -1,12 +1,21 @@
 // Copyright 2024 Safronov Mikhail
 #include "seq/safronov_m/include/ops_seq.hpp"
 
+#include <algorithm>
 #include <cmath>
-#include <cstring>
 #include <iostream>
 #include <random>
 
-using namespace std::chrono_literals;
+#include "core/gemm/include/blocking.hpp"
+#include "core/gemm/include/gemm.hpp"
+
+namespace {
+void multiplyBlock(const ppc::core::TiledMatrix& A, const ppc::core::TiledMatrix& B, ppc::core::TiledMatrix& C, int i,
+                   int j, int k) {
+  int t = C.Tile();
+  ppc::core::Gemm(t, t, t, A.Block(i, k), t, B.Block(k, j), t, C.Block(i, j), t);
+}
+}  // namespace
 
 bool SafronovSeqFoxAlgTask::validation() {
   internal_order_test();
@@ -17,37 +26,38 @@ bool SafronovSeqFoxAlgTask::validation() {
 
 bool SafronovSeqFoxAlgTask::pre_processing() {
   internal_order_test();
-  A = reinterpret_cast<double *>(taskData->inputs[0]);
-  B = reinterpret_cast<double *>(taskData->inputs[1]);
-  C = reinterpret_cast<double *>(taskData->outputs[0]);
-  n = round(sqrt(taskData->inputs_count[0]));
-  memset(C, 0, n * n * sizeof(*C));
+  n = static_cast<size_t>(std::round(std::sqrt(taskData->inputs_count[0])));
+  int n_int = static_cast<int>(n);
+  // blocks are contiguous tiles that Gemm reads in place; edge blocks are padded with zeros, so the block size
+  // measured for this host does not have to divide n
+  int block = n_int > 0 ? ppc::core::TuneBlockSize("fox", n_int, 1) : 1;
+  A = ppc::core::TiledMatrix(n_int, n_int, block);
+  B = ppc::core::TiledMatrix(n_int, n_int, block);
+  C = ppc::core::TiledMatrix(n_int, n_int, block);
+  A.FromRowMajor(reinterpret_cast<double*>(taskData->inputs[0]), n_int);
+  B.FromRowMajor(reinterpret_cast<double*>(taskData->inputs[1]), n_int);
   return true;
 }
 
 bool SafronovSeqFoxAlgTask::run() {
   internal_order_test();
-  try {
-    double c = 0;
-    for (size_t i = 0; i < n; i++) {
-      for (size_t j = 0; j < n; j++) {
-        c = 0;
-        for (size_t k = 0; k < n; k++) {
-          c += A[i * n + k] * B[k * n + j];
-        }
-        C[i * n + j] = c;
+  // Fox's stages: at stage s block (i, j) of C adds the product of block (i, (i + s) mod q) of A, broadcast along
+  // block row i, and the matching block of B
+  int q = C.BlockRows();
+  C.SetZero();
+  for (int stage = 0; stage < q; ++stage) {
+    for (int i = 0; i < q; ++i) {
+      for (int j = 0; j < q; ++j) {
+        multiplyBlock(A, B, C, i, j, (i + stage) % q);
       }
     }
-  } catch (const std::exception &e) {
-    std::cout << e.what() << std::endl;
-    return false;
   }
   return true;
 }
 
 bool SafronovSeqFoxAlgTask::post_processing() {
   internal_order_test();
-
+  C.ToRowMajor(reinterpret_cast<double*>(taskData->outputs[0]), C.Cols());
   return true;
 }
 
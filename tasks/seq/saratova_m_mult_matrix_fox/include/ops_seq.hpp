@@ -6,6 +6,7 @@
 #include <utility>
 #include <vector>
 
+#include "core/gemm/include/tiled.hpp"
 #include "core/task/include/task.hpp"
 
 void ScaledIdentityMatrix(double* matrix, int n, double k = 1.0);
@@ -21,6 +22,7 @@ class SaratovaTaskSequential : public ppc::core::Task {
   bool post_processing() override;
 
  private:
-  double *A{}, *B{}, *C{};
-  size_t n{};
+  ppc::core::TiledMatrix A;
+  ppc::core::TiledMatrix B;
+  ppc::core::TiledMatrix C;
 };
@@ -1,11 +1,21 @@
 // Copyright 2024 Saratova Marina
 #include "seq/saratova_m_mult_matrix_fox/include/ops_seq.hpp"
 
+#include <algorithm>
 #include <cmath>
-#include <cstring>
-#include <iostream>
 #include <random>
 
+#include "core/gemm/include/blocking.hpp"
+#include "core/gemm/include/gemm.hpp"
+
+namespace {
+void multiplyBlock(const ppc::core::TiledMatrix& A, const ppc::core::TiledMatrix& B, ppc::core::TiledMatrix& C, int i,
+                   int j, int k) {
+  int t = C.Tile();
+  ppc::core::Gemm(t, t, t, A.Block(i, k), t, B.Block(k, j), t, C.Block(i, j), t);
+}
+}  // namespace
+
 bool SaratovaTaskSequential::validation() {
   internal_order_test();
   return (taskData->inputs[0] != nullptr) && (taskData->inputs[1] != nullptr) && (taskData->outputs[0] != nullptr) &&
@@ -15,36 +25,37 @@ bool SaratovaTaskSequential::validation() {
 
 bool SaratovaTaskSequential::pre_processing() {
   internal_order_test();
-  A = reinterpret_cast<double*>(taskData->inputs[0]);
-  B = reinterpret_cast<double*>(taskData->inputs[1]);
-  C = reinterpret_cast<double*>(taskData->outputs[0]);
-  n = round(sqrt(taskData->inputs_count[0]));
-  memset(C, 0, n * n * sizeof(*C));
+  int n = static_cast<int>(std::round(std::sqrt(taskData->inputs_count[0])));
+  // blocks are contiguous tiles that Gemm reads in place; edge blocks are padded with zeros, so the block size
+  // measured for this host does not have to divide the matrix size
+  int block = n > 0 ? ppc::core::TuneBlockSize("fox", n, 1) : 1;
+  A = ppc::core::TiledMatrix(n, n, block);
+  B = ppc::core::TiledMatrix(n, n, block);
+  C = ppc::core::TiledMatrix(n, n, block);
+  A.FromRowMajor(reinterpret_cast<double*>(taskData->inputs[0]), n);
+  B.FromRowMajor(reinterpret_cast<double*>(taskData->inputs[1]), n);
   return true;
 }
 
 bool SaratovaTaskSequential::run() {
   internal_order_test();
-  try {
-    double c = 0;
-    for (size_t i = 0; i < n; i++) {
-      for (size_t j = 0; j < n; j++) {
-        c = 0;
-        for (size_t k = 0; k < n; k++) {
-          c += A[i * n + k] * B[k * n + j];
-        }
-        C[i * n + j] = c;
+  // Fox's stages: at stage s block (i, j) of C adds the product of block (i, (i + s) mod q) of A, broadcast along
+  // block row i, and the matching block of B
+  int q = C.BlockRows();
+  C.SetZero();
+  for (int stage = 0; stage < q; ++stage) {
+    for (int i = 0; i < q; ++i) {
+      for (int j = 0; j < q; ++j) {
+        multiplyBlock(A, B, C, i, j, (i + stage) % q);
       }
     }
-  } catch (const std::exception& e) {
-    std::cout << e.what() << std::endl;
-    return false;
   }
   return true;
 }
 
 bool SaratovaTaskSequential::post_processing() {
   internal_order_test();
+  C.ToRowMajor(reinterpret_cast<double*>(taskData->outputs[0]), C.Cols());
   return true;
 }
 
@@ -7,6 +7,38 @@
 
 using namespace Savchuk;
 
+namespace {
+MatrixCRS toCRS(const std::vector<Complex> &matrix, int numRows, int numCols) {
+  MatrixCRS crs;
+  crs.numRows = numRows;
+  crs.numCols = numCols;
+  crs.rowPtr.push_back(0);
+  for (int i = 0; i < numRows; ++i) {
+    for (int j = 0; j < numCols; ++j) {
+      if (matrix[i * numCols + j] != Complex(0, 0)) {
+        crs.values.push_back(matrix[i * numCols + j]);
+        crs.colPtr.push_back(j);
+      }
+    }
+    crs.rowPtr.push_back(crs.values.size());
+  }
+  return crs;
+}
+
+std::vector<Complex> toDense(const MatrixCRS &crs) {
+  std::vector<Complex> matrix(crs.numRows * crs.numCols);
+  for (int i = 0; i < crs.numRows; ++i) {
+    for (int k = crs.rowPtr[i]; k < crs.rowPtr[i + 1]; ++k) {
+      if (k > crs.rowPtr[i]) {
+        EXPECT_LT(crs.colPtr[k - 1], crs.colPtr[k]);
+      }
+      matrix[i * crs.numCols + crs.colPtr[k]] = crs.values[k];
+    }
+  }
+  return matrix;
+}
+}  // namespace
+
 TEST(savchuk_a_crs_matmult, test_sizes_true) {
   size_t n1 = 4;
   size_t m1 = 6;
@@ -194,4 +226,87 @@ TEST(savchuk_a_crs_matmult, zero_matrix) {
   }
 
   ASSERT_EQ(m, n1 * m2);
-}
\ No newline at end of file
+}
+
+TEST(savchuk_a_crs_matmult, crs_input_test_sizes) {
+  // Create data
+  MatrixCRS in1 = toCRS(std::vector<Complex>(4 * 6), 4, 6);
+  MatrixCRS in2 = toCRS(std::vector<Complex>(5 * 2), 5, 2);
+  MatrixCRS out;
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(&in1));
+  taskDataSeq->inputs_count.emplace_back(4);
+  taskDataSeq->inputs_count.emplace_back(6);
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(&in2));
+  taskDataSeq->inputs_count.emplace_back(5);
+  taskDataSeq->inputs_count.emplace_back(2);
+  taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(&out));
+
+  // Create Task
+  SavchukCRSMatMultSparse savchukCRSMatMultSparse(taskDataSeq);
+  ASSERT_FALSE(savchukCRSMatMultSparse.validation());
+}
+
+TEST(savchuk_a_crs_matmult, crs_input_multy_correct) {
+  // Create data
+  MatrixCRS in1 = toCRS({Complex(3, 2), Complex(0, 0), Complex(0, 0), Complex(0, 0), Complex(1, -3), Complex(0, 0),
+                         Complex(0, 0), Complex(0, 0), Complex(-4, 1)},
+                        3, 3);
+  MatrixCRS in2 = toCRS({Complex(0, 0), Complex(2, -1), Complex(0, 0), Complex(0, 0), Complex(0, 0), Complex(-5, 2),
+                         Complex(0, 0), Complex(2, 1), Complex(0, 0)},
+                        3, 3);
+  MatrixCRS out;
+  std::vector<Complex> test{Complex(0, 0),  Complex(8, 1), Complex(0, 0),   Complex(0, 0), Complex(0, 0),
+                            Complex(1, 17), Complex(0, 0), Complex(-9, -2), Complex(0, 0)};
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(&in1));
+  taskDataSeq->inputs_count.emplace_back(3);
+  taskDataSeq->inputs_count.emplace_back(3);
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(&in2));
+  taskDataSeq->inputs_count.emplace_back(3);
+  taskDataSeq->inputs_count.emplace_back(3);
+  taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(&out));
+
+  // Create Task
+  SavchukCRSMatMultSparse savchukCRSMatMultSparse(taskDataSeq);
+  ASSERT_TRUE(savchukCRSMatMultSparse.validation());
+  ASSERT_TRUE(savchukCRSMatMultSparse.pre_processing());
+  ASSERT_TRUE(savchukCRSMatMultSparse.run());
+  ASSERT_TRUE(savchukCRSMatMultSparse.post_processing());
+  ASSERT_EQ(out.values.size(), 3u);
+  ASSERT_EQ(toDense(out), test);
+}
+
+TEST(savchuk_a_crs_matmult, crs_input_rectangular) {
+  // Create data
+  MatrixCRS in1 =
+      toCRS({Complex(1, 1), Complex(0, 0), Complex(2, 0), Complex(0, 0), Complex(0, 1), Complex(0, 0)}, 2, 3);
+  MatrixCRS in2 =
+      toCRS({Complex(0, 0), Complex(1, 0), Complex(3, 0), Complex(0, 0), Complex(1, -1), Complex(0, 0)}, 3, 2);
+  MatrixCRS out;
+  std::vector<Complex> test{Complex(2, -2), Complex(1, 1), Complex(0, 3), Complex(0, 0)};
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(&in1));
+  taskDataSeq->inputs_count.emplace_back(2);
+  taskDataSeq->inputs_count.emplace_back(3);
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(&in2));
+  taskDataSeq->inputs_count.emplace_back(3);
+  taskDataSeq->inputs_count.emplace_back(2);
+  taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(&out));
+
+  // Create Task
+  SavchukCRSMatMultSparse savchukCRSMatMultSparse(taskDataSeq);
+  ASSERT_TRUE(savchukCRSMatMultSparse.validation());
+  ASSERT_TRUE(savchukCRSMatMultSparse.pre_processing());
+  ASSERT_TRUE(savchukCRSMatMultSparse.run());
+  ASSERT_TRUE(savchukCRSMatMultSparse.post_processing());
+  ASSERT_EQ(out.numRows, 2);
+  ASSERT_EQ(out.numCols, 2);
+  ASSERT_EQ(toDense(out), test);
+}
@@ -10,6 +10,21 @@ namespace Savchuk {
 
 using Complex = std::complex<double>;
 
+// Matrix in compressed rows: rowPtr has numRows + 1 entries and the columns of row i are
+// colPtr[rowPtr[i]], ..., colPtr[rowPtr[i + 1] - 1] in increasing order.
+struct MatrixCRS {
+  std::vector<Complex> values;
+  std::vector<int> rowPtr;
+  std::vector<int> colPtr;
+  int numRows{};
+  int numCols{};
+};
+
+// C = A * B row by row: row i of C gathers the rows of B picked by row i of A in a dense accumulator that is read back
+// only at the columns they touched, so time and memory follow the nonzeros.
+// C keeps every structural nonzero, including products that cancel.
+MatrixCRS MultiplyCRS(const MatrixCRS &a, const MatrixCRS &b);
+
 class SavchukCRSMatMult : public ppc::core::Task {
   std::vector<Complex> values1{};
   std::vector<int> rowPtr1{};
@@ -30,4 +45,21 @@ class SavchukCRSMatMult : public ppc::core::Task {
   bool run() override;
   bool post_processing() override;
 };
-}  // namespace Savchuk
\ No newline at end of file
+
+// Same multiplication without dense buffers: inputs[0] and inputs[1] point to the MatrixCRS of A (n1 x m1) and
+// B (m1 x m2), inputs_count is {n1, m1, m1, m2}, outputs[0] points to the MatrixCRS receiving C.
+class SavchukCRSMatMultSparse : public ppc::core::Task {
+ public:
+  explicit SavchukCRSMatMultSparse(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+  bool pre_processing() override;
+  bool validation() override;
+  bool run() override;
+  bool post_processing() override;
+
+ private:
+  const MatrixCRS *a{};
+  const MatrixCRS *b{};
+  MatrixCRS c;
+  MatrixCRS *out{};
+};
+}  // namespace Savchuk
@@ -1,8 +1,11 @@
 // Copyright 2024 Savchuk Anton
 #include "seq/savchuk_a_crs_matmult/include/crs_matmult_seq.hpp"
 
+#include <algorithm>
 #include <complex>
 
+#include "core/sparse/include/compress.hpp"
+
 using namespace Savchuk;
 
 bool SavchukCRSMatMult::validation() {
@@ -25,33 +28,9 @@ bool SavchukCRSMatMult::pre_processing() {
 
   result = new Complex[numRows1 * numCols2]{0.0};
 
-  int notNullNumbers = 0;
-  for (int i = 0; i < numRows1; ++i) {
-    rowPtr1.push_back(notNullNumbers);
-    for (int j = 0; j < numCols1; ++j) {
-      int index = i * numCols1 + j;
-      if (matrix1[index] != Complex(0.0, 0.0)) {
-        values1.push_back(matrix1[index]);
-        colPtr1.push_back(j);
-        notNullNumbers++;
-      }
-    }
-  }
-  rowPtr1.push_back(notNullNumbers);
-
-  notNullNumbers = 0;
-  for (int i = 0; i < numRows2; ++i) {
-    rowPtr2.push_back(notNullNumbers);
-    for (int j = 0; j < numCols2; ++j) {
-      int index = i * numCols2 + j;
-      if (matrix2[index] != Complex(0.0, 0.0)) {
-        values2.push_back(matrix2[index]);
-        colPtr2.push_back(j);
-        notNullNumbers++;
-      }
-    }
-  }
-  rowPtr2.push_back(notNullNumbers);
+  auto nonzero = [](const Complex& v) { return v != Complex(0.0, 0.0); };
+  ppc::core::DenseToCompressed(matrix1, numRows1, numCols1, false, nonzero, values1, colPtr1, rowPtr1);
+  ppc::core::DenseToCompressed(matrix2, numRows2, numCols2, false, nonzero, values2, colPtr2, rowPtr2);
 
   return true;
 }
@@ -88,3 +67,82 @@ bool SavchukCRSMatMult::post_processing() {
 
   return true;
 }
+
+MatrixCRS Savchuk::MultiplyCRS(const MatrixCRS& a, const MatrixCRS& b) {
+  MatrixCRS c;
+  c.numRows = a.numRows;
+  c.numCols = b.numCols;
+  c.rowPtr.push_back(0);
+  std::vector<Complex> row(b.numCols);
+  std::vector<char> touched(b.numCols);
+  std::vector<int> rowCols;
+  for (int i = 0; i < a.numRows; i++) {
+    for (int j = a.rowPtr[i]; j < a.rowPtr[i + 1]; j++) {
+      int col1 = a.colPtr[j];
+      for (int k = b.rowPtr[col1]; k < b.rowPtr[col1 + 1]; k++) {
+        int col2 = b.colPtr[k];
+        if (touched[col2] == 0) {
+          touched[col2] = 1;
+          rowCols.push_back(col2);
+        }
+        row[col2] += a.values[j] * b.values[k];
+      }
+    }
+    std::sort(rowCols.begin(), rowCols.end());
+    for (int col : rowCols) {
+      c.values.push_back(row[col]);
+      c.colPtr.push_back(col);
+      row[col] = Complex(0.0, 0.0);
+      touched[col] = 0;
+    }
+    rowCols.clear();
+    c.rowPtr.push_back(c.values.size());
+  }
+  return c;
+}
+
+bool SavchukCRSMatMultSparse::validation() {
+  internal_order_test();
+
+  if (taskData->inputs.size() != 2 || taskData->inputs_count.size() != 4 || taskData->outputs.size() != 1) {
+    return false;
+  }
+  if (taskData->inputs[0] == nullptr || taskData->inputs[1] == nullptr || taskData->outputs[0] == nullptr) {
+    return false;
+  }
+  const auto* matrix1 = reinterpret_cast<MatrixCRS*>(taskData->inputs[0]);
+  const auto* matrix2 = reinterpret_cast<MatrixCRS*>(taskData->inputs[1]);
+  return taskData->inputs_count[1] == taskData->inputs_count[2] &&
+         matrix1->numRows == static_cast<int>(taskData->inputs_count[0]) &&
+         matrix1->numCols == static_cast<int>(taskData->inputs_count[1]) &&
+         matrix2->numRows == static_cast<int>(taskData->inputs_count[2]) &&
+         matrix2->numCols == static_cast<int>(taskData->inputs_count[3]) &&
+         matrix1->rowPtr.size() == static_cast<size_t>(matrix1->numRows) + 1 &&
+         matrix2->rowPtr.size() == static_cast<size_t>(matrix2->numRows) + 1;
+}
+
+bool SavchukCRSMatMultSparse::pre_processing() {
+  internal_order_test();
+
+  a = reinterpret_cast<MatrixCRS*>(taskData->inputs[0]);
+  b = reinterpret_cast<MatrixCRS*>(taskData->inputs[1]);
+  out = reinterpret_cast<MatrixCRS*>(taskData->outputs[0]);
+
+  return true;
+}
+
+bool SavchukCRSMatMultSparse::run() {
+  internal_order_test();
+
+  c = MultiplyCRS(*a, *b);
+
+  return true;
+}
+
+bool SavchukCRSMatMultSparse::post_processing() {
+  internal_order_test();
+
+  *out = std::move(c);
+
+  return true;
+}
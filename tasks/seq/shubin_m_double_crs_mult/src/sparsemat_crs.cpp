@@ -4,6 +4,8 @@
 
 #include <cmath>
 
+#include "core/sparse/include/compress.hpp"
+
 SparseMat_CRS::SparseMat_CRS(size_t _row_c, size_t _col_c) {
   row_c = _row_c;
   col_c = _col_c;
@@ -18,19 +20,10 @@ SparseMat_CRS::SparseMat_CRS(size_t _row_c, size_t _col_c, size_t _nz_c) {
 SparseMat_CRS::SparseMat_CRS(const std::vector<double>& matrix, size_t _row_c, size_t _col_c) {
   row_c = _row_c;
   col_c = _col_c;
-  nz_c = 0;
-  for (size_t i = 0; i < row_c; i++) {
-    row_ind.push_back(val.size());
-    for (size_t j = 0; j < col_c; j++) {
-      double temp = matrix[i * col_c + j];
-      if (std::abs(temp) > PRECISION) {
-        val.push_back(temp);
-        col_ind.push_back(j);
-        nz_c++;
-      }
-    }
-  }
-  row_ind.push_back(val.size());
+  auto nonzero = [](double temp) { return std::abs(temp) > PRECISION; };
+  ppc::core::DenseToCompressed(matrix.data(), static_cast<int>(row_c), static_cast<int>(col_c), false, nonzero, val,
+                               col_ind, row_ind);
+  nz_c = val.size();
 }
 
 SparseMat_CRS random_CRS_mat(size_t _row_c, size_t _col_c, double dens, double _min, double _max) {
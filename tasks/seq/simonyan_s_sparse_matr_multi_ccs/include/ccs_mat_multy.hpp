@@ -31,4 +31,40 @@ class SparseMatrixMultiSequential : public ppc::core::Task {
   int numRows3{};
   int numCols3{};
   double* result{};
-};
\ No newline at end of file
+};
+
+namespace SimonyanSeq {
+
+// Matrix in compressed columns: colPtr has numCols + 1 entries and the rows of column j are
+// rows[colPtr[j]], ..., rows[colPtr[j + 1] - 1] in increasing order.
+struct MatrixCCS {
+  std::vector<double> values;
+  std::vector<int> rows;
+  std::vector<int> colPtr;
+  int numRows{};
+  int numCols{};
+};
+
+// C = A * B column by column: column j of C gathers the columns of A picked by column j of B in a dense
+// accumulator that is read back only at the rows they touched, so time and memory follow the nonzeros.
+// C keeps every structural nonzero, including products that cancel.
+MatrixCCS MultiplyCCS(const MatrixCCS& a, const MatrixCCS& b);
+
+// Same multiplication on compressed input: inputs[0] and inputs[1] point to the MatrixCCS of A (n1 x m1) and
+// B (m1 x m2), inputs_count is {n1, m1, m1, m2}, outputs[0] points to the MatrixCCS receiving C.
+class SparseMatrixMultiCCS : public ppc::core::Task {
+ public:
+  explicit SparseMatrixMultiCCS(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+  bool pre_processing() override;
+  bool validation() override;
+  bool run() override;
+  bool post_processing() override;
+
+ private:
+  const MatrixCCS* a{};
+  const MatrixCCS* b{};
+  MatrixCCS c;
+  MatrixCCS* out{};
+};
+
+}  // namespace SimonyanSeq
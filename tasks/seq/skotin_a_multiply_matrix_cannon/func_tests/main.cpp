@@ -60,3 +60,40 @@ TEST(Skotin_A_Multiply_Matrix_Cannon_Seq, Test_Multiplication_100x100) {
 TEST(Skotin_A_Multiply_Matrix_Cannon_Seq, Test_Multiplication_500x500) {
   TestMatrixMultiplication(500, 1.0, 2.0, 1000.0);
 }
+
+TEST(Skotin_A_Multiply_Matrix_Cannon_Seq, Test_Multiplication_Varied_150x150) {
+  // larger than a block and not a multiple of it, with entries that differ
+  const size_t n = 150;
+  std::vector<double> matrixA(n * n);
+  std::vector<double> matrixB(n * n);
+  for (size_t i = 0; i < n * n; ++i) {
+    matrixA[i] = static_cast<double>(i % 7) - 3.0;
+    matrixB[i] = static_cast<double>(i % 5) - 2.0;
+  }
+  std::vector<double> expected(n * n, 0.0);
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t k = 0; k < n; ++k) {
+      for (size_t j = 0; j < n; ++j) {
+        expected[i * n + j] += matrixA[i * n + k] * matrixB[k * n + j];
+      }
+    }
+  }
+
+  std::vector<double> output(n * n);
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.push_back(reinterpret_cast<uint8_t*>(matrixA.data()));
+  taskData->inputs_count.push_back(n * n * sizeof(double));
+  taskData->inputs.push_back(reinterpret_cast<uint8_t*>(matrixB.data()));
+  taskData->inputs_count.push_back(n * n * sizeof(double));
+  taskData->outputs.push_back(reinterpret_cast<uint8_t*>(output.data()));
+  taskData->outputs_count.push_back(n * n * sizeof(double));
+
+  MatrixMultiplicationTask task(taskData);
+  ASSERT_TRUE(task.pre_processing());
+  ASSERT_TRUE(task.validation());
+  ASSERT_TRUE(task.run());
+  ASSERT_TRUE(task.post_processing());
+  for (size_t i = 0; i < n * n; ++i) {
+    ASSERT_NEAR(output[i], expected[i], 1e-9);
+  }
+}
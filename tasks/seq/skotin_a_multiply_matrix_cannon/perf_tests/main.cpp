@@ -59,7 +59,7 @@ TEST(Skotin_A_Multiply_Matrix_Cannon_Seq, test_pipeline_run) {
 
   ppc::core::Perf::print_perf_statistic(perfResults);
 
-  checkMatrixMultiplicationResult(outputData, matrixSize, 10000.0);
+  checkMatrixMultiplicationResult(outputData, matrixSize, 1000.0);
 }
 
 TEST(Skotin_A_Multiply_Matrix_Cannon_Seq, test_task_run) {
@@ -95,5 +95,5 @@ TEST(Skotin_A_Multiply_Matrix_Cannon_Seq, test_task_run) {
 
   ppc::core::Perf::print_perf_statistic(perfResults);
 
-  checkMatrixMultiplicationResult(outputData, matrixSize, 11000.0);
+  checkMatrixMultiplicationResult(outputData, matrixSize, 1000.0);
 }
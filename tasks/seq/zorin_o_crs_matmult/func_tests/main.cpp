@@ -245,4 +245,86 @@ TEST(Zorin_O_CRS_MatMult_Seq, special_matmult) {
         EXPECT_DOUBLE_EQ(out[i * r + j], 0.0);
     }
   }
-}
\ No newline at end of file
+}
+TEST(Zorin_O_CRS_MatMult_Seq, sparse_input_incorrect_matrix_sizes) {
+  // Create data
+  CRSMatrix lhs_in(11, 10);
+  lhs_in.row_ptr.assign(12, 0);
+  CRSMatrix rhs_in(11, 9);
+  rhs_in.row_ptr.assign(12, 0);
+  CRSMatrix out(0, 0);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(&lhs_in));
+  taskDataSeq->inputs_count.emplace_back(11);
+  taskDataSeq->inputs_count.emplace_back(10);
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(&rhs_in));
+  taskDataSeq->inputs_count.emplace_back(11);
+  taskDataSeq->inputs_count.emplace_back(9);
+  taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(&out));
+
+  // Create Task
+  CRSMatMultSparse crsMatMultSeq(taskDataSeq);
+  ASSERT_FALSE(crsMatMultSeq.validation());
+}
+
+TEST(Zorin_O_CRS_MatMult_Seq, sparse_input_matches_dense) {
+  // Create data
+  size_t p = 31;
+  size_t q = 17;
+  size_t r = 23;
+  std::vector<double> lhs_dense = getRandomMatrix(p, q, 0.1);
+  std::vector<double> rhs_dense = getRandomMatrix(q, r, 0.1);
+  std::vector<double> out_dense(p * r);
+  CRSMatrix lhs_in(lhs_dense.data(), p, q);
+  CRSMatrix rhs_in(rhs_dense.data(), q, r);
+  CRSMatrix out(0, 0);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataDense = std::make_shared<ppc::core::TaskData>();
+  taskDataDense->inputs.emplace_back(reinterpret_cast<uint8_t *>(lhs_dense.data()));
+  taskDataDense->inputs_count.emplace_back(p);
+  taskDataDense->inputs_count.emplace_back(q);
+  taskDataDense->inputs.emplace_back(reinterpret_cast<uint8_t *>(rhs_dense.data()));
+  taskDataDense->inputs_count.emplace_back(q);
+  taskDataDense->inputs_count.emplace_back(r);
+  taskDataDense->outputs.emplace_back(reinterpret_cast<uint8_t *>(out_dense.data()));
+  taskDataDense->outputs_count.emplace_back(p);
+  taskDataDense->outputs_count.emplace_back(r);
+  std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(&lhs_in));
+  taskDataSeq->inputs_count.emplace_back(p);
+  taskDataSeq->inputs_count.emplace_back(q);
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(&rhs_in));
+  taskDataSeq->inputs_count.emplace_back(q);
+  taskDataSeq->inputs_count.emplace_back(r);
+  taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(&out));
+
+  // Create Task
+  CRSMatMult crsMatMultDense(taskDataDense);
+  ASSERT_TRUE(crsMatMultDense.validation());
+  ASSERT_TRUE(crsMatMultDense.pre_processing());
+  ASSERT_TRUE(crsMatMultDense.run());
+  ASSERT_TRUE(crsMatMultDense.post_processing());
+  CRSMatMultSparse crsMatMultSeq(taskDataSeq);
+  ASSERT_TRUE(crsMatMultSeq.validation());
+  ASSERT_TRUE(crsMatMultSeq.pre_processing());
+  ASSERT_TRUE(crsMatMultSeq.run());
+  ASSERT_TRUE(crsMatMultSeq.post_processing());
+  ASSERT_EQ(out.n_rows, p);
+  ASSERT_EQ(out.n_cols, r);
+  ASSERT_EQ(out.row_ptr.size(), p + 1);
+  std::vector<double> out_from_sparse(p * r);
+  for (size_t i = 0; i < p; ++i) {
+    for (size_t j = out.row_ptr[i]; j < out.row_ptr[i + 1]; ++j) {
+      if (j > out.row_ptr[i]) {
+        EXPECT_LT(out.col_index[j - 1], out.col_index[j]);
+      }
+      out_from_sparse[i * r + out.col_index[j]] = out.values[j];
+    }
+  }
+  for (size_t i = 0; i < out_dense.size(); ++i) {
+    EXPECT_DOUBLE_EQ(out_from_sparse[i], out_dense[i]);
+  }
+}
@@ -18,3 +18,23 @@ class CRSMatMult : public ppc::core::Task {
   bool run() override;
   bool post_processing() override;
 };
+
+// C = A * B; the dense accumulator is read back only at the columns the row touched, so a row costs its multiply-adds
+// rather than B.n_cols.
+CRSMatrix CRSMultiply(const CRSMatrix& A, const CRSMatrix& B);
+
+// Same multiplication without dense buffers: inputs[0] and inputs[1] point to the CRSMatrix of A (p x q) and B (q x r),
+// inputs_count is {p, q, q, r}, outputs[0] points to the CRSMatrix receiving C.
+class CRSMatMultSparse : public ppc::core::Task {
+  const CRSMatrix* A{};
+  const CRSMatrix* B{};
+  CRSMatrix C{0, 0};
+  CRSMatrix* c_out{};
+
+ public:
+  explicit CRSMatMultSparse(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+  bool pre_processing() override;
+  bool validation() override;
+  bool run() override;
+  bool post_processing() override;
+};
@@ -1,6 +1,9 @@
 // Copyright 2024 Zorin Oleg
 #include "seq/zorin_o_crs_matmult/include/crs_matmult_seq.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 bool CRSMatMult::validation() {
   internal_order_test();
 
@@ -24,41 +27,101 @@ bool CRSMatMult::pre_processing() {
 bool CRSMatMult::run() {
   internal_order_test();
 
-  std::vector<double> temp_row(C->n_cols);
+  *C = CRSMultiply(*A, *B);
+
+  return true;
+}
 
-  for (size_t row_i = 0; row_i < A->n_rows; ++row_i) {
-    for (size_t i = A->row_ptr[row_i]; i < A->row_ptr[row_i + 1]; ++i) {
-      const size_t& col_i = A->col_index[i];
-      const double& val = A->values[i];
-      for (size_t j = B->row_ptr[col_i]; j < B->row_ptr[col_i + 1]; ++j) {
-        temp_row[B->col_index[j]] += val * B->values[j];
+bool CRSMatMult::post_processing() {
+  internal_order_test();
+
+  auto* out_ptr = reinterpret_cast<double*>(taskData->outputs[0]);
+  for (size_t i = 0; i < C->n_rows; ++i) {
+    for (size_t j = C->row_ptr[i]; j < C->row_ptr[i + 1]; ++j) {
+      out_ptr[i * C->n_cols + C->col_index[j]] = C->values[j];
+    }
+  }
+
+  return true;
+}
+
+CRSMatrix CRSMultiply(const CRSMatrix& A, const CRSMatrix& B) {
+  CRSMatrix C(A.n_rows, B.n_cols);
+  std::vector<double> temp_row(B.n_cols);
+  std::vector<bool> touched(B.n_cols);
+  std::vector<size_t> row_cols;
+
+  for (size_t row_i = 0; row_i < A.n_rows; ++row_i) {
+    for (size_t i = A.row_ptr[row_i]; i < A.row_ptr[row_i + 1]; ++i) {
+      const size_t& col_i = A.col_index[i];
+      const double& val = A.values[i];
+      for (size_t j = B.row_ptr[col_i]; j < B.row_ptr[col_i + 1]; ++j) {
+        const size_t& col_j = B.col_index[j];
+        if (!touched[col_j]) {
+          touched[col_j] = true;
+          row_cols.push_back(col_j);
+        }
+        temp_row[col_j] += val * B.values[j];
       }
     }
 
-    C->row_ptr.push_back(C->values.size());
-    for (size_t i = 0; i < temp_row.size(); ++i) {
+    std::sort(row_cols.begin(), row_cols.end());
+    C.row_ptr.push_back(C.values.size());
+    for (const size_t& i : row_cols) {
       double& val = temp_row[i];
       if (std::abs(val) > 1e-8) {
-        C->values.push_back(val);
-        C->col_index.push_back(i);
-        val = 0.0;
+        C.values.push_back(val);
+        C.col_index.push_back(i);
       }
+      val = 0.0;
+      touched[i] = false;
     }
+    row_cols.clear();
   }
-  C->row_ptr.push_back(C->values.size());
+  C.row_ptr.push_back(C.values.size());
 
-  return true;
+  return C;
 }
 
-bool CRSMatMult::post_processing() {
+bool CRSMatMultSparse::validation() {
   internal_order_test();
 
-  auto* out_ptr = reinterpret_cast<double*>(taskData->outputs[0]);
-  for (size_t i = 0; i < C->n_rows; ++i) {
-    for (size_t j = C->row_ptr[i]; j < C->row_ptr[i + 1]; ++j) {
-      out_ptr[i * C->n_cols + C->col_index[j]] = C->values[j];
-    }
+  if (taskData->inputs.size() != 2 || taskData->inputs_count.size() != 4 || taskData->outputs.size() != 1) {
+    return false;
+  }
+  if (taskData->inputs[0] == nullptr || taskData->inputs[1] == nullptr || taskData->outputs[0] == nullptr) {
+    return false;
   }
+  const auto* a = reinterpret_cast<CRSMatrix*>(taskData->inputs[0]);
+  const auto* b = reinterpret_cast<CRSMatrix*>(taskData->inputs[1]);
+  return taskData->inputs_count[1] == taskData->inputs_count[2] && a->n_rows == taskData->inputs_count[0] &&
+         a->n_cols == taskData->inputs_count[1] && b->n_rows == taskData->inputs_count[2] &&
+         b->n_cols == taskData->inputs_count[3] && a->row_ptr.size() == a->n_rows + 1 &&
+         b->row_ptr.size() == b->n_rows + 1;
+}
+
+bool CRSMatMultSparse::pre_processing() {
+  internal_order_test();
+
+  A = reinterpret_cast<CRSMatrix*>(taskData->inputs[0]);
+  B = reinterpret_cast<CRSMatrix*>(taskData->inputs[1]);
+  c_out = reinterpret_cast<CRSMatrix*>(taskData->outputs[0]);
+
+  return true;
+}
+
+bool CRSMatMultSparse::run() {
+  internal_order_test();
+
+  C = CRSMultiply(*A, *B);
+
+  return true;
+}
+
+bool CRSMatMultSparse::post_processing() {
+  internal_order_test();
+
+  *c_out = std::move(C);
 
   return true;
 }
@@ -4,20 +4,14 @@
 
 #include <cmath>
 
+#include "core/sparse/include/compress.hpp"
+
 CRSMatrix::CRSMatrix(size_t n_rows, size_t n_cols) : n_rows(n_rows), n_cols(n_cols) {}
 
 CRSMatrix::CRSMatrix(const double* matrix, size_t n_rows, size_t n_cols) : n_rows(n_rows), n_cols(n_cols) {
-  for (size_t i = 0; i < n_rows; ++i) {
-    row_ptr.push_back(values.size());
-    for (size_t j = 0; j < n_cols; ++j) {
-      const double& val = matrix[i * n_cols + j];
-      if (std::abs(val) > 1e-8) {
-        values.push_back(val);
-        col_index.push_back(j);
-      }
-    }
-  }
-  row_ptr.push_back(values.size());
+  auto nonzero = [](double val) { return std::abs(val) > 1e-8; };
+  ppc::core::DenseToCompressed(matrix, static_cast<int>(n_rows), static_cast<int>(n_cols), false, nonzero, values,
+                               col_index, row_ptr);
 }
 
 std::vector<double> getRandomMatrix(const size_t& n_rows, const size_t& n_cols, const double& density, const double& a,
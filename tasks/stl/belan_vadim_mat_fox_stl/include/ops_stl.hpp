@@ -7,12 +7,11 @@
 #include <utility>
 #include <vector>
 
+#include "core/gemm/include/tiled.hpp"
 #include "core/task/include/task.hpp"
 
 namespace BelanSTL {
 
-using Matrix = std::vector<std::vector<double>>;
-
 class FoxBlockedSequential : public ppc::core::Task {
  public:
   explicit FoxBlockedSequential(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
@@ -22,9 +21,9 @@ class FoxBlockedSequential : public ppc::core::Task {
   bool post_processing() override;
 
  private:
-  Matrix A{};
-  Matrix B{};
-  Matrix C{};
+  ppc::core::TiledMatrix A;
+  ppc::core::TiledMatrix B;
+  ppc::core::TiledMatrix C;
   int block_size{};
 };
 
@@ -37,9 +36,9 @@ class FoxBlockedParallel : public ppc::core::Task {
   bool post_processing() override;
 
  private:
-  Matrix A{};
-  Matrix B{};
-  Matrix C{};
+  ppc::core::TiledMatrix A;
+  ppc::core::TiledMatrix B;
+  ppc::core::TiledMatrix C;
   int block_size{};
 };
 
@@ -1,9 +1,23 @@
 // Copyright 2024 Vadim Belan
 #include "stl/belan_vadim_mat_fox_stl/include/ops_stl.hpp"
 
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "core/gemm/include/blocking.hpp"
+#include "core/gemm/include/gemm.hpp"
+
 using BelanSTL::FoxBlockedParallel;
 using BelanSTL::FoxBlockedSequential;
-using BelanSTL::Matrix;
+
+namespace {
+void multiplyBlock(const ppc::core::TiledMatrix& A, const ppc::core::TiledMatrix& B, ppc::core::TiledMatrix& C, int i,
+                   int j, int k) {
+  int t = C.Tile();
+  ppc::core::Gemm(t, t, t, A.Block(i, k), t, B.Block(k, j), t, C.Block(i, j), t);
+}
+}  // namespace
 
 bool FoxBlockedSequential::validation() {
   internal_order_test();
@@ -21,18 +35,15 @@ bool FoxBlockedSequential::pre_processing() {
   int rows = taskData->inputs_count[0];
   int cols = taskData->inputs_count[1];
 
-  block_size = 32;
-
-  A.resize(rows, std::vector<double>(cols));
-  B.resize(rows, std::vector<double>(cols));
-  C.resize(rows, std::vector<double>(cols));
+  // blocks are contiguous tiles that Gemm reads in place; edge blocks are padded with zeros, so the block size
+  // measured for this host does not have to divide the matrix size
+  block_size = ppc::core::TuneBlockSize("fox", rows, 1);
 
-  for (int i = 0; i < rows; ++i) {
-    for (int j = 0; j < cols; ++j) {
-      A[i][j] = matrixA[i * cols + j];
-      B[i][j] = matrixB[i * cols + j];
-    }
-  }
+  A = ppc::core::TiledMatrix(rows, cols, block_size);
+  B = ppc::core::TiledMatrix(rows, cols, block_size);
+  C = ppc::core::TiledMatrix(rows, cols, block_size);
+  A.FromRowMajor(matrixA, cols);
+  B.FromRowMajor(matrixB, cols);
 
   return true;
 }
@@ -40,16 +51,14 @@ bool FoxBlockedSequential::pre_processing() {
 bool FoxBlockedSequential::run() {
   internal_order_test();
 
-  for (std::vector<double>::size_type i = 0; i < A.size(); i += block_size) {
-    for (std::vector<double>::size_type j = 0; j < B[0].size(); j += block_size) {
-      for (std::vector<double>::size_type k = 0; k < A[0].size(); ++k) {
-        for (std::vector<double>::size_type ii = i;
-             ii < std::min(i + static_cast<std::vector<double>::size_type>(block_size), A.size()); ++ii) {
-          for (std::vector<double>::size_type jj = j;
-               jj < std::min(j + static_cast<std::vector<double>::size_type>(block_size), B[0].size()); ++jj) {
-            C[ii][jj] += A[ii][k] * B[k][jj];
-          }
-        }
+  // Fox's stages: at stage s block (i, j) of C adds the product of block (i, (i + s) mod q) of A, broadcast along
+  // block row i, and the matching block of B
+  int q = C.BlockRows();
+  C.SetZero();
+  for (int stage = 0; stage < q; ++stage) {
+    for (int i = 0; i < q; ++i) {
+      for (int j = 0; j < q; ++j) {
+        multiplyBlock(A, B, C, i, j, (i + stage) % q);
       }
     }
   }
@@ -60,13 +69,7 @@ bool FoxBlockedSequential::run() {
 bool FoxBlockedSequential::post_processing() {
   internal_order_test();
 
-  auto* out_ptr = reinterpret_cast<double*>(taskData->outputs[0]);
-
-  for (std::vector<double>::size_type i = 0; i < C.size(); ++i) {
-    for (std::vector<double>::size_type j = 0; j < C[0].size(); ++j) {
-      out_ptr[i * C[0].size() + j] = C[i][j];
-    }
-  }
+  C.ToRowMajor(reinterpret_cast<double*>(taskData->outputs[0]), C.Cols());
 
   return true;
 }
@@ -87,18 +90,16 @@ bool FoxBlockedParallel::pre_processing() {
   int rows = taskData->inputs_count[0];
   int cols = taskData->inputs_count[1];
 
-  block_size = 32;
+  // blocks are contiguous tiles that Gemm reads in place; edge blocks are padded with zeros, so the block size
+  // measured for this host does not have to divide the matrix size
+  int threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+  block_size = ppc::core::TuneBlockSize("fox", rows, threads);
 
-  A.resize(rows, std::vector<double>(cols));
-  B.resize(rows, std::vector<double>(cols));
-  C.resize(rows, std::vector<double>(cols));
-
-  for (int i = 0; i < rows; ++i) {
-    for (int j = 0; j < cols; ++j) {
-      A[i][j] = matrixA[i * cols + j];
-      B[i][j] = matrixB[i * cols + j];
-    }
-  }
+  A = ppc::core::TiledMatrix(rows, cols, block_size);
+  B = ppc::core::TiledMatrix(rows, cols, block_size);
+  C = ppc::core::TiledMatrix(rows, cols, block_size);
+  A.FromRowMajor(matrixA, cols);
+  B.FromRowMajor(matrixB, cols);
 
   return true;
 }
@@ -106,19 +107,20 @@ bool FoxBlockedParallel::pre_processing() {
 bool FoxBlockedParallel::run() {
   internal_order_test();
 
-  std::vector<std::thread> threads;
+  // every block of C belongs to one thread, which runs all of Fox's stages on it; thread t of T takes blocks t, t + T,
+  // t + 2T and so on
+  int q = C.BlockRows();
+  int num_threads = std::min(q * q, static_cast<int>(std::max(1u, std::thread::hardware_concurrency())));
+  C.SetZero();
 
-  for (int ii = 0; ii < static_cast<int>(A.size()); ii += block_size) {
-    threads.emplace_back([&, ii]() {
-      for (std::vector<double>::size_type jj = 0; jj < B[0].size();
-           jj += static_cast<std::vector<double>::size_type>(block_size)) {
-        for (std::vector<double>::size_type k = 0; k < A[0].size(); ++k) {
-          for (int i = ii; i < std::min(ii + block_size, static_cast<int>(A.size())); ++i) {
-            for (std::vector<double>::size_type j = jj;
-                 j < std::min(jj + static_cast<std::vector<double>::size_type>(block_size), B[0].size()); ++j) {
-              C[i][j] += A[i][k] * B[k][j];
-            }
-          }
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (int b = t; b < q * q; b += num_threads) {
+        int i = b / q;
+        int j = b % q;
+        for (int stage = 0; stage < q; ++stage) {
+          multiplyBlock(A, B, C, i, j, (i + stage) % q);
         }
       }
     });
@@ -134,13 +136,7 @@ bool FoxBlockedParallel::run() {
 bool FoxBlockedParallel::post_processing() {
   internal_order_test();
 
-  auto* out_ptr = reinterpret_cast<double*>(taskData->outputs[0]);
-
-  for (std::vector<double>::size_type i = 0; i < C.size(); ++i) {
-    for (std::vector<double>::size_type j = 0; j < C[0].size(); ++j) {
-      out_ptr[i * C[0].size() + j] = C[i][j];
-    }
-  }
+  C.ToRowMajor(reinterpret_cast<double*>(taskData->outputs[0]), C.Cols());
 
   return true;
-}
\ No newline at end of file
+}
@@ -5,11 +5,15 @@
 #include <vector>
 
 #include "core/task/include/task.hpp"
+#include "stl/kostin_a_sle_conjugate_gradient/include/precond.hpp"
 
 namespace KostinArtemSTL {
 class ConjugateGradientMethodSTL : public ppc::core::Task {
  public:
-  explicit ConjugateGradientMethodSTL(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+  // with a preconditioner other than None, A is converted to CSR and solved by preconditioned CG
+  explicit ConjugateGradientMethodSTL(std::shared_ptr<ppc::core::TaskData> taskData_,
+                                      PreconditionerKind preconditioner_ = PreconditionerKind::None)
+      : Task(std::move(taskData_)), preconditioner(preconditioner_) {}
   bool pre_processing() override;
   bool validation() override;
   bool run() override;
@@ -20,8 +24,42 @@ class ConjugateGradientMethodSTL : public ppc::core::Task {
   int size = 0;
   std::vector<double> b;
   std::vector<double> x;
+  PreconditionerKind preconditioner;
+  CsrMatrix csr;
 };
 
+// The same solve for a matrix given in CSR: inputs are row_ptr (n + 1 ints), col and val (nnz ints and doubles) and
+// b (n doubles), the output is x. Nothing of size n^2 is stored, so systems of millions of unknowns fit in memory.
+class SparseConjugateGradientMethodSTL : public ppc::core::Task {
+ public:
+  explicit SparseConjugateGradientMethodSTL(std::shared_ptr<ppc::core::TaskData> taskData_,
+                                            PreconditionerKind preconditioner_ = PreconditionerKind::None,
+                                            double tolerance_ = 1e-6)
+      : Task(std::move(taskData_)), preconditioner(preconditioner_), tolerance(tolerance_) {}
+  bool pre_processing() override;
+  bool validation() override;
+  bool run() override;
+  bool post_processing() override;
+  int iterations() const { return result.iterations; }
+
+ private:
+  // views of the input buffers, which outlive the task
+  CsrView A;
+  std::vector<double> b;
+  PreconditionerKind preconditioner;
+  double tolerance;
+  CgResult result;
+};
+
+// CG from x = 0 until the 2-norm of the residual drops below tolerance, in one run of the thread team for the whole
+// solve, passing over the vectors as few times as it can; threads = 0 takes the whole team, more are capped at its
+// size. Only plain CG is fused this way: preconditioned_conjugate_gradient keeps one parallel loop per step, because
+// the triangular sweeps of SSOR and IC(0) run on the team themselves and cannot be nested in a body.
+std::vector<double> conjugate_gradient(const std::vector<double>& A, int n, const std::vector<double>& b,
+                                       double tolerance, int threads = 0);
+CgResult conjugate_gradient(CsrView A, const std::vector<double>& b, double tolerance,
+                            int max_iterations = 100000, int threads = 0);
+
 std::vector<double> generateSPDMatrix(int size, int max_value);
 
 std::vector<double> generatePDVector(int size, int max_value);
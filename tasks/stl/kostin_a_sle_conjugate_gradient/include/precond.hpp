@@ -0,0 +1,99 @@
+// Copyright 2024 Kostin Artem
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "stl/kostin_a_sle_conjugate_gradient/include/spmv.hpp"
+
+namespace KostinArtemSTL {
+// Preconditioner M of a symmetric positive definite matrix, applied as z = M^-1 r once per CG iteration.
+class Preconditioner {
+ public:
+  virtual ~Preconditioner() = default;
+  virtual void apply(const double* r, double* z) const = 0;
+};
+
+// M = I, plain CG.
+class IdentityPreconditioner : public Preconditioner {
+ public:
+  explicit IdentityPreconditioner(CsrView A) : n(A.n) {}
+  void apply(const double* r, double* z) const override;
+
+ private:
+  int n;
+};
+
+// M = diag(A).
+class JacobiPreconditioner : public Preconditioner {
+ public:
+  explicit JacobiPreconditioner(CsrView A);
+  void apply(const double* r, double* z) const override;
+
+ private:
+  std::vector<double> inv_diag;
+};
+
+// Triangular matrix with the off-diagonal part in CSR. Rows are grouped into levels, every row depending only on
+// rows of earlier levels (level scheduling), so that the rows of one level are solved in parallel.
+struct TriangularMatrix {
+  CsrMatrix strict;
+  std::vector<double> diag;
+  bool lower = true;
+  std::vector<int> level_ptr;   // offset of every level in level_rows
+  std::vector<int> level_rows;  // rows sorted by level
+
+  TriangularMatrix() = default;
+  TriangularMatrix(CsrMatrix strict_, std::vector<double> diag_, bool lower_);
+  // x = T^-1 rhs
+  void solve(const double* rhs, double* x) const;
+};
+
+// M = w / (2 - w) (D / w + L) (D / w)^-1 (D / w + L^T), symmetric successive over-relaxation with 0 < w < 2.
+class SsorPreconditioner : public Preconditioner {
+ public:
+  explicit SsorPreconditioner(CsrView A, double omega = 1.0);
+  void apply(const double* r, double* z) const override;
+
+ private:
+  std::vector<double> middle;  // (2 - w) D / w^2
+  TriangularMatrix lower;
+  TriangularMatrix upper;
+  mutable std::vector<double> work;
+};
+
+// M = L L^T, where L keeps the sparsity of the lower triangle of A. Where the factorization breaks down on a
+// non-positive pivot, it is restarted on A + shift * diag(A) with a growing shift.
+class IncompleteCholeskyPreconditioner : public Preconditioner {
+ public:
+  explicit IncompleteCholeskyPreconditioner(CsrView A);
+  void apply(const double* r, double* z) const override;
+  double diagonal_shift() const { return shift; }
+
+ private:
+  double shift = 0.0;
+  TriangularMatrix lower;
+  TriangularMatrix upper;
+  mutable std::vector<double> work;
+};
+
+enum class PreconditionerKind { None, Jacobi, Ssor, IncompleteCholesky };
+
+std::unique_ptr<Preconditioner> make_preconditioner(PreconditionerKind kind, CsrView A);
+
+struct CgResult {
+  std::vector<double> x;
+  int iterations = 0;
+  double residual = 0.0;  // 2-norm of b - A x
+};
+
+// Preconditioned CG from x = 0, until the 2-norm of the residual drops below tolerance. Not fused like
+// conjugate_gradient: the product, the dot products, the updates and M.apply are separate loops on the team.
+CgResult preconditioned_conjugate_gradient(CsrView A, const std::vector<double>& b, const Preconditioner& M,
+                                           double tolerance, int max_iterations = 100000);
+
+// Cell-centred diffusion on a side x side grid with zero Dirichlet boundary: a 5-point SPD matrix whose coefficient
+// is constant on 8 x 8 blocks of cells and log-uniform in [1, contrast], so that the condition number grows with
+// both side^2 and contrast. Contrast 1 gives the Poisson matrix.
+CsrMatrix generate_diffusion_csr(int side, double contrast);
+}  // namespace KostinArtemSTL
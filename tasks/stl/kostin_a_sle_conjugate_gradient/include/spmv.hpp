@@ -0,0 +1,68 @@
+// Copyright 2024 Kostin Artem
+#pragma once
+
+#include <vector>
+
+namespace KostinArtemSTL {
+// Square sparse matrix in compressed sparse rows, columns sorted inside every row.
+struct CsrMatrix {
+  int n = 0;
+  std::vector<int> row_ptr;
+  std::vector<int> col;
+  std::vector<double> val;
+};
+
+// Non-owning view of a CsrMatrix or of CSR arrays owned elsewhere, such as the input buffers of a task.
+struct CsrView {
+  int n = 0;
+  const int* row_ptr = nullptr;
+  const int* col = nullptr;
+  const double* val = nullptr;
+
+  CsrView() = default;
+  CsrView(int n_, const int* row_ptr_, const int* col_, const double* val_)
+      : n(n_), row_ptr(row_ptr_), col(col_), val(val_) {}
+  CsrView(const CsrMatrix& A)  // NOLINT
+      : n(A.n), row_ptr(A.row_ptr.data()), col(A.col.data()), val(A.val.data()) {}
+  int nnz() const { return row_ptr[n]; }
+};
+
+// SELL-C-sigma: rows are sorted by length inside windows of sigma rows and grouped into slices of C rows. A slice is
+// padded to its longest row and stored column by column, so its C rows are multiplied in lockstep, without a test per
+// element. A row is padded with zeros at its own last column: 0 * x[j] is NaN when x[j] is infinite or NaN, but then
+// the row is not finite anyway. An empty row is padded at column 0 and stored as 0 from row_len.
+struct SellMatrix {
+  static constexpr int C = 8;
+  int n = 0;
+  int sigma = 0;
+  std::vector<int> perm;       // perm[s * C + r] is the original index of row r of slice s
+  std::vector<int> slice_ptr;  // offset of every slice in col and val
+  std::vector<int> row_len;    // row_len[s * C + r] is the length of row r of slice s, 0 past the last row
+  std::vector<int> col;
+  std::vector<double> val;
+};
+
+// CSR5-like tiles: the nonzeros are cut into tiles of OMEGA x SIGMA elements, every tile is stored transposed so that
+// its OMEGA lanes advance through consecutive memory, and row boundaries are kept as per-element flags. Work per tile
+// is the same whatever the row lengths are. A short tail of less than one tile is kept in CSR order as a single lane.
+struct Csr5Matrix {
+  static constexpr int OMEGA = 4;
+  static constexpr int SIGMA = 32;
+  int n = 0;
+  int tiles = 0;  // including the tail
+  std::vector<int> col;
+  std::vector<double> val;
+  std::vector<char> row_start;     // 1 where an element opens a row
+  std::vector<int> lane_row;       // per lane: position in nonempty_rows of the row holding its first element
+  std::vector<int> nonempty_rows;  // rows with at least one element, in order
+};
+
+CsrMatrix dense_to_csr(const std::vector<double>& A, int n);
+SellMatrix csr_to_sell(CsrView A, int sigma = 256);
+Csr5Matrix csr_to_csr5(CsrView A);
+
+// y = A * x
+void spmv(CsrView A, const double* x, double* y);
+void spmv(const SellMatrix& A, const double* x, double* y);
+void spmv(const Csr5Matrix& A, const double* x, double* y);
+}  // namespace KostinArtemSTL
@@ -0,0 +1,49 @@
+// Copyright 2024 Kostin Artem
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace KostinArtemSTL {
+// hardware_concurrency() - 1 threads started on first use and kept until the process exits, so that the loops run on
+// every CG iteration (SpMV, dot products, preconditioner sweeps) hand their ranges to waiting threads instead of
+// starting and joining new ones each time.
+class ThreadTeam {
+ public:
+  static ThreadTeam& instance();
+
+  ThreadTeam(const ThreadTeam&) = delete;
+  ThreadTeam& operator=(const ThreadTeam&) = delete;
+  ~ThreadTeam();
+
+  // the calling thread and the team
+  int size() const { return static_cast<int>(workers.size()) + 1; }
+
+  // Calls body(0) on the calling thread and body(1), ..., body(threads - 1) on the team, all at once, and returns
+  // when every call is done; threads must not exceed size(). A run started from inside a body calls the bodies one
+  // after another on its own thread.
+  void run(int threads, const std::function<void(int)>& body);
+  // whether the calling thread is inside a body, where a run would not reach the team; anything that makes threads meet
+  // (a barrier) must then take a sequential path
+  static bool in_team();
+
+ private:
+  explicit ThreadTeam(int threads);
+  void work(int index);
+
+  std::vector<std::thread> workers;
+  std::mutex run_mutex;  // one job at a time
+  std::mutex mutex;
+  std::condition_variable start;
+  std::condition_variable done;
+  const std::function<void(int)>* job = nullptr;
+  int job_threads = 0;
+  int pending = 0;
+  int64_t generation = 0;
+  bool stop = false;
+};
+}  // namespace KostinArtemSTL
@@ -1,11 +1,14 @@
 // Copyright 2024 Kostin Artem
 #include "stl/kostin_a_sle_conjugate_gradient/include/ops_stl.hpp"
 
-#include <future>
+#include <algorithm>
+#include <barrier>
+#include <cmath>
+#include <cstdint>
 #include <random>
-#include <thread>
+#include <stdexcept>
 
-using namespace std::chrono_literals;
+#include "stl/kostin_a_sle_conjugate_gradient/include/team.hpp"
 
 namespace KostinArtemSTL {
 std::vector<double> dense_matrix_vector_multiply(const std::vector<double>& A, int n, const std::vector<double>& x) {
@@ -18,65 +21,130 @@ std::vector<double> dense_matrix_vector_multiply(const std::vector<double>& A, i
   return result;
 }
 
-double dot_product(const std::vector<double>& a, const std::vector<double>& b) {
-  double result = 0.0;
-  for (size_t i = 0; i < a.size(); ++i) {
-    result += a[i] * b[i];
-  }
-  return result;
-}
+namespace {
+// rows of the product per thread below which starting another thread costs more than it saves
+const int MIN_ROWS = 64;
 
-std::vector<double> conjugate_gradient(const std::vector<double>& A, int n, const std::vector<double>& b,
-                                       double tolerance) {
-  std::vector<double> x(n, 0.0);
+// Partial sums of one thread, each on a cache line of its own.
+struct alignas(64) Partial {
+  double pq = 0.0;
+  double rr = 0.0;
+};
+
+// CG from x = 0 in one run of the thread team for the whole solve, with row(i, p) giving row i of A times p. Thread
+// t owns a contiguous block of rows of x, r, p and q = A p and is the only one writing them, so a block stays in the
+// cache of its thread from one iteration to the next. The team meets at a barrier three times per iteration:
+//  1. q = A p and the partial p.q on the own rows, in one pass; every thread then adds the partials up to alpha;
+//  2. x += alpha p, r -= alpha q and the partial r.r, in one pass; every thread adds up r.r and checks it;
+//  3. p = r + beta p, after which p is read whole by the next product.
+// The partials are added in thread order, so all threads get the same alpha and beta and leave at the same iteration.
+// Besides the pass over A, an iteration makes 9 passes over vectors of n: p and q in 1, x, p, q and r (x and r both
+// read and written) in 2, r and p (p read and written) in 3. Nothing is allocated or copied inside the loop.
+template <typename Row>
+CgResult fused_conjugate_gradient(int n, const Row& row, const std::vector<double>& b, double tolerance,
+                                  int max_iterations, int threads) {
+  ThreadTeam& team = ThreadTeam::instance();
+  if (threads <= 0) {
+    threads = team.size();
+  }
+  // inside a team body the bodies would run one after another and never meet at the barrier
+  threads = ThreadTeam::in_team() ? 1 : std::clamp(std::min(n / MIN_ROWS, team.size()), 1, threads);
+  CgResult result;
+  result.x.assign(n, 0.0);
   std::vector<double> r = b;
-  std::vector<double> p = r;
-  std::vector<double> r_prev = b;
-
-  while (true) {
-    // 1st
-    double Ap_dot_p;
-    std::vector<double> Ap;
-    auto update_future = std::async(std::launch::async, [&A, &n, &p, &Ap, &Ap_dot_p] {
-      Ap = dense_matrix_vector_multiply(A, n, p);
-      Ap_dot_p = dot_product(Ap, p);
-    });
-    double r_dot_r = dot_product(r, r);
-    update_future.wait();
-    double alpha = r_dot_r / Ap_dot_p;
-    // end of 1st
-
-    // 2nd
-    auto update_r_future = std::async(std::launch::async, [&r, &r_prev, &Ap, alpha] {
-      for (size_t i = 0; i < r.size(); ++i) {
-        r[i] = r_prev[i] - alpha * Ap[i];
-      }
-    });
-    for (size_t i = 0; i < x.size(); ++i) {
-      x[i] += alpha * p[i];
+  std::vector<double> p = b;
+  std::vector<double> q(n);
+  std::vector<Partial> partial(threads);
+  std::barrier sync(threads);
+
+  auto body = [&](int t) {
+    int begin = static_cast<int>(static_cast<int64_t>(n) * t / threads);
+    int end = static_cast<int>(static_cast<int64_t>(n) * (t + 1) / threads);
+    double* x = result.x.data();
+    double sum = 0.0;
+    for (int i = begin; i < end; i++) {
+      sum += r[i] * r[i];
+    }
+    partial[t].rr = sum;
+    sync.arrive_and_wait();
+    double rr = 0.0;
+    for (const auto& part : partial) {
+      rr += part.rr;
     }
-    update_r_future.wait();
-    // end of 2nd
+    int iterations = 0;
+    while (std::sqrt(rr) >= tolerance && iterations < max_iterations) {
+      sum = 0.0;
+      for (int i = begin; i < end; i++) {
+        q[i] = row(i, p.data());
+        sum += p[i] * q[i];
+      }
+      partial[t].pq = sum;
+      sync.arrive_and_wait();
+      double pq = 0.0;
+      for (const auto& part : partial) {
+        pq += part.pq;
+      }
+      double alpha = rr / pq;
 
-    // 3rd
-    auto r_dot_r_future_2 = std::async(std::launch::async, dot_product, r, r);
-    double r_prev_dot_prev_r = dot_product(r_prev, r_prev);
-    double r_dot_r_2 = r_dot_r_future_2.get();
-    // end of 3rd
+      sum = 0.0;
+      for (int i = begin; i < end; i++) {
+        x[i] += alpha * p[i];
+        r[i] -= alpha * q[i];
+        sum += r[i] * r[i];
+      }
+      partial[t].rr = sum;
+      sync.arrive_and_wait();
+      double rr_next = 0.0;
+      for (const auto& part : partial) {
+        rr_next += part.rr;
+      }
+      iterations++;
+      if (std::sqrt(rr_next) < tolerance) {
+        rr = rr_next;
+        break;
+      }
+      double beta = rr_next / rr;
+      rr = rr_next;
 
-    if (sqrt(r_dot_r_2) < tolerance) {
-      break;
+      for (int i = begin; i < end; i++) {
+        p[i] = r[i] + beta * p[i];
+      }
+      sync.arrive_and_wait();
     }
-    double beta = r_dot_r_2 / r_prev_dot_prev_r;
-
-    for (size_t i = 0; i < p.size(); ++i) {
-      p[i] = r[i] + beta * p[i];
+    if (t == 0) {
+      result.iterations = iterations;
+      result.residual = std::sqrt(rr);
     }
+  };
 
-    r_prev = r;
-  }
+  team.run(threads, body);
+  return result;
+}
+}  // namespace
+
+std::vector<double> conjugate_gradient(const std::vector<double>& A, int n, const std::vector<double>& b,
+                                       double tolerance, int threads) {
+  auto row = [&](int i, const double* p) {
+    const double* a = A.data() + static_cast<size_t>(i) * n;
+    double sum = 0.0;
+    for (int j = 0; j < n; j++) {
+      sum += a[j] * p[j];
+    }
+    return sum;
+  };
+  return fused_conjugate_gradient(n, row, b, tolerance, 100000, threads).x;
+}
 
-  return x;
+CgResult conjugate_gradient(CsrView A, const std::vector<double>& b, double tolerance, int max_iterations,
+                            int threads) {
+  auto row = [&](int i, const double* p) {
+    double sum = 0.0;
+    for (int j = A.row_ptr[i]; j < A.row_ptr[i + 1]; j++) {
+      sum += A.val[j] * p[A.col[j]];
+    }
+    return sum;
+  };
+  return fused_conjugate_gradient(A.n, row, b, tolerance, max_iterations, threads);
 }
 
 std::vector<double> generateSPDMatrix(int size, int max_value) {
@@ -136,6 +204,9 @@ bool ConjugateGradientMethodSTL::pre_processing() {
 
   size = *reinterpret_cast<int*>(taskData->inputs[2]);
   x = std::vector<double>(size, 0);
+  if (preconditioner != PreconditionerKind::None) {
+    csr = dense_to_csr(A, size);
+  }
   return true;
 }
 
@@ -148,7 +219,18 @@ bool ConjugateGradientMethodSTL::validation() {
 
 bool ConjugateGradientMethodSTL::run() {
   internal_order_test();
-  x = conjugate_gradient(A, size, b, 1e-6);
+  if (preconditioner == PreconditionerKind::None) {
+    x = conjugate_gradient(A, size, b, 1e-6);
+  } else {
+    // setup of the preconditioner is part of the solve, as it is part of the time to reach the tolerance
+    // a non-positive diagonal entry makes the preconditioner setup throw: the matrix is not positive definite
+    try {
+      auto M = make_preconditioner(preconditioner, csr);
+      x = preconditioned_conjugate_gradient(csr, b, *M, 1e-6).x;
+    } catch (const std::invalid_argument&) {
+      return false;
+    }
+  }
   return true;
 }
 
@@ -159,4 +241,46 @@ bool ConjugateGradientMethodSTL::post_processing() {
   }
   return true;
 }
+
+bool SparseConjugateGradientMethodSTL::pre_processing() {
+  internal_order_test();
+  int n = static_cast<int>(taskData->inputs_count[3]);
+  A = CsrView(n, reinterpret_cast<int*>(taskData->inputs[0]), reinterpret_cast<int*>(taskData->inputs[1]),
+              reinterpret_cast<double*>(taskData->inputs[2]));
+  b.assign(reinterpret_cast<double*>(taskData->inputs[3]), reinterpret_cast<double*>(taskData->inputs[3]) + n);
+  return true;
+}
+
+bool SparseConjugateGradientMethodSTL::validation() {
+  internal_order_test();
+  if (taskData->inputs.size() != 4 || taskData->inputs_count.size() != 4 || taskData->outputs.size() != 1 ||
+      taskData->outputs_count.size() != 1 || taskData->inputs_count[0] != taskData->inputs_count[3] + 1 ||
+      taskData->inputs_count[1] != taskData->inputs_count[2] ||
+      taskData->outputs_count[0] != taskData->inputs_count[3]) {
+    return false;
+  }
+  const int* row_ptr = reinterpret_cast<int*>(taskData->inputs[0]);
+  return row_ptr[0] == 0 && row_ptr[taskData->inputs_count[3]] == static_cast<int>(taskData->inputs_count[1]);
+}
+
+bool SparseConjugateGradientMethodSTL::run() {
+  internal_order_test();
+  if (preconditioner == PreconditionerKind::None) {
+    result = conjugate_gradient(A, b, tolerance);
+  } else {
+    try {
+      auto M = make_preconditioner(preconditioner, A);
+      result = preconditioned_conjugate_gradient(A, b, *M, tolerance);
+    } catch (const std::invalid_argument&) {
+      return false;
+    }
+  }
+  return result.residual < tolerance;
+}
+
+bool SparseConjugateGradientMethodSTL::post_processing() {
+  internal_order_test();
+  std::copy(result.x.begin(), result.x.end(), reinterpret_cast<double*>(taskData->outputs[0]));
+  return true;
+}
 }  // namespace KostinArtemSTL
@@ -0,0 +1,85 @@
+// Copyright 2024 Kostin Artem
+#include "stl/kostin_a_sle_conjugate_gradient/include/team.hpp"
+
+#include <algorithm>
+
+namespace KostinArtemSTL {
+namespace {
+// set while the thread runs a body, on the team and on the caller alike
+thread_local bool in_body = false;
+}  // namespace
+
+ThreadTeam& ThreadTeam::instance() {
+  static ThreadTeam team(std::max(1, static_cast<int>(std::thread::hardware_concurrency())));
+  return team;
+}
+
+bool ThreadTeam::in_team() { return in_body; }
+
+ThreadTeam::ThreadTeam(int threads) {
+  for (int i = 1; i < threads; i++) {
+    workers.emplace_back([this, i] { work(i); });
+  }
+}
+
+ThreadTeam::~ThreadTeam() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stop = true;
+  }
+  start.notify_all();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
+void ThreadTeam::run(int threads, const std::function<void(int)>& body) {
+  if (threads <= 1 || in_body) {
+    for (int t = 0; t < threads; t++) {
+      body(t);
+    }
+    return;
+  }
+  std::lock_guard<std::mutex> run_lock(run_mutex);
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    job = &body;
+    job_threads = threads;
+    pending = threads - 1;
+    generation++;
+  }
+  start.notify_all();
+  in_body = true;
+  body(0);
+  in_body = false;
+  std::unique_lock<std::mutex> lock(mutex);
+  done.wait(lock, [this] { return pending == 0; });
+  job = nullptr;
+}
+
+void ThreadTeam::work(int index) {
+  int64_t seen = 0;
+  while (true) {
+    const std::function<void(int)>* body;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      start.wait(lock, [&] { return stop || generation != seen; });
+      if (stop) {
+        return;
+      }
+      seen = generation;
+      if (index >= job_threads) {
+        continue;
+      }
+      body = job;
+    }
+    in_body = true;
+    (*body)(index);
+    in_body = false;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (--pending == 0) {
+      done.notify_one();
+    }
+  }
+}
+}  // namespace KostinArtemSTL
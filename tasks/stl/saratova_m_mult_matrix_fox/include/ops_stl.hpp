@@ -7,6 +7,7 @@
 #include <utility>
 #include <vector>
 
+#include "core/gemm/include/tiled.hpp"
 #include "core/task/include/task.hpp"
 
 namespace saratova_stl {
@@ -17,10 +18,9 @@ void FillRandomValues(double *matrix, int size);
 
 class SaratovaTaskSequential : public ppc::core::Task {
  private:
-  size_t dimension{};
-  double *matrixA{nullptr};
-  double *matrixB{nullptr};
-  double *matrixC{nullptr};
+  ppc::core::TiledMatrix matrixA;
+  ppc::core::TiledMatrix matrixB;
+  ppc::core::TiledMatrix matrixC;
 
  public:
   explicit SaratovaTaskSequential(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
@@ -32,10 +32,9 @@ class SaratovaTaskSequential : public ppc::core::Task {
 
 class SaratovaTaskSTL : public ppc::core::Task {
  private:
-  size_t dimension{};
-  double *matrixA{nullptr};
-  double *matrixB{nullptr};
-  double *matrixC{nullptr};
+  ppc::core::TiledMatrix matrixA;
+  ppc::core::TiledMatrix matrixB;
+  ppc::core::TiledMatrix matrixC;
 
  public:
   explicit SaratovaTaskSTL(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
@@ -1,10 +1,22 @@
 // Copyright 2024 Saratova Marina
 #include "stl/saratova_m_mult_matrix_fox/include/ops_stl.hpp"
 
+#include <algorithm>
 #include <cmath>
-#include <cstring>
-#include <iostream>
 #include <random>
+#include <thread>
+#include <vector>
+
+#include "core/gemm/include/blocking.hpp"
+#include "core/gemm/include/gemm.hpp"
+
+namespace {
+void multiplyBlock(const ppc::core::TiledMatrix& A, const ppc::core::TiledMatrix& B, ppc::core::TiledMatrix& C, int i,
+                   int j, int k) {
+  int t = C.Tile();
+  ppc::core::Gemm(t, t, t, A.Block(i, k), t, B.Block(k, j), t, C.Block(i, j), t);
+}
+}  // namespace
 
 void saratova_stl::GenerateIdentityMatrix(double* matrix, int size, double scale) {
   std::fill(matrix, matrix + size * size, 0.0);
@@ -38,35 +50,37 @@ bool saratova_stl::SaratovaTaskSequential::validation() {
 
 bool saratova_stl::SaratovaTaskSequential::pre_processing() {
   internal_order_test();
-  matrixA = reinterpret_cast<double*>(taskData->inputs[0]);
-  matrixB = reinterpret_cast<double*>(taskData->inputs[1]);
-  matrixC = reinterpret_cast<double*>(taskData->outputs[0]);
-  dimension = static_cast<size_t>(std::sqrt(taskData->inputs_count[0]));
-  std::fill(matrixC, matrixC + dimension * dimension, 0.0);
+  int n = static_cast<int>(std::round(std::sqrt(taskData->inputs_count[0])));
+  // blocks are contiguous tiles that Gemm reads in place; edge blocks are padded with zeros, so the block size
+  // measured for this host does not have to divide the matrix size
+  int block = n > 0 ? ppc::core::TuneBlockSize("fox", n, 1) : 1;
+  matrixA = ppc::core::TiledMatrix(n, n, block);
+  matrixB = ppc::core::TiledMatrix(n, n, block);
+  matrixC = ppc::core::TiledMatrix(n, n, block);
+  matrixA.FromRowMajor(reinterpret_cast<double*>(taskData->inputs[0]), n);
+  matrixB.FromRowMajor(reinterpret_cast<double*>(taskData->inputs[1]), n);
   return true;
 }
 
 bool saratova_stl::SaratovaTaskSequential::run() {
   internal_order_test();
-  try {
-    for (size_t i = 0; i < dimension; ++i) {
-      for (size_t j = 0; j < dimension; ++j) {
-        double sum = 0.0;
-        for (size_t k = 0; k < dimension; ++k) {
-          sum += matrixA[i * dimension + k] * matrixB[k * dimension + j];
-        }
-        matrixC[i * dimension + j] = sum;
+  // Fox's stages: at stage s block (i, j) of C adds the product of block (i, (i + s) mod q) of A, broadcast along
+  // block row i, and the matching block of B
+  int q = matrixC.BlockRows();
+  matrixC.SetZero();
+  for (int stage = 0; stage < q; ++stage) {
+    for (int i = 0; i < q; ++i) {
+      for (int j = 0; j < q; ++j) {
+        multiplyBlock(matrixA, matrixB, matrixC, i, j, (i + stage) % q);
       }
     }
-  } catch (const std::exception& ex) {
-    std::cerr << ex.what() << std::endl;
-    return false;
   }
   return true;
 }
 
 bool saratova_stl::SaratovaTaskSequential::post_processing() {
   internal_order_test();
+  matrixC.ToRowMajor(reinterpret_cast<double*>(taskData->outputs[0]), matrixC.Cols());
   return true;
 }
 
@@ -79,53 +93,47 @@ bool saratova_stl::SaratovaTaskSTL::validation() {
 
 bool saratova_stl::SaratovaTaskSTL::pre_processing() {
   internal_order_test();
-  matrixA = reinterpret_cast<double*>(taskData->inputs[0]);
-  matrixB = reinterpret_cast<double*>(taskData->inputs[1]);
-  matrixC = reinterpret_cast<double*>(taskData->outputs[0]);
-  dimension = static_cast<size_t>(std::sqrt(taskData->inputs_count[0]));
-  std::fill(matrixC, matrixC + dimension * dimension, 0.0);
+  int n = static_cast<int>(std::round(std::sqrt(taskData->inputs_count[0])));
+  // blocks are contiguous tiles that Gemm reads in place; edge blocks are padded with zeros, so the block size
+  // measured for this host does not have to divide the matrix size
+  int threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+  int block = n > 0 ? ppc::core::TuneBlockSize("fox", n, threads) : 1;
+  matrixA = ppc::core::TiledMatrix(n, n, block);
+  matrixB = ppc::core::TiledMatrix(n, n, block);
+  matrixC = ppc::core::TiledMatrix(n, n, block);
+  matrixA.FromRowMajor(reinterpret_cast<double*>(taskData->inputs[0]), n);
+  matrixB.FromRowMajor(reinterpret_cast<double*>(taskData->inputs[1]), n);
   return true;
 }
 
 bool saratova_stl::SaratovaTaskSTL::run() {
   internal_order_test();
-  try {
-    unsigned int num_threads = std::thread::hardware_concurrency();
-    std::vector<std::thread> threads;
+  // every block of C belongs to one thread, which runs all of Fox's stages on it; thread t of T takes blocks t, t + T,
+  // t + 2T and so on
+  int q = matrixC.BlockRows();
+  int num_threads = std::min(q * q, static_cast<int>(std::max(1u, std::thread::hardware_concurrency())));
+  matrixC.SetZero();
 
-    auto compute_partial_matrix = [&](size_t start_row, size_t end_row) {
-      for (size_t i = start_row; i < end_row; ++i) {
-        for (size_t j = 0; j < dimension; ++j) {
-          double sum = 0.0;
-          for (size_t k = 0; k < dimension; ++k) {
-            sum += matrixA[i * dimension + k] * matrixB[k * dimension + j];
-          }
-          matrixC[i * dimension + j] = sum;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (int blk = t; blk < q * q; blk += num_threads) {
+        int i = blk / q;
+        int j = blk % q;
+        for (int stage = 0; stage < q; ++stage) {
+          multiplyBlock(matrixA, matrixB, matrixC, i, j, (i + stage) % q);
         }
       }
-    };
-
-    size_t rows_per_thread = dimension / num_threads;
-    size_t start_row = 0;
-    size_t end_row = 0;
-    for (unsigned int i = 0; i < num_threads - 1; ++i) {
-      end_row = start_row + rows_per_thread;
-      threads.emplace_back(compute_partial_matrix, start_row, end_row);
-      start_row = end_row;
-    }
-    threads.emplace_back(compute_partial_matrix, start_row, dimension);
-
-    for (auto& thread : threads) {
-      thread.join();
-    }
-  } catch (const std::exception& ex) {
-    std::cerr << ex.what() << std::endl;
-    return false;
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
   }
   return true;
 }
 
 bool saratova_stl::SaratovaTaskSTL::post_processing() {
   internal_order_test();
+  matrixC.ToRowMajor(reinterpret_cast<double*>(taskData->outputs[0]), matrixC.Cols());
   return true;
 }
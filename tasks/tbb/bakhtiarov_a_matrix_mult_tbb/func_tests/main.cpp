@@ -5,6 +5,42 @@
 
 #include "tbb/bakhtiarov_a_matrix_mult_tbb/include/ccs_matrix_mult.hpp"
 
+namespace {
+BakhtiarovTbb::MatrixCCS toCCS(const std::vector<double> &matrix, int numRows, int numCols) {
+  BakhtiarovTbb::MatrixCCS ccs;
+  ccs.numRows = numRows;
+  ccs.numCols = numCols;
+  ccs.colPtr.push_back(0);
+  for (int j = 0; j < numCols; ++j) {
+    for (int i = 0; i < numRows; ++i) {
+      const double &value = matrix[i * numCols + j];
+      if (value != 0) {
+        ccs.values.push_back(value);
+        ccs.rows.push_back(i);
+      }
+    }
+    ccs.colPtr.push_back(ccs.values.size());
+  }
+  return ccs;
+}
+
+void expectDense(const BakhtiarovTbb::MatrixCCS &ccs, const std::vector<double> &expected) {
+  std::vector<double> matrix(ccs.numRows * ccs.numCols, 0.0);
+  for (int j = 0; j < ccs.numCols; ++j) {
+    for (int k = ccs.colPtr[j]; k < ccs.colPtr[j + 1]; ++k) {
+      if (k > ccs.colPtr[j]) {
+        EXPECT_LT(ccs.rows[k - 1], ccs.rows[k]);
+      }
+      matrix[ccs.rows[k] * ccs.numCols + j] = ccs.values[k];
+    }
+  }
+  ASSERT_EQ(matrix.size(), expected.size());
+  for (size_t i = 0; i < matrix.size(); ++i) {
+    EXPECT_DOUBLE_EQ(matrix[i], expected[i]);
+  }
+}
+}  // namespace
+
 TEST(bakhtiarov_a_matrix_mult_tbb, test_size) {
   size_t n1 = 4;
   size_t m1 = 5;
@@ -199,3 +235,77 @@ TEST(bakhtiarov_a_matrix_mult_tbb, zero_matrix) {
 
   ASSERT_EQ(k, n1 * m2);
 }
+
+TEST(bakhtiarov_a_matrix_mult_tbb, ccs_input_sizes_incorrect) {
+  // Create data
+  BakhtiarovTbb::MatrixCCS in1 = toCCS(std::vector<double>(4 * 5, 0.0), 4, 5);
+  BakhtiarovTbb::MatrixCCS in2 = toCCS(std::vector<double>(3 * 4, 0.0), 3, 4);
+  BakhtiarovTbb::MatrixCCS out;
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataParallel = std::make_shared<ppc::core::TaskData>();
+  taskDataParallel->inputs.emplace_back(reinterpret_cast<uint8_t *>(&in1));
+  taskDataParallel->inputs_count.emplace_back(4);
+  taskDataParallel->inputs_count.emplace_back(5);
+  taskDataParallel->inputs.emplace_back(reinterpret_cast<uint8_t *>(&in2));
+  taskDataParallel->inputs_count.emplace_back(3);
+  taskDataParallel->inputs_count.emplace_back(4);
+  taskDataParallel->outputs.emplace_back(reinterpret_cast<uint8_t *>(&out));
+
+  // Create Task
+  BakhtiarovTbb::SparseMatrixMultiCCS sparseMatrixMultiCCS(taskDataParallel);
+  ASSERT_FALSE(sparseMatrixMultiCCS.validation());
+}
+
+TEST(bakhtiarov_a_matrix_mult_tbb, ccs_input_multy) {
+  // Create data
+  BakhtiarovTbb::MatrixCCS in1 = toCCS({5, 0, 0, 0, 0, 0, 5, 0, 0, 1, 0, 0, 8, 0, 6, 0}, 4, 4);
+  BakhtiarovTbb::MatrixCCS in2 = toCCS({5, 0, 0, 8, 0, 0, 1, 0, 0, 5, 0, 6, 0, 0, 0, 0}, 4, 4);
+  BakhtiarovTbb::MatrixCCS out;
+  std::vector<double> test{25, 0, 0, 40, 0, 25, 0, 30, 0, 0, 1, 0, 40, 30, 0, 100};
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataParallel = std::make_shared<ppc::core::TaskData>();
+  taskDataParallel->inputs.emplace_back(reinterpret_cast<uint8_t *>(&in1));
+  taskDataParallel->inputs_count.emplace_back(4);
+  taskDataParallel->inputs_count.emplace_back(4);
+  taskDataParallel->inputs.emplace_back(reinterpret_cast<uint8_t *>(&in2));
+  taskDataParallel->inputs_count.emplace_back(4);
+  taskDataParallel->inputs_count.emplace_back(4);
+  taskDataParallel->outputs.emplace_back(reinterpret_cast<uint8_t *>(&out));
+
+  // Create Task
+  BakhtiarovTbb::SparseMatrixMultiCCS sparseMatrixMultiCCS(taskDataParallel);
+  ASSERT_TRUE(sparseMatrixMultiCCS.validation());
+  ASSERT_TRUE(sparseMatrixMultiCCS.pre_processing());
+  ASSERT_TRUE(sparseMatrixMultiCCS.run());
+  ASSERT_TRUE(sparseMatrixMultiCCS.post_processing());
+  expectDense(out, test);
+}
+
+TEST(bakhtiarov_a_matrix_mult_tbb, ccs_input_keeps_cancelled_products) {
+  // Create data
+  BakhtiarovTbb::MatrixCCS in1 = toCCS({1, 1, 0, 2}, 2, 2);
+  BakhtiarovTbb::MatrixCCS in2 = toCCS({1, 3, -1, 0}, 2, 2);
+  BakhtiarovTbb::MatrixCCS out;
+  std::vector<double> test{0, 3, -2, 0};
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataParallel = std::make_shared<ppc::core::TaskData>();
+  taskDataParallel->inputs.emplace_back(reinterpret_cast<uint8_t *>(&in1));
+  taskDataParallel->inputs_count.emplace_back(2);
+  taskDataParallel->inputs_count.emplace_back(2);
+  taskDataParallel->inputs.emplace_back(reinterpret_cast<uint8_t *>(&in2));
+  taskDataParallel->inputs_count.emplace_back(2);
+  taskDataParallel->inputs_count.emplace_back(2);
+  taskDataParallel->outputs.emplace_back(reinterpret_cast<uint8_t *>(&out));
+
+  // Create Task
+  BakhtiarovTbb::SparseMatrixMultiCCS sparseMatrixMultiCCS(taskDataParallel);
+  ASSERT_TRUE(sparseMatrixMultiCCS.validation());
+  ASSERT_TRUE(sparseMatrixMultiCCS.pre_processing());
+  ASSERT_TRUE(sparseMatrixMultiCCS.run());
+  ASSERT_TRUE(sparseMatrixMultiCCS.post_processing());
+  ASSERT_EQ(out.colPtr, std::vector<int>({0, 2, 3}));
+  expectDense(out, test);
+}
@@ -209,4 +209,48 @@ TEST(FoxBlockedParallel, MatrixMultiplicationWithNegatives) {
 
   // Free memory
   delete[] output;
-}
\ No newline at end of file
+}
+
+TEST(FoxBlockedParallel, MatrixMultiplication_SeveralBlocks) {
+  // Define input matrices larger than a block and not a multiple of it
+  const int n = 150;
+  std::vector<double> matrixA(n * n);
+  std::vector<double> matrixB(n * n);
+  for (int i = 0; i < n * n; ++i) {
+    matrixA[i] = i % 7 - 3;
+    matrixB[i] = i % 5 - 2;
+  }
+  std::vector<double> expectedOutput(n * n, 0.0);
+  for (int i = 0; i < n; ++i) {
+    for (int k = 0; k < n; ++k) {
+      for (int j = 0; j < n; ++j) {
+        expectedOutput[i * n + j] += matrixA[i * n + k] * matrixB[k * n + j];
+      }
+    }
+  }
+  std::vector<double> output(n * n);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(matrixA.data()));
+  taskData->inputs_count.emplace_back(n);
+  taskData->inputs_count.emplace_back(n);
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(matrixB.data()));
+  taskData->inputs_count.emplace_back(n);
+  taskData->inputs_count.emplace_back(n);
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(output.data()));
+  taskData->outputs_count.emplace_back(n);
+  taskData->outputs_count.emplace_back(n);
+
+  // Create Task
+  FoxBlockedParallel foxBlockedParallel(taskData);
+  ASSERT_TRUE(foxBlockedParallel.validation());
+  ASSERT_TRUE(foxBlockedParallel.pre_processing());
+  ASSERT_TRUE(foxBlockedParallel.run());
+  ASSERT_TRUE(foxBlockedParallel.post_processing());
+
+  // Check the output
+  for (int i = 0; i < n * n; ++i) {
+    ASSERT_DOUBLE_EQ(output[i], expectedOutput[i]);
+  }
+}
@@ -3,10 +3,21 @@
 
 #include <tbb/blocked_range2d.h>
 #include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
+#include "core/gemm/include/blocking.hpp"
+#include "core/gemm/include/gemm.hpp"
 
 using BelanTBB::FoxBlockedParallel;
 using BelanTBB::FoxBlockedSequential;
-using BelanTBB::Matrix;
+
+namespace {
+void multiplyBlock(const ppc::core::TiledMatrix& A, const ppc::core::TiledMatrix& B, ppc::core::TiledMatrix& C, int i,
+                   int j, int k) {
+  int t = C.Tile();
+  ppc::core::Gemm(t, t, t, A.Block(i, k), t, B.Block(k, j), t, C.Block(i, j), t);
+}
+}  // namespace
 
 bool FoxBlockedSequential::validation() {
   internal_order_test();
@@ -24,18 +35,15 @@ bool FoxBlockedSequential::pre_processing() {
   int rows = taskData->inputs_count[0];
   int cols = taskData->inputs_count[1];
 
-  block_size = 32;
+  // blocks are contiguous tiles that Gemm reads in place; edge blocks are padded with zeros, so the block size
+  // measured for this host does not have to divide the matrix size
+  block_size = ppc::core::TuneBlockSize("fox", rows, 1);
 
-  A.resize(rows, std::vector<double>(cols));
-  B.resize(rows, std::vector<double>(cols));
-  C.resize(rows, std::vector<double>(cols));
-
-  for (int i = 0; i < rows; ++i) {
-    for (int j = 0; j < cols; ++j) {
-      A[i][j] = matrixA[i * cols + j];
-      B[i][j] = matrixB[i * cols + j];
-    }
-  }
+  A = ppc::core::TiledMatrix(rows, cols, block_size);
+  B = ppc::core::TiledMatrix(rows, cols, block_size);
+  C = ppc::core::TiledMatrix(rows, cols, block_size);
+  A.FromRowMajor(matrixA, cols);
+  B.FromRowMajor(matrixB, cols);
 
   return true;
 }
@@ -43,16 +51,14 @@ bool FoxBlockedSequential::pre_processing() {
 bool FoxBlockedSequential::run() {
   internal_order_test();
 
-  for (std::vector<double>::size_type i = 0; i < A.size(); i += block_size) {
-    for (std::vector<double>::size_type j = 0; j < B[0].size(); j += block_size) {
-      for (std::vector<double>::size_type k = 0; k < A[0].size(); ++k) {
-        for (std::vector<double>::size_type ii = i;
-             ii < std::min(i + static_cast<std::vector<double>::size_type>(block_size), A.size()); ++ii) {
-          for (std::vector<double>::size_type jj = j;
-               jj < std::min(j + static_cast<std::vector<double>::size_type>(block_size), B[0].size()); ++jj) {
-            C[ii][jj] += A[ii][k] * B[k][jj];
-          }
-        }
+  // Fox's stages: at stage s block (i, j) of C adds the product of block (i, (i + s) mod q) of A, broadcast along
+  // block row i, and the matching block of B
+  int q = C.BlockRows();
+  C.SetZero();
+  for (int stage = 0; stage < q; ++stage) {
+    for (int i = 0; i < q; ++i) {
+      for (int j = 0; j < q; ++j) {
+        multiplyBlock(A, B, C, i, j, (i + stage) % q);
       }
     }
   }
@@ -63,13 +69,7 @@ bool FoxBlockedSequential::run() {
 bool FoxBlockedSequential::post_processing() {
   internal_order_test();
 
-  auto* out_ptr = reinterpret_cast<double*>(taskData->outputs[0]);
-
-  for (std::vector<double>::size_type i = 0; i < C.size(); ++i) {
-    for (std::vector<double>::size_type j = 0; j < C[0].size(); ++j) {
-      out_ptr[i * C[0].size() + j] = C[i][j];
-    }
-  }
+  C.ToRowMajor(reinterpret_cast<double*>(taskData->outputs[0]), C.Cols());
 
   return true;
 }
@@ -90,18 +90,15 @@ bool FoxBlockedParallel::pre_processing() {
   int rows = taskData->inputs_count[0];
   int cols = taskData->inputs_count[1];
 
-  block_size = 32;
+  // blocks are contiguous tiles that Gemm reads in place; edge blocks are padded with zeros, so the block size
+  // measured for this host does not have to divide the matrix size
+  block_size = ppc::core::TuneBlockSize("fox", rows, tbb::this_task_arena::max_concurrency());
 
-  A.resize(rows, std::vector<double>(cols));
-  B.resize(rows, std::vector<double>(cols));
-  C.resize(rows, std::vector<double>(cols));
-
-  for (int i = 0; i < rows; ++i) {
-    for (int j = 0; j < cols; ++j) {
-      A[i][j] = matrixA[i * cols + j];
-      B[i][j] = matrixB[i * cols + j];
-    }
-  }
+  A = ppc::core::TiledMatrix(rows, cols, block_size);
+  B = ppc::core::TiledMatrix(rows, cols, block_size);
+  C = ppc::core::TiledMatrix(rows, cols, block_size);
+  A.FromRowMajor(matrixA, cols);
+  B.FromRowMajor(matrixB, cols);
 
   return true;
 }
@@ -109,16 +106,18 @@ bool FoxBlockedParallel::pre_processing() {
 bool FoxBlockedParallel::run() {
   internal_order_test();
 
-  tbb::parallel_for(tbb::blocked_range2d<int>(0, A.size(), block_size, 0, B[0].size(), block_size),
-                    [&](const tbb::blocked_range2d<int>& r) {
-                      for (int ii = r.rows().begin(); ii < r.rows().end(); ++ii) {
-                        for (int jj = r.cols().begin(); jj < r.cols().end(); ++jj) {
-                          for (std::vector<double>::size_type k = 0; k < A[0].size(); ++k) {
-                            C[ii][jj] += A[ii][k] * B[k][jj];
-                          }
-                        }
-                      }
-                    });
+  // every block of C belongs to one task, which runs all of Fox's stages on it
+  int q = C.BlockRows();
+  C.SetZero();
+  tbb::parallel_for(tbb::blocked_range2d<int>(0, q, 0, q), [&](const tbb::blocked_range2d<int>& r) {
+    for (int i = r.rows().begin(); i < r.rows().end(); ++i) {
+      for (int j = r.cols().begin(); j < r.cols().end(); ++j) {
+        for (int stage = 0; stage < q; ++stage) {
+          multiplyBlock(A, B, C, i, j, (i + stage) % q);
+        }
+      }
+    }
+  });
 
   return true;
 }
@@ -126,13 +125,7 @@ bool FoxBlockedParallel::run() {
 bool FoxBlockedParallel::post_processing() {
   internal_order_test();
 
-  auto* out_ptr = reinterpret_cast<double*>(taskData->outputs[0]);
-
-  for (std::vector<double>::size_type i = 0; i < C.size(); ++i) {
-    for (std::vector<double>::size_type j = 0; j < C[0].size(); ++j) {
-      out_ptr[i * C[0].size() + j] = C[i][j];
-    }
-  }
+  C.ToRowMajor(reinterpret_cast<double*>(taskData->outputs[0]), C.Cols());
 
   return true;
 }
@@ -202,3 +202,107 @@ TEST(dostavalov_s_sop_gradient_tbb, Test_Rand_0) {
 
   ASSERT_TRUE(check_solution(matrix, vector, result));
 }  // namespace dostavalov_s_tbb
+
+std::shared_ptr<ppc::core::TaskData> createCsrTaskData(CsrMatrix &matrix, std::vector<double> &vector,
+                                                       std::vector<double> &result) {
+  std::shared_ptr<ppc::core::TaskData> taskDataTbb = std::make_shared<ppc::core::TaskData>();
+
+  taskDataTbb->inputs.emplace_back(reinterpret_cast<uint8_t *>(matrix.row_ptr.data()));
+  taskDataTbb->inputs_count.emplace_back(matrix.row_ptr.size());
+
+  taskDataTbb->inputs.emplace_back(reinterpret_cast<uint8_t *>(matrix.cols.data()));
+  taskDataTbb->inputs_count.emplace_back(matrix.cols.size());
+
+  taskDataTbb->inputs.emplace_back(reinterpret_cast<uint8_t *>(matrix.vals.data()));
+  taskDataTbb->inputs_count.emplace_back(matrix.vals.size());
+
+  taskDataTbb->inputs.emplace_back(reinterpret_cast<uint8_t *>(vector.data()));
+  taskDataTbb->inputs_count.emplace_back(vector.size());
+
+  taskDataTbb->outputs.emplace_back(reinterpret_cast<uint8_t *>(result.data()));
+  taskDataTbb->outputs_count.emplace_back(result.size());
+
+  return taskDataTbb;
+}
+
+TEST(dostavalov_s_sop_gradient_tbb, Test_Csr_Size_4) {
+  CsrMatrix matrix{{0, 2, 5, 8, 10}, {0, 1, 0, 1, 2, 1, 2, 3, 2, 3}, {2, -1, -1, 2, -1, -1, 2, -1, -1, 2}};
+  std::vector<double> vector = {1, 2, 3, 4};
+
+  std::vector<double> result(vector.size(), 0.0);
+  std::vector<double> true_result = {4, 7, 8, 6};
+
+  std::shared_ptr<ppc::core::TaskData> taskDataTbb = createCsrTaskData(matrix, vector, result);
+
+  TbbSLAYGradientCsr testTaskTbb(taskDataTbb);
+
+  ASSERT_TRUE(testTaskTbb.validation());
+  ASSERT_TRUE(testTaskTbb.pre_processing());
+  ASSERT_TRUE(testTaskTbb.run());
+  ASSERT_TRUE(testTaskTbb.post_processing());
+
+  for (size_t i = 0; i < result.size(); ++i) {
+    ASSERT_NEAR(result[i], true_result[i], TOLERANCE);
+  }
+}
+
+TEST(dostavalov_s_sop_gradient_tbb, Test_Csr_Poisson_30) {
+  CsrMatrix matrix = poissonMatrix(30);
+  std::vector<double> vector = randVector(30 * 30);
+
+  std::vector<double> result(vector.size(), 0.0);
+
+  std::shared_ptr<ppc::core::TaskData> taskDataTbb = createCsrTaskData(matrix, vector, result);
+
+  TbbSLAYGradientCsr testTaskTbb(taskDataTbb);
+
+  ASSERT_TRUE(testTaskTbb.validation());
+  ASSERT_TRUE(testTaskTbb.pre_processing());
+  ASSERT_TRUE(testTaskTbb.run());
+  ASSERT_TRUE(testTaskTbb.post_processing());
+
+  ASSERT_TRUE(check_solution(matrix, vector, result));
+}
+
+TEST(dostavalov_s_sop_gradient_tbb, Test_Csr_Wrong_Size) {
+  CsrMatrix matrix = poissonMatrix(3);
+  std::vector<double> vector(8, 1.0);
+
+  std::vector<double> result(vector.size(), 0.0);
+
+  std::shared_ptr<ppc::core::TaskData> taskDataTbb = createCsrTaskData(matrix, vector, result);
+
+  TbbSLAYGradientCsr testTaskTbb(taskDataTbb);
+
+  ASSERT_FALSE(testTaskTbb.validation());
+}
+
+TEST(dostavalov_s_sop_gradient_tbb, Test_Csr_Without_Output_Count) {
+  CsrMatrix matrix = poissonMatrix(3);
+  std::vector<double> vector(9, 1.0);
+
+  std::vector<double> result(vector.size(), 0.0);
+
+  std::shared_ptr<ppc::core::TaskData> taskDataTbb = createCsrTaskData(matrix, vector, result);
+  taskDataTbb->outputs_count.clear();
+
+  TbbSLAYGradientCsr testTaskTbb(taskDataTbb);
+
+  ASSERT_FALSE(testTaskTbb.validation());
+}
+
+TEST(dostavalov_s_sop_gradient_tbb, Test_Csr_Not_Positive_Definite) {
+  // the residual turns into NaN and never drops below the tolerance
+  CsrMatrix matrix{{0, 1, 2}, {0, 1}, {1, -1}};
+  std::vector<double> vector = {1, 1};
+
+  std::vector<double> result(vector.size(), 0.0);
+
+  std::shared_ptr<ppc::core::TaskData> taskDataTbb = createCsrTaskData(matrix, vector, result);
+
+  TbbSLAYGradientCsr testTaskTbb(taskDataTbb);
+
+  ASSERT_TRUE(testTaskTbb.validation());
+  ASSERT_TRUE(testTaskTbb.pre_processing());
+  ASSERT_FALSE(testTaskTbb.run());
+}
@@ -7,13 +7,26 @@
 
 namespace dostavalov_s_tbb {
 const double TOLERANCE = 0.0001;
+const int MAX_ITERATIONS = 100000;
 const double MIN_VALUE = 0.0;
 const double MAX_VALUE = 50.0;
 
 std::vector<double> randVector(int size);
 std::vector<double> randMatrix(int size);
+
+// Square matrix in compressed sparse rows.
+struct CsrMatrix {
+  std::vector<int> row_ptr;
+  std::vector<int> cols;
+  std::vector<double> vals;
+};
+
+// 5-point Laplacian on a side x side grid
+CsrMatrix poissonMatrix(int side);
 bool check_solution(const std::vector<double>& matrixA, const std::vector<double>& vectorB,
                     const std::vector<double>& solutionC);
+bool check_solution(const CsrMatrix& matrixA, const std::vector<double>& vectorB,
+                    const std::vector<double>& solutionC);
 
 class TbbSLAYGradient : public ppc::core::Task {
  public:
@@ -33,4 +46,20 @@ class TbbSLAYGradient : public ppc::core::Task {
   std::vector<double> matrix, vector, answer;
 };
 
+// The same method for a sparse matrix: inputs are row_ptr (n + 1 ints), cols and vals (one int and one double per
+// nonzero) and the right-hand side, so that no n x n array is stored.
+class TbbSLAYGradientCsr : public ppc::core::Task {
+ public:
+  explicit TbbSLAYGradientCsr(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+
+  bool pre_processing() override;
+  bool validation() override;
+  bool run() override;
+  bool post_processing() override;
+
+ private:
+  CsrMatrix matrix;
+  std::vector<double> vector, answer;
+};
+
 }  // namespace dostavalov_s_tbb
@@ -8,6 +8,8 @@
 
 using namespace dostavalov_s_tbb;
 const int SIZE = 300;
+// side of the grid of the sparse system, 40000 unknowns
+const int SIDE = 200;
 
 std::shared_ptr<ppc::core::TaskData> createTaskData(std::vector<double> &matrix, std::vector<double> &vector,
                                                     std::vector<double> &result) {
@@ -77,4 +79,44 @@ TEST(dostavalov_s_sop_gradient_omp, test_task_run) {
   perfAnalyzer->task_run(perfAttr, perfResults);
   ppc::core::Perf::print_perf_statistic(perfResults);
   ASSERT_TRUE(check_solution(matrix, vector, result));
-}  // namespace dostavalov_s_tbb
\ No newline at end of file
+}  // namespace dostavalov_s_tbb
+std::shared_ptr<ppc::core::TaskData> createCsrTaskData(CsrMatrix &matrix, std::vector<double> &vector,
+                                                       std::vector<double> &result) {
+  std::shared_ptr<ppc::core::TaskData> taskDataTbb = std::make_shared<ppc::core::TaskData>();
+
+  taskDataTbb->inputs.emplace_back(reinterpret_cast<uint8_t *>(matrix.row_ptr.data()));
+  taskDataTbb->inputs_count.emplace_back(matrix.row_ptr.size());
+
+  taskDataTbb->inputs.emplace_back(reinterpret_cast<uint8_t *>(matrix.cols.data()));
+  taskDataTbb->inputs_count.emplace_back(matrix.cols.size());
+
+  taskDataTbb->inputs.emplace_back(reinterpret_cast<uint8_t *>(matrix.vals.data()));
+  taskDataTbb->inputs_count.emplace_back(matrix.vals.size());
+
+  taskDataTbb->inputs.emplace_back(reinterpret_cast<uint8_t *>(vector.data()));
+  taskDataTbb->inputs_count.emplace_back(vector.size());
+
+  taskDataTbb->outputs.emplace_back(reinterpret_cast<uint8_t *>(result.data()));
+  taskDataTbb->outputs_count.emplace_back(result.size());
+
+  return taskDataTbb;
+}
+
+TEST(dostavalov_s_sop_gradient_omp, test_task_run_csr) {
+  CsrMatrix matrix = poissonMatrix(SIDE);
+  std::vector<double> vector = randVector(SIDE * SIDE);
+  std::vector<double> result(vector.size());
+
+  std::shared_ptr<ppc::core::TaskData> taskDataTbb = createCsrTaskData(matrix, vector, result);
+
+  auto testTaskTbb = std::make_shared<TbbSLAYGradientCsr>(taskDataTbb);
+
+  auto perfAttr = start_performance_timer();
+
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  auto perfAnalyzer = std::make_shared<ppc::core::Perf>(testTaskTbb);
+  perfAnalyzer->task_run(perfAttr, perfResults);
+  ppc::core::Perf::print_perf_statistic(perfResults);
+  ASSERT_TRUE(check_solution(matrix, vector, result));
+}
@@ -4,6 +4,7 @@
 
 #include <tbb/tbb.h>
 
+#include <algorithm>
 #include <atomic>
 #include <cmath>
 #include <random>
@@ -46,6 +47,39 @@ std::vector<double> randMatrix(int size) {
   return random_matrix;
 }
 
+CsrMatrix poissonMatrix(int side) {
+  CsrMatrix matrix;
+  int size = side * side;
+  matrix.row_ptr.reserve(size + 1);
+  matrix.cols.reserve(5 * size);
+  matrix.vals.reserve(5 * size);
+  matrix.row_ptr.push_back(0);
+  for (int i = 0; i < size; ++i) {
+    // neighbours in column order; the left and right ones only within the same grid row
+    for (int j : {i - side, i - 1, i, i + 1, i + side}) {
+      if (j >= 0 && j < size && (j / side == i / side || j % side == i % side)) {
+        matrix.cols.push_back(j);
+        matrix.vals.push_back(j == i ? 4.0 : -1.0);
+      }
+    }
+    matrix.row_ptr.push_back(static_cast<int>(matrix.cols.size()));
+  }
+  return matrix;
+}
+
+void csrMultiply(const CsrMatrix& matrix, const std::vector<double>& x, std::vector<double>& y) {
+  long size = static_cast<long>(matrix.row_ptr.size()) - 1;
+  tbb::parallel_for(tbb::blocked_range<long>(0, size), [&](const tbb::blocked_range<long>& range) {
+    for (long i = range.begin(); i != range.end(); ++i) {
+      double sum = 0.0;
+      for (int j = matrix.row_ptr[i]; j < matrix.row_ptr[i + 1]; ++j) {
+        sum += matrix.vals[j] * x[matrix.cols[j]];
+      }
+      y[i] += sum;
+    }
+  });
+}
+
 std::atomic<double>& operator+=(std::atomic<double>& atomic_value, double value) {
   double current_value = atomic_value.load();
   while (!atomic_value.compare_exchange_weak(current_value, current_value + value))
@@ -85,51 +119,62 @@ bool TbbSLAYGradient::validation() {
   return true;
 }
 
-bool TbbSLAYGradient::run() {
-  internal_order_test();
-
+// the method needs the matrix only through multiply(direction, A_Dir), which adds A * direction to A_Dir; false when
+// the residual is still above TOLERANCE after MAX_ITERATIONS steps, e.g. for a matrix that is not positive definite
+template <typename Multiply>
+bool gradientSolve(const Multiply& multiply, const std::vector<double>& vector, std::vector<double>& result) {
   long size = vector.size();
-  std::vector<double> result(size, 0.0);
+  result.assign(size, 0.0);
   std::vector<double> residual = vector;
   std::vector<double> direction = residual;
   std::vector<double> prev_residual = vector;
 
-  double* matrix_ptr = matrix.data();
-
-  while (true) {
+  for (int iteration = 0; iteration < MAX_ITERATIONS; iteration++) {
     std::vector<double> A_Dir(size, 0.0);
 
-    tbb::parallel_for(tbb::blocked_range<long>(0, size), [&](const tbb::blocked_range<long>& range) {
-      for (long i = range.begin(); i != range.end(); ++i) {
-        for (long j = 0; j < size; ++j) {
-          A_Dir[i] += matrix_ptr[i * size + j] * direction[j];
-        }
-      }
-    });
+    multiply(direction, A_Dir);
 
-    double residual_dot_residual = computeDotProduct(residual, residual);
-    double A_Dir_dot_direction = computeDotProduct(A_Dir, direction);
+    double residual_dot_residual = TbbSLAYGradient::computeDotProduct(residual, residual);
+    double A_Dir_dot_direction = TbbSLAYGradient::computeDotProduct(A_Dir, direction);
     double alpha = residual_dot_residual / A_Dir_dot_direction;
 
-    updateResult(result, direction, alpha);
+    TbbSLAYGradient::updateResult(result, direction, alpha);
 
-    updateResidual(residual, prev_residual, A_Dir, alpha);
+    TbbSLAYGradient::updateResidual(residual, prev_residual, A_Dir, alpha);
 
-    double new_residual = computeDotProduct(residual, residual);
+    double new_residual = TbbSLAYGradient::computeDotProduct(residual, residual);
 
     if (sqrt(new_residual) < TOLERANCE) {
-      break;
+      return true;
     }
 
     double beta = new_residual / residual_dot_residual;
 
-    updateDirection(direction, residual, beta);
+    TbbSLAYGradient::updateDirection(direction, residual, beta);
 
     prev_residual = residual;
   }
 
-  answer = result;
-  return true;
+  return false;
+}
+
+bool TbbSLAYGradient::run() {
+  internal_order_test();
+
+  long size = vector.size();
+  double* matrix_ptr = matrix.data();
+
+  return gradientSolve(
+      [&](const std::vector<double>& direction, std::vector<double>& A_Dir) {
+        tbb::parallel_for(tbb::blocked_range<long>(0, size), [&](const tbb::blocked_range<long>& range) {
+          for (long i = range.begin(); i != range.end(); ++i) {
+            for (long j = 0; j < size; ++j) {
+              A_Dir[i] += matrix_ptr[i * size + j] * direction[j];
+            }
+          }
+        });
+      },
+      vector, answer);
 }
 
 double TbbSLAYGradient::computeDotProduct(const std::vector<double>& vec1, const std::vector<double>& vec2) {
@@ -232,4 +277,69 @@ bool check_solution(const std::vector<double>& matrixA, const std::vector<double
   return solution_correct;
 }
 
+bool check_solution(const CsrMatrix& matrixA, const std::vector<double>& vectorB,
+                    const std::vector<double>& solutionC) {
+  std::vector<double> A_Sol(vectorB.size(), 0.0);
+  csrMultiply(matrixA, solutionC, A_Sol);
+
+  for (size_t i = 0; i < vectorB.size(); ++i) {
+    if (std::abs(A_Sol[i] - vectorB[i]) > TOLERANCE) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TbbSLAYGradientCsr::pre_processing() {
+  internal_order_test();
+
+  const int* row_ptr = reinterpret_cast<int*>(taskData->inputs[0]);
+  matrix.row_ptr.assign(row_ptr, row_ptr + taskData->inputs_count[0]);
+  const int* cols = reinterpret_cast<int*>(taskData->inputs[1]);
+  matrix.cols.assign(cols, cols + taskData->inputs_count[1]);
+  const double* vals = reinterpret_cast<double*>(taskData->inputs[2]);
+  matrix.vals.assign(vals, vals + taskData->inputs_count[2]);
+
+  const double* input_data_B = reinterpret_cast<double*>(taskData->inputs[3]);
+  vector.assign(input_data_B, input_data_B + taskData->inputs_count[3]);
+
+  answer.resize(vector.size(), 0);
+
+  return true;
+}
+
+bool TbbSLAYGradientCsr::validation() {
+  internal_order_test();
+
+  if (taskData->inputs_count.size() != 4 || taskData->outputs_count.size() != 1 ||
+      taskData->inputs_count[0] != taskData->inputs_count[3] + 1) {
+    return false;
+  }
+
+  if (taskData->inputs_count[1] != taskData->inputs_count[2]) {
+    return false;
+  }
+
+  if (taskData->inputs_count[3] != taskData->outputs_count[0]) {
+    return false;
+  }
+
+  return true;
+}
+
+bool TbbSLAYGradientCsr::run() {
+  internal_order_test();
+
+  return gradientSolve(
+      [&](const std::vector<double>& direction, std::vector<double>& A_Dir) { csrMultiply(matrix, direction, A_Dir); },
+      vector, answer);
+}
+
+bool TbbSLAYGradientCsr::post_processing() {
+  internal_order_test();
+
+  std::copy(answer.begin(), answer.end(), reinterpret_cast<double*>(taskData->outputs[0]));
+  return true;
+}
+
 }  // namespace dostavalov_s_tbb
@@ -49,7 +49,7 @@ TEST(ermolaev_d_fox_algorithm_tbb, test_pipline_run) {
 
   // Create Perf attributes
   auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
-  perfAttr->num_running = 1;
+  perfAttr->num_running = 10;
   perfAttr->current_timer = &timer_tbb;
 
   // Create and init perf results
@@ -99,7 +99,7 @@ TEST(ermolaev_d_fox_algorithm_tbb, test_task_run) {
 
   // Create Perf attributes
   auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
-  perfAttr->num_running = 1;
+  perfAttr->num_running = 10;
   perfAttr->current_timer = &timer_tbb;
 
   // Create and init perf results
@@ -1,8 +1,10 @@
 // Copyright 2024 Kirillov Maxim
 #include <gtest/gtest.h>
 
+#include <iostream>
 #include <vector>
 
+#include "core/gemm/include/gemm.hpp"
 #include "tbb/kirillov_m_strassen_alg/include/ops_tbb.hpp"
 using namespace kirillov_tbb;
 TEST(kirillov_m_strassen_tbb_func_tests, mult4x4) {
@@ -179,3 +181,57 @@ TEST(kirillov_m_strassen_tbb_func_tests, mult64x64) {
     EXPECT_NEAR(res[i], out[i], 10e-6);
   }
 }
+
+TEST(kirillov_m_strassen_tbb_func_tests, mult256x256) {
+  // deep enough to run the recursion below the parallel levels
+  const int n = 256;
+
+  // Create data
+  std::vector<double> A = generateRandomMatrix(n);
+  std::vector<double> B = generateRandomMatrix(n);
+  std::vector<double> out(n * n);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(A.data()));
+  taskDataSeq->inputs_count.emplace_back(A.size());
+
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(B.data()));
+  taskDataSeq->inputs_count.emplace_back(B.size());
+
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(const_cast<int *>(&n)));
+
+  taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskDataSeq->outputs_count.emplace_back(out.size());
+
+  std::vector<double> res = mul(A, B, n);
+
+  // Create Task
+  StrassenMatrixMultParallelTBB strassenMatrixMultParallelTbb(taskDataSeq);
+  ASSERT_EQ(strassenMatrixMultParallelTbb.validation(), true);
+  strassenMatrixMultParallelTbb.pre_processing();
+  strassenMatrixMultParallelTbb.run();
+  strassenMatrixMultParallelTbb.post_processing();
+
+  for (size_t i = 0; i < res.size(); i++) {
+    EXPECT_NEAR(res[i], out[i], 10e-6);
+  }
+}
+
+TEST(kirillov_m_strassen_tbb_func_tests, mult512x512_float) {
+  const int n = 512;
+
+  std::vector<double> A = generateRandomMatrix(n);
+  std::vector<double> B = generateRandomMatrix(n);
+  std::vector<float> Af(A.begin(), A.end());
+  std::vector<float> Bf(B.begin(), B.end());
+
+  // the double product of the inputs as rounded to float: what is left is the error of the computation
+  std::vector<double> Ad(Af.begin(), Af.end());
+  std::vector<double> Bd(Bf.begin(), Bf.end());
+  std::vector<double> res = mul(Ad, Bd, n);
+  double error = ppc::core::RelativeError(strassen(Af, Bf, n), res);
+  std::cout << "relative error of float Strassen for n = " << n << ": " << error << std::endl;
+  // about that of the float Gemm, plus a few roundings of the operand sums per level
+  EXPECT_LT(error, 1e-5);
+}
@@ -9,7 +9,7 @@
 using namespace kirillov_tbb;
 
 TEST(kirillov_m_strassen_tbb_perf_tests, test_pipeline_run) {
-  const int n = 128;
+  const int n = 512;
 
   // Create data
   std::vector<double> A = generateRandomMatrix(n);
@@ -52,7 +52,7 @@ TEST(kirillov_m_strassen_tbb_perf_tests, test_pipeline_run) {
 }
 
 TEST(kirillov_m_strassen_tbb_perf_tests, test_task_run) {
-  const int n = 128;
+  const int n = 512;
 
   // Create data
   std::vector<double> A = generateRandomMatrix(n);
@@ -2,98 +2,122 @@
 
 #include "tbb/kirillov_m_strassen_alg/include/ops_tbb.hpp"
 
-#include <tbb/parallel_invoke.h>
+#include <tbb/task_arena.h>
+#include <tbb/task_group.h>
 
 #include <cmath>
 #include <random>
+
+#include "core/gemm/include/strassen.hpp"
 using namespace kirillov_tbb;
 
-std::vector<double> kirillov_tbb::strassen(const std::vector<double>& A, const std::vector<double>& B, int n) {
-  if ((n == 0) || ((n & (n - 1)) != 0)) {
-    throw std::invalid_argument("Matrix size is not 2^n");
+namespace {
+int threads() { return tbb::this_task_arena::max_concurrency(); }
+
+// levels whose seven products are spawned as tasks: enough of them for two per thread, so that stealing evens out
+// the load; every level adds the operand sums and the products of its blocks to the workspace
+int parallelLevels() {
+  int levels = 0;
+  for (int tasks = 1; tasks < 2 * threads(); tasks *= 7) {
+    levels++;
   }
+  return levels;
+}
+
+// the tuning is read once per product and handed down: TuneStrassen locks on every call
+bool isSequential(int n, int levels, ppc::core::StrassenTuning tuning) {
+  return levels == 0 || n <= tuning.cutoff || n % 2 != 0;
+}
 
-  if (n <= 2) {
-    return mul(A, B, 2);
+// workspace of the spawned levels: operand sums, the seven products and the same again for each of them
+size_t levelsWorkspace(int n, int levels, ppc::core::StrassenTuning tuning) {
+  if (isSequential(n, levels, tuning)) {
+    return 0;
   }
+  size_t half = n / 2;
+  return ppc::core::StrassenSplitWorkspace(n) + 7 * half * half + 7 * levelsWorkspace(n / 2, levels - 1, tuning);
+}
 
-  int half = n / 2;
+// Blocks below the spawned levels all have the same size and are multiplied without a scheduling point, so each
+// thread needs the workspace of one of them at a time, wherever the scheduler sends it.
+template <typename T>
+struct PerThread {
+  T* work;
+  size_t size;
+};
+
+size_t leafWorkspace(int n, int levels, ppc::core::StrassenTuning tuning) {
+  if (isSequential(n, levels, tuning)) {
+    return ppc::core::StrassenWorkspace(n, tuning.cutoff);
+  }
+  return leafWorkspace(n / 2, levels - 1, tuning);
+}
 
-  std::vector<double> A11(half * half);
-  std::vector<double> A12(half * half);
-  std::vector<double> A21(half * half);
-  std::vector<double> A22(half * half);
-
-  std::vector<double> B11(half * half);
-  std::vector<double> B12(half * half);
-  std::vector<double> B21(half * half);
-  std::vector<double> B22(half * half);
-
-  splitMatrix(A, A11, A12, A21, A22);
-  splitMatrix(B, B11, B12, B21, B22);
-  std::vector<double> p1;
-  std::vector<double> p2;
-  std::vector<double> p3;
-  std::vector<double> p4;
-  std::vector<double> p5;
-  std::vector<double> p6;
-  std::vector<double> p7;
-  tbb::parallel_invoke(
-      [&] { p1 = strassen(add(A11, A22), add(B11, B22), half); }, [&] { p2 = strassen(add(A21, A22), B11, half); },
-      [&] { p3 = strassen(A11, sub(B12, B22), half); }, [&] { p4 = strassen(A22, sub(B21, B11), half); },
-      [&] { p5 = strassen(add(A11, A12), B22, half); }, [&] { p6 = strassen(sub(A21, A11), add(B11, B12), half); },
-      [&] { p7 = strassen(sub(A12, A22), add(B21, B22), half); });
-  std::vector<double> C11 = add(add(p1, p4), sub(p7, p5));
-  std::vector<double> C12 = add(p3, p5);
-  std::vector<double> C21 = add(p2, p4);
-  std::vector<double> C22 = add(sub(p1, p2), add(p3, p6));
-
-  return joinMatrices(C11, C12, C21, C22, n);
-}
-
-std::vector<double> kirillov_tbb::joinMatrices(const std::vector<double>& A11, const std::vector<double>& A12,
-                                               const std::vector<double>& A21, const std::vector<double>& A22, int n) {
-  int half = n / 2;
-  std::vector<double> A(n * n, 0.0);
-  for (int i = 0; i < half; i++) {
-    for (int j = 0; j < half; j++) {
-      A[i * n + j] = A11[i * half + j];
-      A[i * n + j + half] = A12[i * half + j];
-      A[(i + half) * n + j] = A21[i * half + j];
-      A[(i + half) * n + j + half] = A22[i * half + j];
-    }
+template <typename T>
+void strassenLevels(int n, const T* A, int lda, const T* B, int ldb, T* C, int ldc, T* work, PerThread<T> perThread,
+                    int levels, ppc::core::StrassenTuning tuning) {
+  if (isSequential(n, levels, tuning)) {
+    T* own = perThread.work + tbb::this_task_arena::current_thread_index() * perThread.size;
+    ppc::core::Strassen(n, A, lda, B, ldb, C, ldc, own, tuning.cutoff, tuning.variant);
+    return;
   }
-  return A;
-}
-
-void kirillov_tbb::splitMatrix(const std::vector<double>& A, std::vector<double>& A11, std::vector<double>& A12,
-                               std::vector<double>& A21, std::vector<double>& A22) {
-  int half = std::sqrt(A.size()) / 2;
-  for (int i = 0; i < half; i++) {
-    for (int j = 0; j < half; j++) {
-      A11[i * half + j] = A[i * half * 2 + j];
-      A12[i * half + j] = A[i * half * 2 + j + half];
-      A21[i * half + j] = A[(i + half) * half * 2 + j];
-      A22[i * half + j] = A[(i + half) * half * 2 + j + half];
-    }
+  int half = n / 2;
+  size_t block = static_cast<size_t>(half) * half;
+  size_t child = levelsWorkspace(half, levels - 1, tuning);
+  ppc::core::BasicStrassenProduct<T> products[7];
+  ppc::core::StrassenSplit(n, A, lda, B, ldb, work, products, tuning.variant);
+  T* M = work + ppc::core::StrassenSplitWorkspace(n);
+  T* rest = M + 7 * block;
+  tbb::task_group group;
+  for (int i = 0; i < 7; i++) {
+    group.run([=, &products] {
+      strassenLevels(half, products[i].A, products[i].lda, products[i].B, products[i].ldb, M + i * block, half,
+                     rest + i * child, perThread, levels - 1, tuning);
+    });
   }
+  group.wait();
+  ppc::core::StrassenMerge(n, M, C, ldc, tuning.variant);
 }
 
-std::vector<double> kirillov_tbb::add(const std::vector<double>& A, const std::vector<double>& B) {
-  int n = A.size();
-  std::vector<double> C(n);
-  for (int i = 0; i < n; i++) {
-    C[i] = A[i] + B[i];
+template <typename T>
+void strassenParallel(int n, const T* A, int lda, const T* B, int ldb, T* C, int ldc, T* work) {
+  int levels = parallelLevels();
+  ppc::core::StrassenTuning tuning = ppc::core::TuneStrassen(threads());
+  PerThread<T> perThread{work + levelsWorkspace(n, levels, tuning), leafWorkspace(n, levels, tuning)};
+  // started as a task, so that the calling thread has a slot in the arena even when the whole product is one leaf
+  tbb::task_group group;
+  group.run_and_wait([&] { strassenLevels(n, A, lda, B, ldb, C, ldc, work, perThread, levels, tuning); });
+}
+}  // namespace
+
+size_t kirillov_tbb::strassenWorkspace(int n) {
+  int levels = parallelLevels();
+  ppc::core::StrassenTuning tuning = ppc::core::TuneStrassen(threads());
+  return levelsWorkspace(n, levels, tuning) + threads() * leafWorkspace(n, levels, tuning);
+}
+
+void kirillov_tbb::strassen(int n, const double* A, int lda, const double* B, int ldb, double* C, int ldc,
+                            double* work) {
+  strassenParallel(n, A, lda, B, ldb, C, ldc, work);
+}
+
+std::vector<double> kirillov_tbb::strassen(const std::vector<double>& A, const std::vector<double>& B, int n) {
+  if ((n == 0) || ((n & (n - 1)) != 0)) {
+    throw std::invalid_argument("Matrix size is not 2^n");
   }
+  std::vector<double> C(n * n);
+  std::vector<double> work(strassenWorkspace(n));
+  strassen(n, A.data(), n, B.data(), n, C.data(), n, work.data());
   return C;
 }
 
-std::vector<double> kirillov_tbb::sub(const std::vector<double>& A, const std::vector<double>& B) {
-  int n = A.size();
-  std::vector<double> C(n);
-  for (int i = 0; i < n; i++) {
-    C[i] = A[i] - B[i];
+std::vector<float> kirillov_tbb::strassen(const std::vector<float>& A, const std::vector<float>& B, int n) {
+  if ((n == 0) || ((n & (n - 1)) != 0)) {
+    throw std::invalid_argument("Matrix size is not 2^n");
   }
+  std::vector<float> C(n * n);
+  std::vector<float> work(strassenWorkspace(n));
+  strassenParallel(n, A.data(), n, B.data(), n, C.data(), n, work.data());
   return C;
 }
 
@@ -131,6 +155,8 @@ bool StrassenMatrixMultParallelTBB::pre_processing() {
   B.resize(taskData->inputs_count[1]);
 
   n = *reinterpret_cast<int*>(taskData->inputs[2]);
+  C.resize(taskData->outputs_count[0]);
+  work.resize(strassenWorkspace(n));
 
   auto* aPtr = reinterpret_cast<double*>(taskData->inputs[0]);
   auto* bPtr = reinterpret_cast<double*>(taskData->inputs[1]);
@@ -151,7 +177,7 @@ bool StrassenMatrixMultParallelTBB::validation() {
 
 bool StrassenMatrixMultParallelTBB::run() {
   internal_order_test();
-  C = strassen(A, B, n);
+  strassen(n, A.data(), n, B.data(), n, C.data(), n, work.data());
   return true;
 }
 
@@ -5,6 +5,38 @@
 
 #include "tbb/kozyreva_k_sparse_matr_multi_ccs_tbb/include/ccs_mat_multy.hpp"
 
+namespace {
+SparseMatrixCCS toCCS(const std::vector<double> &matrix, int numRows, int numCols) {
+  SparseMatrixCCS ccs;
+  ccs.numRows = numRows;
+  ccs.numCols = numCols;
+  ccs.colPtr.push_back(0);
+  for (int j = 0; j < numCols; ++j) {
+    for (int i = 0; i < numRows; ++i) {
+      if (matrix[i * numCols + j] != 0) {
+        ccs.values.push_back(matrix[i * numCols + j]);
+        ccs.rows.push_back(i);
+      }
+    }
+    ccs.colPtr.push_back(ccs.values.size());
+  }
+  return ccs;
+}
+
+std::vector<double> toDense(const SparseMatrixCCS &ccs) {
+  std::vector<double> matrix(ccs.numRows * ccs.numCols);
+  for (int j = 0; j < ccs.numCols; ++j) {
+    for (int k = ccs.colPtr[j]; k < ccs.colPtr[j + 1]; ++k) {
+      if (k > ccs.colPtr[j]) {
+        EXPECT_LT(ccs.rows[k - 1], ccs.rows[k]);
+      }
+      matrix[ccs.rows[k] * ccs.numCols + j] = ccs.values[k];
+    }
+  }
+  return matrix;
+}
+}  // namespace
+
 TEST(kozyreva_k_sparse_matr_multi_ccs_tbb, test_sizes) {
   size_t n1 = 4;
   size_t m1 = 5;
@@ -335,4 +367,80 @@ TEST(kozyreva_k_sparse_matr_multi_ccs_tbb, zero_matrix) {
   }
 
   ASSERT_EQ(ch, n1 * m2);
-}
\ No newline at end of file
+}
+
+TEST(kozyreva_k_sparse_matr_multi_ccs_tbb, ccs_input_test_sizes) {
+  // Create data
+  SparseMatrixCCS in1 = toCCS(std::vector<double>(3 * 4), 3, 4);
+  SparseMatrixCCS in2 = toCCS(std::vector<double>(3 * 2), 3, 2);
+  SparseMatrixCCS out;
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataParallel = std::make_shared<ppc::core::TaskData>();
+  taskDataParallel->inputs.emplace_back(reinterpret_cast<uint8_t *>(&in1));
+  taskDataParallel->inputs_count.emplace_back(3);
+  taskDataParallel->inputs_count.emplace_back(4);
+  taskDataParallel->inputs.emplace_back(reinterpret_cast<uint8_t *>(&in2));
+  taskDataParallel->inputs_count.emplace_back(3);
+  taskDataParallel->inputs_count.emplace_back(2);
+  taskDataParallel->outputs.emplace_back(reinterpret_cast<uint8_t *>(&out));
+
+  // Create Task
+  SparseTBBMatrixMultiCCS sparseTBBMatrixMultiCCS(taskDataParallel);
+  ASSERT_FALSE(sparseTBBMatrixMultiCCS.validation());
+}
+
+TEST(kozyreva_k_sparse_matr_multi_ccs_tbb, ccs_input_multy_correct) {
+  // Create data
+  SparseMatrixCCS in1 = toCCS({5, 0, 0, 0, 0, 0, 5, 0, 0, 1, 0, 0, 8, 0, 6, 0}, 4, 4);
+  SparseMatrixCCS in2 = toCCS({5, 0, 0, 8, 0, 0, 1, 0, 0, 5, 0, 6, 0, 0, 0, 0}, 4, 4);
+  SparseMatrixCCS out;
+  std::vector<double> test{25, 0, 0, 40, 0, 25, 0, 30, 0, 0, 1, 0, 40, 30, 0, 100};
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataParallel = std::make_shared<ppc::core::TaskData>();
+  taskDataParallel->inputs.emplace_back(reinterpret_cast<uint8_t *>(&in1));
+  taskDataParallel->inputs_count.emplace_back(4);
+  taskDataParallel->inputs_count.emplace_back(4);
+  taskDataParallel->inputs.emplace_back(reinterpret_cast<uint8_t *>(&in2));
+  taskDataParallel->inputs_count.emplace_back(4);
+  taskDataParallel->inputs_count.emplace_back(4);
+  taskDataParallel->outputs.emplace_back(reinterpret_cast<uint8_t *>(&out));
+
+  // Create Task
+  SparseTBBMatrixMultiCCS sparseTBBMatrixMultiCCS(taskDataParallel);
+  ASSERT_TRUE(sparseTBBMatrixMultiCCS.validation());
+  ASSERT_TRUE(sparseTBBMatrixMultiCCS.pre_processing());
+  ASSERT_TRUE(sparseTBBMatrixMultiCCS.run());
+  ASSERT_TRUE(sparseTBBMatrixMultiCCS.post_processing());
+  ASSERT_EQ(out.values.size(), 8u);
+  ASSERT_EQ(toDense(out), test);
+}
+
+TEST(kozyreva_k_sparse_matr_multi_ccs_tbb, ccs_input_rectangular) {
+  // Create data
+  SparseMatrixCCS in1 = toCCS({1, 0, 2, 0, 0, 0, 0, 3, 4, 0, 0, 0}, 3, 4);
+  SparseMatrixCCS in2 = toCCS({0, 1, 2, 0, 0, 0, 5, 0}, 4, 2);
+  SparseMatrixCCS out;
+  std::vector<double> test{0, 1, 15, 0, 0, 4};
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataParallel = std::make_shared<ppc::core::TaskData>();
+  taskDataParallel->inputs.emplace_back(reinterpret_cast<uint8_t *>(&in1));
+  taskDataParallel->inputs_count.emplace_back(3);
+  taskDataParallel->inputs_count.emplace_back(4);
+  taskDataParallel->inputs.emplace_back(reinterpret_cast<uint8_t *>(&in2));
+  taskDataParallel->inputs_count.emplace_back(4);
+  taskDataParallel->inputs_count.emplace_back(2);
+  taskDataParallel->outputs.emplace_back(reinterpret_cast<uint8_t *>(&out));
+
+  // Create Task
+  SparseTBBMatrixMultiCCS sparseTBBMatrixMultiCCS(taskDataParallel);
+  ASSERT_TRUE(sparseTBBMatrixMultiCCS.validation());
+  ASSERT_TRUE(sparseTBBMatrixMultiCCS.pre_processing());
+  ASSERT_TRUE(sparseTBBMatrixMultiCCS.run());
+  ASSERT_TRUE(sparseTBBMatrixMultiCCS.post_processing());
+  ASSERT_EQ(out.numRows, 3);
+  ASSERT_EQ(out.numCols, 2);
+  ASSERT_EQ(toDense(out), test);
+}
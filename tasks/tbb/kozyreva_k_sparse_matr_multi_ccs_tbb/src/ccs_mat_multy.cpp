@@ -2,10 +2,14 @@
 
 #include "tbb/kozyreva_k_sparse_matr_multi_ccs_tbb/include/ccs_mat_multy.hpp"
 
+#include <algorithm>
+
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_for.h>
 #include <tbb/tbb.h>
 
+#include "core/sparse/include/compress.hpp"
+
 using namespace std::chrono_literals;
 
 using namespace std;
@@ -23,33 +27,9 @@ bool SparseTBBMatrixMultiSequential::pre_processing() {
 
   result = new double[numRows1 * numCols2]{0};
 
-  int notNullNumbers = 0;
-  for (int j = 0; j < numCols1; ++j) {
-    colPtr1.push_back(notNullNumbers);
-    for (int i = 0; i < numRows1; ++i) {
-      int index = i * numRows1 + j;
-      if (matrix1[index] != 0) {
-        values1.push_back(matrix1[index]);
-        rows1.push_back(i);
-        notNullNumbers++;
-      }
-    }
-  }
-  colPtr1.push_back(notNullNumbers);
-
-  notNullNumbers = 0;
-  for (int j = 0; j < numCols2; ++j) {
-    colPtr2.push_back(notNullNumbers);
-    for (int i = 0; i < numRows2; ++i) {
-      int index = i * numRows2 + j;
-      if (matrix2[index] != 0) {
-        values2.push_back(matrix2[index]);
-        rows2.push_back(i);
-        notNullNumbers++;
-      }
-    }
-  }
-  colPtr2.push_back(notNullNumbers);
+  auto nonzero = [](double v) { return v != 0; };
+  ppc::core::DenseToCompressed(matrix1, numRows1, numCols1, true, nonzero, values1, rows1, colPtr1);
+  ppc::core::DenseToCompressed(matrix2, numRows2, numCols2, true, nonzero, values2, rows2, colPtr2);
 
   return true;
 }
@@ -123,33 +103,11 @@ bool SparseTBBMatrixMultiParallel::pre_processing() {
 
   result = new double[numRows1 * numCols2]{0};
 
-  int notNullNumbers = 0;
-  for (int j = 0; j < numCols1; ++j) {
-    colPtr1.push_back(notNullNumbers);
-    for (int i = 0; i < numRows1; ++i) {
-      int index = i * numRows1 + j;
-      if (matrix1[index] != 0) {
-        values1.push_back(matrix1[index]);
-        rows1.push_back(i);
-        notNullNumbers++;
-      }
-    }
-  }
-  colPtr1.push_back(notNullNumbers);
-
-  notNullNumbers = 0;
-  for (int j = 0; j < numCols2; ++j) {
-    colPtr2.push_back(notNullNumbers);
-    for (int i = 0; i < numRows2; ++i) {
-      int index = i * numRows2 + j;
-      if (matrix2[index] != 0) {
-        values2.push_back(matrix2[index]);
-        rows2.push_back(i);
-        notNullNumbers++;
-      }
-    }
-  }
-  colPtr2.push_back(notNullNumbers);
+  auto nonzero = [](double v) { return v != 0; };
+  ppc::core::DenseToCompressed(matrix1, numRows1, numCols1, true, nonzero, values1, rows1, colPtr1,
+                               tbb::this_task_arena::max_concurrency());
+  ppc::core::DenseToCompressed(matrix2, numRows2, numCols2, true, nonzero, values2, rows2, colPtr2,
+                               tbb::this_task_arena::max_concurrency());
 
   return true;
 }
@@ -212,4 +170,102 @@ bool SparseTBBMatrixMultiParallel::post_processing() {
   delete[] result;
 
   return true;
-}
\ No newline at end of file
+}
+
+SparseMatrixCCS MultiplyCCS(const SparseMatrixCCS& a, const SparseMatrixCCS& b) {
+  SparseMatrixCCS c;
+  c.numRows = a.numRows;
+  c.numCols = b.numCols;
+  c.colPtr.assign(b.numCols + 1, 0);
+
+  // first pass: the number of structural nonzeros of every column of C
+  tbb::parallel_for(tbb::blocked_range<int>(0, b.numCols), [&](const tbb::blocked_range<int>& r) {
+    std::vector<int> mark(a.numRows, -1);
+    for (int j = r.begin(); j < r.end(); j++) {
+      int count = 0;
+      for (int k = b.colPtr[j]; k < b.colPtr[j + 1]; k++) {
+        int row2 = b.rows[k];
+        for (int l = a.colPtr[row2]; l < a.colPtr[row2 + 1]; l++) {
+          if (mark[a.rows[l]] != j) {
+            mark[a.rows[l]] = j;
+            count++;
+          }
+        }
+      }
+      c.colPtr[j + 1] = count;
+    }
+  });
+
+  // prefix sum: colPtr[j] becomes the offset of column j in the final arrays
+  for (int j = 0; j < b.numCols; j++) {
+    c.colPtr[j + 1] += c.colPtr[j];
+  }
+  c.rows.resize(c.colPtr[b.numCols]);
+  c.values.resize(c.colPtr[b.numCols]);
+
+  // second pass: every column is written straight into its place in the final arrays
+  tbb::parallel_for(tbb::blocked_range<int>(0, b.numCols), [&](const tbb::blocked_range<int>& r) {
+    std::vector<double> column(a.numRows);
+    std::vector<int> mark(a.numRows, -1);
+    for (int j = r.begin(); j < r.end(); j++) {
+      int pos = c.colPtr[j];
+      for (int k = b.colPtr[j]; k < b.colPtr[j + 1]; k++) {
+        int row2 = b.rows[k];
+        for (int l = a.colPtr[row2]; l < a.colPtr[row2 + 1]; l++) {
+          int row1 = a.rows[l];
+          if (mark[row1] != j) {
+            mark[row1] = j;
+            c.rows[pos++] = row1;
+          }
+          column[row1] += a.values[l] * b.values[k];
+        }
+      }
+      std::sort(c.rows.begin() + c.colPtr[j], c.rows.begin() + pos);
+      for (int i = c.colPtr[j]; i < pos; i++) {
+        c.values[i] = column[c.rows[i]];
+        column[c.rows[i]] = 0.0;
+      }
+    }
+  });
+
+  return c;
+}
+
+bool SparseTBBMatrixMultiCCS::pre_processing() {
+  internal_order_test();
+  a = reinterpret_cast<SparseMatrixCCS*>(taskData->inputs[0]);
+  b = reinterpret_cast<SparseMatrixCCS*>(taskData->inputs[1]);
+  out = reinterpret_cast<SparseMatrixCCS*>(taskData->outputs[0]);
+  return true;
+}
+
+bool SparseTBBMatrixMultiCCS::validation() {
+  internal_order_test();
+  if (taskData->inputs.size() != 2 || taskData->inputs_count.size() != 4 || taskData->outputs.size() != 1) {
+    return false;
+  }
+  if (taskData->inputs[0] == nullptr || taskData->inputs[1] == nullptr || taskData->outputs[0] == nullptr) {
+    return false;
+  }
+  const auto* matrix1 = reinterpret_cast<SparseMatrixCCS*>(taskData->inputs[0]);
+  const auto* matrix2 = reinterpret_cast<SparseMatrixCCS*>(taskData->inputs[1]);
+  return taskData->inputs_count[1] == taskData->inputs_count[2] &&
+         matrix1->numRows == static_cast<int>(taskData->inputs_count[0]) &&
+         matrix1->numCols == static_cast<int>(taskData->inputs_count[1]) &&
+         matrix2->numRows == static_cast<int>(taskData->inputs_count[2]) &&
+         matrix2->numCols == static_cast<int>(taskData->inputs_count[3]) &&
+         matrix1->colPtr.size() == static_cast<size_t>(matrix1->numCols) + 1 &&
+         matrix2->colPtr.size() == static_cast<size_t>(matrix2->numCols) + 1;
+}
+
+bool SparseTBBMatrixMultiCCS::run() {
+  internal_order_test();
+  c = MultiplyCCS(*a, *b);
+  return true;
+}
+
+bool SparseTBBMatrixMultiCCS::post_processing() {
+  internal_order_test();
+  *out = std::move(c);
+  return true;
+}
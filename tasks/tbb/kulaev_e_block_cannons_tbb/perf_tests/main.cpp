@@ -2,6 +2,7 @@
 #include <gtest/gtest.h>
 #include <oneapi/tbb.h>
 
+#include <cmath>
 #include <vector>
 
 #include "core/perf/include/perf.hpp"
@@ -50,7 +51,7 @@ TEST(tbb_kulaev_e_block_cannons_perf_test, test_pipeline_run) {
   ppc::core::Perf::print_perf_statistic(perfResults);
 
   for (size_t i = 0; i < res.size(); ++i) {
-    ASSERT_EQ(res[i], out[i]);
+    ASSERT_NEAR(res[i], out[i], 1e-12 * std::abs(out[i]));
   }
 }
 
@@ -96,6 +97,6 @@ TEST(tbb_kulaev_e_block_cannons_perf_test, test_task_run) {
   ppc::core::Perf::print_perf_statistic(perfResults);
 
   for (size_t i = 0; i < res.size(); ++i) {
-    ASSERT_EQ(res[i], out[i]);
+    ASSERT_NEAR(res[i], out[i], 1e-12 * std::abs(out[i]));
   }
 }
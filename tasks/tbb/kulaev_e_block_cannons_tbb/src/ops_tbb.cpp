@@ -8,72 +8,79 @@
 #include <vector>
 #undef min
 
-std::vector<double> cannonMatrixMultiplication(const std::vector<double>& A, const std::vector<double>& B, int n,
-                                               int m) {
-  int blockSize = std::min(n, m);
+#include "core/gemm/include/blocking.hpp"
+#include "core/gemm/include/gemm.hpp"
+#include "core/gemm/include/tiled.hpp"
+
+namespace {
+// A is n x m and B is m x m. Blocks are contiguous tiles that Gemm reads in place; edge blocks are padded with zeros,
+// so the block size measured for this host does not have to divide n or m
+struct CannonTiles {
+  ppc::core::TiledMatrix a;
+  ppc::core::TiledMatrix b;
+  ppc::core::TiledMatrix c;
+};
+
+CannonTiles toTiles(const std::vector<double>& A, const std::vector<double>& B, int n, int m, int threads) {
+  int block = ppc::core::TuneBlockSize("cannon", std::max(n, m), threads);
+  CannonTiles tiles{ppc::core::TiledMatrix(n, m, block), ppc::core::TiledMatrix(m, m, block),
+                    ppc::core::TiledMatrix(n, m, block)};
+  tiles.a.FromRowMajor(A.data(), m);
+  tiles.b.FromRowMajor(B.data(), m);
+  return tiles;
+}
+
+// block (i, j) of C at Cannon's step s: the product of block (i, (i + j + s) mod q) of A and the matching block of B
+void cannonStep(CannonTiles& tiles, int i, int j, int step) {
+  int q = tiles.b.BlockRows();
+  int k = (i + j + step) % q;
+  int t = tiles.c.Tile();
+  ppc::core::Gemm(t, t, t, tiles.a.Block(i, k), t, tiles.b.Block(k, j), t, tiles.c.Block(i, j), t);
+}
 
-  std::vector<double> C(n * m, 0.0);
+std::vector<double> fromTiles(const CannonTiles& tiles, int n, int m) {
+  std::vector<double> C(n * m);
+  tiles.c.ToRowMajor(C.data(), m);
+  return C;
+}
+}  // namespace
 
+std::vector<double> cannonMatrixMultiplication(const std::vector<double>& A, const std::vector<double>& B, int n,
+                                               int m) {
   if (n == 0 || m == 0) {
     return std::vector<double>();
   }
 
-  for (int i = 0; i < n; i += blockSize) {
-    for (int j = 0; j < m; j += blockSize) {
-      for (int k = 0; k < m; k += blockSize) {
-        int i_end = std::min(i + blockSize, n);
-        int j_end = std::min(j + blockSize, m);
-        int k_end = std::min(k + blockSize, m);
-
-        for (int ii = i; ii < i_end; ++ii) {
-          for (int kk = k; kk < k_end; ++kk) {
-            double A_ik = A[ii * m + kk];
-            for (int jj = j; jj < j_end; ++jj) {
-              C[ii * m + jj] += A_ik * B[kk * m + jj];
-            }
-          }
-        }
+  CannonTiles tiles = toTiles(A, B, n, m, 1);
+  int q = tiles.b.BlockRows();
+  for (int step = 0; step < q; ++step) {
+    for (int i = 0; i < tiles.c.BlockRows(); ++i) {
+      for (int j = 0; j < q; ++j) {
+        cannonStep(tiles, i, j, step);
       }
     }
   }
-  return C;
+
+  return fromTiles(tiles, n, m);
 }
 
 std::vector<double> cannonMatrixMultiplication_tbb(const std::vector<double>& A, const std::vector<double>& B, int n,
                                                    int m) {
-  int blockSize = std::min(n, m);
-
-  std::vector<double> C(n * m, 0.0);
-
   if (n == 0 || m == 0) {
     return std::vector<double>();
   }
 
-  tbb::parallel_for(0, n, blockSize, [&](int i) {
-    std::vector<double> local_accumulator(n * m, 0.0);
-
-    for (int j = 0; j < m; j += blockSize) {
-      for (int k = 0; k < m; k += blockSize) {
-        int i_end = std::min(i + blockSize, n);
-        int j_end = std::min(j + blockSize, m);
-        int k_end = std::min(k + blockSize, m);
-
-        for (int ii = i; ii < i_end; ++ii) {
-          for (int jj = j; jj < j_end; ++jj) {
-            for (int kk = k; kk < k_end; ++kk) {
-              local_accumulator[ii * m + jj] += A[ii * m + kk] * B[kk * m + jj];
-            }
-          }
-        }
-      }
-    }
+  CannonTiles tiles = toTiles(A, B, n, m, tbb::this_task_arena::max_concurrency());
+  int q = tiles.b.BlockRows();
 
-    for (int index = 0; index < n * m; ++index) {
-      C[index] += local_accumulator[index];
+  // every block of C belongs to one task, which runs all of Cannon's steps on it
+  tbb::parallel_for(0, tiles.c.BlockRows() * q, [&](int t) {
+    for (int step = 0; step < q; ++step) {
+      cannonStep(tiles, t / q, t % q, step);
     }
   });
 
-  return C;
+  return fromTiles(tiles, n, m);
 }
 
 std::vector<double> getRandomMatrix(int rows, int cols) {
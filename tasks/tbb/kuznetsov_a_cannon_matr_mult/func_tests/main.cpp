@@ -1,8 +1,10 @@
 // Copyright 2023 Kuznetsov Artem
 #include <gtest/gtest.h>
 
+#include <iostream>
 #include <vector>
 
+#include "core/gemm/include/gemm.hpp"
 #include "tbb/kuznetsov_a_cannon_matr_mult/include/ops_tbb.hpp"
 
 TEST(Kuznetsov_a_cannon_matr_mult_tbb_func_tests, mult_3x3) {
@@ -246,4 +248,76 @@ TEST(Kuznetsov_a_cannon_matr_mult_tbb_func_tests, mult_7x7) {
   for (size_t i = 0; i < resSize; ++i) {
     ASSERT_TRUE(KuznetsovArtyomTbb::isEqual(resSeq[i], outputMatr[i]));
   }
-}
\ No newline at end of file
+}
+
+TEST(Kuznetsov_a_cannon_matr_mult_tbb_func_tests, mult_tuned_block) {
+  // Create data
+  size_t size = 100;
+  // 0: the task picks the block size itself
+  size_t block = 0;
+
+  auto inputMatrOne = KuznetsovArtyomTbb::getRandomSquareMatrix(size, -100.0, 100.0);
+  auto inputMatrTwo = KuznetsovArtyomTbb::getRandomSquareMatrix(size, -100.0, 100.0);
+  std::vector<double> outputMatr(size * size, 0.0);
+
+  // Create TaskData
+  auto taskDataTbb = std::make_shared<ppc::core::TaskData>();
+
+  // Add matrOne
+  taskDataTbb->inputs.emplace_back(reinterpret_cast<uint8_t *>(inputMatrOne.data()));
+  taskDataTbb->inputs_count.emplace_back(inputMatrOne.size());
+
+  // Add matrTwo
+  taskDataTbb->inputs.emplace_back(reinterpret_cast<uint8_t *>(inputMatrTwo.data()));
+  taskDataTbb->inputs_count.emplace_back(inputMatrTwo.size());
+
+  // Add size
+  taskDataTbb->inputs.emplace_back(reinterpret_cast<uint8_t *>(&size));
+
+  // Add block
+  taskDataTbb->inputs.emplace_back(reinterpret_cast<uint8_t *>(&block));
+
+  // Add out matr
+  taskDataTbb->outputs.emplace_back(reinterpret_cast<uint8_t *>(outputMatr.data()));
+  taskDataTbb->outputs_count.emplace_back(outputMatr.size());
+
+  auto resSeq = KuznetsovArtyomTbb::CannonMatrixMultSeq(inputMatrOne, inputMatrTwo, size, 10);
+
+  // Create Task
+  KuznetsovArtyomTbb::KuznetsovCannonMatrMultTbb taskTaskTbb(taskDataTbb);
+
+  ASSERT_TRUE(taskTaskTbb.validation());
+  taskTaskTbb.pre_processing();
+  taskTaskTbb.run();
+  taskTaskTbb.post_processing();
+
+  auto resSize = resSeq.size();
+
+  for (size_t i = 0; i < resSize; ++i) {
+    ASSERT_TRUE(KuznetsovArtyomTbb::isEqual(resSeq[i], outputMatr[i]));
+  }
+}
+
+TEST(Kuznetsov_a_cannon_matr_mult_tbb_func_tests, mult_reduced_precision) {
+  int size = 300;
+  int block = 64;
+
+  auto matrOne = KuznetsovArtyomTbb::getRandomSquareMatrix(size, -100.0, 100.0);
+  auto matrTwo = KuznetsovArtyomTbb::getRandomSquareMatrix(size, -100.0, 100.0);
+  std::vector<float> floatOne(matrOne.begin(), matrOne.end());
+  std::vector<float> floatTwo(matrTwo.begin(), matrTwo.end());
+
+  // the double product of the inputs as rounded to float: what is left is the error of the computation
+  auto resDouble = KuznetsovArtyomTbb::CannonMatrixMultTbb(std::vector<double>(floatOne.begin(), floatOne.end()),
+                                                           std::vector<double>(floatTwo.begin(), floatTwo.end()),
+                                                           size, block);
+  auto resFloat = KuznetsovArtyomTbb::CannonMatrixMultTbb(floatOne, floatTwo, size, block);
+  auto resMixed = KuznetsovArtyomTbb::CannonMatrixMultTbbMixed(floatOne, floatTwo, size, block);
+
+  double errorFloat = ppc::core::RelativeError(resFloat, resDouble);
+  double errorMixed = ppc::core::RelativeError(resMixed, resDouble);
+  std::cout << "relative error for n = " << size << ": float " << errorFloat << ", mixed " << errorMixed << std::endl;
+  EXPECT_LT(errorFloat, size * 6e-8);
+  // each block of the result is summed by one task per step in the order of the steps, as in the double version
+  EXPECT_EQ(0.0, errorMixed);
+}
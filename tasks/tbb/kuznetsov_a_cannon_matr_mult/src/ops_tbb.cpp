@@ -1,6 +1,10 @@
 // Copyright 2024 Kuznetsov Artem
 #include "tbb/kuznetsov_a_cannon_matr_mult/include/ops_tbb.hpp"
 
+#include "core/gemm/include/blocking.hpp"
+#include "core/gemm/include/gemm.hpp"
+#include "core/gemm/include/tiled.hpp"
+
 using namespace std::chrono_literals;
 
 namespace KuznetsovArtyomTbb {
@@ -34,33 +38,55 @@ std::vector<double> CannonMatrixMultSeq(const std::vector<double>& matrOne, cons
   return matrRes;
 }
 
-std::vector<double> CannonMatrixMultTbb(const std::vector<double>& matrOne, const std::vector<double>& matrTwo,
-                                        int size, int block) {
+namespace {
+// T is the element type of the operands, Acc that of the result: float and float for single precision, float and
+// double for float operands accumulated in double
+template <typename T, typename Acc>
+std::vector<Acc> cannonTiledTbb(const std::vector<T>& matrOne, const std::vector<T>& matrTwo, int size, int block) {
   if (!validateMatrix(matrOne.size(), matrTwo.size())) throw std::invalid_argument{"invalid matrixs"};
 
   if (block > size) throw std::invalid_argument{"Wrong size block"};
 
-  int jbMin = 0;
-  int kbMin = 0;
-  std::vector<double> matrRes(size * size, 0.0);
-
-  for (int jb = 0; jb < size; jb += block) {
-    for (int kb = 0; kb < size; kb += block) {
-      jbMin = size < jb + block ? size : jb + block;
-      kbMin = size < kb + block ? size : kb + block;
-
-      tbb::parallel_for(0, size, 1, [&](int i) {
-        for (int k = kb; k < kbMin; ++k) {
-          for (int j = jb; j < jbMin; ++j) {
-            matrRes[i * size + j] += matrOne[i * size + k] * matrTwo[k * size + j];
-          }
-        }
-      });
-    }
+  // every block is a contiguous tile, so the block products run on the packed kernel without gathering
+  ppc::core::BasicTiledMatrix<T> tileOne(size, size, block);
+  ppc::core::BasicTiledMatrix<T> tileTwo(size, size, block);
+  ppc::core::BasicTiledMatrix<Acc> tileRes(size, size, block);
+  tileOne.FromRowMajor(matrOne.data(), size);
+  tileTwo.FromRowMajor(matrTwo.data(), size);
+  int grid = tileOne.BlockRows();
+
+  // at each step block (i, j) of the result takes the product of the blocks Cannon's shifts have brought to it; the
+  // blocks of a step are independent
+  for (int step = 0; step < grid; ++step) {
+    tbb::parallel_for(0, grid * grid, [&](int t) {
+      int i = t / grid;
+      int j = t % grid;
+      int k = (i + j + step) % grid;
+      ppc::core::Gemm(block, block, block, tileOne.Block(i, k), block, tileTwo.Block(k, j), block, tileRes.Block(i, j),
+                      block);
+    });
   }
 
+  std::vector<Acc> matrRes(size * size);
+  tileRes.ToRowMajor(matrRes.data(), size);
   return matrRes;
 }
+}  // namespace
+
+std::vector<double> CannonMatrixMultTbb(const std::vector<double>& matrOne, const std::vector<double>& matrTwo,
+                                        int size, int block) {
+  return cannonTiledTbb<double, double>(matrOne, matrTwo, size, block);
+}
+
+std::vector<float> CannonMatrixMultTbb(const std::vector<float>& matrOne, const std::vector<float>& matrTwo, int size,
+                                       int block) {
+  return cannonTiledTbb<float, float>(matrOne, matrTwo, size, block);
+}
+
+std::vector<double> CannonMatrixMultTbbMixed(const std::vector<float>& matrOne, const std::vector<float>& matrTwo,
+                                             int size, int block) {
+  return cannonTiledTbb<float, double>(matrOne, matrTwo, size, block);
+}
 
 std::vector<double> getRandomSquareMatrix(size_t size, double minVal, double maxVal) {
   std::mt19937 gen(std::random_device{}());
@@ -81,6 +107,10 @@ bool KuznetsovCannonMatrMultTbb::pre_processing() {
 
   mSize = *reinterpret_cast<size_t*>(taskData->inputs[SIZE]);
   mBlock = *reinterpret_cast<size_t*>(taskData->inputs[BLOCK]);
+  // 0: no block size from the caller, use the one measured for this host
+  if (mBlock == 0) {
+    mBlock = ppc::core::TuneBlockSize("cannon", static_cast<int>(mSize), tbb::this_task_arena::max_concurrency());
+  }
 
   size_t countElem = mSize * mSize;
 
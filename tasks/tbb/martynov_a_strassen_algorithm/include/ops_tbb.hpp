@@ -7,6 +7,7 @@
 #include <utility>
 #include <vector>
 
+#include "core/gemm/include/strassen.hpp"
 #include "core/task/include/task.hpp"
 inline std::vector<double> fillMatrix(int n) {
   std::random_device seed;
@@ -37,4 +38,8 @@ class Strssn_alg : public ppc::core::Task {
   std::vector<double> first_matrix;
   std::vector<double> second_matrix;
   std::vector<double> result;
+  // operand sums and products of the spawned levels, then one leaf workspace per thread; sized in pre_processing
+  std::vector<double> work;
+  ppc::core::StrassenTuning tuning{};
+  int levels = 0;
 };
\ No newline at end of file
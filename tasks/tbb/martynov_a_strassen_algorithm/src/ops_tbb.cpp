@@ -1,64 +1,73 @@
 // Copyright 2024 Martynov Aleksandr
 #include "tbb/martynov_a_strassen_algorithm/include/ops_tbb.hpp"
 
-#include <tbb/tbb.h>
+#include <tbb/task_arena.h>
+#include <tbb/task_group.h>
 
 #include <algorithm>
 #include <cmath>
-#include <thread>
 #include <vector>
 
-using namespace std::chrono_literals;
+#include "core/gemm/include/strassen.hpp"
 
 inline int get_size(std::vector<double>& a) { return (int)(round(std::sqrt(a.size()))); }
 
-void toSubmatrices(const std::vector<double>& initialMatrix, std::vector<double>& a11, std::vector<double>& a12,
-                   std::vector<double>& a21, std::vector<double>& a22) {
-  int n = int(std::sqrt(initialMatrix.size()) / 2);
-
-  for (int i = 0; i < n; i++) {
-    std::copy(initialMatrix.begin() + (2 * i) * n, initialMatrix.begin() + (2 * i + 1) * n, a11.begin() + i * n);
-    std::copy(initialMatrix.begin() + (2 * i + 1) * n, initialMatrix.begin() + (2 * i + 2) * n, a12.begin() + i * n);
-    std::copy(initialMatrix.begin() + ((n * n * 2) + (2 * i * n)),
-              initialMatrix.begin() + ((n * n * 2) + ((2 * i + 1) * n)), a21.begin() + i * n);
-    std::copy(initialMatrix.begin() + ((n * n * 2) + ((2 * i + 1) * n)),
-              initialMatrix.begin() + ((n * n * 2) + ((2 * i + 2) * n)), a22.begin() + i * n);
+namespace {
+// levels whose seven products are tasks: two tasks per thread are enough for the load to even out, and every level
+// more would only add its operand sums and products to the workspace
+int parallelLevels(int threads) {
+  int levels = 0;
+  for (int tasks = 1; tasks < 2 * threads; tasks *= 7) {
+    levels++;
   }
+  return levels;
 }
-inline std::vector<double> tojoin(std::vector<double> a11, std::vector<double> a12, std::vector<double> a21,
-                                  std::vector<double> a22) {
-  int n = a11.size();
-  std::vector<double> result(4 * n, 0.0);
-  n = (int)(std::sqrt(n));
 
-  for (int i = 0; i < n; i++) {
-    std::copy(a11.begin() + i * n, a11.begin() + (i + 1) * n, result.begin() + (2 * i * n));
-    std::copy(a12.begin() + i * n, a12.begin() + (i + 1) * n, result.begin() + (2 * i + 1) * n);
-    std::copy(a21.begin() + i * n, a21.begin() + (i + 1) * n, result.begin() + ((n * n * 2) + (2 * i * n)));
-    std::copy(a22.begin() + i * n, a22.begin() + (i + 1) * n, result.begin() + ((n * n * 2) + ((2 * i + 1) * n)));
-  }
-  return result;
+bool isSequential(int n, int levels, ppc::core::StrassenTuning tuning) {
+  return levels == 0 || n <= tuning.cutoff || n % 2 != 0;
 }
 
-inline std::vector<double> sum_matrix(const std::vector<double>& a, const std::vector<double>& b) {
-  int n = a.size();
-  std::vector<double> result(n);
-
-  for (int i = 0; i < n; i++) {
-    result[i] = a[i] + b[i];
+size_t levelsWorkspace(int n, int levels, ppc::core::StrassenTuning tuning) {
+  if (isSequential(n, levels, tuning)) {
+    return 0;
   }
-  return result;
+  size_t half = n / 2;
+  return ppc::core::StrassenSplitWorkspace(n) + 7 * half * half + 7 * levelsWorkspace(n / 2, levels - 1, tuning);
 }
 
-inline std::vector<double> sub(const std::vector<double>& a, const std::vector<double>& b) {
-  int n = a.size();
-  std::vector<double> result(n);
+// below the task levels a block is multiplied from start to end by the thread that picked it up
+size_t leafWorkspace(int n, int levels, ppc::core::StrassenTuning tuning) {
+  if (isSequential(n, levels, tuning)) {
+    return ppc::core::StrassenWorkspace(n, tuning.cutoff);
+  }
+  return leafWorkspace(n / 2, levels - 1, tuning);
+}
 
-  for (int i = 0; i < n; i++) {
-    result[i] = a[i] - b[i];
+void strassen(int n, const double* a, int lda, const double* b, int ldb, double* c, int ldc, double* work,
+              double* leaves, size_t leafSize, int levels, ppc::core::StrassenTuning tuning) {
+  if (isSequential(n, levels, tuning)) {
+    double* own = leaves + tbb::this_task_arena::current_thread_index() * leafSize;
+    ppc::core::Strassen(n, a, lda, b, ldb, c, ldc, own, tuning.cutoff, tuning.variant);
+    return;
   }
-  return result;
+  int size = n / 2;
+  size_t block = static_cast<size_t>(size) * size;
+  size_t child = levelsWorkspace(size, levels - 1, tuning);
+  ppc::core::StrassenProduct p[7];
+  ppc::core::StrassenSplit(n, a, lda, b, ldb, work, p, tuning.variant);
+  double* m = work + ppc::core::StrassenSplitWorkspace(n);
+  double* rest = m + 7 * block;
+  tbb::task_group group;
+  for (int i = 0; i < 7; i++) {
+    group.run([=, &p] {
+      strassen(size, p[i].A, p[i].lda, p[i].B, p[i].ldb, m + i * block, size, rest + i * child, leaves, leafSize,
+               levels - 1, tuning);
+    });
+  }
+  group.wait();
+  ppc::core::StrassenMerge(n, m, c, ldc, tuning.variant);
 }
+}  // namespace
 
 bool Strssn_alg::post_processing() {
   internal_order_test();
@@ -74,10 +83,17 @@ bool Strssn_alg::validation() {
 
 bool Strssn_alg::pre_processing() {
   internal_order_test();
-
-  n = *reinterpret_cast<int*>(taskData->inputs[2]);
+  // smaller blocks go to the packed kernel: the extra additions and copies do not pay off there; where that happens
+  // depends on the host, so it is measured here rather than inside the timed run
+  int threads = tbb::this_task_arena::max_concurrency();
+  tuning = ppc::core::TuneStrassen(threads);
+  levels = parallelLevels(threads);
+  // Init value for input and output
   first_matrix = std::vector<double>(taskData->inputs_count[0]);
   second_matrix = std::vector<double>(taskData->inputs_count[1]);
+  n = get_size(first_matrix);
+  result = std::vector<double>(n * n);
+  work = std::vector<double>(levelsWorkspace(n, levels, tuning) + threads * leafWorkspace(n, levels, tuning));
 
   auto* temporary1 = reinterpret_cast<double*>(taskData->inputs[0]);
   auto* temporary2 = reinterpret_cast<double*>(taskData->inputs[1]);
@@ -87,50 +103,16 @@ bool Strssn_alg::pre_processing() {
   }
   return true;
 }
-std::vector<double> strassen(const std::vector<double>& a, const std::vector<double>& b, int n) {
-  int size = n;
-
-  if (size <= 2) {
-    return ijkalgorithm(a, b, size);
-  }
-  size = size / 2;
-  std::vector<double> b11(size * size);
-  std::vector<double> b12(size * size);
-  std::vector<double> b21(size * size);
-  std::vector<double> b22(size * size);
-  std::vector<double> a11(size * size);
-  std::vector<double> a12(size * size);
-  std::vector<double> a21(size * size);
-  std::vector<double> a22(size * size);
-
-  toSubmatrices(a, a11, a12, a21, a22);
-  toSubmatrices(b, b11, b12, b21, b22);
-
-  std::vector<double> p1;
-  std::vector<double> p2;
-  std::vector<double> p3;
-  std::vector<double> p4;
-  std::vector<double> p5;
-  std::vector<double> p6;
-  std::vector<double> p7;
-
-  oneapi::tbb::parallel_invoke(
-      [&] { p1 = strassen(sum_matrix(a11, a22), sum_matrix(b11, b22), size); },
-      [&] { p2 = strassen(sum_matrix(a21, a22), b11, size); }, [&] { p3 = strassen(a11, sub(b12, b22), size); },
-      [&] { p4 = strassen(a22, sub(b21, b11), size); }, [&] { p5 = strassen(sum_matrix(a11, a12), b22, size); },
-      [&] { p6 = strassen(sub(a21, a11), sum_matrix(b11, b12), size); },
-      [&] { p7 = strassen(sub(a12, a22), sum_matrix(b21, b22), size); });
-
-  std::vector<double> c11 = sum_matrix(sum_matrix(p1, p4), sub(p7, p5));
-  std::vector<double> c12 = sum_matrix(p3, p5);
-  std::vector<double> c21 = sum_matrix(p2, p4);
-  std::vector<double> c22 = sum_matrix(sub(p1, p2), sum_matrix(p3, p6));
-  return tojoin(c11, c12, c21, c22);
-}
 bool Strssn_alg::run() {
   internal_order_test();
-  n = get_size(first_matrix);
-  result = strassen(first_matrix, second_matrix, n);
+  double* leaves = work.data() + levelsWorkspace(n, levels, tuning);
+  size_t leafSize = leafWorkspace(n, levels, tuning);
+  // run as a task, so that the calling thread has a slot in the arena even when the whole product is one leaf
+  tbb::task_group group;
+  group.run_and_wait([&] {
+    strassen(n, first_matrix.data(), n, second_matrix.data(), n, result.data(), n, work.data(), leaves, leafSize,
+             levels, tuning);
+  });
   return true;
 }
 std::vector<double> ijkalgorithm(const std::vector<double>& first_matrix, const std::vector<double>& second_matrix,
@@ -145,4 +127,4 @@ std::vector<double> ijkalgorithm(const std::vector<double>& first_matrix, const
     }
   }
   return result_matrix;
-}
\ No newline at end of file
+}
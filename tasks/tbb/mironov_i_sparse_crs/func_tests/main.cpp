@@ -155,3 +155,171 @@ TEST(mironov_i_sparse_crs_tbb, TestRandom) {
   testTask.run();
   testTask.post_processing();
 }
+
+TEST(mironov_i_sparse_crs_tbb, TestSymbolicReuse) {
+  std::vector<double> A = {2, 0, 2, 0, 0, 1, 0, 2, -2, 0, 3, 0};
+  std::vector<double> B = {2, 0, 0, 0, -3, 0, 0, 1, 4, 1, 2, 3};
+  std::vector<double> res = {4, 2, 8, 2, 1, 6, -4, 3, 12};
+  int n = 3;
+  int m = 4;
+  int k = 3;
+
+  mironov_tbb::MatrixCRS a(A.data(), n, m);
+  mironov_tbb::MatrixCRS b(B.data(), m, k);
+  mironov_tbb::MatrixCRS c = mironov_tbb::MultiplicateSymbolic(a, b, k);
+  ASSERT_EQ(c.NZ, c.RowIndex[n]);
+
+  for (int scale = 1; scale <= 3; scale++) {
+    for (auto &value : a.Value) {
+      value *= scale;
+    }
+    mironov_tbb::MultiplicateNumeric(a, b, k, c);
+    std::vector<double> C(n * k, 0.0);
+    for (int i = 0; i < n; i++) {
+      for (int c_j = c.RowIndex[i]; c_j < c.RowIndex[i + 1]; c_j++) {
+        C[i * k + c.Col[c_j]] = c.Value[c_j];
+      }
+    }
+    for (size_t i = 0; i < C.size(); i++) {
+      EXPECT_DOUBLE_EQ(res[i] * scale, C[i]);
+      res[i] *= scale;
+    }
+  }
+}
+
+TEST(mironov_i_sparse_crs_tbb, TestSparseInputOutput) {
+  // A = {{2, 0, 2, 0}, {0, 1, 0, 2}, {-2, 0, 3, 0}}, B = {{2, 0, 0}, {0, -3, 0}, {0, 1, 4}, {1, 2, 3}}
+  mironov_tbb::MatrixCRS A(3, 6);
+  A.Value = {2, 2, 1, 2, -2, 3};
+  A.Col = {0, 2, 1, 3, 0, 2};
+  A.RowIndex = {0, 2, 4, 6};
+  mironov_tbb::MatrixCRS B(4, 7);
+  B.Value = {2, -3, 1, 4, 1, 2, 3};
+  B.Col = {0, 1, 1, 2, 0, 1, 2};
+  B.RowIndex = {0, 1, 2, 4, 7};
+  mironov_tbb::MatrixCRS C;
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(&A));
+  taskData->inputs_count.emplace_back(3);
+  taskData->inputs_count.emplace_back(4);
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(&B));
+  taskData->inputs_count.emplace_back(4);
+  taskData->inputs_count.emplace_back(3);
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(&C));
+  taskData->outputs_count.emplace_back(1);
+
+  // Create Task
+  MironovITBBSparse testTask(taskData);
+  ASSERT_EQ(testTask.validation(), true);
+  testTask.pre_processing();
+  testTask.run();
+  testTask.post_processing();
+
+  ASSERT_EQ(C.N, 3);
+  EXPECT_EQ(C.RowIndex, std::vector<int>({0, 3, 6, 9}));
+  EXPECT_EQ(C.Col, std::vector<int>({0, 1, 2, 0, 1, 2, 0, 1, 2}));
+  std::vector<double> res = {4, 2, 8, 2, 1, 6, -4, 3, 12};
+  for (size_t i = 0; i < res.size(); i++) {
+    EXPECT_DOUBLE_EQ(res[i], C.Value[i]);
+  }
+}
+
+TEST(mironov_i_sparse_crs_tbb, TestSparseDimensionMismatch) {
+  mironov_tbb::MatrixCRS A(3, 0);
+  mironov_tbb::MatrixCRS B(5, 0);
+  mironov_tbb::MatrixCRS C;
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(&A));
+  taskData->inputs_count.emplace_back(3);
+  taskData->inputs_count.emplace_back(4);
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(&B));
+  taskData->inputs_count.emplace_back(5);
+  taskData->inputs_count.emplace_back(3);
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(&C));
+  taskData->outputs_count.emplace_back(1);
+
+  // Create Task
+  MironovITBBSparse testTask(taskData);
+  ASSERT_EQ(testTask.validation(), false);
+}
+
+TEST(mironov_i_sparse_crs_tbb, TestDenseToCCS) {
+  // wider than one conversion block, so several column slabs are filled independently
+  int n = 7;
+  int m = 150;
+  std::vector<double> A(n * m, 0.0);
+  for (int i = 0; i < n; i++) {
+    for (int j = (i * 3) % 5; j < m; j += 4 + i) {
+      A[i * m + j] = i * 1000 + j + 1;
+    }
+  }
+
+  mironov_tbb::MatrixCRS a(A.data(), n, m);
+  mironov_tbb::MatrixCRS at(A.data(), n, m, true);
+  ASSERT_EQ(a.N, n);
+  ASSERT_EQ(at.N, m);
+  ASSERT_EQ(a.NZ, at.NZ);
+  ASSERT_EQ(at.RowIndex[m], at.NZ);
+
+  std::vector<double> A_from_rows(n * m, 0.0);
+  std::vector<double> A_from_cols(n * m, 0.0);
+  for (int i = 0; i < n; i++) {
+    for (int j = a.RowIndex[i]; j < a.RowIndex[i + 1]; j++) {
+      A_from_rows[i * m + a.Col[j]] = a.Value[j];
+    }
+  }
+  for (int j = 0; j < m; j++) {
+    for (int k = at.RowIndex[j]; k < at.RowIndex[j + 1]; k++) {
+      if (k > at.RowIndex[j]) {
+        EXPECT_LT(at.Col[k - 1], at.Col[k]);
+      }
+      A_from_cols[at.Col[k] * m + j] = at.Value[k];
+    }
+  }
+  EXPECT_EQ(A, A_from_rows);
+  EXPECT_EQ(A, A_from_cols);
+}
+
+TEST(mironov_i_sparse_crs_tbb, TestSkewedRows) {
+  // power-law row lengths: row 0 is full, row i holds about n / (i + 1) entries
+  int n = 257;
+  std::vector<double> A(n * n, 0.0);
+  for (int i = 0; i < n; i++) {
+    for (int j = i % 3; j < n; j += i + 1) {
+      A[i * n + j] = (i + 2 * j) % 7 - 3;
+    }
+  }
+  std::vector<double> x(n);
+  for (int j = 0; j < n; j++) {
+    x[j] = j % 5 - 2;
+  }
+
+  mironov_tbb::MatrixCRS a(A.data(), n, n);
+  mironov_tbb::MatrixCRS c = mironov_tbb::MultiplicateSymbolic(a, a, n);
+  mironov_tbb::MultiplicateNumeric(a, a, n, c);
+  std::vector<double> y(n, -1.0);
+  mironov_tbb::MultiplicateVector(a, x.data(), y.data());
+
+  std::vector<double> C(n * n, 0.0);
+  for (int i = 0; i < n; i++) {
+    for (int c_j = c.RowIndex[i]; c_j < c.RowIndex[i + 1]; c_j++) {
+      C[i * n + c.Col[c_j]] = c.Value[c_j];
+    }
+  }
+  for (int i = 0; i < n; i++) {
+    double y_ref = 0.0;
+    for (int j = 0; j < n; j++) {
+      y_ref += A[i * n + j] * x[j];
+      double c_ref = 0.0;
+      for (int l = 0; l < n; l++) {
+        c_ref += A[i * n + l] * A[l * n + j];
+      }
+      ASSERT_DOUBLE_EQ(c_ref, C[i * n + j]);
+    }
+    EXPECT_DOUBLE_EQ(y_ref, y[i]);
+  }
+}
@@ -20,6 +20,15 @@ class MatrixCRS {
   explicit MatrixCRS(int n = 0, int nz = 0);
   MatrixCRS(const double* matrix, int n, int m, bool transpose = false);
 };
+
+// Symbolic phase of C = A * B, k is the number of columns of B: exact RowIndex and Col of C, Value allocated but
+// not filled. The result can be reused by MultiplicateNumeric for any A and B with the same sparsity pattern.
+MatrixCRS MultiplicateSymbolic(const MatrixCRS& A, const MatrixCRS& B, int k);
+// Numeric phase: fills C.Value for the structure produced by MultiplicateSymbolic.
+void MultiplicateNumeric(const MatrixCRS& A, const MatrixCRS& B, int k, MatrixCRS& C);
+// y = A * x. The rows and nonzeros are split together along the merge path, so every thread gets the same share of
+// work however unevenly the nonzeros are spread over the rows.
+void MultiplicateVector(const MatrixCRS& A, const double* x, double* y);
 }  // namespace mironov_tbb
 
 class MironovITBB : public ppc::core::Task {
@@ -34,9 +43,27 @@ class MironovITBB : public ppc::core::Task {
 
  private:
   mironov_tbb::MatrixCRS A;
-  mironov_tbb::MatrixCRS BT;
+  mironov_tbb::MatrixCRS B;
   mironov_tbb::MatrixCRS C;
   double* c_out{};
   int M{};
   int K{};
 };
+
+// Same multiplication without dense buffers: inputs[0] and inputs[1] point to mironov_tbb::MatrixCRS of A (n x m)
+// and B (m x k), inputs_count is {n, m, m, k}, outputs[0] points to the mironov_tbb::MatrixCRS receiving C.
+class MironovITBBSparse : public ppc::core::Task {
+ public:
+  explicit MironovITBBSparse(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+  bool pre_processing() override;
+  bool validation() override;
+  bool run() override;
+  bool post_processing() override;
+
+ private:
+  const mironov_tbb::MatrixCRS* A{};
+  const mironov_tbb::MatrixCRS* B{};
+  mironov_tbb::MatrixCRS C;
+  mironov_tbb::MatrixCRS* c_out{};
+  int K{};
+};
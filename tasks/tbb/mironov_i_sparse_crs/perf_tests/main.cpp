@@ -3,11 +3,104 @@
 #include <oneapi/tbb.h>
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <sstream>
+#include <string>
 #include <vector>
 
 #include "core/perf/include/perf.hpp"
 #include "tbb/mironov_i_sparse_crs/include/ops_tbb.hpp"
 
+namespace {
+// n x n matrix with row_nz random entries per row, built directly in CRS; a skewed matrix has power-law rows instead,
+// row i gets max(row_nz, n / (i + 1)) draws, with the dense rows on top as in a degree-sorted graph
+mironov_tbb::MatrixCRS GenerateCRS(int n, int row_nz, bool skewed = false) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> col(0, n - 1);
+  std::uniform_real_distribution<double> value(-10.0, 10.0);
+  mironov_tbb::MatrixCRS a(n, 0);
+  for (int i = 0; i < n; i++) {
+    std::vector<int> cols(skewed ? std::max(row_nz, n / (i + 1)) : row_nz);
+    for (auto &c : cols) {
+      c = col(gen);
+    }
+    std::sort(cols.begin(), cols.end());
+    cols.erase(std::unique(cols.begin(), cols.end()), cols.end());
+    for (int c : cols) {
+      a.Col.push_back(c);
+      a.Value.push_back(value(gen));
+    }
+    a.RowIndex[i + 1] = static_cast<int>(a.Col.size());
+  }
+  a.NZ = a.RowIndex[n];
+  return a;
+}
+
+// Largest number of multiply-adds of A * A given to one of parts ranges of equal row count, relative to the average;
+// this is the slowdown over a perfect split that plain row partitioning would suffer on the matrix.
+double RowSplitImbalance(const mironov_tbb::MatrixCRS &a, int parts) {
+  std::vector<double> flops(parts, 0.0);
+  for (int i = 0; i < a.N; i++) {
+    for (int j = a.RowIndex[i]; j < a.RowIndex[i + 1]; j++) {
+      flops[static_cast<int64_t>(i) * parts / a.N] += a.RowIndex[a.Col[j] + 1] - a.RowIndex[a.Col[j]];
+    }
+  }
+  double total = 0.0;
+  for (double f : flops) {
+    total += f;
+  }
+  return *std::max_element(flops.begin(), flops.end()) * parts / total;
+}
+
+// Runs body through Perf::task_run, first once to size the measurement and then often enough to take about a quarter
+// of a second, and prints the statistic with note; returns the time of one call.
+class KernelTask : public ppc::core::Task {
+ public:
+  explicit KernelTask(std::function<void()> body_)
+      : Task(std::make_shared<ppc::core::TaskData>()), body(std::move(body_)) {}
+  bool validation() override {
+    internal_order_test();
+    return true;
+  }
+  bool pre_processing() override {
+    internal_order_test();
+    return true;
+  }
+  bool run() override {
+    internal_order_test();
+    body();
+    return true;
+  }
+  bool post_processing() override {
+    internal_order_test();
+    return true;
+  }
+
+ private:
+  std::function<void()> body;
+};
+
+double MeasureKernel(const std::string &note, const std::function<void()> &body) {
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 1;
+  const auto t0 = oneapi::tbb::tick_count::now();
+  perfAttr->current_timer = [&] { return (oneapi::tbb::tick_count::now() - t0).seconds(); };
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+  ppc::core::Perf perfAnalyzer(std::make_shared<KernelTask>(body));
+  perfAnalyzer.task_run(perfAttr, perfResults);
+  perfAttr->num_running = std::clamp<uint64_t>(static_cast<uint64_t>(0.25 / std::max(perfResults->time_sec, 1e-6)) + 1,
+                                              1, 1000);
+  perfAnalyzer.task_run(perfAttr, perfResults);
+  perfResults->notes.insert(perfResults->notes.begin(),
+                            note + " (" + std::to_string(perfAttr->num_running) + " calls)");
+  ppc::core::Perf::print_perf_statistic(perfResults);
+  return perfResults->time_sec / static_cast<double>(perfAttr->num_running);
+}
+}  // namespace
+
 TEST(tbb_mironov_i_sparse_crs_perf_test, test_pipeline_run) {
   int n = 2000;
   int m = 2000;
@@ -87,3 +180,74 @@ TEST(tbb_mironov_i_sparse_crs_perf_test, test_task_run) {
   perfAnalyzer->task_run(perfAttr, perfResults);
   ppc::core::Perf::print_perf_statistic(perfResults);
 }
+
+// Power-law rows: the kernels split work by multiply-adds and nonzeros, not by rows, so the dense rows on top
+// do not end up on a single thread. Each kernel is measured against the same product with the rows divided evenly
+// between the threads.
+TEST(tbb_mironov_i_sparse_crs_skewed_perf_test, test_spgemm) {
+  int n = 50000;
+  mironov_tbb::MatrixCRS a = GenerateCRS(n, 4, true);
+  mironov_tbb::MatrixCRS c = mironov_tbb::MultiplicateSymbolic(a, a, n);
+  mironov_tbb::MatrixCRS c_rows = c;
+  int threads = oneapi::tbb::this_task_arena::max_concurrency();
+
+  std::ostringstream note;
+  note << "skewed A * A numeric phase, row split, nnz(A) = " << a.NZ << ", nnz(C) = " << c.NZ
+       << "; the busiest of " << threads << " threads gets " << RowSplitImbalance(a, threads) << "x the average work";
+  double rows_time = MeasureKernel(note.str(), [&] {
+    oneapi::tbb::parallel_for(
+        oneapi::tbb::blocked_range<int>(0, n, n / threads + 1),
+        [&](const oneapi::tbb::blocked_range<int> &range) {
+          std::vector<double> acc(n, 0.0);
+          for (int i = range.begin(); i < range.end(); i++) {
+            for (int j = a.RowIndex[i]; j < a.RowIndex[i + 1]; j++) {
+              for (int m = a.RowIndex[a.Col[j]]; m < a.RowIndex[a.Col[j] + 1]; m++) {
+                acc[a.Col[m]] += a.Value[j] * a.Value[m];
+              }
+            }
+            for (int j = c_rows.RowIndex[i]; j < c_rows.RowIndex[i + 1]; j++) {
+              c_rows.Value[j] = acc[c_rows.Col[j]];
+              acc[c_rows.Col[j]] = 0.0;
+            }
+          }
+        },
+        oneapi::tbb::simple_partitioner());
+  });
+  MeasureKernel("skewed A * A numeric phase, split by multiply-adds; the row split took " + std::to_string(rows_time) +
+                    " s per call",
+                [&] { mironov_tbb::MultiplicateNumeric(a, a, n, c); });
+  for (int j = 0; j < c.NZ; j++) {
+    ASSERT_NEAR(c_rows.Value[j], c.Value[j], 1e-9 * (1.0 + std::abs(c_rows.Value[j])));
+  }
+}
+
+TEST(tbb_mironov_i_sparse_crs_skewed_perf_test, test_spmv) {
+  int n = 300000;
+  int threads = oneapi::tbb::this_task_arena::max_concurrency();
+  mironov_tbb::MatrixCRS a = GenerateCRS(n, 4, true);
+  std::vector<double> x(n, 1.0);
+  std::vector<double> y(n);
+  std::vector<double> y_rows(n);
+  double bytes = 12.0 * a.NZ + 4.0 * (n + 1) + 16.0 * n;
+
+  std::ostringstream note;
+  note << "skewed SpMV, row split, nnz = " << a.NZ << ", " << bytes / (1 << 20) << " MiB moved per call";
+  double rows_time = MeasureKernel(note.str(), [&] {
+    oneapi::tbb::parallel_for(oneapi::tbb::blocked_range<int>(0, n, n / threads + 1),
+                              [&](const oneapi::tbb::blocked_range<int> &range) {
+                                for (int i = range.begin(); i < range.end(); i++) {
+                                  double sum = 0.0;
+                                  for (int j = a.RowIndex[i]; j < a.RowIndex[i + 1]; j++) {
+                                    sum += a.Value[j] * x[a.Col[j]];
+                                  }
+                                  y_rows[i] = sum;
+                                }
+                              },
+                              oneapi::tbb::simple_partitioner());
+  });
+  MeasureKernel("skewed SpMV, merge path; the row split took " + std::to_string(rows_time) + " s per call",
+                [&] { mironov_tbb::MultiplicateVector(a, x.data(), y.data()); });
+  for (int i = 0; i < n; i++) {
+    ASSERT_NEAR(y_rows[i], y[i], 1e-9 * (1.0 + std::abs(y_rows[i])));
+  }
+}
@@ -3,9 +3,15 @@
 
 #include <oneapi/tbb.h>
 
-#include <cstring>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
 #include <random>
+#include <utility>
 #include <vector>
+
+#include "core/sparse/include/compress.hpp"
 const double EPS = 1e-6;
 
 mironov_tbb::MatrixCRS::MatrixCRS(int n, int nz) : N(n), NZ(nz) {
@@ -14,87 +20,179 @@ mironov_tbb::MatrixCRS::MatrixCRS(int n, int nz) : N(n), NZ(nz) {
   RowIndex.resize(n + 1);
 }
 
-mironov_tbb::MatrixCRS::MatrixCRS(const double* matrix, int n, int m, bool transpose) {
-  int index;
-  if (transpose) {
-    N = m;
-    m = n;
-  } else {
-    N = n;
-  }
-  RowIndex.reserve(N + 1);
-  NZ = 0;
+namespace {
+// Replaces per-row counts with their exclusive prefix sums; data[n] receives the total.
+void ExclusiveScan(int* data, int n) {
+  data[n] = tbb::parallel_scan(
+      tbb::blocked_range<int>(0, n), 0,
+      [&](const tbb::blocked_range<int>& range, int sum, bool is_final_scan) {
+        for (int i = range.begin(); i < range.end(); i++) {
+          int tmp = data[i];
+          if (is_final_scan) {
+            data[i] = sum;
+          }
+          sum += tmp;
+        }
+        return sum;
+      },
+      std::plus<>());
+}
+
+// Splits the rows of C = A * B into parts contiguous ranges of equal merge-path length (one step per row plus one per
+// multiply-add), so a few dense rows of a power-law matrix do not leave the other threads idle.
+std::vector<int> BalancedRowSplit(const mironov_tbb::MatrixCRS& A, const mironov_tbb::MatrixCRS& B, int parts) {
+  int N = A.N;
+  std::vector<int64_t> work(N + 1, 0);
+  tbb::parallel_for(0, N, [&](int i) {
+    int64_t flops = 1;
+    for (int a_j = A.RowIndex[i]; a_j < A.RowIndex[i + 1]; a_j++) {
+      flops += B.RowIndex[A.Col[a_j] + 1] - B.RowIndex[A.Col[a_j]];
+    }
+    work[i + 1] = flops;
+  });
   for (int i = 0; i < N; i++) {
-    RowIndex[i] = NZ;
-    for (int j = 0; j < m; j++) {
-      index = transpose ? i + N * j : i * m + j;
-      if (std::fabs(matrix[index]) >= EPS) {
-        Value.push_back(matrix[index]);
-        Col.push_back(j);
-        NZ++;
-      }
+    work[i + 1] += work[i];
+  }
+  // work is strictly increasing, so split[0] == 0 and split[parts] == N
+  std::vector<int> split(parts + 1);
+  for (int p = 0; p <= parts; p++) {
+    split[p] = std::lower_bound(work.begin(), work.end(), work[N] * p / parts) - work.begin();
+  }
+  return split;
+}
+
+// Coordinate reached after d steps of the walk that merges the row ends of A with the nonzero indices:
+// first = rows completed, second = nonzeros consumed.
+std::pair<int, int> MergePathSearch(int64_t d, const mironov_tbb::MatrixCRS& A) {
+  int lo = static_cast<int>(std::max<int64_t>(d - A.NZ, 0));
+  int hi = static_cast<int>(std::min<int64_t>(d, A.N));
+  while (lo < hi) {
+    int pivot = lo + (hi - lo) / 2;
+    if (A.RowIndex[pivot + 1] <= d - pivot - 1) {
+      lo = pivot + 1;
+    } else {
+      hi = pivot;
     }
   }
-  RowIndex[N] = NZ;
+  return {lo, static_cast<int>(d - lo)};
 }
 
-mironov_tbb::MatrixCRS Multiplicate2(const mironov_tbb::MatrixCRS& A, const mironov_tbb::MatrixCRS& BT, int m) {
+// ranges per thread; more than one lets work stealing absorb rows that cannot be split
+const int PARTS_PER_THREAD = 4;
+}  // namespace
+
+mironov_tbb::MatrixCRS::MatrixCRS(const double* matrix, int n, int m, bool transpose) : N(transpose ? m : n) {
+  // transposed, the rows of the result are the columns of matrix, so it is compressed by columns
+  auto nonzero = [](double v) { return std::fabs(v) >= EPS; };
+  ppc::core::DenseToCompressed(matrix, n, m, transpose, nonzero, Value, Col, RowIndex,
+                               tbb::this_task_arena::max_concurrency());
+  NZ = RowIndex[N];
+}
+
+mironov_tbb::MatrixCRS mironov_tbb::MultiplicateSymbolic(const MatrixCRS& A, const MatrixCRS& B, int k) {
   int N = A.N;
-  auto* columns = new std::vector<int>[N];
-  auto* values = new std::vector<double>[N];
-  int* row_index = new int[N + 1];
-  memset(row_index, 0, sizeof(int) * N);
-  tbb::parallel_for(tbb::blocked_range<int>(0, N), [&](const tbb::blocked_range<int>& range) {
-    int j;
-    int k;
-    int* temp = new int[m];
-    for (int i = range.begin(); i < range.end(); i++) {
-      memset(temp, -1, m * sizeof(*temp));
-      int ind1 = A.RowIndex[i];
-      int ind2 = A.RowIndex[i + 1];
-      for (k = ind1; k < ind2; k++) {
-        temp[A.Col[k]] = k;
+  int parts = tbb::this_task_arena::max_concurrency() * PARTS_PER_THREAD;
+  std::vector<int> split = BalancedRowSplit(A, B, parts);
+  std::vector<int> row_index(N + 1, 0);
+  // first pass: exact number of structural nonzeros in every row of C
+  tbb::enumerable_thread_specific<std::vector<int>> marks(std::vector<int>(k, -1));
+  tbb::parallel_for(0, parts, [&](int p) {
+    std::vector<int>& mark = marks.local();
+    for (int i = split[p]; i < split[p + 1]; i++) {
+      int count = 0;
+      for (int a_j = A.RowIndex[i]; a_j < A.RowIndex[i + 1]; a_j++) {
+        int row = A.Col[a_j];
+        for (int b_j = B.RowIndex[row]; b_j < B.RowIndex[row + 1]; b_j++) {
+          if (mark[B.Col[b_j]] != i) {
+            mark[B.Col[b_j]] = i;
+            count++;
+          }
+        }
       }
-      for (j = 0; j < BT.N; j++) {
-        double sum = 0;
-        int ind3 = BT.RowIndex[j];
-        int ind4 = BT.RowIndex[j + 1];
-        for (k = ind3; k < ind4; k++) {
-          int aind = temp[BT.Col[k]];
-          if (aind != -1) {
-            sum += A.Value[aind] * BT.Value[k];
+      row_index[i] = count;
+    }
+  });
+  ExclusiveScan(row_index.data(), N);
+
+  MatrixCRS C(N, row_index[N]);
+  C.RowIndex = std::move(row_index);
+  // second pass: column indices are written straight into their final place
+  // stamps left by the first pass would hide the same rows here
+  marks.clear();
+  tbb::parallel_for(0, parts, [&](int p) {
+    std::vector<int>& mark = marks.local();
+    for (int i = split[p]; i < split[p + 1]; i++) {
+      int pos = C.RowIndex[i];
+      for (int a_j = A.RowIndex[i]; a_j < A.RowIndex[i + 1]; a_j++) {
+        int row = A.Col[a_j];
+        for (int b_j = B.RowIndex[row]; b_j < B.RowIndex[row + 1]; b_j++) {
+          if (mark[B.Col[b_j]] != i) {
+            mark[B.Col[b_j]] = i;
+            C.Col[pos++] = B.Col[b_j];
           }
         }
-        if (fabs(sum) > EPS) {
-          columns[i].push_back(j);
-          values[i].push_back(sum);
-          row_index[i]++;
+      }
+      std::sort(C.Col.begin() + C.RowIndex[i], C.Col.begin() + pos);
+    }
+  });
+  return C;
+}
+
+void mironov_tbb::MultiplicateNumeric(const MatrixCRS& A, const MatrixCRS& B, int k, MatrixCRS& C) {
+  int parts = tbb::this_task_arena::max_concurrency() * PARTS_PER_THREAD;
+  std::vector<int> split = BalancedRowSplit(A, B, parts);
+  tbb::enumerable_thread_specific<std::vector<double>> accs(std::vector<double>(k, 0.0));
+  tbb::parallel_for(0, parts, [&](int p) {
+    std::vector<double>& acc = accs.local();
+    for (int i = split[p]; i < split[p + 1]; i++) {
+      for (int a_j = A.RowIndex[i]; a_j < A.RowIndex[i + 1]; a_j++) {
+        int row = A.Col[a_j];
+        double a_val = A.Value[a_j];
+        for (int b_j = B.RowIndex[row]; b_j < B.RowIndex[row + 1]; b_j++) {
+          acc[B.Col[b_j]] += a_val * B.Value[b_j];
         }
       }
+      for (int c_j = C.RowIndex[i]; c_j < C.RowIndex[i + 1]; c_j++) {
+        C.Value[c_j] = acc[C.Col[c_j]];
+        acc[C.Col[c_j]] = 0.0;
+      }
     }
-    delete[] temp;
   });
-  // }
-  int NZ = 0;
-  int i;
-  for (i = 0; i < N; i++) {
-    int tmp = row_index[i];
-    row_index[i] = NZ;
-    NZ += tmp;
-  }
-  row_index[N] = NZ;
-  mironov_tbb::MatrixCRS C(N, NZ);
-  int count = 0;
-  for (i = 0; i < N; i++) {
-    int size = columns[i].size();
-    memcpy(C.Col.data() + count, columns[i].data(), size * sizeof(*columns[i].data()));
-    memcpy(C.Value.data() + count, values[i].data(), size * sizeof(*values[i].data()));
-    count += size;
+}
+
+void mironov_tbb::MultiplicateVector(const MatrixCRS& A, const double* x, double* y) {
+  int parts = tbb::this_task_arena::max_concurrency();
+  int64_t total = static_cast<int64_t>(A.N) + A.NZ;
+  // every range ends inside at most one row; its partial sum is added once all ranges are done
+  std::vector<int> carry_row(parts);
+  std::vector<double> carry_value(parts);
+  tbb::parallel_for(0, parts, [&](int p) {
+    auto [row, nz] = MergePathSearch(total * p / parts, A);
+    auto [row_end, nz_end] = MergePathSearch(total * (p + 1) / parts, A);
+    for (; row < row_end; row++) {
+      double sum = 0.0;
+      for (; nz < A.RowIndex[row + 1]; nz++) {
+        sum += A.Value[nz] * x[A.Col[nz]];
+      }
+      y[row] = sum;
+    }
+    double sum = 0.0;
+    for (; nz < nz_end; nz++) {
+      sum += A.Value[nz] * x[A.Col[nz]];
+    }
+    carry_row[p] = row_end;
+    carry_value[p] = sum;
+  });
+  for (int p = 0; p < parts; p++) {
+    if (carry_row[p] < A.N) {
+      y[carry_row[p]] += carry_value[p];
+    }
   }
-  memcpy(C.RowIndex.data(), row_index, (N + 1) * sizeof(*row_index));
-  delete[] row_index;
-  delete[] columns;
-  delete[] values;
+}
+
+mironov_tbb::MatrixCRS Multiplicate2(const mironov_tbb::MatrixCRS& A, const mironov_tbb::MatrixCRS& B, int k) {
+  mironov_tbb::MatrixCRS C = mironov_tbb::MultiplicateSymbolic(A, B, k);
+  mironov_tbb::MultiplicateNumeric(A, B, k, C);
   return C;
 }
 
@@ -103,7 +201,7 @@ bool MironovITBB::pre_processing() {
   M = taskData->inputs_count[1];
   K = taskData->inputs_count[3];
   A = mironov_tbb::MatrixCRS(reinterpret_cast<double*>(taskData->inputs[0]), taskData->inputs_count[0], M, false);
-  BT = mironov_tbb::MatrixCRS(reinterpret_cast<double*>(taskData->inputs[1]), taskData->inputs_count[2], K, true);
+  B = mironov_tbb::MatrixCRS(reinterpret_cast<double*>(taskData->inputs[1]), taskData->inputs_count[2], K, false);
   c_out = reinterpret_cast<double*>(taskData->outputs[0]);
   return true;
 }
@@ -136,7 +234,7 @@ void PrintCRSMatrix(const mironov_tbb::MatrixCRS& matrix, int m) {
 
 bool MironovITBB::run() {
   internal_order_test();
-  C = Multiplicate2(A, BT, M);
+  C = Multiplicate2(A, B, K);
   return true;
 }
 
@@ -150,6 +248,42 @@ bool MironovITBB::post_processing() {
   return true;
 }
 
+bool MironovITBBSparse::pre_processing() {
+  internal_order_test();
+  A = reinterpret_cast<mironov_tbb::MatrixCRS*>(taskData->inputs[0]);
+  B = reinterpret_cast<mironov_tbb::MatrixCRS*>(taskData->inputs[1]);
+  K = taskData->inputs_count[3];
+  c_out = reinterpret_cast<mironov_tbb::MatrixCRS*>(taskData->outputs[0]);
+  return true;
+}
+
+bool MironovITBBSparse::validation() {
+  internal_order_test();
+  if (taskData->inputs.size() != 2 || taskData->inputs_count.size() != 4 || taskData->outputs.size() != 1) {
+    return false;
+  }
+  if (taskData->inputs[0] == nullptr || taskData->inputs[1] == nullptr || taskData->outputs[0] == nullptr) {
+    return false;
+  }
+  const auto* a = reinterpret_cast<mironov_tbb::MatrixCRS*>(taskData->inputs[0]);
+  const auto* b = reinterpret_cast<mironov_tbb::MatrixCRS*>(taskData->inputs[1]);
+  return taskData->inputs_count[1] == taskData->inputs_count[2] &&
+         a->N == static_cast<int>(taskData->inputs_count[0]) && b->N == static_cast<int>(taskData->inputs_count[2]) &&
+         taskData->inputs_count[3] != 0u;
+}
+
+bool MironovITBBSparse::run() {
+  internal_order_test();
+  C = Multiplicate2(*A, *B, K);
+  return true;
+}
+
+bool MironovITBBSparse::post_processing() {
+  internal_order_test();
+  *c_out = std::move(C);
+  return true;
+}
+
 void MironovITBB::genrateSparseMatrix(double* matrix, int sz, double ro) {
   int nz = sz * ro;
   std::uniform_int_distribution<int> distribution(0, sz - 1);
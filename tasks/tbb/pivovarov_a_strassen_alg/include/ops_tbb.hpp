@@ -7,6 +7,7 @@
 #include <utility>
 #include <vector>
 
+#include "core/gemm/include/strassen.hpp"
 #include "core/task/include/task.hpp"
 
 class TestTaskTBBParallelPivovarovStrassen : public ppc::core::Task {
@@ -23,6 +24,10 @@ class TestTaskTBBParallelPivovarovStrassen : public ppc::core::Task {
   std::vector<double> B;
   std::vector<double> result;
   int n = 0, m = 0;
+  // operand sums and products of the levels run as tasks, then a leaf workspace for each thread
+  std::vector<double> work;
+  ppc::core::StrassenTuning tuning{};
+  int levels = 0;
 };
 
 inline std::vector<double> createRndMatrix(int n) {
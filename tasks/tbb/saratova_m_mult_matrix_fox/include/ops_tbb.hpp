@@ -6,6 +6,7 @@
 #include <utility>
 #include <vector>
 
+#include "core/gemm/include/tiled.hpp"
 #include "core/task/include/task.hpp"
 
 namespace saratova_tbb {
@@ -16,10 +17,9 @@ void FillRandomValues(double *matrix, int size);
 
 class SaratovaTaskSequential : public ppc::core::Task {
  private:
-  size_t dimension{};
-  double *matrixA{nullptr};
-  double *matrixB{nullptr};
-  double *matrixC{nullptr};
+  ppc::core::TiledMatrix matrixA;
+  ppc::core::TiledMatrix matrixB;
+  ppc::core::TiledMatrix matrixC;
 
  public:
   explicit SaratovaTaskSequential(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
@@ -31,10 +31,9 @@ class SaratovaTaskSequential : public ppc::core::Task {
 
 class SaratovaTaskTbb : public ppc::core::Task {
  private:
-  size_t dimension{};
-  double *matrixA{nullptr};
-  double *matrixB{nullptr};
-  double *matrixC{nullptr};
+  ppc::core::TiledMatrix matrixA;
+  ppc::core::TiledMatrix matrixB;
+  ppc::core::TiledMatrix matrixC;
 
  public:
   explicit SaratovaTaskTbb(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
@@ -10,6 +10,20 @@ namespace SavchukTbb {
 
 using Complex = std::complex<double>;
 
+// Matrix in compressed rows: rowPtr has numRows + 1 entries and the columns of row i are
+// colPtr[rowPtr[i]], ..., colPtr[rowPtr[i + 1] - 1] in increasing order.
+struct MatrixCRS {
+  std::vector<Complex> values;
+  std::vector<int> rowPtr;
+  std::vector<int> colPtr;
+  int numRows{};
+  int numCols{};
+};
+
+// C = A * B without dense buffers: the rows of C are counted first and then written at their final offsets, so C keeps
+// every structural nonzero, including products that cancel.
+MatrixCRS MultiplyCRS(const MatrixCRS &a, const MatrixCRS &b);
+
 class SavchukCRSMatMultTBBSequential : public ppc::core::Task {
  public:
   explicit SavchukCRSMatMultTBBSequential(std::shared_ptr<ppc::core::TaskData> taskData_)
@@ -54,4 +68,21 @@ class SavchukCRSMatMultTBBParallel : public ppc::core::Task {
   int numCols2{};
   Complex *result{};
 };
-}  // namespace SavchukTbb
\ No newline at end of file
+
+// Same multiplication without dense buffers: inputs[0] and inputs[1] point to the MatrixCRS of A (n1 x m1) and
+// B (m1 x m2), inputs_count is {n1, m1, m1, m2}, outputs[0] points to the MatrixCRS receiving C.
+class SavchukCRSMatMultTBBSparse : public ppc::core::Task {
+ public:
+  explicit SavchukCRSMatMultTBBSparse(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+  bool pre_processing() override;
+  bool validation() override;
+  bool run() override;
+  bool post_processing() override;
+
+ private:
+  const MatrixCRS *a{};
+  const MatrixCRS *b{};
+  MatrixCRS c;
+  MatrixCRS *out{};
+};
+}  // namespace SavchukTbb
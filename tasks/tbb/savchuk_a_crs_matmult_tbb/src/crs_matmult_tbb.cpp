@@ -2,8 +2,12 @@
 
 #include "tbb/savchuk_a_crs_matmult_tbb/include/crs_matmult_tbb.hpp"
 
+#include <algorithm>
+
 #include <tbb/tbb.h>
 
+#include "core/sparse/include/compress.hpp"
+
 using namespace SavchukTbb;
 
 bool SavchukCRSMatMultTBBSequential::validation() {
@@ -26,33 +30,9 @@ bool SavchukCRSMatMultTBBSequential::pre_processing() {
 
   result = new Complex[numRows1 * numCols2]{Complex(0.0)};
 
-  int notNullNumbers = 0;
-  for (int i = 0; i < numRows1; ++i) {
-    rowPtr1.push_back(notNullNumbers);
-    for (int j = 0; j < numCols1; ++j) {
-      int index = i * numCols1 + j;
-      if (matrix1[index] != Complex(0.0, 0.0)) {
-        values1.push_back(matrix1[index]);
-        colPtr1.push_back(j);
-        notNullNumbers++;
-      }
-    }
-  }
-  rowPtr1.push_back(notNullNumbers);
-
-  notNullNumbers = 0;
-  for (int i = 0; i < numRows2; ++i) {
-    rowPtr2.push_back(notNullNumbers);
-    for (int j = 0; j < numCols2; ++j) {
-      int index = i * numCols2 + j;
-      if (matrix2[index] != Complex(0.0, 0.0)) {
-        values2.push_back(matrix2[index]);
-        colPtr2.push_back(j);
-        notNullNumbers++;
-      }
-    }
-  }
-  rowPtr2.push_back(notNullNumbers);
+  auto nonzero = [](const Complex& v) { return v != Complex(0.0, 0.0); };
+  ppc::core::DenseToCompressed(matrix1, numRows1, numCols1, false, nonzero, values1, colPtr1, rowPtr1);
+  ppc::core::DenseToCompressed(matrix2, numRows2, numCols2, false, nonzero, values2, colPtr2, rowPtr2);
 
   return true;
 }
@@ -110,33 +90,11 @@ bool SavchukCRSMatMultTBBParallel::pre_processing() {
 
   result = new Complex[numRows1 * numCols2]{0.0};
 
-  int notNullNumbers = 0;
-  for (int i = 0; i < numRows1; ++i) {
-    rowPtr1.push_back(notNullNumbers);
-    for (int j = 0; j < numCols1; ++j) {
-      int index = i * numCols1 + j;
-      if (matrix1[index] != 0.0) {
-        values1.push_back(matrix1[index]);
-        colPtr1.push_back(j);
-        notNullNumbers++;
-      }
-    }
-  }
-  rowPtr1.push_back(notNullNumbers);
-
-  notNullNumbers = 0;
-  for (int i = 0; i < numRows2; ++i) {
-    rowPtr2.push_back(notNullNumbers);
-    for (int j = 0; j < numCols2; ++j) {
-      int index = i * numCols2 + j;
-      if (matrix2[index] != 0.0) {
-        values2.push_back(matrix2[index]);
-        colPtr2.push_back(j);
-        notNullNumbers++;
-      }
-    }
-  }
-  rowPtr2.push_back(notNullNumbers);
+  auto nonzero = [](const Complex& v) { return v != 0.0; };
+  ppc::core::DenseToCompressed(matrix1, numRows1, numCols1, false, nonzero, values1, colPtr1, rowPtr1,
+                               tbb::this_task_arena::max_concurrency());
+  ppc::core::DenseToCompressed(matrix2, numRows2, numCols2, false, nonzero, values2, colPtr2, rowPtr2,
+                               tbb::this_task_arena::max_concurrency());
 
   return true;
 }
@@ -172,4 +130,109 @@ bool SavchukCRSMatMultTBBParallel::post_processing() {
   delete[] result;
 
   return true;
-}
\ No newline at end of file
+}
+
+MatrixCRS SavchukTbb::MultiplyCRS(const MatrixCRS& a, const MatrixCRS& b) {
+  MatrixCRS c;
+  c.numRows = a.numRows;
+  c.numCols = b.numCols;
+  c.rowPtr.assign(a.numRows + 1, 0);
+
+  // first pass: the number of structural nonzeros of every row of C
+  tbb::parallel_for(tbb::blocked_range<int>(0, a.numRows), [&](const tbb::blocked_range<int>& range) {
+    std::vector<int> mark(b.numCols, -1);
+    for (int i = range.begin(); i < range.end(); i++) {
+      int count = 0;
+      for (int j = a.rowPtr[i]; j < a.rowPtr[i + 1]; j++) {
+        int col1 = a.colPtr[j];
+        for (int k = b.rowPtr[col1]; k < b.rowPtr[col1 + 1]; k++) {
+          if (mark[b.colPtr[k]] != i) {
+            mark[b.colPtr[k]] = i;
+            count++;
+          }
+        }
+      }
+      c.rowPtr[i + 1] = count;
+    }
+  });
+
+  // prefix sum: rowPtr[i] becomes the offset of row i in the final arrays
+  for (int i = 0; i < a.numRows; i++) {
+    c.rowPtr[i + 1] += c.rowPtr[i];
+  }
+  c.colPtr.resize(c.rowPtr[a.numRows]);
+  c.values.resize(c.rowPtr[a.numRows]);
+
+  // second pass: every row is written straight into its place in the final arrays
+  tbb::parallel_for(tbb::blocked_range<int>(0, a.numRows), [&](const tbb::blocked_range<int>& range) {
+    std::vector<Complex> row(b.numCols);
+    std::vector<int> mark(b.numCols, -1);
+    for (int i = range.begin(); i < range.end(); i++) {
+      int pos = c.rowPtr[i];
+      for (int j = a.rowPtr[i]; j < a.rowPtr[i + 1]; j++) {
+        int col1 = a.colPtr[j];
+        for (int k = b.rowPtr[col1]; k < b.rowPtr[col1 + 1]; k++) {
+          int col2 = b.colPtr[k];
+          if (mark[col2] != i) {
+            mark[col2] = i;
+            c.colPtr[pos++] = col2;
+          }
+          row[col2] += a.values[j] * b.values[k];
+        }
+      }
+      std::sort(c.colPtr.begin() + c.rowPtr[i], c.colPtr.begin() + pos);
+      for (int j = c.rowPtr[i]; j < pos; j++) {
+        c.values[j] = row[c.colPtr[j]];
+        row[c.colPtr[j]] = Complex(0.0, 0.0);
+      }
+    }
+  });
+
+  return c;
+}
+
+bool SavchukCRSMatMultTBBSparse::validation() {
+  internal_order_test();
+
+  if (taskData->inputs.size() != 2 || taskData->inputs_count.size() != 4 || taskData->outputs.size() != 1) {
+    return false;
+  }
+  if (taskData->inputs[0] == nullptr || taskData->inputs[1] == nullptr || taskData->outputs[0] == nullptr) {
+    return false;
+  }
+  const auto* matrix1 = reinterpret_cast<MatrixCRS*>(taskData->inputs[0]);
+  const auto* matrix2 = reinterpret_cast<MatrixCRS*>(taskData->inputs[1]);
+  return taskData->inputs_count[1] == taskData->inputs_count[2] &&
+         matrix1->numRows == static_cast<int>(taskData->inputs_count[0]) &&
+         matrix1->numCols == static_cast<int>(taskData->inputs_count[1]) &&
+         matrix2->numRows == static_cast<int>(taskData->inputs_count[2]) &&
+         matrix2->numCols == static_cast<int>(taskData->inputs_count[3]) &&
+         matrix1->rowPtr.size() == static_cast<size_t>(matrix1->numRows) + 1 &&
+         matrix2->rowPtr.size() == static_cast<size_t>(matrix2->numRows) + 1;
+}
+
+bool SavchukCRSMatMultTBBSparse::pre_processing() {
+  internal_order_test();
+
+  a = reinterpret_cast<MatrixCRS*>(taskData->inputs[0]);
+  b = reinterpret_cast<MatrixCRS*>(taskData->inputs[1]);
+  out = reinterpret_cast<MatrixCRS*>(taskData->outputs[0]);
+
+  return true;
+}
+
+bool SavchukCRSMatMultTBBSparse::run() {
+  internal_order_test();
+
+  c = MultiplyCRS(*a, *b);
+
+  return true;
+}
+
+bool SavchukCRSMatMultTBBSparse::post_processing() {
+  internal_order_test();
+
+  *out = std::move(c);
+
+  return true;
+}
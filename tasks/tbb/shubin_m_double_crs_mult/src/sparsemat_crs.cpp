@@ -2,8 +2,12 @@
 
 #include "tbb/shubin_m_double_crs_mult/include/sparsemat_crs.hpp"
 
+#include <tbb/tbb.h>
+
 #include <cmath>
 
+#include "core/sparse/include/compress.hpp"
+
 SparseMat_CRS::SparseMat_CRS(size_t _row_c, size_t _col_c) {
   row_c = _row_c;
   col_c = _col_c;
@@ -18,19 +22,11 @@ SparseMat_CRS::SparseMat_CRS(size_t _row_c, size_t _col_c, size_t _nz_c) {
 SparseMat_CRS::SparseMat_CRS(const std::vector<double>& matrix, size_t _row_c, size_t _col_c) {
   row_c = _row_c;
   col_c = _col_c;
-  nz_c = 0;
-  for (size_t i = 0; i < row_c; i++) {
-    row_ind.push_back(val.size());
-    for (size_t j = 0; j < col_c; j++) {
-      double temp = matrix[i * col_c + j];
-      if (std::abs(temp) > PRECISION) {
-        val.push_back(temp);
-        col_ind.push_back(j);
-        nz_c++;
-      }
-    }
-  }
-  row_ind.push_back(val.size());
+  auto nonzero = [](double temp) { return std::abs(temp) > PRECISION; };
+  ppc::core::DenseToCompressed(matrix.data(), static_cast<int>(row_c), static_cast<int>(col_c), false, nonzero, val,
+                               col_ind, row_ind,
+                               tbb::this_task_arena::max_concurrency());
+  nz_c = val.size();
 }
 
 SparseMat_CRS random_CRS_mat(size_t _row_c, size_t _col_c, double dens, double _min, double _max) {
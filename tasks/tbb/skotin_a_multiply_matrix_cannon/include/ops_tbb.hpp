@@ -1,9 +1,9 @@
 // Copyright 2024 Skotin Alexander
 #pragma once
 
-#include <string>
 #include <vector>
 
+#include "core/gemm/include/tiled.hpp"
 #include "core/task/include/task.hpp"
 
 class SkotinMatrixMultiplicationTBBSeq : public ppc::core::Task {
@@ -17,12 +17,9 @@ class SkotinMatrixMultiplicationTBBSeq : public ppc::core::Task {
   bool post_processing() override;
 
  private:
-  std::vector<std::vector<double>> matrixA;
-  std::vector<std::vector<double>> matrixB;
-  std::vector<std::vector<double>> resultMatrix;
-
-  static bool loadMatrix(const std::vector<double>& inputData, std::vector<std::vector<double>>& matrix, size_t size);
-  bool saveResult();
+  ppc::core::TiledMatrix matrixA;
+  ppc::core::TiledMatrix matrixB;
+  ppc::core::TiledMatrix resultMatrix;
 };
 
 class SkotinMatrixMultiplicationTBBParallel : public ppc::core::Task {
@@ -36,10 +33,7 @@ class SkotinMatrixMultiplicationTBBParallel : public ppc::core::Task {
   bool post_processing() override;
 
  private:
-  std::vector<std::vector<double>> matrixA;
-  std::vector<std::vector<double>> matrixB;
-  std::vector<std::vector<double>> resultMatrix;
-
-  static bool loadMatrix(const std::vector<double>& inputData, std::vector<std::vector<double>>& matrix, size_t size);
-  bool saveResult();
+  ppc::core::TiledMatrix matrixA;
+  ppc::core::TiledMatrix matrixB;
+  ppc::core::TiledMatrix resultMatrix;
 };
@@ -3,11 +3,21 @@
 
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_for.h>
-#include <tbb/spin_mutex.h>
+#include <tbb/task_arena.h>
 
-#include <algorithm>
 #include <cmath>
-#include <cstring>
+#include <iostream>
+
+#include "core/gemm/include/blocking.hpp"
+#include "core/gemm/include/gemm.hpp"
+
+namespace {
+void multiplyBlock(const ppc::core::TiledMatrix& A, const ppc::core::TiledMatrix& B, ppc::core::TiledMatrix& C, int i,
+                   int j, int k) {
+  int t = C.Tile();
+  ppc::core::Gemm(t, t, t, A.Block(i, k), t, B.Block(k, j), t, C.Block(i, j), t);
+}
+}  // namespace
 
 bool SkotinMatrixMultiplicationTBBSeq::pre_processing() {
   size_t totalElementsPerMatrix = taskData->inputs_count[0] / sizeof(double);
@@ -18,46 +28,43 @@ bool SkotinMatrixMultiplicationTBBSeq::pre_processing() {
     return false;
   }
 
-  std::vector<double> matrixAData(matrixSize * matrixSize);
-  memcpy(matrixAData.data(), taskData->inputs[0], taskData->inputs_count[0]);
-
-  if (!loadMatrix(matrixAData, matrixA, matrixSize)) {
-    std::cerr << "Failed to load matrix A." << std::endl;
+  if (taskData->inputs_count[1] != taskData->inputs_count[0]) {
+    std::cerr << "Failed to load matrix B." << std::endl;
     return false;
   }
 
-  std::vector<double> matrixBData(matrixSize * matrixSize);
-  memcpy(matrixBData.data(), taskData->inputs[1], taskData->inputs_count[1]);
-
-  if (!loadMatrix(matrixBData, matrixB, matrixSize)) {
-    std::cerr << "Failed to load matrix B." << std::endl;
-    return false;
+  matrixA = ppc::core::TiledMatrix();
+  matrixB = ppc::core::TiledMatrix();
+  if (matrixSize == 0) {
+    return true;
   }
 
-  resultMatrix.resize(matrixSize, std::vector<double>(matrixSize, 0));
+  // blocks are contiguous tiles that Gemm reads in place; edge blocks are padded with zeros, so the block size
+  // measured for this host does not have to divide the matrix size
+  int n = static_cast<int>(matrixSize);
+  int block = ppc::core::TuneBlockSize("cannon", n, 1);
+  matrixA = ppc::core::TiledMatrix(n, n, block);
+  matrixB = ppc::core::TiledMatrix(n, n, block);
+  resultMatrix = ppc::core::TiledMatrix(n, n, block);
+  matrixA.FromRowMajor(reinterpret_cast<double*>(taskData->inputs[0]), n);
+  matrixB.FromRowMajor(reinterpret_cast<double*>(taskData->inputs[1]), n);
   return true;
 }
 
 bool SkotinMatrixMultiplicationTBBSeq::validation() {
-  if (matrixA.empty() || matrixB.empty()) return false;
-  return matrixA[0].size() == matrixB.size();
+  if (matrixA.Rows() == 0 || matrixB.Rows() == 0) return false;
+  return matrixA.Cols() == matrixB.Rows();
 }
 
 bool SkotinMatrixMultiplicationTBBSeq::run() {
-  size_t blockSize = std::sqrt(matrixA.size());
-  size_t n = matrixA.size();
-  resultMatrix.resize(n, std::vector<double>(n, 0.0));
-
-  for (size_t blockRow = 0; blockRow < n; blockRow += blockSize) {
-    for (size_t blockCol = 0; blockCol < n; blockCol += blockSize) {
-      for (size_t i = 0; i < n; ++i) {
-        for (size_t j = blockCol; j < std::min(blockCol + blockSize, n); ++j) {
-          double sum = 0.0;
-          for (size_t k = blockRow; k < std::min(blockRow + blockSize, n); ++k) {
-            sum += matrixA[i][k] * matrixB[k][j];
-          }
-          resultMatrix[i][j] += sum;
-        }
+  // Cannon's steps: at step s block (i, j) of the result adds the product of block (i, (i + j + s) mod q) of A and
+  // the matching block of B, the blocks the initial skew and s shifts have brought to it
+  int q = resultMatrix.BlockRows();
+  resultMatrix.SetZero();
+  for (int step = 0; step < q; ++step) {
+    for (int i = 0; i < q; ++i) {
+      for (int j = 0; j < q; ++j) {
+        multiplyBlock(matrixA, matrixB, resultMatrix, i, j, (i + j + step) % q);
       }
     }
   }
@@ -65,39 +72,9 @@ bool SkotinMatrixMultiplicationTBBSeq::run() {
   return true;
 }
 
-bool SkotinMatrixMultiplicationTBBSeq::post_processing() { return saveResult(); }
-
-bool SkotinMatrixMultiplicationTBBSeq::loadMatrix(const std::vector<double>& inputData,
-                                                  std::vector<std::vector<double>>& matrix, size_t size) {
-  if (inputData.size() != size * size) {
-    std::cerr << "Input data size does not match expected matrix size." << std::endl;
-    return false;
-  }
-  if (inputData.size() != size * size) return false;
-  matrix.resize(size, std::vector<double>(size, 0));
-  for (size_t i = 0; i < size; ++i) {
-    for (size_t j = 0; j < size; ++j) {
-      matrix[i][j] = inputData[i * size + j];
-    }
-  }
-  return true;
-}
-
-bool SkotinMatrixMultiplicationTBBSeq::saveResult() {
-  size_t totalBytes = resultMatrix.size() * resultMatrix[0].size() * sizeof(double);
-
-  std::vector<uint8_t> outputData(totalBytes);
-
-  for (size_t i = 0; i < resultMatrix.size(); ++i) {
-    for (size_t j = 0; j < resultMatrix[i].size(); ++j) {
-      double value = resultMatrix[i][j];
-      memcpy(&outputData[(i * resultMatrix[i].size() + j) * sizeof(double)], &value, sizeof(double));
-    }
-  }
-
-  std::copy(outputData.begin(), outputData.end(), taskData->outputs[0]);
-
-  taskData->outputs_count[0] = totalBytes;
+bool SkotinMatrixMultiplicationTBBSeq::post_processing() {
+  resultMatrix.ToRowMajor(reinterpret_cast<double*>(taskData->outputs[0]), resultMatrix.Cols());
+  taskData->outputs_count[0] = resultMatrix.Rows() * resultMatrix.Cols() * sizeof(double);
   return true;
 }
 
@@ -110,82 +87,53 @@ bool SkotinMatrixMultiplicationTBBParallel::pre_processing() {
     return false;
   }
 
-  std::vector<double> matrixAData(matrixSize * matrixSize);
-  memcpy(matrixAData.data(), taskData->inputs[0], taskData->inputs_count[0]);
-
-  if (!loadMatrix(matrixAData, matrixA, matrixSize)) {
-    std::cerr << "Failed to load matrix A." << std::endl;
+  if (taskData->inputs_count[1] != taskData->inputs_count[0]) {
+    std::cerr << "Failed to load matrix B." << std::endl;
     return false;
   }
 
-  std::vector<double> matrixBData(matrixSize * matrixSize);
-  memcpy(matrixBData.data(), taskData->inputs[1], taskData->inputs_count[1]);
-
-  if (!loadMatrix(matrixBData, matrixB, matrixSize)) {
-    std::cerr << "Failed to load matrix B." << std::endl;
-    return false;
+  matrixA = ppc::core::TiledMatrix();
+  matrixB = ppc::core::TiledMatrix();
+  if (matrixSize == 0) {
+    return true;
   }
 
-  resultMatrix.resize(matrixSize, std::vector<double>(matrixSize, 0));
+  // blocks are contiguous tiles that Gemm reads in place; edge blocks are padded with zeros, so the block size
+  // measured for this host does not have to divide the matrix size
+  int n = static_cast<int>(matrixSize);
+  int block = ppc::core::TuneBlockSize("cannon", n, tbb::this_task_arena::max_concurrency());
+  matrixA = ppc::core::TiledMatrix(n, n, block);
+  matrixB = ppc::core::TiledMatrix(n, n, block);
+  resultMatrix = ppc::core::TiledMatrix(n, n, block);
+  matrixA.FromRowMajor(reinterpret_cast<double*>(taskData->inputs[0]), n);
+  matrixB.FromRowMajor(reinterpret_cast<double*>(taskData->inputs[1]), n);
   return true;
 }
 
 bool SkotinMatrixMultiplicationTBBParallel::validation() {
-  if (matrixA.empty() || matrixB.empty()) return false;
-  return matrixA[0].size() == matrixB.size();
+  if (matrixA.Rows() == 0 || matrixB.Rows() == 0) return false;
+  return matrixA.Cols() == matrixB.Rows();
 }
 
 bool SkotinMatrixMultiplicationTBBParallel::run() {
-  size_t n = matrixA.size();
-  resultMatrix.resize(n, std::vector<double>(n, 0.0));
-  std::vector<tbb::spin_mutex> mutexes(n * n);
-
-  tbb::parallel_for(size_t(0), n, [&](size_t i) {
-    for (size_t j = 0; j < n; ++j) {
-      double sum = 0.0;
-      for (size_t k = 0; k < n; ++k) {
-        sum += matrixA[i][k] * matrixB[k][j];
+  // every block of the result belongs to one task, which runs all of Cannon's steps on it
+  int q = resultMatrix.BlockRows();
+  resultMatrix.SetZero();
+  tbb::parallel_for(tbb::blocked_range<int>(0, q * q), [&](const tbb::blocked_range<int>& range) {
+    for (int t = range.begin(); t != range.end(); ++t) {
+      int i = t / q;
+      int j = t % q;
+      for (int step = 0; step < q; ++step) {
+        multiplyBlock(matrixA, matrixB, resultMatrix, i, j, (i + j + step) % q);
       }
-      tbb::spin_mutex::scoped_lock lock(mutexes[i * n + j]);
-      resultMatrix[i][j] += sum;
     }
   });
 
   return true;
 }
 
-bool SkotinMatrixMultiplicationTBBParallel::post_processing() { return saveResult(); }
-
-bool SkotinMatrixMultiplicationTBBParallel::loadMatrix(const std::vector<double>& inputData,
-                                                       std::vector<std::vector<double>>& matrix, size_t size) {
-  if (inputData.size() != size * size) {
-    std::cerr << "Input data size does not match expected matrix size." << std::endl;
-    return false;
-  }
-  if (inputData.size() != size * size) return false;
-  matrix.resize(size, std::vector<double>(size, 0));
-  for (size_t i = 0; i < size; ++i) {
-    for (size_t j = 0; j < size; ++j) {
-      matrix[i][j] = inputData[i * size + j];
-    }
-  }
+bool SkotinMatrixMultiplicationTBBParallel::post_processing() {
+  resultMatrix.ToRowMajor(reinterpret_cast<double*>(taskData->outputs[0]), resultMatrix.Cols());
+  taskData->outputs_count[0] = resultMatrix.Rows() * resultMatrix.Cols() * sizeof(double);
   return true;
 }
-
-bool SkotinMatrixMultiplicationTBBParallel::saveResult() {
-  size_t totalBytes = resultMatrix.size() * resultMatrix[0].size() * sizeof(double);
-
-  std::vector<uint8_t> outputData(totalBytes);
-
-  for (size_t i = 0; i < resultMatrix.size(); ++i) {
-    for (size_t j = 0; j < resultMatrix[i].size(); ++j) {
-      double value = resultMatrix[i][j];
-      memcpy(&outputData[(i * resultMatrix[i].size() + j) * sizeof(double)], &value, sizeof(double));
-    }
-  }
-
-  std::copy(outputData.begin(), outputData.end(), taskData->outputs[0]);
-
-  taskData->outputs_count[0] = totalBytes;
-  return true;
-}
\ No newline at end of file
@@ -308,4 +308,91 @@ TEST(ustinov_a_spgemm_csc_complex_omp, test_permutation_matrix) {
   testTaskParallel.post_processing();
 
   EXPECT_EQ(C_seq, C_par);
-}
\ No newline at end of file
+}
+
+void expect_same_matrix(const sparse_matrix &expected, const sparse_matrix_soa &actual) {
+  ASSERT_EQ(expected.row_num, actual.row_num);
+  ASSERT_EQ(expected.col_num, actual.col_num);
+  ASSERT_EQ(expected.nonzeros, actual.nonzeros);
+  for (int i = 0; i <= expected.col_num; ++i) {
+    ASSERT_EQ(expected.col_ptr[i], actual.col_ptr[i]);
+  }
+  for (int j = 0; j < expected.nonzeros; ++j) {
+    ASSERT_EQ(expected.rows[j], actual.rows[j]);
+    EXPECT_NEAR(expected.values[j].real(), actual.re[j], 1e-12);
+    EXPECT_NEAR(expected.values[j].imag(), actual.im[j], 1e-12);
+  }
+}
+
+TEST(ustinov_a_spgemm_csc_complex_tbb, test_soa_dft64x64) {
+  int n = 64;
+  sparse_matrix A = dft_matrix(n);
+  sparse_matrix B = dft_conj_matrix(n);
+  sparse_matrix C_seq;
+  sparse_matrix_soa A_soa = to_soa(A);
+  sparse_matrix_soa B_soa = to_soa(B);
+  sparse_matrix_soa C_soa;
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(&A));
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(&B));
+  taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(&C_seq));
+
+  // Create Task
+  SpgemmCSCComplexTBBSeq testTaskSequential(taskDataSeq);
+  ASSERT_EQ(testTaskSequential.validation(), true);
+  testTaskSequential.pre_processing();
+  testTaskSequential.run();
+  testTaskSequential.post_processing();
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataSoA = std::make_shared<ppc::core::TaskData>();
+  taskDataSoA->inputs.emplace_back(reinterpret_cast<uint8_t *>(&A_soa));
+  taskDataSoA->inputs.emplace_back(reinterpret_cast<uint8_t *>(&B_soa));
+  taskDataSoA->outputs.emplace_back(reinterpret_cast<uint8_t *>(&C_soa));
+
+  // Create Task
+  SpgemmCSCComplexTBBParSoA testTaskSoA(taskDataSoA);
+  ASSERT_EQ(testTaskSoA.validation(), true);
+  testTaskSoA.pre_processing();
+  testTaskSoA.run();
+  testTaskSoA.post_processing();
+
+  expect_same_matrix(C_seq, C_soa);
+  EXPECT_EQ(C_seq, from_soa(C_soa));
+}
+
+TEST(ustinov_a_spgemm_csc_complex_tbb, test_soa_rectangular) {
+  // A is 3 x 2, B is 2 x 4 with an empty column
+  sparse_matrix_soa A(3, 2, 3);
+  A.col_ptr = {0, 2, 3};
+  A.rows = {0, 2, 1};
+  A.re = {1.0, 0.0, 2.0};
+  A.im = {1.0, -1.0, 0.0};
+  sparse_matrix_soa B(2, 4, 3);
+  B.col_ptr = {0, 1, 1, 3, 3};
+  B.rows = {0, 0, 1};
+  B.re = {0.0, 1.0, 3.0};
+  B.im = {1.0, 0.0, -1.0};
+  sparse_matrix_soa C;
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataSoA = std::make_shared<ppc::core::TaskData>();
+  taskDataSoA->inputs.emplace_back(reinterpret_cast<uint8_t *>(&A));
+  taskDataSoA->inputs.emplace_back(reinterpret_cast<uint8_t *>(&B));
+  taskDataSoA->outputs.emplace_back(reinterpret_cast<uint8_t *>(&C));
+
+  // Create Task
+  SpgemmCSCComplexTBBParSoA testTaskSoA(taskDataSoA);
+  ASSERT_EQ(testTaskSoA.validation(), true);
+  testTaskSoA.pre_processing();
+  testTaskSoA.run();
+  testTaskSoA.post_processing();
+
+  // column 0: (1+i) * i, -i * i; column 2: (1+i), 2 * (3-i), -i
+  EXPECT_EQ(C.col_ptr, std::vector<int>({0, 2, 2, 5, 5}));
+  EXPECT_EQ(C.rows, std::vector<int>({0, 2, 0, 1, 2}));
+  EXPECT_EQ(C.re, std::vector<double>({-1.0, 1.0, 1.0, 6.0, 0.0}));
+  EXPECT_EQ(C.im, std::vector<double>({1.0, 0.0, 1.0, -2.0, -1.0}));
+}
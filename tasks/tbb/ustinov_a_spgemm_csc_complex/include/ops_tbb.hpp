@@ -26,4 +26,17 @@ class SpgemmCSCComplexTBBPar : public ppc::core::Task {
 
  private:
   sparse_matrix *A, *B, *C;
-};
\ No newline at end of file
+};
+
+// SpgemmCSCComplexTBBPar on split real/imaginary storage: inputs and output are sparse_matrix_soa
+class SpgemmCSCComplexTBBParSoA : public ppc::core::Task {
+ public:
+  explicit SpgemmCSCComplexTBBParSoA(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+  bool pre_processing() override;
+  bool validation() override;
+  bool run() override;
+  bool post_processing() override;
+
+ private:
+  sparse_matrix_soa *A, *B, *C;
+};
@@ -191,3 +191,107 @@ bool SpgemmCSCComplexTBBPar::post_processing() {
 
   return true;
 }
+
+bool SpgemmCSCComplexTBBParSoA::pre_processing() {
+  internal_order_test();
+
+  A = reinterpret_cast<sparse_matrix_soa *>(taskData->inputs[0]);
+  B = reinterpret_cast<sparse_matrix_soa *>(taskData->inputs[1]);
+  C = reinterpret_cast<sparse_matrix_soa *>(taskData->outputs[0]);
+  return true;
+}
+
+bool SpgemmCSCComplexTBBParSoA::validation() {
+  internal_order_test();
+
+  int A_col_num = reinterpret_cast<sparse_matrix_soa *>(taskData->inputs[0])->col_num;
+  int B_row_num = reinterpret_cast<sparse_matrix_soa *>(taskData->inputs[1])->row_num;
+  // check that matrices are compatible for multiplication
+  return (A_col_num == B_row_num);
+}
+
+bool SpgemmCSCComplexTBBParSoA::run() {
+  internal_order_test();
+
+  // symbolic stage
+  C->row_num = A->row_num;
+  C->col_num = B->col_num;
+  C->col_ptr.resize(C->col_num + 1);
+  C->col_ptr[0] = 0;
+  constexpr int grain_size = 32;
+  oneapi::tbb::parallel_for(tbb::blocked_range<int>(0, C->col_num, grain_size), [&](tbb::blocked_range<int> &r) {
+    std::vector<int> present_elements(C->row_num);
+    for (int b_col = r.begin(); b_col < r.end(); ++b_col) {
+      for (int c_row = 0; c_row < C->row_num; ++c_row) {
+        present_elements[c_row] = 0;
+      }
+      for (int b_idx = B->col_ptr[b_col]; b_idx < B->col_ptr[b_col + 1]; ++b_idx) {
+        int b_row = B->rows[b_idx];
+        for (int a_idx = A->col_ptr[b_row]; a_idx < A->col_ptr[b_row + 1]; ++a_idx) {
+          present_elements[A->rows[a_idx]] = 1;
+        }
+      }
+      int col_nonzero_count = 0;
+      for (int c_row = 0; c_row < C->row_num; ++c_row) {
+        col_nonzero_count += present_elements[c_row];
+      }
+      C->col_ptr[b_col + 1] = col_nonzero_count;
+    }
+  });
+
+  // allocate memory for matrix C
+  for (int c_col = 0; c_col < C->col_num; ++c_col) {
+    C->col_ptr[c_col + 1] += C->col_ptr[c_col];
+  }
+  int total_nonzeros = C->col_ptr[C->col_num];
+  C->nonzeros = total_nonzeros;
+  C->rows.resize(total_nonzeros);
+  C->re.resize(total_nonzeros);
+  C->im.resize(total_nonzeros);
+
+  // numeric stage: the accumulator is updated with plain double arithmetic
+  oneapi::tbb::parallel_for(tbb::blocked_range<int>(0, C->col_num, grain_size), [&](tbb::blocked_range<int> &r) {
+    // interleaved, so the scattered update of one row touches a single cache line
+    std::vector<double> acc(2 * C->row_num);
+    std::vector<int> present_elements(C->row_num);
+    const int *a_rows = A->rows.data();
+    const double *a_re = A->re.data();
+    const double *a_im = A->im.data();
+    for (int b_col = r.begin(); b_col < r.end(); ++b_col) {
+      for (int c_row = 0; c_row < C->row_num; ++c_row) {
+        acc[2 * c_row] = 0.0;
+        acc[2 * c_row + 1] = 0.0;
+        present_elements[c_row] = 0;
+      }
+      // calculate column into accumulator
+      for (int b_idx = B->col_ptr[b_col]; b_idx < B->col_ptr[b_col + 1]; ++b_idx) {
+        int b_row = B->rows[b_idx];
+        double b_re = B->re[b_idx];
+        double b_im = B->im[b_idx];
+        for (int a_idx = A->col_ptr[b_row]; a_idx < A->col_ptr[b_row + 1]; ++a_idx) {
+          int a_row = a_rows[a_idx];
+          acc[2 * a_row] += a_re[a_idx] * b_re - a_im[a_idx] * b_im;
+          acc[2 * a_row + 1] += a_re[a_idx] * b_im + a_im[a_idx] * b_re;
+          present_elements[a_row] = 1;
+        }
+      }
+      // write column into matrix C
+      int c_pos = C->col_ptr[b_col];
+      for (int c_row = 0; c_row < C->row_num; ++c_row) {
+        if (present_elements[c_row] != 0) {
+          C->rows[c_pos] = c_row;
+          C->re[c_pos] = acc[2 * c_row];
+          C->im[c_pos++] = acc[2 * c_row + 1];
+        }
+      }
+    }
+  });
+
+  return true;
+}
+
+bool SpgemmCSCComplexTBBParSoA::post_processing() {
+  internal_order_test();
+
+  return true;
+}
@@ -133,3 +133,81 @@ TEST(veselov_i_systems_grad_method_tbb, Test_triple_diag_matrix) {
     ASSERT_LE(abs(excepted_res[i] - res[i]), 1e-6);
   }
 }
+
+namespace {
+std::shared_ptr<ppc::core::TaskData> csrTaskData(CsrMatrix &matrix, std::vector<double> &vec,
+                                                 std::vector<double> &res) {
+  std::shared_ptr<ppc::core::TaskData> taskDataTbb = std::make_shared<ppc::core::TaskData>();
+  taskDataTbb->inputs.emplace_back(reinterpret_cast<uint8_t *>(matrix.rowPtr.data()));
+  taskDataTbb->inputs_count.emplace_back(matrix.rowPtr.size());
+  taskDataTbb->inputs.emplace_back(reinterpret_cast<uint8_t *>(matrix.cols.data()));
+  taskDataTbb->inputs_count.emplace_back(matrix.cols.size());
+  taskDataTbb->inputs.emplace_back(reinterpret_cast<uint8_t *>(matrix.vals.data()));
+  taskDataTbb->inputs_count.emplace_back(matrix.vals.size());
+  taskDataTbb->inputs.emplace_back(reinterpret_cast<uint8_t *>(vec.data()));
+  taskDataTbb->inputs_count.emplace_back(vec.size());
+  taskDataTbb->outputs.emplace_back(reinterpret_cast<uint8_t *>(res.data()));
+  taskDataTbb->outputs_count.emplace_back(res.size());
+  return taskDataTbb;
+}
+}  // namespace
+
+TEST(veselov_i_systems_grad_method_tbb, Test_csr_triple_diag_matrix) {
+  CsrMatrix matrix{{0, 2, 5, 8, 10}, {0, 1, 0, 1, 2, 1, 2, 3, 2, 3}, {2, -1, -1, 2, -1, -1, 2, -1, -1, 2}};
+  std::vector<double> vec = {1, 2, 3, 4};
+  std::vector<double> res(vec.size());
+  std::vector<double> excepted_res = {4, 7, 8, 6};
+
+  SystemsGradMethodCsrTbb systemsGradMethodTbb(csrTaskData(matrix, vec, res));
+  ASSERT_TRUE(systemsGradMethodTbb.validation());
+  ASSERT_TRUE(systemsGradMethodTbb.pre_processing());
+  ASSERT_TRUE(systemsGradMethodTbb.run());
+  ASSERT_TRUE(systemsGradMethodTbb.post_processing());
+  for (size_t i = 0; i < res.size(); i++) {
+    ASSERT_LE(abs(excepted_res[i] - res[i]), 1e-6);
+  }
+}
+
+TEST(veselov_i_systems_grad_method_tbb, Test_csr_poisson) {
+  CsrMatrix matrix = genPoissonCsr(30);
+  std::vector<double> vec = genRandomVector(30 * 30, 10);
+  std::vector<double> res(vec.size());
+
+  SystemsGradMethodCsrTbb systemsGradMethodTbb(csrTaskData(matrix, vec, res));
+  ASSERT_TRUE(systemsGradMethodTbb.validation());
+  ASSERT_TRUE(systemsGradMethodTbb.pre_processing());
+  ASSERT_TRUE(systemsGradMethodTbb.run());
+  ASSERT_TRUE(systemsGradMethodTbb.post_processing());
+  ASSERT_TRUE(checkSolution(matrix, vec, res));
+}
+
+TEST(veselov_i_systems_grad_method_tbb, Test_csr_validation) {
+  CsrMatrix matrix = genPoissonCsr(3);
+  std::vector<double> vec(9, 1.0);
+  std::vector<double> res(8);
+
+  SystemsGradMethodCsrTbb systemsGradMethodTbb(csrTaskData(matrix, vec, res));
+  ASSERT_FALSE(systemsGradMethodTbb.validation());
+}
+
+TEST(veslov_i_systems_grad_method_tbb, Test_csr_without_output_count) {
+  CsrMatrix matrix = genPoissonCsr(3);
+  std::vector<double> vec(9, 1.0);
+  std::vector<double> res(9);
+
+  std::shared_ptr<ppc::core::TaskData> taskDataTbb = csrTaskData(matrix, vec, res);
+  taskDataTbb->outputs_count.clear();
+  SystemsGradMethodCsrTbb systemsGradMethodTbb(taskDataTbb);
+  ASSERT_FALSE(systemsGradMethodTbb.validation());
+}
+
+TEST(veslov_i_systems_grad_method_tbb, Test_csr_not_positive_definite) {
+  CsrMatrix matrix{{0, 1, 2}, {0, 1}, {1, -1}};
+  std::vector<double> vec = {1, 1};
+  std::vector<double> res(vec.size());
+
+  SystemsGradMethodCsrTbb systemsGradMethodTbb(csrTaskData(matrix, vec, res));
+  ASSERT_TRUE(systemsGradMethodTbb.validation());
+  ASSERT_TRUE(systemsGradMethodTbb.pre_processing());
+  ASSERT_FALSE(systemsGradMethodTbb.run());
+}
@@ -75,3 +75,40 @@ TEST(veselov_i_systems_grad_method_tbb, test_task_run) {
   ppc::core::Perf::print_perf_statistic(perfResults);
   ASSERT_TRUE(checkSolution(matrix, vec, res, 1e-6));
 }
+
+TEST(veselov_i_systems_grad_method_tbb, test_task_run_csr) {
+  int side = 200;
+
+  CsrMatrix matrix = genPoissonCsr(side);
+  std::vector<double> vec = genRandomVector(side * side, 10);
+  std::vector<double> res(vec.size());
+
+  std::shared_ptr<ppc::core::TaskData> taskDataTbb = std::make_shared<ppc::core::TaskData>();
+  taskDataTbb->inputs.emplace_back(reinterpret_cast<uint8_t *>(matrix.rowPtr.data()));
+  taskDataTbb->inputs_count.emplace_back(matrix.rowPtr.size());
+  taskDataTbb->inputs.emplace_back(reinterpret_cast<uint8_t *>(matrix.cols.data()));
+  taskDataTbb->inputs_count.emplace_back(matrix.cols.size());
+  taskDataTbb->inputs.emplace_back(reinterpret_cast<uint8_t *>(matrix.vals.data()));
+  taskDataTbb->inputs_count.emplace_back(matrix.vals.size());
+  taskDataTbb->inputs.emplace_back(reinterpret_cast<uint8_t *>(vec.data()));
+  taskDataTbb->inputs_count.emplace_back(vec.size());
+  taskDataTbb->outputs.emplace_back(reinterpret_cast<uint8_t *>(res.data()));
+  taskDataTbb->outputs_count.emplace_back(res.size());
+
+  auto testTaskTbb = std::make_shared<SystemsGradMethodCsrTbb>(taskDataTbb);
+
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 3;
+  const auto t0 = std::chrono::high_resolution_clock::now();
+  perfAttr->current_timer = [&] {
+    auto current_time_point = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(current_time_point - t0).count();
+    return static_cast<double>(duration) * 1e-9;
+  };
+
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+  auto perfAnalyzer = std::make_shared<ppc::core::Perf>(testTaskTbb);
+  perfAnalyzer->task_run(perfAttr, perfResults);
+  ppc::core::Perf::print_perf_statistic(perfResults);
+  ASSERT_TRUE(checkSolution(matrix, vec, res, 1e-6));
+}
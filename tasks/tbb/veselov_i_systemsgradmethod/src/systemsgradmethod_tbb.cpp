@@ -40,15 +40,33 @@ std::vector<double> matrixVectorProduct(const std::vector<double> &Aa, const std
   return res;
 }
 
-std::vector<double> SLEgradSolver(const std::vector<double> &Aa, const std::vector<double> &bb, int n,
-                                  double tol = 1e-6) {
-  std::vector<double> res(n, 0.0);
+std::vector<double> csrMatrixVectorProduct(const CsrMatrix &Aa, const std::vector<double> &xx) {
+  int n = static_cast<int>(Aa.rowPtr.size()) - 1;
+  std::vector<double> result(n);
+  tbb::parallel_for(tbb::blocked_range<int>(0, n), [&](const tbb::blocked_range<int> &r) {
+    for (int i = r.begin(); i != r.end(); ++i) {
+      double sum = 0.0;
+      for (int j = Aa.rowPtr[i]; j < Aa.rowPtr[i + 1]; ++j) {
+        sum += Aa.vals[j] * xx[Aa.cols[j]];
+      }
+      result[i] = sum;
+    }
+  });
+  return result;
+}
+
+// the method needs the matrix only through product(p) = A * p; false when the residual is still above tol after
+// maxIterations steps, e.g. for a matrix that is not positive definite
+template <typename Product>
+bool gradSolver(const Product &product, const std::vector<double> &bb, int n, double tol, std::vector<double> &res,
+                int maxIterations = 100000) {
+  res.assign(n, 0.0);
   std::vector<double> r = bb;
   std::vector<double> p = r;
   std::vector<double> r_old = bb;
 
-  while (true) {
-    std::vector<double> Ap = matrixVectorProduct(Aa, p, n);
+  for (int iteration = 0; iteration < maxIterations; ++iteration) {
+    std::vector<double> Ap = product(p);
     double alpha = dotProduct(r, r) / dotProduct(Ap, p);
 
     tbb::parallel_for(tbb::blocked_range<int>(0, n), [&](const tbb::blocked_range<int> &r) {
@@ -64,7 +82,7 @@ std::vector<double> SLEgradSolver(const std::vector<double> &Aa, const std::vect
     });
 
     if (std::sqrt(dotProduct(r, r)) < tol) {
-      break;
+      return true;
     }
     double beta = dotProduct(r, r) / dotProduct(r_old, r_old);
 
@@ -76,7 +94,12 @@ std::vector<double> SLEgradSolver(const std::vector<double> &Aa, const std::vect
 
     r_old = r;
   }
-  return res;
+  return false;
+}
+
+bool SLEgradSolver(const std::vector<double> &Aa, const std::vector<double> &bb, int n, std::vector<double> &xx,
+                   double tol = 1e-6) {
+  return gradSolver([&](const std::vector<double> &p) { return matrixVectorProduct(Aa, p, n); }, bb, n, tol, xx);
 }
 
 bool SystemsGradMethodTbb::pre_processing() {
@@ -105,11 +128,10 @@ bool SystemsGradMethodTbb::validation() {
 bool SystemsGradMethodTbb::run() {
   try {
     internal_order_test();
-    x = SLEgradSolver(A, b, rows);
+    return SLEgradSolver(A, b, rows, x);
   } catch (...) {
     return false;
   }
-  return true;
 }
 
 bool SystemsGradMethodTbb::post_processing() {
@@ -120,6 +142,48 @@ bool SystemsGradMethodTbb::post_processing() {
   return true;
 }
 
+bool SystemsGradMethodCsrTbb::pre_processing() {
+  try {
+    internal_order_test();
+    rows = static_cast<int>(taskData->inputs_count[3]);
+    int nonzeros = static_cast<int>(taskData->inputs_count[1]);
+    A.rowPtr.assign(reinterpret_cast<int *>(taskData->inputs[0]),
+                    reinterpret_cast<int *>(taskData->inputs[0]) + rows + 1);
+    A.cols.assign(reinterpret_cast<int *>(taskData->inputs[1]),
+                  reinterpret_cast<int *>(taskData->inputs[1]) + nonzeros);
+    A.vals.assign(reinterpret_cast<double *>(taskData->inputs[2]),
+                  reinterpret_cast<double *>(taskData->inputs[2]) + nonzeros);
+    b.assign(reinterpret_cast<double *>(taskData->inputs[3]), reinterpret_cast<double *>(taskData->inputs[3]) + rows);
+    x = std::vector<double>(rows, 0.0);
+  } catch (...) {
+    return false;
+  }
+  return true;
+}
+
+bool SystemsGradMethodCsrTbb::validation() {
+  internal_order_test();
+  return taskData->inputs.size() == 4 && taskData->inputs_count.size() == 4 && taskData->outputs_count.size() == 1 &&
+         taskData->inputs_count[0] == taskData->inputs_count[3] + 1 &&
+         taskData->inputs_count[1] == taskData->inputs_count[2] &&
+         taskData->inputs_count[3] == taskData->outputs_count[0];
+}
+
+bool SystemsGradMethodCsrTbb::run() {
+  try {
+    internal_order_test();
+    return gradSolver([&](const std::vector<double> &p) { return csrMatrixVectorProduct(A, p); }, b, rows, 1e-6, x);
+  } catch (...) {
+    return false;
+  }
+}
+
+bool SystemsGradMethodCsrTbb::post_processing() {
+  internal_order_test();
+  std::copy(x.begin(), x.end(), reinterpret_cast<double *>(taskData->outputs[0]));
+  return true;
+}
+
 bool checkSolution(const std::vector<double> &Aa, const std::vector<double> &bb, const std::vector<double> &xx,
                    double tol) {
   int n = bb.size();
@@ -139,6 +203,38 @@ bool checkSolution(const std::vector<double> &Aa, const std::vector<double> &bb,
   return true;
 }
 
+bool checkSolution(const CsrMatrix &Aa, const std::vector<double> &bb, const std::vector<double> &xx, double tol) {
+  std::vector<double> Ax = csrMatrixVectorProduct(Aa, xx);
+  for (size_t i = 0; i < bb.size(); ++i) {
+    if (std::abs(Ax[i] - bb[i]) > tol) {
+      return false;
+    }
+  }
+  return true;
+}
+
+CsrMatrix genPoissonCsr(int side) {
+  CsrMatrix matrix;
+  int n = side * side;
+  matrix.rowPtr.reserve(n + 1);
+  matrix.cols.reserve(5 * n);
+  matrix.vals.reserve(5 * n);
+  matrix.rowPtr.push_back(0);
+  for (int i = 0; i < n; ++i) {
+    int row = i / side;
+    int col = i % side;
+    // neighbours in column order
+    for (int j : {i - side, i - 1, i, i + 1, i + side}) {
+      if (j >= 0 && j < n && (j / side == row || j % side == col)) {
+        matrix.cols.push_back(j);
+        matrix.vals.push_back(j == i ? 4.0 : -1.0);
+      }
+    }
+    matrix.rowPtr.push_back(static_cast<int>(matrix.cols.size()));
+  }
+  return matrix;
+}
+
 std::vector<double> genRandomVector(int size, int maxVal) {
   std::random_device rd;
   std::mt19937 gen(rd());
@@ -7,6 +7,43 @@
 
 using namespace VeselovTbb;
 
+namespace {
+MatrixCCS toCCS(const std::vector<Complex> &matrix, int numRows, int numCols) {
+  MatrixCCS ccs;
+  ccs.numRows = numRows;
+  ccs.numCols = numCols;
+  ccs.cols.push_back(0);
+  for (int j = 0; j < numCols; ++j) {
+    for (int i = 0; i < numRows; ++i) {
+      const Complex &value = matrix[i * numCols + j];
+      if (value.real != 0 || value.imag != 0) {
+        ccs.val.push_back(value);
+        ccs.rows.push_back(i);
+      }
+    }
+    ccs.cols.push_back(ccs.val.size());
+  }
+  return ccs;
+}
+
+void expectDense(const MatrixCCS &ccs, const std::vector<Complex> &expected) {
+  std::vector<Complex> matrix(ccs.numRows * ccs.numCols, Complex{0, 0});
+  for (int j = 0; j < ccs.numCols; ++j) {
+    for (int k = ccs.cols[j]; k < ccs.cols[j + 1]; ++k) {
+      if (k > ccs.cols[j]) {
+        EXPECT_LT(ccs.rows[k - 1], ccs.rows[k]);
+      }
+      matrix[ccs.rows[k] * ccs.numCols + j] = ccs.val[k];
+    }
+  }
+  ASSERT_EQ(matrix.size(), expected.size());
+  for (size_t i = 0; i < matrix.size(); ++i) {
+    EXPECT_DOUBLE_EQ(matrix[i].real, expected[i].real);
+    EXPECT_DOUBLE_EQ(matrix[i].imag, expected[i].imag);
+  }
+}
+}  // namespace
+
 TEST(veselov_m_matrcomplexmultyCCS, test_sizes_true) {
   size_t n1 = 4;
   size_t m1 = 6;
@@ -332,4 +369,78 @@ TEST(veselov_m_matrcomplexmultyCCS, zero_matrix) {
   }
 
   ASSERT_EQ(m, n1 * m2);
-}
\ No newline at end of file
+}
+
+TEST(veselov_m_matrcomplexmultyCCS, ccs_input_sizes_incorrect) {
+  // Create data
+  MatrixCCS in1 = toCCS(std::vector<Complex>(4 * 5, Complex{0, 0}), 4, 5);
+  MatrixCCS in2 = toCCS(std::vector<Complex>(3 * 4, Complex{0, 0}), 3, 4);
+  MatrixCCS out;
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataParallel = std::make_shared<ppc::core::TaskData>();
+  taskDataParallel->inputs.emplace_back(reinterpret_cast<uint8_t *>(&in1));
+  taskDataParallel->inputs_count.emplace_back(4);
+  taskDataParallel->inputs_count.emplace_back(5);
+  taskDataParallel->inputs.emplace_back(reinterpret_cast<uint8_t *>(&in2));
+  taskDataParallel->inputs_count.emplace_back(3);
+  taskDataParallel->inputs_count.emplace_back(4);
+  taskDataParallel->outputs.emplace_back(reinterpret_cast<uint8_t *>(&out));
+
+  // Create Task
+  SparseMatrixComplexMultiTBBSparse sparseMatrixComplexMultiTBBSparse(taskDataParallel);
+  ASSERT_FALSE(sparseMatrixComplexMultiTBBSparse.validation());
+}
+
+TEST(veselov_m_matrcomplexmultyCCS, ccs_input_multy) {
+  // Create data
+  MatrixCCS in1 = toCCS({{3, 2}, {0, 0}, {0, 0}, {0, 0}, {1, -3}, {0, 0}, {0, 0}, {0, 0}, {-4, 1}}, 3, 3);
+  MatrixCCS in2 = toCCS({{0, 0}, {2, -1}, {0, 0}, {0, 0}, {0, 0}, {-5, 2}, {0, 0}, {2, 1}, {0, 0}}, 3, 3);
+  MatrixCCS out;
+  std::vector<Complex> test{{0, 0}, {8, 1}, {0, 0}, {0, 0}, {0, 0}, {1, 17}, {0, 0}, {-9, -2}, {0, 0}};
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataParallel = std::make_shared<ppc::core::TaskData>();
+  taskDataParallel->inputs.emplace_back(reinterpret_cast<uint8_t *>(&in1));
+  taskDataParallel->inputs_count.emplace_back(3);
+  taskDataParallel->inputs_count.emplace_back(3);
+  taskDataParallel->inputs.emplace_back(reinterpret_cast<uint8_t *>(&in2));
+  taskDataParallel->inputs_count.emplace_back(3);
+  taskDataParallel->inputs_count.emplace_back(3);
+  taskDataParallel->outputs.emplace_back(reinterpret_cast<uint8_t *>(&out));
+
+  // Create Task
+  SparseMatrixComplexMultiTBBSparse sparseMatrixComplexMultiTBBSparse(taskDataParallel);
+  ASSERT_TRUE(sparseMatrixComplexMultiTBBSparse.validation());
+  ASSERT_TRUE(sparseMatrixComplexMultiTBBSparse.pre_processing());
+  ASSERT_TRUE(sparseMatrixComplexMultiTBBSparse.run());
+  ASSERT_TRUE(sparseMatrixComplexMultiTBBSparse.post_processing());
+  expectDense(out, test);
+}
+
+TEST(veselov_m_matrcomplexmultyCCS, ccs_input_keeps_cancelled_products) {
+  // Create data
+  MatrixCCS in1 = toCCS({{1, 0}, {0, 1}, {0, 0}, {2, 0}}, 2, 2);
+  MatrixCCS in2 = toCCS({{0, 1}, {3, 0}, {-1, 0}, {0, 0}}, 2, 2);
+  MatrixCCS out;
+  std::vector<Complex> test{{0, 0}, {3, 0}, {-2, 0}, {0, 0}};
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataParallel = std::make_shared<ppc::core::TaskData>();
+  taskDataParallel->inputs.emplace_back(reinterpret_cast<uint8_t *>(&in1));
+  taskDataParallel->inputs_count.emplace_back(2);
+  taskDataParallel->inputs_count.emplace_back(2);
+  taskDataParallel->inputs.emplace_back(reinterpret_cast<uint8_t *>(&in2));
+  taskDataParallel->inputs_count.emplace_back(2);
+  taskDataParallel->inputs_count.emplace_back(2);
+  taskDataParallel->outputs.emplace_back(reinterpret_cast<uint8_t *>(&out));
+
+  // Create Task
+  SparseMatrixComplexMultiTBBSparse sparseMatrixComplexMultiTBBSparse(taskDataParallel);
+  ASSERT_TRUE(sparseMatrixComplexMultiTBBSparse.validation());
+  ASSERT_TRUE(sparseMatrixComplexMultiTBBSparse.pre_processing());
+  ASSERT_TRUE(sparseMatrixComplexMultiTBBSparse.run());
+  ASSERT_TRUE(sparseMatrixComplexMultiTBBSparse.post_processing());
+  ASSERT_EQ(out.cols, std::vector<int>({0, 2, 3}));
+  expectDense(out, test);
+}
@@ -1,10 +1,13 @@
 // Copyright 2024 Veselov Mikhail
 #include "tbb/veselov_m_matrcomplexmultyCCS_tbb/include/ops_tbb.hpp"
 
+#include <algorithm>
 #include <tbb/tbb.h>
 
 #include <thread>
 
+#include "core/sparse/include/compress.hpp"
+
 using namespace VeselovTbb;
 
 bool SparseMatrixComplexMultiTBBSequential::validation() {
@@ -27,33 +30,9 @@ bool SparseMatrixComplexMultiTBBSequential::pre_processing() {
 
   res = new Complex[numRows1 * numCols2]{{0.0, 0.0}};
 
-  int notNullNumbers = 0;
-  for (int j = 0; j < numCols1; ++j) {
-    cols1.push_back(notNullNumbers);
-    for (int i = 0; i < numRows1; ++i) {
-      int index = i * numRows1 + j;
-      if (mat1[index].real != 0 || mat1[index].imag != 0) {
-        val1.push_back(mat1[index]);
-        rows1.push_back(i);
-        notNullNumbers++;
-      }
-    }
-  }
-  cols1.push_back(notNullNumbers);
-
-  notNullNumbers = 0;
-  for (int j = 0; j < numCols2; ++j) {
-    cols2.push_back(notNullNumbers);
-    for (int i = 0; i < numRows2; ++i) {
-      int index = i * numRows2 + j;
-      if (mat2[index].real != 0 || mat2[index].imag != 0) {
-        val2.push_back(mat2[index]);
-        rows2.push_back(i);
-        notNullNumbers++;
-      }
-    }
-  }
-  cols2.push_back(notNullNumbers);
+  auto nonzero = [](const Complex& v) { return v.real != 0 || v.imag != 0; };
+  ppc::core::DenseToCompressed(mat1, numRows1, numCols1, true, nonzero, val1, rows1, cols1);
+  ppc::core::DenseToCompressed(mat2, numRows2, numCols2, true, nonzero, val2, rows2, cols2);
 
   return true;
 }
@@ -110,33 +89,11 @@ bool SparseMatrixComplexMultiTBBParallel::pre_processing() {
 
   res = new Complex[numRows1 * numCols2]{{0.0, 0.0}};
 
-  int notNullNumbers = 0;
-  for (int j = 0; j < numCols1; ++j) {
-    cols1.push_back(notNullNumbers);
-    for (int i = 0; i < numRows1; ++i) {
-      int index = i * numRows1 + j;
-      if (mat1[index].real != 0 || mat1[index].imag != 0) {
-        val1.push_back(mat1[index]);
-        rows1.push_back(i);
-        notNullNumbers++;
-      }
-    }
-  }
-  cols1.push_back(notNullNumbers);
-
-  notNullNumbers = 0;
-  for (int j = 0; j < numCols2; ++j) {
-    cols2.push_back(notNullNumbers);
-    for (int i = 0; i < numRows2; ++i) {
-      int index = i * numRows2 + j;
-      if (mat2[index].real != 0 || mat2[index].imag != 0) {
-        val2.push_back(mat2[index]);
-        rows2.push_back(i);
-        notNullNumbers++;
-      }
-    }
-  }
-  cols2.push_back(notNullNumbers);
+  auto nonzero = [](const Complex& v) { return v.real != 0 || v.imag != 0; };
+  ppc::core::DenseToCompressed(mat1, numRows1, numCols1, true, nonzero, val1, rows1, cols1,
+                               tbb::this_task_arena::max_concurrency());
+  ppc::core::DenseToCompressed(mat2, numRows2, numCols2, true, nonzero, val2, rows2, cols2,
+                               tbb::this_task_arena::max_concurrency());
 
   return true;
 }
@@ -170,4 +127,116 @@ bool SparseMatrixComplexMultiTBBParallel::post_processing() {
   delete[] res;
 
   return true;
-}
\ No newline at end of file
+}
+
+namespace VeselovTbb {
+
+MatrixCCS MultiplyCCS(const MatrixCCS& a, const MatrixCCS& b) {
+  MatrixCCS c;
+  c.numRows = a.numRows;
+  c.numCols = b.numCols;
+  c.cols.assign(b.numCols + 1, 0);
+
+  // first pass: the number of structural nonzeros of every column of C
+  tbb::parallel_for(tbb::blocked_range<int>(0, b.numCols), [&](const tbb::blocked_range<int>& r) {
+    std::vector<int> mark(a.numRows, -1);
+    for (int j = r.begin(); j < r.end(); j++) {
+      int count = 0;
+      for (int k = b.cols[j]; k < b.cols[j + 1]; k++) {
+        int rowB = b.rows[k];
+        for (int i = a.cols[rowB]; i < a.cols[rowB + 1]; i++) {
+          if (mark[a.rows[i]] != j) {
+            mark[a.rows[i]] = j;
+            count++;
+          }
+        }
+      }
+      c.cols[j + 1] = count;
+    }
+  });
+
+  // prefix sum: cols[j] becomes the offset of column j in the final arrays
+  for (int j = 0; j < b.numCols; j++) {
+    c.cols[j + 1] += c.cols[j];
+  }
+  c.rows.resize(c.cols[b.numCols]);
+  c.val.resize(c.cols[b.numCols]);
+
+  // second pass: every column is written straight into its place in the final arrays
+  tbb::parallel_for(tbb::blocked_range<int>(0, b.numCols), [&](const tbb::blocked_range<int>& r) {
+    std::vector<Complex> column(a.numRows, Complex{0.0, 0.0});
+    std::vector<int> mark(a.numRows, -1);
+    for (int j = r.begin(); j < r.end(); j++) {
+      int pos = c.cols[j];
+      for (int k = b.cols[j]; k < b.cols[j + 1]; k++) {
+        int rowB = b.rows[k];
+        Complex y = b.val[k];
+        for (int i = a.cols[rowB]; i < a.cols[rowB + 1]; i++) {
+          int rowA = a.rows[i];
+          Complex x = a.val[i];
+          if (mark[rowA] != j) {
+            mark[rowA] = j;
+            c.rows[pos++] = rowA;
+          }
+          column[rowA].real += x.real * y.real - x.imag * y.imag;
+          column[rowA].imag += x.real * y.imag + x.imag * y.real;
+        }
+      }
+      std::sort(c.rows.begin() + c.cols[j], c.rows.begin() + pos);
+      for (int p = c.cols[j]; p < pos; p++) {
+        c.val[p] = column[c.rows[p]];
+        column[c.rows[p]] = {0.0, 0.0};
+      }
+    }
+  });
+
+  return c;
+}
+
+bool SparseMatrixComplexMultiTBBSparse::validation() {
+  internal_order_test();
+
+  if (taskData->inputs.size() != 2 || taskData->inputs_count.size() != 4 || taskData->outputs.size() != 1) {
+    return false;
+  }
+  if (taskData->inputs[0] == nullptr || taskData->inputs[1] == nullptr || taskData->outputs[0] == nullptr) {
+    return false;
+  }
+  const auto* matrix1 = reinterpret_cast<MatrixCCS*>(taskData->inputs[0]);
+  const auto* matrix2 = reinterpret_cast<MatrixCCS*>(taskData->inputs[1]);
+  return taskData->inputs_count[1] == taskData->inputs_count[2] &&
+         matrix1->numRows == static_cast<int>(taskData->inputs_count[0]) &&
+         matrix1->numCols == static_cast<int>(taskData->inputs_count[1]) &&
+         matrix2->numRows == static_cast<int>(taskData->inputs_count[2]) &&
+         matrix2->numCols == static_cast<int>(taskData->inputs_count[3]) &&
+         matrix1->cols.size() == static_cast<size_t>(matrix1->numCols) + 1 &&
+         matrix2->cols.size() == static_cast<size_t>(matrix2->numCols) + 1;
+}
+
+bool SparseMatrixComplexMultiTBBSparse::pre_processing() {
+  internal_order_test();
+
+  a = reinterpret_cast<MatrixCCS*>(taskData->inputs[0]);
+  b = reinterpret_cast<MatrixCCS*>(taskData->inputs[1]);
+  out = reinterpret_cast<MatrixCCS*>(taskData->outputs[0]);
+
+  return true;
+}
+
+bool SparseMatrixComplexMultiTBBSparse::run() {
+  internal_order_test();
+
+  c = MultiplyCCS(*a, *b);
+
+  return true;
+}
+
+bool SparseMatrixComplexMultiTBBSparse::post_processing() {
+  internal_order_test();
+
+  *out = std::move(c);
+
+  return true;
+}
+
+}  // namespace VeselovTbb
@@ -1,6 +1,9 @@
 // Copyright 2024 Zorin Oleg
 #include "tbb/zorin_o_crs_matmult/include/crs_matmult_tbb.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 #include "tbb/tbb.h"
 
 bool CRSMatMult::validation() {
@@ -25,49 +28,125 @@ bool CRSMatMult::pre_processing() {
 
 bool CRSMatMult::run() {
   internal_order_test();
-  std::vector<std::vector<double>> all_value(A->n_rows);
-  std::vector<std::vector<int>> all_col_index(A->n_rows);
 
-  oneapi::tbb::parallel_for(0, A->n_rows, [&](const int& row_i) {
-    std::vector<double> local_row(C->n_cols);
-    for (int i = A->row_ptr[row_i]; i < A->row_ptr[row_i + 1]; ++i) {
-      const int& col_i = A->col_index[i];
-      const double& val = A->values[i];
+  *C = CRSMultiply(*A, *B);
+
+  return true;
+}
+
+bool CRSMatMult::post_processing() {
+  internal_order_test();
 
-      for (int j = B->row_ptr[col_i]; j < B->row_ptr[col_i + 1]; ++j) {
-        local_row[B->col_index[j]] += val * B->values[j];
+  auto* out_ptr = reinterpret_cast<double*>(taskData->outputs[0]);
+  for (int i = 0; i < C->n_rows; ++i) {
+    for (int j = C->row_ptr[i]; j < C->row_ptr[i + 1]; ++j) {
+      out_ptr[i * C->n_cols + C->col_index[j]] = C->values[j];
+    }
+  }
+
+  return true;
+}
+
+CRSMatrix CRSMultiply(const CRSMatrix& A, const CRSMatrix& B) {
+  CRSMatrix C(A.n_rows, B.n_cols);
+  C.row_ptr.assign(A.n_rows + 1, 0);
+
+  // first pass: the number of structural nonzeros of every row of C
+  oneapi::tbb::parallel_for(oneapi::tbb::blocked_range<int>(0, A.n_rows), [&](const auto& r) {
+    std::vector<int> mark(B.n_cols, -1);
+    for (int row_i = r.begin(); row_i < r.end(); ++row_i) {
+      int count = 0;
+      for (int i = A.row_ptr[row_i]; i < A.row_ptr[row_i + 1]; ++i) {
+        const int& col_i = A.col_index[i];
+        for (int j = B.row_ptr[col_i]; j < B.row_ptr[col_i + 1]; ++j) {
+          if (mark[B.col_index[j]] != row_i) {
+            mark[B.col_index[j]] = row_i;
+            count++;
+          }
+        }
       }
+      C.row_ptr[row_i + 1] = count;
     }
+  });
+
+  // prefix sum: row_ptr[i] becomes the offset of row i in the final arrays
+  for (int i = 0; i < A.n_rows; ++i) {
+    C.row_ptr[i + 1] += C.row_ptr[i];
+  }
+  C.col_index.resize(C.row_ptr[A.n_rows]);
+  C.values.resize(C.row_ptr[A.n_rows]);
 
-    for (int i = 0; i < C->n_cols; ++i) {
-      double& val = local_row[i];
-      if (std::abs(val) > EPS) {
-        all_col_index[row_i].emplace_back(i);
-        all_value[row_i].emplace_back(val);
-        val = 0.0;
+  // second pass: every row is written straight into its place in the final arrays
+  oneapi::tbb::parallel_for(oneapi::tbb::blocked_range<int>(0, A.n_rows), [&](const auto& r) {
+    std::vector<double> local_row(B.n_cols);
+    std::vector<int> mark(B.n_cols, -1);
+    for (int row_i = r.begin(); row_i < r.end(); ++row_i) {
+      int pos = C.row_ptr[row_i];
+      for (int i = A.row_ptr[row_i]; i < A.row_ptr[row_i + 1]; ++i) {
+        const int& col_i = A.col_index[i];
+        const double& val = A.values[i];
+        for (int j = B.row_ptr[col_i]; j < B.row_ptr[col_i + 1]; ++j) {
+          const int& col_j = B.col_index[j];
+          if (mark[col_j] != row_i) {
+            mark[col_j] = row_i;
+            C.col_index[pos++] = col_j;
+          }
+          local_row[col_j] += val * B.values[j];
+        }
+      }
+      std::sort(C.col_index.begin() + C.row_ptr[row_i], C.col_index.begin() + pos);
+      for (int j = C.row_ptr[row_i]; j < pos; ++j) {
+        C.values[j] = local_row[C.col_index[j]];
+        local_row[C.col_index[j]] = 0.0;
       }
     }
   });
 
-  for (int i = 0; i < C->n_rows; ++i) {
-    C->row_ptr.emplace_back(static_cast<int>(C->values.size()));
-    C->col_index.insert(C->col_index.cend(), all_col_index[i].begin(), all_col_index[i].end());
-    C->values.insert(C->values.cend(), all_value[i].begin(), all_value[i].end());
+  return C;
+}
+
+bool CRSMatMultSparse::validation() {
+  internal_order_test();
+
+  if (taskData->inputs.size() != 2 || taskData->inputs_count.size() != 4 || taskData->outputs.size() != 1) {
+    return false;
+  }
+  if (taskData->inputs[0] == nullptr || taskData->inputs[1] == nullptr || taskData->outputs[0] == nullptr) {
+    return false;
   }
-  C->row_ptr.emplace_back(static_cast<int>(C->values.size()));
+  const auto* a = reinterpret_cast<CRSMatrix*>(taskData->inputs[0]);
+  const auto* b = reinterpret_cast<CRSMatrix*>(taskData->inputs[1]);
+  return taskData->inputs_count[1] == taskData->inputs_count[2] &&
+         a->n_rows == static_cast<int>(taskData->inputs_count[0]) &&
+         a->n_cols == static_cast<int>(taskData->inputs_count[1]) &&
+         b->n_rows == static_cast<int>(taskData->inputs_count[2]) &&
+         b->n_cols == static_cast<int>(taskData->inputs_count[3]) &&
+         a->row_ptr.size() == static_cast<size_t>(a->n_rows) + 1 &&
+         b->row_ptr.size() == static_cast<size_t>(b->n_rows) + 1;
+}
+
+bool CRSMatMultSparse::pre_processing() {
+  internal_order_test();
+
+  A = reinterpret_cast<CRSMatrix*>(taskData->inputs[0]);
+  B = reinterpret_cast<CRSMatrix*>(taskData->inputs[1]);
+  c_out = reinterpret_cast<CRSMatrix*>(taskData->outputs[0]);
 
   return true;
 }
 
-bool CRSMatMult::post_processing() {
+bool CRSMatMultSparse::run() {
   internal_order_test();
 
-  auto* out_ptr = reinterpret_cast<double*>(taskData->outputs[0]);
-  for (int i = 0; i < C->n_rows; ++i) {
-    for (int j = C->row_ptr[i]; j < C->row_ptr[i + 1]; ++j) {
-      out_ptr[i * C->n_cols + C->col_index[j]] = C->values[j];
-    }
-  }
+  C = CRSMultiply(*A, *B);
+
+  return true;
+}
+
+bool CRSMatMultSparse::post_processing() {
+  internal_order_test();
+
+  *c_out = std::move(C);
 
   return true;
 }
@@ -2,22 +2,18 @@
 
 #include "tbb/zorin_o_crs_matmult/include/crs_matrix.hpp"
 
+#include <tbb/tbb.h>
+
 #include <cmath>
 
+#include "core/sparse/include/compress.hpp"
+
 CRSMatrix::CRSMatrix(int n_rows, int n_cols) : n_rows(n_rows), n_cols(n_cols) { row_ptr.reserve(n_rows + 1); }
 
 CRSMatrix::CRSMatrix(const double* matrix, int n_rows, int n_cols) : CRSMatrix(n_rows, n_cols) {
-  for (int i = 0; i < n_rows; ++i) {
-    row_ptr.emplace_back(static_cast<int>(values.size()));
-    for (int j = 0; j < n_cols; ++j) {
-      const double& val = matrix[i * n_cols + j];
-      if (std::abs(val) > EPS) {
-        values.emplace_back(val);
-        col_index.emplace_back(j);
-      }
-    }
-  }
-  row_ptr.emplace_back(static_cast<int>(values.size()));
+  auto nonzero = [](double val) { return std::abs(val) > EPS; };
+  ppc::core::DenseToCompressed(matrix, n_rows, n_cols, false, nonzero, values, col_index, row_ptr,
+                               tbb::this_task_arena::max_concurrency());
 }
 
 std::vector<double> getRandomMatrix(const int& n_rows, const int& n_cols, const double& density, const double& a,